@@ -131,17 +131,10 @@ public:
     {
         auto* effectFormat = new DemoEffectFormat();
         effectFormat->fill (kpl);
-        apfm.addFormat (effectFormat);
+        getAudioPluginFormatManager().addFormat (effectFormat);
     }
 
-    //==============================================================================
-    /** */
-    const AudioPluginFormatManager& getAudioPluginFormatManager() const override { return apfm; }
-
 private:
-    //==============================================================================
-    AudioPluginFormatManager apfm;
-
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DemoEffectFactory)
 };
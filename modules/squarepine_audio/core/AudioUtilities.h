@@ -95,6 +95,60 @@ static void addFrom (juce::AudioBuffer<FloatType>& destination, juce::AudioBuffe
              gainFactor);
 }
 
+/** Blends a dry signal into a wet signal, in a single pass, overwriting the wet signal.
+
+    In other words: wet = (wet * mixLevel) + (dry * (1 - mixLevel))
+
+    @param wet          The wet signal, which will be replaced by the blended signal.
+    @param dry          The dry signal.
+    @param mixLevel     The normalised mix level; where 0 is entirely dry and 1 is entirely wet.
+    @param numSamples   The number of samples to blend.
+*/
+template<typename FloatType>
+inline void mixDryIntoWet (FloatType* wet, const FloatType* dry, FloatType mixLevel, int numSamples) noexcept
+{
+    const auto dryLevel = static_cast<FloatType> (1) - mixLevel;
+
+    for (int i = 0; i < numSamples; ++i)
+        wet[i] = wet[i] * mixLevel + dry[i] * dryLevel;
+}
+
+/** Blends a dry signal into a wet signal, in a single pass, overwriting the wet signal,
+    while linearly ramping the mix level across the samples.
+
+    Each sample is blended the same way as with a constant mix level,
+    so a ramp that starts and ends on the same level gives the same result.
+
+    The ramp matches what stepping a LinearSmoothedValue per sample would produce:
+    the first sample is mixed one step after the start level, and the last sample
+    lands on the end level.
+
+    There's no dependency between iterations here, so any
+    reasonable compiler will vectorise this for floats and doubles.
+
+    @param wet              The wet signal, which will be replaced by the blended signal.
+    @param dry              The dry signal.
+    @param startMixLevel    The normalised mix level prior to the first sample.
+    @param endMixLevel      The normalised mix level at the last sample.
+    @param numSamples       The number of samples to blend.
+*/
+template<typename FloatType>
+inline void mixDryIntoWet (FloatType* wet, const FloatType* dry,
+                           FloatType startMixLevel, FloatType endMixLevel,
+                           int numSamples) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    const auto increment = (endMixLevel - startMixLevel) / static_cast<FloatType> (numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto mixLevel = startMixLevel + increment * static_cast<FloatType> (i + 1);
+        wet[i] = wet[i] * mixLevel + dry[i] * (static_cast<FloatType> (1) - mixLevel);
+    }
+}
+
 //==============================================================================
 /** Quick-and-dirty function to format a timecode string. */
 [[nodiscard]] inline String timeToTimecodeString (double seconds)
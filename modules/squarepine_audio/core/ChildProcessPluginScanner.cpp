@@ -1,183 +1,66 @@
-namespace XMLAttributeKeys
-{
-    static const String IDKey = "IDValue";
-    static const String formatKey = "formatValue";
-    static const String fileKey = "fileValue";
-}
-
 ChildProcessPluginScanner::ChildProcessPluginScanner() { }
 
-bool ChildProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
-                                                    OwnedArray<PluginDescription>& result,
-                                                    const String& fileOrIdentifier)
-{
-    TemporaryFile tempFile;
-    auto tempResultsFile = tempFile.getFile();
-
-    StringArray args;
-    args.add (File::getSpecialLocation (File::currentExecutableFile).getFullPathName());
-    args.add (createCommandArgument (format, fileOrIdentifier, tempResultsFile));
-
-    {
-        ChildProcess child;
-        if (child.start (args))
-        {
-            waitForChildProcessOutput (child);
-
-            //For some reason this stops some plugins from hanging, 
-            //letting them write their results file.
-            if (tempResultsFile.getSize() == 0)
-                child.readAllProcessOutput();
-        }
-    }
-
-    return handleResultsFile (tempResultsFile, result);
-}
-
-void ChildProcessPluginScanner::performScan (const String& commandLine, OwnedArray<AudioPluginFormat> customFormats)
+ChildProcessPluginScanner::ChildProcessPluginScanner (const PluginScanService::Options& options, const File& cacheFile) :
+    scanService (options)
 {
-    const auto request = XmlDocument::parse (commandLine.trim().unquoted());
-
-    if (request != nullptr
-        && request->hasTagName ("PluginScan")
-        && request->hasAttribute (XMLAttributeKeys::IDKey)
-        && request->hasAttribute (XMLAttributeKeys::formatKey)
-        && request->hasAttribute (XMLAttributeKeys::fileKey))
-    {
-        performScanInChildProcess (request->getStringAttribute (XMLAttributeKeys::IDKey),
-                                   request->getStringAttribute (XMLAttributeKeys::formatKey),
-                                   request->getStringAttribute (XMLAttributeKeys::fileKey),
-                                   customFormats);
-        return;
-    }
-
-    jassertfalse;
+    if (cacheFile != File())
+        scanCache = std::make_unique<PluginScanCache> (cacheFile);
 }
 
-bool ChildProcessPluginScanner::shouldScan (const String& commandLine)
+ChildProcessPluginScanner::~ChildProcessPluginScanner()
 {
-    return commandLine.contains ("PluginScan");
+    if (scanCache != nullptr)
+        scanCache->save();
 }
 
-void ChildProcessPluginScanner::waitForChildProcessOutput (ChildProcess& child)
+bool ChildProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
 {
-    int total = 30000;
+    const auto formatName = format.getName();
 
-    while (total > 0)
-    {
-        if (! MessageManager::getInstance()->isThisTheMessageThread())
-        {
-            Thread* t = Thread::getCurrentThread();
-            if (t == nullptr || t->threadShouldExit())
-                break;
-        }
+    if (scanCache == nullptr)
+        return scanService.scan (formatName, fileOrIdentifier, result) == PluginScanService::Outcome::scanned;
 
-        child.waitForProcessToFinish (50);
+    // N.B.: The fingerprint is taken before scanning, so that a file changing mid-scan gets rescanned next time.
+    const auto fingerprint = PluginScanCache::Fingerprint::create (fileOrIdentifier);
 
-        Thread::sleep (1);
-        total -= 50;
-    }
-}
+    if (scanCache->find (formatName, fileOrIdentifier, fingerprint, result))
+        return true;
 
-bool ChildProcessPluginScanner::handleResultsFile (const File& resultsFile, OwnedArray <PluginDescription>& result)
-{
-    const auto xml = XmlDocument::parse (resultsFile);
-    resultsFile.deleteFile(); //No longer needed, so clean it up
+    OwnedArray<PluginDescription> found;
 
-    if (xml != nullptr)
-    {
-        handleResultXml (*xml, result);
-        return true;
-    }
+    if (scanService.scan (formatName, fileOrIdentifier, found) != PluginScanService::Outcome::scanned)
+        return false;
 
-    return false;
-}
+    scanCache->store (formatName, fileOrIdentifier, fingerprint, found);
 
-void ChildProcessPluginScanner::handleResultXml (const XmlElement& xml, OwnedArray<PluginDescription>& found)
-{
-    if (xml.hasTagName ("PluginsFound"))
-    {
-        for (auto* e : xml.getChildIterator())
-        {
-            PluginDescription desc;
-            if (desc.loadFromXml (*e))
-                found.add (new PluginDescription (desc));
-        }
-    }
+    result.addArray (found);
+    found.clear (false);
+    return true;
 }
 
-String ChildProcessPluginScanner::createCommandArgument (AudioPluginFormat& format,
-                                                         const String& fileOrIdentifier,
-                                                         const File& tempResultsFile)
+void ChildProcessPluginScanner::scanFinished()
 {
-    XmlElement request ("PluginScan");
-    request.setAttribute (XMLAttributeKeys::IDKey, fileOrIdentifier);
-    request.setAttribute (XMLAttributeKeys::formatKey, format.getName());
-    request.setAttribute (XMLAttributeKeys::fileKey, tempResultsFile.getFullPathName());
-
-    return URL::addEscapeChars (request.toString(), true);
+    if (scanCache != nullptr)
+        scanCache->save();
 }
 
-void ChildProcessPluginScanner::performScanInChildProcess (const String& fileOrIdentifier, 
-                                                           const String& formatName, 
-                                                           File resultsFile,
-                                                           OwnedArray<AudioPluginFormat>& customFormats)
+std::unique_ptr<PluginScanWorker> ChildProcessPluginScanner::startScanWorker (const String& commandLine,
+                                                                              OwnedArray<AudioPluginFormat> customFormats)
 {
-   #if JUCE_MAC
-    setupSignalHandling();
-   #endif
-
-    if (resultsFile.existsAsFile())
-        resultsFile.deleteFile();
-
-    resultsFile.create();
-    auto outStream = resultsFile.createOutputStream();
-
-    if (outStream != nullptr && outStream->openedOk())
+    if (shouldScan (commandLine))
     {
-        AudioPluginFormatManager pluginFormatManager;
-        pluginFormatManager.addDefaultFormats();
+        auto worker = std::make_unique<PluginScanWorker> (std::move (customFormats));
 
-        for (auto i = customFormats.size(); --i >= 0;)
-            pluginFormatManager.addFormat (customFormats.removeAndReturn (i));
-
-        for (auto i = 0; i < pluginFormatManager.getNumFormats(); ++i)
-        {
-            auto format = pluginFormatManager.getFormat (i);
-
-            if (format->getName() == formatName)
-            {
-                OwnedArray<PluginDescription> found;
-                format->findAllTypesForFile (found, fileOrIdentifier);
-
-                XmlElement result ("PluginsFound");
-
-                for (auto pd : found)
-                    result.addChildElement (pd->createXml().release());
-
-                *outStream << result.toString();
-                outStream->flush();
-            }
-        }
+        if (worker->initialiseFromCommandLine (commandLine))
+            return worker;
     }
-}
 
-#if ! JUCE_WINDOWS
-
-void ChildProcessPluginScanner::killWithoutMercy (int)
-{
-    std::exit (EXIT_FAILURE);
+    return {};
 }
 
-void ChildProcessPluginScanner::setupSignalHandling()
+bool ChildProcessPluginScanner::shouldScan (const String& commandLine)
 {
-/*
-    for (auto v : { SIGFPE, SIGILL, SIGSEGV, SIGBUS, SIGABRT })
-    {
-        ::signal (v, killWithoutMercy);
-        siginterrupt (v, 1);
-    }
-*/
+    return PluginScanWorker::isWorkerCommandLine (commandLine);
 }
-
-#endif
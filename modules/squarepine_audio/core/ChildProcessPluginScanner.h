@@ -1,41 +1,81 @@
-/** */
+/** A KnownPluginList::CustomScanner that scans plugins out of process,
+    using a PluginScanService's pool of long-lived worker processes.
+
+    Any plugins that crash or hang a worker are blacklisted by the service,
+    and fail to scan from then on. Seeing as the service is thread safe,
+    this works with any number of scanning threads; eg: PluginListComponent's.
+
+    Given a cache file, the results of every scan are kept in a PluginScanCache,
+    so that plugins whose files haven't changed since are never rescanned.
+    The cache gets saved whenever a scan finishes, and when the scanner is destroyed.
+
+    The application must start a worker when its command line asks for one:
+
+    @code
+        void initialise (const String& commandLine) override
+        {
+            if (ChildProcessPluginScanner::shouldScan (commandLine))
+            {
+                scanWorker = ChildProcessPluginScanner::startScanWorker (commandLine);
+
+                if (scanWorker != nullptr)
+                    return;
+            }
+
+            ...
+        }
+    @endcode
+
+    @see PluginScanService, PluginScanWorker
+*/
 class ChildProcessPluginScanner final : public KnownPluginList::CustomScanner
 {
 public:
-    /** */
+    /** Constructor, using the default scanning options. */
     ChildProcessPluginScanner();
 
+    /** Constructor.
+
+        @param options      How to run the worker processes.
+        @param cacheFile    Where to keep the results of previous scans.
+                            Leave this empty to always scan everything.
+    */
+    explicit ChildProcessPluginScanner (const PluginScanService::Options& options, const File& cacheFile = {});
+
+    /** Destructor, which saves the cache. */
+    ~ChildProcessPluginScanner() override;
+
     //==============================================================================
-    /** */
-    static void performScan (const String& commandLine, OwnedArray<AudioPluginFormat> customFormats = {});
+    /** @returns the service doing the scanning; eg: to store or restore its blacklist. */
+    [[nodiscard]] PluginScanService& getScanService() noexcept { return scanService; }
 
-    /** */
+    /** @returns the cache of previous scans, or null if there isn't one. */
+    [[nodiscard]] PluginScanCache* getScanCache() noexcept { return scanCache.get(); }
+
+    //==============================================================================
+    /** @returns a worker, connected to the scanner that started this process,
+        which must be kept alive until the worker quits the application.
+        Or null if the command line isn't a worker's.
+
+        @param commandLine      The command line this process was started with.
+        @param customFormats    Any formats to scan with besides JUCE's default ones.
+    */
+    [[nodiscard]] static std::unique_ptr<PluginScanWorker> startScanWorker (const String& commandLine,
+                                                                            OwnedArray<AudioPluginFormat> customFormats = {});
+
+    /** @returns true if the command line was made to start a scanning worker. */
     [[nodiscard]] static bool shouldScan (const String& commandLine);
 
     //==============================================================================
     /** @internal */
     [[nodiscard]] bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
 
 private:
     //==============================================================================
-    void waitForChildProcessOutput (ChildProcess& child);
-    bool handleResultsFile (const File& resultsFile, OwnedArray<PluginDescription>& result);
-    void handleResultXml (const XmlElement& xml, OwnedArray<PluginDescription>& found);
-
-    [[nodiscard]] static String createCommandArgument (AudioPluginFormat&,
-                                                       const String& fileOrIdentifier,
-                                                       const File& tempResultsFile);
-
-    static void performScanInChildProcess (const String& fileOrIdentifier, 
-                                           const String& formatName, 
-                                           File resultsFile,
-                                           OwnedArray<AudioPluginFormat>& customFormats);
-
-    //==============================================================================
-   #if ! JUCE_WINDOWS
-    static void killWithoutMercy (int);
-    static void setupSignalHandling();
-   #endif
+    PluginScanService scanService;
+    std::unique_ptr<PluginScanCache> scanCache;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessPluginScanner)
@@ -1,6 +1,7 @@
 EffectProcessor::EffectProcessor (std::shared_ptr<AudioPluginInstance> api,
                             const PluginDescription& pd) :
     isBypassed (false),
+    targetMixLevel (1.0f),
     mixLevel (1.0f),
     plugin (std::move (api)),
     description (pd)
@@ -23,26 +24,31 @@ bool EffectProcessor::reloadFromStateIfValid()
     {
         bool wasValid = false;
 
-        MemoryOutputStream stream;
-
-        if (Base64::convertFromBase64 (stream, lastKnownBase64State)
-            && stream.getData() != nullptr
-            && stream.getDataSize() > 0)
+        if (lastKnownState.getData() != nullptr && lastKnownState.getSize() > 0)
         {
-            plugin->setStateInformation (stream.getData(), (int) stream.getDataSize());
+            plugin->setStateInformation (lastKnownState.getData(), (int) lastKnownState.getSize());
             wasValid = true;
         }
 
-        lastKnownBase64State.clear();
+        lastKnownState.reset();
         return wasValid;
     }
 
     return true;
 }
 
+void EffectProcessor::prepareLatencyCompensation (int numChannels)
+{
+    latencySamples = isMissing() ? 0 : jmax (0, plugin->getLatencySamples());
+    numChannels = jmax (numChannels, description.numInputChannels, description.numOutputChannels);
+
+    floatCompensationDelay.prepare (numChannels, latencySamples);
+    doubleCompensationDelay.prepare (numChannels, latencySamples);
+}
+
 bool EffectProcessor::canBeProcessed() const noexcept
 {
     return ! isMissing()
         && ! isBypassed.load (std::memory_order_relaxed)
-        && mixLevel.getTargetValue() > 0.0f;
+        && targetMixLevel.load (std::memory_order_relaxed) > 0.0f;
 }
@@ -29,17 +29,46 @@ public:
     /** @returns true if the plugin was able to be restored from its last known state. */
     bool reloadFromStateIfValid();
 
+    //==============================================================================
+    /** Captures the plugin's current latency, and sizes the dry signal's compensation delays to match.
+
+        This allocates, so call it after preparing the plugin, and before the audio thread can see this effect.
+
+        @param numChannels The number of channels the chain outputs.
+                           The plugin's own channel counts get accounted for here.
+    */
+    void prepareLatencyCompensation (int numChannels);
+
+    /** @returns the plugin's latency, as of when prepareLatencyCompensation() was last called. */
+    [[nodiscard]] int getLatencySamples() const noexcept { return latencySamples; }
+
+    /** @returns the delay that lines the dry signal up with the plugin's output. */
+    template<typename FloatType>
+    [[nodiscard]] LatencyCompensationDelay<FloatType>& getCompensationDelay() noexcept
+    {
+        if constexpr (std::is_same_v<FloatType, double>)
+            return doubleCompensationDelay;
+        else
+            return floatCompensationDelay;
+    }
+
     //==============================================================================
     String name;                                    //<
     std::atomic<bool> isBypassed;                   //<
-    LinearSmoothedValue<float> mixLevel;            //< The normalised mix level.
+    std::atomic<float> targetMixLevel;              //< The normalised mix level, as requested from any thread.
+    LinearSmoothedValue<float> mixLevel;            //< The normalised mix level, as ramped on the audio thread.
     juce::Point<int> lastUIPosition;                //<
     std::shared_ptr<AudioPluginInstance> plugin;    //<
     const PluginDescription description;            //<
     MemoryBlock defaultState;                       //<
-    String lastKnownBase64State;                    //<
+    MemoryBlock lastKnownState;                     //< A plugin state waiting to be restored, or kept around while the plugin is missing.
 
 private:
+    //==============================================================================
+    int latencySamples = 0;
+    LatencyCompensationDelay<float> floatCompensationDelay;     // Only used by the audio thread, once prepared.
+    LatencyCompensationDelay<double> doubleCompensationDelay;   // Only used by the audio thread, once prepared.
+
     //==============================================================================
     EffectProcessor() = delete;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EffectProcessor)
@@ -4,11 +4,148 @@ EffectProcessorChain::EffectProcessorChain (std::shared_ptr<EffectProcessorFacto
 {
     jassert (factory != nullptr);
     plugins.reserve (10);
+
+    const ScopedLock sl (mutationLock);
+    publishSnapshot();
+}
+
+EffectProcessorChain::~EffectProcessorChain()
+{
+    cancelAsyncRestore();
+
+    // The audio thread must be done with this chain by now!
+    jassert (audioThreadGeneration.load() == idleGeneration);
+
+    const ScopedLock sl (mutationLock);
+    publishedSnapshot = nullptr;
+    liveSnapshots.clear();
+
+    for (auto& effect : plugins)
+        retiredEffects.emplace_back (std::move (effect));
+
+    plugins.clear();
+    recycleRetiredEffects();
 }
 
 //==============================================================================
+EffectProcessorChain::ScopedSnapshotReader::ScopedSnapshotReader (EffectProcessorChain& c) noexcept :
+    chain (c)
+{
+    chain.audioThreadGeneration.store (chain.publishedGeneration.load());
+    snapshot = chain.publishedSnapshot.load();
+}
+
+EffectProcessorChain::ScopedSnapshotReader::~ScopedSnapshotReader() noexcept
+{
+    chain.audioThreadGeneration.store (idleGeneration);
+}
+
+void EffectProcessorChain::publishSnapshot()
+{
+    // Anything the previous snapshot had that's gone from the chain now is retired:
+    if (const auto* previous = publishedSnapshot.load())
+        for (const auto& effect : previous->plugins)
+            if (effect != nullptr && std::find (plugins.begin(), plugins.end(), effect) == plugins.end())
+                retiredEffects.emplace_back (effect);
+
+    auto snapshot = std::make_unique<Snapshot>();
+    snapshot->plugins = plugins;
+    snapshot->requiredChannels = getRequiredChannelCount();
+    snapshot->generation = ++lastGeneration;
+
+    publishedSnapshot.store (snapshot.get());
+    publishedGeneration.store (snapshot->generation);
+    liveSnapshots.emplace_back (std::move (snapshot));
+
+    reclaimSnapshots();
+}
+
+void EffectProcessorChain::reclaimSnapshots()
+{
+    const auto generationInUse = audioThreadGeneration.load();
+    const auto* const current = publishedSnapshot.load();
+
+    liveSnapshots.erase (std::remove_if (liveSnapshots.begin(), liveSnapshots.end(),
+                                         [&] (const std::unique_ptr<Snapshot>& snapshot)
+                                         {
+                                             return snapshot.get() != current
+                                                 && snapshot->generation < generationInUse;
+                                         }),
+                         liveSnapshots.end());
+
+    recycleRetiredEffects();
+}
+
+void EffectProcessorChain::recycleRetiredEffects()
+{
+    // N.B.: Once the chain is the only owner of a retired effect, no snapshot refers to it anymore
+    //       and nobody else can get a hold of it, so its plugin can safely be reused.
+    retiredEffects.erase (std::remove_if (retiredEffects.begin(), retiredEffects.end(),
+                                          [&] (const EffectProcessor::Ptr& effect)
+                                          {
+                                              if (effect.use_count() > 1)
+                                                  return false;
+
+                                              if (factory != nullptr && effect->plugin.use_count() == 1)
+                                                  factory->recyclePlugin (effect->description, std::move (effect->plugin));
+
+                                              return true;
+                                          }),
+                          retiredEffects.end());
+}
+
+//==============================================================================
+void EffectProcessorChain::preparePlugin (AudioPluginInstance& plugin, double sampleRate, int blockSize,
+                                          int numChannels, AudioPlayHead* playHead)
+{
+    EffectProcessorFactory::preparePlugin (plugin, { sampleRate, blockSize, numChannels }, playHead);
+}
+
+void EffectProcessorChain::resetMixLevel (EffectProcessor& effect, double sampleRate)
+{
+    if (sampleRate > 0.0)
+        effect.mixLevel.reset (sampleRate, mixRampLengthSeconds);
+    else
+        effect.mixLevel.setCurrentAndTargetValue (effect.mixLevel.getTargetValue());
+}
+
+template<typename Type>
+EffectProcessor::Ptr EffectProcessorChain::createEffect (EffectProcessorFactory& effectFactory, const Type& valueOrRef,
+                                                         double sampleRate, int blockSize, int numChannels,
+                                                         AudioPlayHead* playHead, const EffectInitialiser& initialiser)
+{
+    const auto description = effectFactory.createPluginDescription (valueOrRef);
+    std::shared_ptr<AudioPluginInstance> pluginInstance;
+
+    if (auto pooledInstance = effectFactory.takePooledPlugin (description, { sampleRate, blockSize, numChannels }))
+    {
+        pooledInstance->setPlayHead (playHead);
+        pluginInstance = std::move (pooledInstance);
+    }
+    else
+    {
+        pluginInstance = effectFactory.createPlugin (description);
+        if (pluginInstance == nullptr)
+            return {};
+
+        preparePlugin (*pluginInstance, sampleRate, blockSize, numChannels, playHead);
+    }
+
+    auto effect = std::make_shared<EffectProcessor> (std::move (pluginInstance), description);
+
+    // Nobody else knows about the new effect yet, so this is the time to configure it:
+    if (initialiser != nullptr)
+        initialiser (*effect);
+
+    // N.B.: Restoring a state can change the plugin's latency, so this has to come after the initialiser.
+    effect->prepareLatencyCompensation (numChannels);
+    resetMixLevel (*effect, sampleRate);
+    return effect;
+}
+
 template<typename Type>
-EffectProcessor::Ptr EffectProcessorChain::insertInternal (const Type& valueOrRef, int destinationIndex, InsertionStyle insertionStyle)
+EffectProcessor::Ptr EffectProcessorChain::insertInternal (const Type& valueOrRef, int destinationIndex,
+                                                           InsertionStyle insertionStyle, EffectInitialiser initialiser)
 {
     if (factory == nullptr)
     {
@@ -16,15 +153,10 @@ EffectProcessor::Ptr EffectProcessorChain::insertInternal (const Type& valueOrRe
         return {};
     }
 
-    if (auto pluginInstance = factory->createPlugin (valueOrRef))
+    if (auto effect = createEffect (*factory, valueOrRef, getSampleRate(), getBlockSize(), getMainChannelCount(), getPlayHead(), initialiser))
     {
-        pluginInstance->setPlayHead (getPlayHead());
-        pluginInstance->prepareToPlay (getSampleRate(), getBlockSize());
-
-        auto effect = std::make_shared<EffectProcessor> (std::move (pluginInstance), factory->createPluginDescription (valueOrRef));
-
         {
-            const ScopedLock sl (getCallbackLock());
+            const ScopedLock sl (mutationLock);
 
             if (insertionStyle == InsertionStyle::append
                 || ! isPositiveAndBelow (destinationIndex, getNumEffects()))
@@ -41,6 +173,7 @@ EffectProcessor::Ptr EffectProcessorChain::insertInternal (const Type& valueOrRe
             }
 
             updateLatency();
+            publishSnapshot();
         }
 
         updateHostDisplay();
@@ -64,8 +197,11 @@ bool EffectProcessorChain::moveEffect (int pluginIndex, int destinationIndex)
     bool changed = false;
 
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (mutationLock);
         changed = moveItem (plugins, pluginIndex, std::clamp (destinationIndex, 0, getNumEffects()));
+
+        if (changed)
+            publishSnapshot();
     }
 
     if (changed)
@@ -89,7 +225,7 @@ bool EffectProcessorChain::moveEffect (int pluginIndex, PluginPositionPreset des
     bool changed = false;
 
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (mutationLock);
 
         switch (destinationPosition)
         {
@@ -103,6 +239,9 @@ bool EffectProcessorChain::moveEffect (int pluginIndex, PluginPositionPreset des
                 jassertfalse;
                 break;
         };
+
+        if (changed)
+            publishSnapshot();
     }
 
     if (changed)
@@ -114,7 +253,7 @@ bool EffectProcessorChain::moveEffect (int pluginIndex, PluginPositionPreset des
 //==============================================================================
 int EffectProcessorChain::getNumEffects() const
 {
-    const ScopedLock sl (getCallbackLock());
+    const ScopedLock sl (mutationLock);
     return static_cast<int> (plugins.size());
 }
 
@@ -123,9 +262,14 @@ bool EffectProcessorChain::removeEffect (int index)
     bool changed = false;
 
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (mutationLock);
         changed = removeItem (plugins, index);
-        updateLatency();
+
+        if (changed)
+        {
+            updateLatency();
+            publishSnapshot();
+        }
     }
 
     if (changed)
@@ -139,13 +283,14 @@ bool EffectProcessorChain::clear()
     bool changed = false;
 
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (mutationLock);
         changed = ! plugins.empty();
 
         if (changed)
         {
             plugins.clear();
-            updateLatency();// Doing this here to avoid doubly locking.
+            updateLatency();
+            publishSnapshot();
         }
     }
 
@@ -158,7 +303,7 @@ bool EffectProcessorChain::clear()
 //==============================================================================
 EffectProcessor::Ptr EffectProcessorChain::getEffectProcessor (int index) const
 {
-    const ScopedLock sl (getCallbackLock());
+    const ScopedLock sl (mutationLock);
 
     if (isPositiveAndBelow (index, getNumEffects()))
         return plugins[(size_t) index];
@@ -213,7 +358,7 @@ std::optional<float> EffectProcessorChain::getMixLevel (int index) const
 {
     return getEffectProperty<float> (index, [&] (EffectProcessor::Ptr e)
                                      {
-                                         return e->mixLevel.getTargetValue();
+                                         return e->targetMixLevel.load (std::memory_order_relaxed);
                                      });
 }
 
@@ -235,22 +380,44 @@ std::optional<bool> EffectProcessorChain::isPluginMissing (int index) const
 
 bool EffectProcessorChain::loadIfMissing (int index)
 {
-    const ScopedLock sl (getCallbackLock());
+    auto effect = getEffectProcessor (index);
+    if (effect == nullptr || ! effect->isMissing())
+        return false;
 
-    if (isPositiveAndBelow (index, getNumEffects())
-        && isPluginMissing (index))
-    {
-        if (auto effect = plugins[(size_t) index])
-        {
-            const InternalProcessor::ScopedBypass sb (*this);
+    auto pluginInstance = factory->createPlugin (effect->description);
+    if (pluginInstance == nullptr)
+        return false;
 
-            effect->plugin = factory->createPlugin (effect->description);
-            effect->reloadFromStateIfValid();
-            return true;
-        }
+    preparePlugin (*pluginInstance, getSampleRate(), getBlockSize(), getMainChannelCount(), getPlayHead());
+
+    // The audio thread may still be looking at the missing effect,
+    // so the reloaded plugin gets swapped in as an entirely new effect.
+    auto newEffect = std::make_shared<EffectProcessor> (std::move (pluginInstance), effect->description);
+
+    {
+        const ScopedLock sl (mutationLock);
+
+        auto it = std::find (plugins.begin(), plugins.end(), effect);
+        if (it == plugins.end())
+            return false; // Removed while the plugin was being loaded...
+
+        newEffect->name = effect->name;
+        newEffect->isBypassed = effect->isBypassed.load();
+        newEffect->targetMixLevel = effect->targetMixLevel.load();
+        newEffect->mixLevel.setCurrentAndTargetValue (newEffect->targetMixLevel);
+        newEffect->lastUIPosition = effect->lastUIPosition;
+        newEffect->lastKnownState = effect->lastKnownState;
+        newEffect->reloadFromStateIfValid();
+        newEffect->prepareLatencyCompensation (getMainChannelCount());
+        resetMixLevel (*newEffect, getSampleRate());
+
+        *it = newEffect;
+        updateLatency();
+        publishSnapshot();
     }
 
-    return false;
+    updateHostDisplay();
+    return true;
 }
 
 //==============================================================================
@@ -258,7 +425,7 @@ bool EffectProcessorChain::setEffectProperty (int index, std::function<void (Eff
 {
     jassert (func != nullptr);
 
-    const ScopedLock sl (getCallbackLock());
+    const ScopedLock sl (mutationLock);
 
     if (auto effect = getEffectProcessor (index))
     {
@@ -287,14 +454,19 @@ bool EffectProcessorChain::setBypass (int index, bool bypass)
 
 bool EffectProcessorChain::setMixLevel (int index, float mixLevel)
 {
+    // N.B.: The audio thread expects a normalised mix level, so it's clamped here rather than there.
+    mixLevel = jlimit (0.0f, 1.0f, mixLevel);
+
     return setEffectProperty (index, [&] (EffectProcessor::Ptr e)
                               {
-                                  e->mixLevel = mixLevel;
+                                  e->targetMixLevel = mixLevel;
                               });
 }
 
 void EffectProcessorChain::setTimeEffectsInChain (EffectUpdateFn f)
 {
+    const ScopedLock sl (mutationLock);
+
     for (const auto& effect: plugins)
     {
         if (effect == nullptr || effect->plugin == nullptr)// if effect == nullptr, continue
@@ -316,104 +488,202 @@ void EffectProcessorChain::prepareToPlay (const double sampleRate, const int est
 
     const auto numChans = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels(), 1);
 
-    const ScopedLock sl (getCallbackLock());
+    // The factory's pools get ready for whatever gets inserted next:
+    if (factory != nullptr)
+        factory->setPlaybackConfiguration ({ sampleRate, estimatedSamplesPerBlock, numChans });
 
-    floatBuffers.prepare (numChans, estimatedSamplesPerBlock);
-    doubleBuffers.prepare (numChans, estimatedSamplesPerBlock);
+    {
+        const ScopedLock sl (getCallbackLock());
+
+        floatBuffers.prepare (numChans, estimatedSamplesPerBlock);
+        doubleBuffers.prepare (numChans, estimatedSamplesPerBlock);
+    }
+
+    const ScopedLock sl (mutationLock);
 
     for (auto effect: plugins)
     {
         if (effect != nullptr)
         {
+            effect->mixLevel.reset (sampleRate, mixRampLengthSeconds);
+
             if (auto plugin = effect->plugin)
-            {
-                plugin->setPlayHead (getPlayHead());
-                plugin->prepareToPlay (sampleRate, estimatedSamplesPerBlock);
-            }
+                preparePlugin (*plugin, sampleRate, estimatedSamplesPerBlock, numChans, getPlayHead());
+
+            effect->prepareLatencyCompensation (numChans);
         }
     }
 
     updateLatency();
 }
 
+int EffectProcessorChain::getMainChannelCount() const
+{
+    return jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+}
+
 void EffectProcessorChain::updateLatency()
 {
-    updateChannelCount();
+    // Bypassed and fully dry effects still delay the signal by their latency,
+    // so that toggling them doesn't make the chain's latency jump around.
+    int totalLatency = 0;
 
-    // N.B.: This probably isn't accurate at all (@todo ?)
-    for (auto effect: plugins)
-        if (auto plugin = effect->plugin)
-            setLatencySamples (getLatencySamples() + plugin->getLatencySamples());
+    for (const auto& effect: plugins)
+        if (effect != nullptr && ! effect->isMissing())
+            totalLatency += effect->getLatencySamples();
+
+    setLatencySamples (totalLatency);
 }
 
-void EffectProcessorChain::updateChannelCount()
+int EffectProcessorChain::getRequiredChannelCount() const
 {
     int newRequiredChannels = 0;
 
     for (auto effect: plugins)
-        newRequiredChannels = jmax (newRequiredChannels, effect->description.numInputChannels, effect->description.numOutputChannels);
+        if (effect != nullptr)
+            newRequiredChannels = jmax (newRequiredChannels, effect->description.numInputChannels, effect->description.numOutputChannels);
 
-    requiredChannels = newRequiredChannels;
+    return newRequiredChannels;
 }
 
 //==============================================================================
 template<typename FloatType>
-void EffectProcessorChain::processInternal (juce::AudioBuffer<FloatType>& source,
+void EffectProcessorChain::processEffect (AudioPluginInstance& plugin, juce::AudioBuffer<FloatType>& buffer,
+                                          MidiBuffer& midiMessages, int numPluginChannels, int numSamples)
+{
+    if (numPluginChannels >= buffer.getNumChannels())
+    {
+        processSafely (plugin, buffer, midiMessages);
+        return;
+    }
+
+    // Uses a view onto the buffer's channels so as to avoid allocating anything:
+    juce::AudioBuffer<FloatType> view (buffer.getArrayOfWritePointers(), numPluginChannels, numSamples);
+    processSafely (plugin, view, midiMessages);
+}
+
+int EffectProcessorChain::getNumChannelsForPlugin (const AudioPluginInstance& plugin, int numChannels) noexcept
+{
+    // Plugins that kept a narrower layout than the chain only get handed the channels they were prepared for.
+    const auto numPluginChannels = jmax (plugin.getTotalNumInputChannels(), plugin.getTotalNumOutputChannels());
+    return numPluginChannels > 0 ? jmin (numPluginChannels, numChannels) : numChannels;
+}
+
+template<typename FloatType>
+void EffectProcessorChain::processInternal (const Snapshot& snapshot,
+                                            juce::AudioBuffer<FloatType>& source,
                                             MidiBuffer& midiMessages,
                                             BufferPackage<FloatType>& bufferPackage,
                                             const int numChannels,
                                             const int numSamples)
 {
-    // Uses requiredChannels to ensure enough memory is allocated for the plugin to
-    // potentially read from/write to - avoids bad accesses.
-    // We only care about the main outputs, so still use the numChannels variable throughout
-    bufferPackage.prepare (requiredChannels, numSamples);
-    bufferPackage.clear();
+    // Uses requiredChannels to ensure enough memory is allocated for any plugin to
+    // potentially read from/write to - avoids bad accesses - while still running
+    // every one of the incoming channels through the chain.
+    const auto workingChannels = jmax (numChannels, snapshot.requiredChannels);
 
-    const auto channels = jmin (numChannels, requiredChannels.load());
+    bufferPackage.prepare (workingChannels, numSamples);
 
-    addFrom (bufferPackage.mixingBuffer, source, channels, numSamples);
+    auto* current = &bufferPackage.sourceAlias;
 
-    for (auto effect: plugins)
+    if (numChannels >= workingChannels)
+    {
+        // Zero-copy: the effects get run directly on the incoming channels.
+        current->setDataToReferTo (source.getArrayOfWritePointers(), workingChannels, numSamples);
+    }
+    else
     {
-        if (effect == nullptr || ! effect->canBeProcessed())
+        current = &bufferPackage.dryBuffer;
+        current->clear();
+        addFrom (*current, source, numChannels, numSamples);
+    }
+
+    for (const auto& effect: snapshot.plugins)
+    {
+        if (effect == nullptr || effect->isMissing())
             continue;
 
-        // Process the effect:
-        bufferPackage.effectBuffer.clear();
-        addFrom (bufferPackage.effectBuffer, bufferPackage.mixingBuffer, channels, numSamples);
+        // Bypassing an effect ramps it down to a dry mix, rather than cutting it off, to avoid clicks.
+        auto& mixLevel = effect->mixLevel;
+        mixLevel.setTargetValue (effect->isBypassed.load (std::memory_order_relaxed)
+                                    ? 0.0f
+                                    : effect->targetMixLevel.load (std::memory_order_relaxed));
 
-        processSafely (*effect->plugin, bufferPackage.effectBuffer, midiMessages);
+        // Ramps the mix across the whole block, or skips straight through when it's flat:
+        const auto startMixLevel = mixLevel.getCurrentValue();
+        const auto endMixLevel = mixLevel.isSmoothing() ? mixLevel.skip (numSamples) : startMixLevel;
+        jassert (isPositiveAndBelow (startMixLevel, 1.00001f) && isPositiveAndBelow (endMixLevel, 1.00001f));
 
-        // Add the effect-saturated samples at the specified mix level:
-        const auto mixLevel = effect->mixLevel.getNextValue();
-        jassert (isPositiveAndBelow (mixLevel, 1.00001f));
+        // The dry signal always goes through the effect's compensation delay,
+        // keeping it lined up with the wet signal, and the chain's latency constant.
+        // Any channels past the ones the plugin processes are delayed all the same.
+        auto& compensationDelay = effect->getCompensationDelay<FloatType>();
+        const auto numPluginChannels = getNumChannelsForPlugin (*effect->plugin, workingChannels);
 
-        bufferPackage.lastBuffer.clear();
-        addFrom (bufferPackage.lastBuffer, bufferPackage.effectBuffer, channels, numSamples, mixLevel);
+        if (startMixLevel <= 0.0f && endMixLevel <= 0.0f)
+        {
+            // Entirely dry:
+            compensationDelay.process (*current, workingChannels, numSamples);
+            continue;
+        }
+
+        if (startMixLevel >= 1.0f && endMixLevel >= 1.0f)
+        {
+            compensationDelay.pushAndProcess (*current, numPluginChannels, workingChannels, numSamples);
+            processEffect (*effect->plugin, *current, midiMessages, numPluginChannels, numSamples);
+            continue;
+        }
 
-        // Add the original samples, at a percentage of the original gain, if the effect level isn't 100%:
-        if (mixLevel < 1.0f)
-            addFrom (bufferPackage.lastBuffer, bufferPackage.mixingBuffer, channels, numSamples, mixLevel);
+        // Render the effect into the other buffer, and blend the delayed dry signal into it
+        // so that it becomes the input of the next effect:
+        auto& wet = bufferPackage.getOther (*current);
 
-        // Copy the result:
-        bufferPackage.mixingBuffer.clear();
-        addFrom (bufferPackage.mixingBuffer, bufferPackage.lastBuffer, channels, numSamples);
+        for (int i = 0; i < workingChannels; ++i)
+            wet.copyFrom (i, 0, *current, i, 0, numSamples);
+
+        processEffect (*effect->plugin, wet, midiMessages, numPluginChannels, numSamples);
+        compensationDelay.process (*current, workingChannels, numSamples);
+
+        if (approximatelyEqual (startMixLevel, endMixLevel))
+        {
+            for (int i = 0; i < numPluginChannels; ++i)
+                mixDryIntoWet (wet.getWritePointer (i), current->getReadPointer (i),
+                               static_cast<FloatType> (endMixLevel), numSamples);
+        }
+        else
+        {
+            for (int i = 0; i < numPluginChannels; ++i)
+                mixDryIntoWet (wet.getWritePointer (i), current->getReadPointer (i),
+                               static_cast<FloatType> (startMixLevel), static_cast<FloatType> (endMixLevel), numSamples);
+        }
+
+        for (int i = numPluginChannels; i < workingChannels; ++i)
+            wet.copyFrom (i, 0, *current, i, 0, numSamples);
+
+        current = &wet;
     }
 
-    source.clear();
-    addFrom (source, bufferPackage.mixingBuffer, channels, numSamples);
+    if (current != &bufferPackage.sourceAlias)
+        for (int i = 0; i < numChannels; ++i)
+            source.copyFrom (i, 0, *current, i, 0, numSamples);
 }
 
-bool EffectProcessorChain::isWholeChainBypassed() const
+bool EffectProcessorChain::isWholeChainBypassed (const Snapshot& snapshot)
 {
-    size_t numBypassedPlugins = 0;
+    // N.B.: Effects that are still fading down to a dry mix need to finish their ramps,
+    //       and those with any latency still need to delay the signal.
+    for (const auto& effect: snapshot.plugins)
+    {
+        if (effect == nullptr || effect->isMissing())
+            continue;
 
-    for (auto effect: plugins)
-        if (effect == nullptr || ! effect->canBeProcessed())
-            ++numBypassedPlugins;
+        if (! effect->isBypassed.load (std::memory_order_relaxed)
+            || effect->getLatencySamples() > 0
+            || effect->mixLevel.getCurrentValue() > 0.0f)
+            return false;
+    }
 
-    return numBypassedPlugins == plugins.size();
+    return true;
 }
 
 template<typename FloatType>
@@ -422,17 +692,17 @@ void EffectProcessorChain::process (juce::AudioBuffer<FloatType>& buffer, MidiBu
     if (InternalProcessor::isBypassed())
         return;
 
-    const GenericScopedTryLock<CriticalSection> sl (getCallbackLock());
-    const auto numChannels = jmin ((int) 2, buffer.getNumChannels());
+    const ScopedSnapshotReader reader (*this);
+    const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
-    if (sl.isLocked()
-        && ! plugins.empty()
+    if (reader.snapshot != nullptr
+        && ! reader.snapshot->plugins.empty()
         && numChannels > 0
         && numSamples > 0
-        && ! isWholeChainBypassed())
+        && ! isWholeChainBypassed (*reader.snapshot))
     {
-        processInternal (buffer, midiMessages, package, numChannels, numSamples);
+        processInternal (*reader.snapshot, buffer, midiMessages, package, numChannels, numSamples);
     }
 }
 
@@ -442,7 +712,7 @@ void EffectProcessorChain::processBlock (juce::AudioBuffer<double>& buffer, Midi
 //==============================================================================
 double EffectProcessorChain::getTailLengthSeconds() const
 {
-    const ScopedLock sl (getCallbackLock());
+    const ScopedLock sl (mutationLock);
     auto largestTailLength = 0.0;
 
     for (auto effect: plugins)
@@ -461,68 +731,54 @@ void EffectProcessorChain::processorLayoutsChanged() { loopThroughEffectsAndCall
 const String EffectProcessorChain::getName() const { return TRANS ("Effect Processor Chain"); }
 
 //==============================================================================
-namespace ChainIds
-{
-#define CREATE_ATTRIBUTE(name) \
-static const String name = JUCE_STRINGIFY (name);
-
-CREATE_ATTRIBUTE (rootBypassed)
-CREATE_ATTRIBUTE (effectRoot)
-CREATE_ATTRIBUTE (effectName)
-CREATE_ATTRIBUTE (effectBypassed)
-CREATE_ATTRIBUTE (effectMixLevel)
-CREATE_ATTRIBUTE (effectUIX)
-CREATE_ATTRIBUTE (effectUIY)
-CREATE_ATTRIBUTE (effectState)
-
-#undef CREATE_ATTRIBUTE
-}
-
 void EffectProcessorChain::getStateInformation (MemoryBlock& destData)
 {
-    XmlElement effectChainElement (getIdentifier().toString());
-    effectChainElement.setAttribute (ChainIds::rootBypassed, InternalProcessor::isBypassed() ? 1 : 0);
+    // The plugins can take a while to hand over their states, so the lock is only held long enough to copy the chain.
+    const auto effectsToSave = [this]()
+    {
+        const ScopedLock sl (mutationLock);
+        return plugins;
+    }();
 
-    for (auto effect: plugins)
+    std::vector<EffectProcessorChainState::Effect> effects;
+    effects.reserve (effectsToSave.size());
+
+    for (const auto& effect : effectsToSave)
         if (effect != nullptr)
-            effectChainElement.addChildElement (createElementForEffect (effect));
+            effects.emplace_back (createStateForEffect (*effect));
 
-    AudioProcessor::copyXmlToBinary (effectChainElement, destData);
-}
+    destData.reset();
+    MemoryOutputStream stream (destData, false);
 
-XmlElement* EffectProcessorChain::createElementForEffect (EffectProcessor::Ptr effect)
-{
-    if (effect == nullptr)
-    {
+    if (! EffectProcessorChainState::write (stream, InternalProcessor::isBypassed(), effects))
         jassertfalse;
-        return nullptr;
-    }
-
-    auto* effectElement = new XmlElement (ChainIds::effectRoot);
-    effectElement->setAttribute (ChainIds::effectName, effect->name);
-    effectElement->setAttribute (ChainIds::effectBypassed, effect->isBypassed ? 1 : 0);
-    effectElement->setAttribute (ChainIds::effectMixLevel, std::clamp (effect->mixLevel.getTargetValue(), 0.0f, 1.0f));
-    effectElement->setAttribute (ChainIds::effectUIX, effect->lastUIPosition.x);
-    effectElement->setAttribute (ChainIds::effectUIY, effect->lastUIPosition.y);
-    effectElement->addChildElement (effect->description.createXml().release());
+}
 
-    {
-        MemoryBlock m;
-        effect->plugin->getStateInformation (m);
-        effectElement->createNewChildElement (ChainIds::effectState)->addTextElement (Base64::toBase64 (m.getData(), m.getSize()));
-    }
+EffectProcessorChainState::Effect EffectProcessorChain::createStateForEffect (EffectProcessor& effect)
+{
+    EffectProcessorChainState::Effect state;
+    state.name = effect.name;
+    state.isBypassed = effect.isBypassed.load();
+    state.mixLevel = std::clamp (effect.targetMixLevel.load(), 0.0f, 1.0f);
+    state.lastUIPosition = effect.lastUIPosition;
+    state.description = effect.description;
+
+    // A missing plugin's last known state is kept as-is, so it doesn't get lost on the next save.
+    if (effect.isMissing())
+        state.state = effect.lastKnownState;
+    else
+        effect.plugin->getStateInformation (state.state);
 
-    return effectElement;
+    return state;
 }
 
 //==============================================================================
 void EffectProcessorChain::setStateInformation (const void* const data, const int sizeInBytes)
 {
+    cancelAsyncRestore();
     clear();
     InternalProcessor::setBypass (false);// To reset back to a normal state
 
-    const ScopedBypass sb (*this);
-
     if (! MessageManager::getInstance()->isThisTheMessageThread())
     {
         /** All supported 3rd-party plugin formats (eg: VST2, VST3, AU),
@@ -533,62 +789,393 @@ void EffectProcessorChain::setStateInformation (const void* const data, const in
         return;
     }
 
-    auto chainElement = AudioProcessor::getXmlFromBinary (data, sizeInBytes);
+    std::vector<EffectProcessorChainState::Effect> effects;
+    auto shouldBeBypassed = false;
 
-    if (chainElement != nullptr && chainElement->getTagName() == getIdentifier().toString())
+    if (! decodeState (data, sizeInBytes, effects, shouldBeBypassed))
     {
-        InternalProcessor::setBypass (chainElement->getBoolAttribute (ChainIds::rootBypassed));
+        jassertfalse;
+        return;
+    }
 
-        for (auto* e: chainElement->getChildWithTagNameIterator (ChainIds::effectRoot))
-            plugins.emplace_back (createEffectProcessorFromXML (e));
+    {
+        const ScopedBypass sb (*this);
 
-        updateLatency();
+        // N.B.: Each restored effect is appended to the chain as it gets created.
+        for (auto& effect : effects)
+            if (createEffectProcessor (effect, -1, InsertionStyle::append) == nullptr)
+                jassertfalse;
     }
-    else
+
+    // N.B.: This has to wait for the ScopedBypass to be gone, or it would get undone.
+    InternalProcessor::setBypass (shouldBeBypassed);
+}
+
+bool EffectProcessorChain::decodeState (const void* const data, const int sizeInBytes,
+                                        std::vector<EffectProcessorChainState::Effect>& effects,
+                                        bool& isChainBypassed) const
+{
+    effects.clear();
+    isChainBypassed = false;
+
+    if (EffectProcessorChainState::isBinaryState (data, (size_t) jmax (0, sizeInBytes)))
+        return decodeBinaryState (data, sizeInBytes, effects, isChainBypassed);
+
+    return decodeXMLState (data, sizeInBytes, effects, isChainBypassed);
+}
+
+bool EffectProcessorChain::decodeBinaryState (const void* const data, const int sizeInBytes,
+                                              std::vector<EffectProcessorChainState::Effect>& effects,
+                                              bool& isChainBypassed)
+{
+    MemoryInputStream stream (data, (size_t) sizeInBytes, false);
+    EffectProcessorChainState::Reader reader (stream);
+
+    if (! reader.isValid())
+        return false;
+
+    effects.reserve ((size_t) reader.getNumEffects());
+
+    for (int i = 0; i < reader.getNumEffects(); ++i)
     {
-        jassertfalse;
+        if (auto effect = reader.readEffect (i))
+            effects.emplace_back (std::move (*effect));
+        else
+            jassertfalse;
     }
+
+    isChainBypassed = reader.isChainBypassed();
+    return true;
+}
+
+EffectProcessor::Ptr EffectProcessorChain::restoreEffect (const void* data, int sizeInBytes, int effectIndex, int destinationIndex)
+{
+    if (! EffectProcessorChainState::isBinaryState (data, (size_t) jmax (0, sizeInBytes)))
+        return {};
+
+    MemoryInputStream stream (data, (size_t) sizeInBytes, false);
+    EffectProcessorChainState::Reader reader (stream);
+
+    if (auto effect = reader.readEffect (effectIndex))
+        return createEffectProcessor (*effect, destinationIndex, InsertionStyle::replace);
+
+    return {};
+}
+
+void EffectProcessorChain::applyState (EffectProcessor& newEffect, EffectProcessorChainState::Effect& state)
+{
+    newEffect.plugin->getStateInformation (newEffect.defaultState);
+
+    newEffect.lastKnownState.swapWith (state.state);
+    newEffect.reloadFromStateIfValid();
+
+    newEffect.name = state.name.trim();
+    newEffect.targetMixLevel = state.mixLevel;
+    newEffect.mixLevel.setCurrentAndTargetValue (state.mixLevel);
+    newEffect.isBypassed = state.isBypassed;
+    newEffect.lastUIPosition = state.lastUIPosition;
+}
+
+EffectProcessor::Ptr EffectProcessorChain::createEffectProcessor (EffectProcessorChainState::Effect& state,
+                                                                  int destinationIndex, InsertionStyle insertionStyle)
+{
+    return insertInternal (state.description, destinationIndex, insertionStyle,
+                           [&] (EffectProcessor& newEffect) { applyState (newEffect, state); });
 }
 
-EffectProcessor::Ptr EffectProcessorChain::createEffectProcessorFromXML (XmlElement* const effectXML)
+//==============================================================================
+/** Creates the effects of a restored chain in the background, and hands them over to the chain once they're all ready.
+
+    The effects that can be created on any thread each get a job on the thread pool,
+    whereas the rest get created on the message thread, one per message so as to keep it responsive.
+    All of the bookkeeping happens on the message thread, which is also where the restorer gets cancelled,
+    so the chain pointer is only ever touched there.
+
+    The jobs and messages keep the restorer alive, so it outlives the chain when cancelled mid-way.
+*/
+class EffectProcessorChain::AsyncRestorer final : public std::enable_shared_from_this<AsyncRestorer>
+{
+public:
+    AsyncRestorer (EffectProcessorChain& c,
+                   std::vector<EffectProcessorChainState::Effect> states,
+                   bool shouldBypassChain,
+                   RestoreProgressCallback progress,
+                   RestoreCompletionCallback completion) :
+        chain (&c),
+        factory (c.factory),
+        sampleRate (c.getSampleRate()),
+        blockSize (c.getBlockSize()),
+        numChannels (c.getMainChannelCount()),
+        playHead (c.getPlayHead()),
+        isChainBypassed (shouldBypassChain),
+        progressCallback (std::move (progress)),
+        completionCallback (std::move (completion))
+    {
+        slots.resize (states.size());
+
+        for (size_t i = 0; i < states.size(); ++i)
+            slots[i].state = std::move (states[i]);
+    }
+
+    void start (ThreadPool* threadPool)
+    {
+        JUCE_ASSERT_MESSAGE_THREAD;
+
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (threadPool != nullptr && factory->canCreatePluginOnAnyThread (slots[i].state.description))
+            {
+                threadPool->addJob ([self = shared_from_this(), i]()
+                {
+                    self->createSlot (i);
+                    MessageManager::callAsync ([self]() { self->slotFinished(); });
+                });
+            }
+            else
+            {
+                messageThreadSlots.push_back (i);
+            }
+        }
+
+        // Also takes care of empty chains, which finish straight away:
+        MessageManager::callAsync ([self = shared_from_this()]() { self->createNextOnMessageThread(); });
+    }
+
+    void cancel()
+    {
+        JUCE_ASSERT_MESSAGE_THREAD;
+
+        cancelled = true;
+        chain = nullptr;
+    }
+
+private:
+    struct Slot final
+    {
+        EffectProcessorChainState::Effect state;
+        EffectProcessor::Ptr effect;
+    };
+
+    EffectProcessorChain* chain = nullptr;
+    const std::shared_ptr<EffectProcessorFactory> factory;
+    const double sampleRate;
+    const int blockSize, numChannels;
+    AudioPlayHead* const playHead;
+    const bool isChainBypassed;
+    const RestoreProgressCallback progressCallback;
+    const RestoreCompletionCallback completionCallback;
+
+    std::vector<Slot> slots;                // Each slot is only touched by whoever is creating its effect, until it's finished.
+    std::vector<size_t> messageThreadSlots;
+    size_t nextMessageThreadSlot = 0;
+    int numFinished = 0;
+    std::atomic<bool> cancelled { false };
+
+    void createSlot (size_t index)
+    {
+        if (cancelled.load())
+            return;
+
+        auto& slot = slots[index];
+        slot.effect = createEffect (*factory, slot.state.description, sampleRate, blockSize, numChannels, playHead,
+                                    [&] (EffectProcessor& newEffect) { applyState (newEffect, slot.state); });
+    }
+
+    void createNextOnMessageThread()
+    {
+        if (cancelled.load())
+            return;
+
+        if (nextMessageThreadSlot < messageThreadSlots.size())
+        {
+            createSlot (messageThreadSlots[nextMessageThreadSlot++]);
+            slotFinished();
+
+            if (nextMessageThreadSlot < messageThreadSlots.size())
+                MessageManager::callAsync ([self = shared_from_this()]() { self->createNextOnMessageThread(); });
+        }
+        else if (slots.empty())
+        {
+            finish();
+        }
+    }
+
+    void slotFinished()
+    {
+        if (cancelled.load())
+            return;
+
+        const auto numEffects = (int) slots.size();
+        ++numFinished;
+
+        if (progressCallback != nullptr)
+            progressCallback (numFinished, numEffects);
+
+        // The progress callback might have cancelled everything...
+        if (! cancelled.load() && numFinished == numEffects)
+            finish();
+    }
+
+    void finish()
+    {
+        jassert (chain != nullptr);
+
+        ContainerType effects;
+        effects.reserve (slots.size());
+        auto allRestored = true;
+
+        for (auto& slot : slots)
+        {
+            if (slot.effect != nullptr)
+                effects.emplace_back (std::move (slot.effect));
+            else
+                allRestored = false;
+        }
+
+        // Keeps this alive for the callback, given the chain lets go of it here:
+        const auto self = shared_from_this();
+        auto* const c = chain;
+        chain = nullptr;
+
+        c->asyncRestorer.reset();
+        c->swapInRestoredEffects (std::move (effects), isChainBypassed, sampleRate, blockSize, numChannels);
+
+        if (completionCallback != nullptr)
+            completionCallback (allRestored);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AsyncRestorer)
+};
+
+bool EffectProcessorChain::setStateInformationAsync (const void* data, int sizeInBytes, ThreadPool* threadPool,
+                                                     RestoreProgressCallback progressCallback,
+                                                     RestoreCompletionCallback completionCallback)
 {
-    if (effectXML == nullptr)
+    JUCE_ASSERT_MESSAGE_THREAD;
+
+    std::vector<EffectProcessorChainState::Effect> effects;
+    auto shouldBeBypassed = false;
+
+    if (factory == nullptr)
     {
         jassertfalse;
-        return {};
+        return false;
     }
 
-    auto* pdState = effectXML->getChildByName ("PLUGIN");
+    if (! decodeState (data, sizeInBytes, effects, shouldBeBypassed))
+        return false;
+
+    cancelAsyncRestore();
+
+    asyncRestorer = std::make_shared<AsyncRestorer> (*this, std::move (effects), shouldBeBypassed,
+                                                     std::move (progressCallback), std::move (completionCallback));
+    asyncRestorer->start (threadPool);
+    return true;
+}
+
+void EffectProcessorChain::cancelAsyncRestore()
+{
+    if (auto restorer = std::exchange (asyncRestorer, nullptr))
+        restorer->cancel();
+}
+
+void EffectProcessorChain::swapInRestoredEffects (ContainerType effects, bool isChainBypassed,
+                                                  double restoredSampleRate, int restoredBlockSize, int restoredNumChannels)
+{
+    // The chain may have been prepared differently while the effects were being created:
+    if (! approximatelyEqual (restoredSampleRate, getSampleRate())
+        || restoredBlockSize != getBlockSize()
+        || restoredNumChannels != getMainChannelCount())
+    {
+        for (auto& effect : effects)
+        {
+            preparePlugin (*effect->plugin, getSampleRate(), getBlockSize(), getMainChannelCount(), getPlayHead());
+            effect->prepareLatencyCompensation (getMainChannelCount());
+            resetMixLevel (*effect, getSampleRate());
+        }
+    }
+
+    {
+        const ScopedLock sl (mutationLock);
+
+        plugins = std::move (effects);
+        updateLatency();
+        publishSnapshot();
+    }
+
+    InternalProcessor::setBypass (isChainBypassed);
+    updateHostDisplay();
+}
+
+//==============================================================================
+namespace ChainIds
+{
+#define CREATE_ATTRIBUTE(name) \
+static const String name = JUCE_STRINGIFY (name);
+
+CREATE_ATTRIBUTE (rootBypassed)
+CREATE_ATTRIBUTE (effectRoot)
+CREATE_ATTRIBUTE (effectName)
+CREATE_ATTRIBUTE (effectBypassed)
+CREATE_ATTRIBUTE (effectMixLevel)
+CREATE_ATTRIBUTE (effectUIX)
+CREATE_ATTRIBUTE (effectUIY)
+CREATE_ATTRIBUTE (effectState)
+
+#undef CREATE_ATTRIBUTE
+}
+
+/** Chains used to be saved as XML, with Base64 encoded plugin states, so that's still supported for older sessions. */
+bool EffectProcessorChain::decodeXMLState (const void* const data, const int sizeInBytes,
+                                           std::vector<EffectProcessorChainState::Effect>& effects,
+                                           bool& isChainBypassed) const
+{
+    auto chainElement = AudioProcessor::getXmlFromBinary (data, sizeInBytes);
+
+    if (chainElement == nullptr || chainElement->getTagName() != getIdentifier().toString())
+        return false;
+
+    for (auto* e: chainElement->getChildWithTagNameIterator (ChainIds::effectRoot))
+    {
+        if (auto effect = createStateFromXML (*e))
+            effects.emplace_back (std::move (*effect));
+        else
+            jassertfalse;
+    }
+
+    isChainBypassed = chainElement->getBoolAttribute (ChainIds::rootBypassed);
+    return true;
+}
+
+std::optional<EffectProcessorChainState::Effect> EffectProcessorChain::createStateFromXML (const XmlElement& effectXML)
+{
+    auto* pdState = effectXML.getChildByName ("PLUGIN");
     if (pdState == nullptr)
     {
         jassertfalse;
         return {};
     }
 
-    PluginDescription description;
-    if (! description.loadFromXml (*pdState))
+    EffectProcessorChainState::Effect effect;
+
+    if (! effect.description.loadFromXml (*pdState))
     {
         jassertfalse;
         return {};
     }
 
-    if (auto newEffect = insertInternal (description, -1, InsertionStyle::append))
+    if (const auto* const state = effectXML.getChildByName (ChainIds::effectState))
     {
-        newEffect->plugin->getStateInformation (newEffect->defaultState);
+        MemoryOutputStream stream (effect.state, false);
 
-        if (const auto* const state = effectXML->getChildByName (ChainIds::effectState))
-        {
-            newEffect->lastKnownBase64State = state->getAllSubText();
-            newEffect->reloadFromStateIfValid();
-        }
-
-        newEffect->name = effectXML->getStringAttribute (ChainIds::effectName, String()).trim();
-        newEffect->mixLevel = (float) std::clamp (effectXML->getDoubleAttribute (ChainIds::effectMixLevel, 1.0), 0.0, 1.0);
-        newEffect->isBypassed = effectXML->getBoolAttribute (ChainIds::effectBypassed);
-        newEffect->lastUIPosition.x = effectXML->getIntAttribute (ChainIds::effectUIX);
-        newEffect->lastUIPosition.y = effectXML->getIntAttribute (ChainIds::effectUIY);
-        return newEffect;
+        if (! Base64::convertFromBase64 (stream, state->getAllSubText()))
+            stream.reset();
     }
 
-    return {};
+    effect.name = effectXML.getStringAttribute (ChainIds::effectName, String());
+    effect.mixLevel = (float) std::clamp (effectXML.getDoubleAttribute (ChainIds::effectMixLevel, 1.0), 0.0, 1.0);
+    effect.isBypassed = effectXML.getBoolAttribute (ChainIds::effectBypassed);
+    effect.lastUIPosition.x = effectXML.getIntAttribute (ChainIds::effectUIX);
+    effect.lastUIPosition.y = effectXML.getIntAttribute (ChainIds::effectUIY);
+    return effect;
 }
@@ -1,5 +1,11 @@
 /** Contains an array of effect plugins that connect to each other in series.
 
+    Any of the mutators and getters here are safe to call from any non-audio thread
+    and will never contend with the audio thread: every change publishes a new,
+    immutable snapshot of the chain which the audio thread picks up atomically
+    at the start of the next block. Snapshots the audio thread is finished with
+    are reclaimed by whichever thread next changes the chain.
+
     @see EffectProcessor, EffectProcessorFactory
 */
 class EffectProcessorChain final : public InternalProcessor
@@ -19,6 +25,9 @@ public:
     */
     EffectProcessorChain (std::shared_ptr<EffectProcessorFactory> factory);
 
+    /** Destructor. */
+    ~EffectProcessorChain() override;
+
     //==============================================================================
     /** @returns the current number of effect processors in this chain. */
     [[nodiscard]] int getNumEffects() const;
@@ -158,7 +167,7 @@ public:
     /** Change the mix level of a contained effect.
 
         @param index    Index within the array of plugins.
-        @param mixLevel Normalised range; from 0.0f to 1.0f.
+        @param mixLevel Normalised range; from 0.0f to 1.0f. Anything outside of that gets clamped.
 
         @returns true if anything changed.
     */
@@ -186,9 +195,9 @@ public:
 
     /** Obtain the plugin instance of a contained effect.
 
-        This isn't very safe to use, unless you lock using the processor's callback lock
-        around the pointer instance to get anything out of it or change its properties.
-        But doing that should generate really ugly noise because it will block the audio thread!
+        This isn't very safe to use because the audio thread may be processing the
+        plugin at the same time. Locking the plugin's callback lock around anything
+        you do with it will keep you safe, at the cost of blocking that plugin's processing.
 
         @param index Index of the desired plugin.
 
@@ -236,6 +245,77 @@ public:
     */
     bool loadIfMissing (int index);
 
+    //==============================================================================
+    /** Restores a single effect from a chain state, as made by getStateInformation(),
+        without decoding any of the other effects in it.
+
+        @param data             The chain state.
+        @param sizeInBytes      The size of the chain state.
+        @param effectIndex      The index of the effect within the saved chain.
+        @param destinationIndex The index of the effect to replace in this chain.
+                                If this is out of range, the restored effect gets appended.
+
+        @returns the restored effect, or nullptr if the state or the effect index wasn't valid.
+                 This will also fail for chain states saved in the older, XML based, format.
+    */
+    EffectProcessor::Ptr restoreEffect (const void* data, int sizeInBytes, int effectIndex, int destinationIndex);
+
+    //==============================================================================
+    /** Called on the message thread as each effect of an asynchronous restore gets created.
+
+        @param numRestored  The number of effects that are ready so far.
+        @param numEffects   The total number of effects being restored.
+    */
+    using RestoreProgressCallback = std::function<void (int numRestored, int numEffects)>;
+
+    /** Called on the message thread once an asynchronous restore has been swapped in.
+
+        @param allRestored  False if any of the effects failed to be created, in which case they were left out.
+    */
+    using RestoreCompletionCallback = std::function<void (bool allRestored)>;
+
+    /** Restores a chain state, as made by getStateInformation(), without blocking the message thread.
+
+        The effects using internal plugins (ie: from the InternalAudioPluginFormat) get created, prepared
+        and have their states restored concurrently on the provided thread pool. The effects of every
+        other plugin format get created on the message thread, one per message, because that's
+        what those formats require.
+
+        The current effects carry on being processed in the meantime, and are replaced by the
+        restored ones in one go once they're all ready, so the chain never plays half-restored.
+
+        Starting another restore, or calling setStateInformation(), cancels any restore in progress.
+
+        @param data             The chain state. This gets decoded before returning, so it needn't stay around.
+        @param sizeInBytes      The size of the chain state.
+        @param threadPool       The pool to create the internal plugins on, which must outlive the restore.
+                                If this is null, every effect gets created on the message thread.
+        @param progressCallback Optional; called on the message thread as each effect is ready.
+        @param completionCallback Optional; called on the message thread once the restored effects are in place.
+
+        @returns false if the state couldn't be decoded, in which case nothing is changed
+                 and neither of the callbacks will be called.
+
+        @warning This must be called from the message thread.
+
+        @see cancelAsyncRestore, isRestoring
+    */
+    bool setStateInformationAsync (const void* data, int sizeInBytes, ThreadPool* threadPool,
+                                   RestoreProgressCallback progressCallback = nullptr,
+                                   RestoreCompletionCallback completionCallback = nullptr);
+
+    /** Cancels any asynchronous restore in progress, leaving the chain as it is.
+
+        Neither of the restore's callbacks will be called after this.
+        Any effects that are still being created on the thread pool get thrown away once they're done.
+
+        @warning This must be called from the message thread.
+    */
+    void cancelAsyncRestore();
+
+    /** @returns true if an asynchronous restore is in progress. */
+    [[nodiscard]] bool isRestoring() const noexcept { return asyncRestorer != nullptr; }
+
     //==============================================================================
     /** @internal */
     void reset() override;
@@ -271,40 +351,91 @@ public:
     void setStateInformation (const void*, int) override;
 private:
     //==============================================================================
+    /** The buffers used to render the chain.
+
+        When the incoming buffer provides every channel the chain needs, the effects
+        are run on the sourceAlias, which simply refers to the incoming buffer's channels.
+        Otherwise the incoming audio is copied into the dryBuffer first.
+
+        The dryBuffer and wetBuffer get ping-ponged between whenever an effect
+        needs blending with its dry signal, so nothing ever gets copied back.
+    */
     template<typename FloatType>
     struct BufferPackage final
     {
         using Buffer = juce::AudioBuffer<FloatType>;
 
-        void clear() noexcept
+        /** @returns whichever buffer, of the dry and wet buffers, isn't the provided one. */
+        Buffer& getOther (const Buffer& buffer) noexcept
         {
-            for (auto& buff: buffers)
-                buff->clear();
+            return &buffer == &wetBuffer ? dryBuffer : wetBuffer;
         }
 
         void prepare (int numChannels, int numSamples)
         {
-            for (auto& buff: buffers)
+            for (auto* buff : { &dryBuffer, &wetBuffer })
                 buff->setSize (numChannels, numSamples, false, true, true);
-
-            clear();
         }
 
-        Buffer mixingBuffer, effectBuffer, lastBuffer;
-        std::array<Buffer*, 3> buffers = { &mixingBuffer, &effectBuffer, &lastBuffer };
+        Buffer sourceAlias, dryBuffer, wetBuffer;
     };
 
+    //==============================================================================
+    using ContainerType = std::vector<EffectProcessor::Ptr>;
+
+    /** An immutable copy of the chain, as handed over to the audio thread. */
+    struct Snapshot final
+    {
+        ContainerType plugins;
+        int requiredChannels = 0;
+        uint64 generation = 0;
+    };
+
+    /** Used by the audio thread to claim the latest snapshot for the duration of a block.
+
+        The audio thread first advertises the newest generation it may be about to use,
+        and only then loads the snapshot pointer. Writers can therefore safely reclaim
+        any snapshot older than the advertised generation, or any snapshot except the
+        published one when the audio thread is idle.
+    */
+    class ScopedSnapshotReader final
+    {
+    public:
+        ScopedSnapshotReader (EffectProcessorChain&) noexcept;
+        ~ScopedSnapshotReader() noexcept;
+
+        const Snapshot* snapshot = nullptr;
+
+    private:
+        EffectProcessorChain& chain;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedSnapshotReader)
+    };
+
+    static constexpr auto idleGeneration = std::numeric_limits<uint64>::max();
+
+    /** The time it takes for an effect's mix level to reach a newly requested value. */
+    static constexpr auto mixRampLengthSeconds = 0.05;
+
     //==============================================================================
     std::shared_ptr<EffectProcessorFactory> factory;
 
-    using ContainerType = std::vector<EffectProcessor::Ptr>;
-    ContainerType plugins;
+    CriticalSection mutationLock;                           // Never taken by the audio thread.
+    ContainerType plugins;                                  // The writers' copy of the chain, guarded by the mutationLock.
+    std::vector<std::unique_ptr<Snapshot>> liveSnapshots;   // Guarded by the mutationLock.
+    ContainerType retiredEffects;                           // Removed, and waiting for their plugins to be recycled. Guarded by the mutationLock.
+    uint64 lastGeneration = 0;                              // Guarded by the mutationLock.
 
-    std::atomic<int> requiredChannels { 0 };
+    std::atomic<Snapshot*> publishedSnapshot { nullptr };
+    std::atomic<uint64> publishedGeneration { 0 },
+                        audioThreadGeneration { idleGeneration };
 
     BufferPackage<float> floatBuffers;
     BufferPackage<double> doubleBuffers;
 
+    class AsyncRestorer;
+    std::shared_ptr<AsyncRestorer> asyncRestorer;           // Only ever touched by the message thread.
+
     //==============================================================================
     enum class InsertionStyle
     {
@@ -313,26 +444,63 @@ private:
         replace
     };
 
-    [[nodiscard]] bool isWholeChainBypassed() const;
+    [[nodiscard]] static bool isWholeChainBypassed (const Snapshot&);
+    void publishSnapshot();
+    void reclaimSnapshots();
+    void recycleRetiredEffects();
     void updateLatency();
-    void updateChannelCount();
-    [[nodiscard]] XmlElement* createElementForEffect (EffectProcessor::Ptr effect);
-    [[nodiscard]] EffectProcessor::Ptr createEffectProcessorFromXML (XmlElement* state);
+    [[nodiscard]] int getMainChannelCount() const;
+    [[nodiscard]] int getRequiredChannelCount() const;
+    [[nodiscard]] static EffectProcessorChainState::Effect createStateForEffect (EffectProcessor&);
+    [[nodiscard]] static std::optional<EffectProcessorChainState::Effect> createStateFromXML (const XmlElement&);
+    [[nodiscard]] bool decodeState (const void* data, int sizeInBytes, std::vector<EffectProcessorChainState::Effect>&, bool& isChainBypassed) const;
+    [[nodiscard]] static bool decodeBinaryState (const void* data, int sizeInBytes, std::vector<EffectProcessorChainState::Effect>&, bool& isChainBypassed);
+    [[nodiscard]] bool decodeXMLState (const void* data, int sizeInBytes, std::vector<EffectProcessorChainState::Effect>&, bool& isChainBypassed) const;
+    void swapInRestoredEffects (ContainerType, bool isChainBypassed, double restoredSampleRate, int restoredBlockSize, int restoredNumChannels);
     [[nodiscard]] bool setEffectProperty (int index, std::function<void (EffectProcessor::Ptr)> func);
 
     template<typename FloatType>
     void process (juce::AudioBuffer<FloatType>&, MidiBuffer&, BufferPackage<FloatType>&);
 
     template<typename FloatType>
-    void processInternal (juce::AudioBuffer<FloatType>& source, MidiBuffer& midiMessages, BufferPackage<FloatType>& bufferPackage, int numChannels, int numSamples);
+    static void processEffect (AudioPluginInstance&, juce::AudioBuffer<FloatType>&, MidiBuffer&, int numPluginChannels, int numSamples);
+    [[nodiscard]] static int getNumChannelsForPlugin (const AudioPluginInstance&, int numChannels) noexcept;
+
+    template<typename FloatType>
+    void processInternal (const Snapshot&, juce::AudioBuffer<FloatType>& source, MidiBuffer& midiMessages, BufferPackage<FloatType>& bufferPackage, int numChannels, int numSamples);
+
+    /** Called on a newly created effect, before the effect gets published to the audio thread. */
+    using EffectInitialiser = std::function<void (EffectProcessor&)>;
+
+    static void applyState (EffectProcessor&, EffectProcessorChainState::Effect&);
+    [[nodiscard]] EffectProcessor::Ptr createEffectProcessor (EffectProcessorChainState::Effect&, int destinationIndex, InsertionStyle);
+
+    /** @see EffectProcessorFactory::preparePlugin */
+    static void preparePlugin (AudioPluginInstance&, double sampleRate, int blockSize, int numChannels, AudioPlayHead*);
 
+    /** Restarts an effect's mix ramp at the sample rate, or makes the mix level jump straight
+        to its target when the chain hasn't been prepared yet, leaving prepareToPlay() to set up the ramp.
+    */
+    static void resetMixLevel (EffectProcessor&, double sampleRate);
+
+    /** Creates and prepares an effect, without touching the chain, so this can be called from any thread the plugin allows.
+
+        The factory's pooled plugins are used when they're ready, sparing the effect from being constructed and prepared.
+    */
     template<typename Type>
-    [[nodiscard]] EffectProcessor::Ptr insertInternal (const Type& valueOrRef, int destinationIndex, InsertionStyle insertionStyle = InsertionStyle::insert);
+    [[nodiscard]] static EffectProcessor::Ptr createEffect (EffectProcessorFactory&, const Type& valueOrRef,
+                                                            double sampleRate, int blockSize, int numChannels,
+                                                            AudioPlayHead*, const EffectInitialiser& initialiser);
+
+    template<typename Type>
+    [[nodiscard]] EffectProcessor::Ptr insertInternal (const Type& valueOrRef, int destinationIndex,
+                                                       InsertionStyle insertionStyle = InsertionStyle::insert,
+                                                       EffectInitialiser initialiser = nullptr);
 
     template<typename Type>
     std::optional<Type> getEffectProperty (int index, std::function<Type (EffectProcessor::Ptr)> func) const
     {
-        const ScopedLock sl (getCallbackLock());
+        const ScopedLock sl (mutationLock);
 
         if (isPositiveAndBelow (index, getNumEffects()))
             if (auto effect = plugins[(size_t) index])
@@ -344,6 +512,8 @@ private:
     template<void (AudioProcessor::*function)()>
     void loopThroughEffectsAndCall()
     {
+        const ScopedLock sl (mutationLock);
+
         for (auto effect: plugins)
             if (effect != nullptr)
                 if (auto* plugin = effect->plugin.get())
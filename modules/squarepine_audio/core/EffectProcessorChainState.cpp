@@ -0,0 +1,205 @@
+namespace ChainStateHelpers
+{
+    constexpr auto magic = ByteOrder::makeInt ('S', 'P', 'F', 'X');
+
+    enum
+    {
+        headerSize          = 16,   // Magic, version, flags, number of effects.
+        indexEntrySize      = 16,   // Offset and size.
+        fixedChunkSize      = 32,   // Flags, mix level, UI position, name size, description size, state size.
+        bypassedFlag        = 1
+    };
+
+    inline String createDescriptionString (const PluginDescription& description)
+    {
+        if (auto xml = description.createXml())
+            return xml->toString (XmlElement::TextFormat().singleLine().withoutHeader());
+
+        return {};
+    }
+
+    inline bool writeBlock (OutputStream& destination, const void* data, size_t numBytes)
+    {
+        return numBytes == 0 || destination.write (data, numBytes);
+    }
+
+    inline bool writeString (OutputStream& destination, const String& text)
+    {
+        const auto numBytes = text.getNumBytesAsUTF8();
+
+        return destination.writeInt ((int) numBytes)
+            && writeBlock (destination, text.toRawUTF8(), numBytes);
+    }
+
+    inline bool readString (InputStream& source, int64& numBytesRemaining, String& result)
+    {
+        if (numBytesRemaining < 4)
+            return false;
+
+        const auto numBytes = (int64) source.readInt();
+        numBytesRemaining -= 4;
+
+        if (numBytes < 0 || numBytes > numBytesRemaining)
+            return false;
+
+        numBytesRemaining -= numBytes;
+
+        if (numBytes == 0)
+        {
+            result = {};
+            return true;
+        }
+
+        HeapBlock<char> buffer ((size_t) numBytes);
+        if (source.read (buffer.get(), (int) numBytes) != (int) numBytes)
+            return false;
+
+        result = String::fromUTF8 (buffer.get(), (int) numBytes);
+        return true;
+    }
+}
+
+//==============================================================================
+bool EffectProcessorChainState::isBinaryState (const void* data, size_t sizeInBytes) noexcept
+{
+    return data != nullptr
+        && sizeInBytes >= (size_t) ChainStateHelpers::headerSize
+        && ByteOrder::littleEndianInt (data) == ChainStateHelpers::magic;
+}
+
+bool EffectProcessorChainState::write (OutputStream& destination, bool isChainBypassed, const std::vector<Effect>& effects)
+{
+    using namespace ChainStateHelpers;
+
+    const auto numEffects = effects.size();
+
+    StringArray descriptions;
+    descriptions.ensureStorageAllocated ((int) numEffects);
+
+    for (const auto& effect : effects)
+        descriptions.add (createDescriptionString (effect.description));
+
+    auto ok = destination.writeInt ((int) magic)
+           && destination.writeInt (currentVersion)
+           && destination.writeInt (isChainBypassed ? bypassedFlag : 0)
+           && destination.writeInt ((int) numEffects);
+
+    auto offset = (int64) headerSize + (int64) indexEntrySize * (int64) numEffects;
+
+    for (size_t i = 0; i < numEffects && ok; ++i)
+    {
+        const auto& effect = effects[i];
+        const auto size = (int64) fixedChunkSize
+                        + (int64) effect.name.getNumBytesAsUTF8()
+                        + (int64) descriptions[(int) i].getNumBytesAsUTF8()
+                        + (int64) effect.state.getSize();
+
+        ok = destination.writeInt64 (offset)
+          && destination.writeInt64 (size);
+
+        offset += size;
+    }
+
+    for (size_t i = 0; i < numEffects && ok; ++i)
+    {
+        const auto& effect = effects[i];
+
+        ok = destination.writeInt (effect.isBypassed ? bypassedFlag : 0)
+          && destination.writeFloat (jlimit (0.0f, 1.0f, effect.mixLevel))
+          && destination.writeInt (effect.lastUIPosition.x)
+          && destination.writeInt (effect.lastUIPosition.y)
+          && writeString (destination, effect.name)
+          && writeString (destination, descriptions[(int) i])
+          && destination.writeInt64 ((int64) effect.state.getSize())
+          && writeBlock (destination, effect.state.getData(), effect.state.getSize());
+    }
+
+    return ok;
+}
+
+//==============================================================================
+EffectProcessorChainState::Reader::Reader (InputStream& s) :
+    source (s),
+    startPosition (s.getPosition())
+{
+    using namespace ChainStateHelpers;
+
+    const auto numBytesAvailable = source.getTotalLength() - startPosition;
+
+    if (numBytesAvailable < headerSize || (uint32) source.readInt() != magic)
+        return;
+
+    version = source.readInt();
+    chainBypassed = (source.readInt() & bypassedFlag) != 0;
+    const auto numEffects = (int64) source.readInt();
+
+    // Newer versions of the format may only add to the end of the chunks.
+    if (version < 1
+        || numEffects < 0
+        || (int64) headerSize + numEffects * (int64) indexEntrySize > numBytesAvailable)
+        return;
+
+    index.resize ((size_t) numEffects);
+
+    for (auto& entry : index)
+    {
+        entry.offset = source.readInt64();
+        entry.size = source.readInt64();
+
+        if (entry.offset < (int64) headerSize
+            || entry.size < (int64) fixedChunkSize
+            || entry.offset > numBytesAvailable - entry.size)
+        {
+            index.clear();
+            return;
+        }
+    }
+
+    valid = true;
+}
+
+std::optional<EffectProcessorChainState::Effect> EffectProcessorChainState::Reader::readEffect (int effectIndex)
+{
+    using namespace ChainStateHelpers;
+
+    if (! valid || ! isPositiveAndBelow (effectIndex, getNumEffects()))
+        return {};
+
+    const auto& entry = index[(size_t) effectIndex];
+
+    if (! source.setPosition (startPosition + entry.offset))
+        return {};
+
+    Effect effect;
+    effect.isBypassed = (source.readInt() & bypassedFlag) != 0;
+    effect.mixLevel = jlimit (0.0f, 1.0f, source.readFloat());
+    effect.lastUIPosition.x = source.readInt();
+    effect.lastUIPosition.y = source.readInt();
+
+    auto numBytesRemaining = entry.size - 16;
+
+    String descriptionText;
+    if (! readString (source, numBytesRemaining, effect.name)
+        || ! readString (source, numBytesRemaining, descriptionText)
+        || numBytesRemaining < 8)
+        return {};
+
+    const auto stateSize = source.readInt64();
+    numBytesRemaining -= 8;
+
+    if (stateSize < 0
+        || stateSize > numBytesRemaining
+        || stateSize > (int64) std::numeric_limits<int>::max())
+        return {};
+
+    effect.state.setSize ((size_t) stateSize);
+
+    if (stateSize > 0 && source.read (effect.state.getData(), (int) stateSize) != (int) stateSize)
+        return {};
+
+    const auto xml = parseXML (descriptionText);
+    if (xml == nullptr || ! effect.description.loadFromXml (*xml))
+        return {};
+
+    return effect;
+}
@@ -0,0 +1,104 @@
+/** A compact, chunked, binary format for the state of an EffectProcessorChain.
+
+    The plugin states are stored as raw blobs, so nothing needs Base64 encoding
+    nor XML parsing, and there's an index up front so that any single effect
+    can be decoded without touching the others.
+
+    The layout is as follows, where all numbers are little-endian:
+    - The header: the magic number ("SPFX"), the format version, the chain's flags,
+      and the number of effects.
+    - The index: the offset, from the start of the data, and the size of each effect's chunk.
+    - The chunks: each effect's flags, mix level, UI position, name,
+      plugin description (as a single line of XML), and plugin state.
+
+    The chunk sizes in the index let newer versions of the format tack extra
+    fields onto the end of a chunk without breaking older readers.
+
+    @see EffectProcessorChain
+*/
+class EffectProcessorChainState final
+{
+public:
+    //==============================================================================
+    /** The current version of the format, as written by write(). */
+    static constexpr int currentVersion = 1;
+
+    /** Everything stored about a single effect. */
+    struct Effect final
+    {
+        String name;                            //<
+        bool isBypassed = false;                //<
+        float mixLevel = 1.0f;                  //< Normalised, from 0.0f to 1.0f.
+        juce::Point<int> lastUIPosition;        //<
+        PluginDescription description;          //<
+        MemoryBlock state;                      //< The plugin's state, as provided by AudioProcessor::getStateInformation().
+    };
+
+    //==============================================================================
+    /** @returns true if the data starts off like the binary format, as opposed to the legacy XML format. */
+    [[nodiscard]] static bool isBinaryState (const void* data, size_t sizeInBytes) noexcept;
+
+    /** Writes a complete chain state to a stream.
+
+        @returns false if the stream failed to write anything.
+    */
+    static bool write (OutputStream& destination, bool isChainBypassed, const std::vector<Effect>& effects);
+
+    //==============================================================================
+    /** Reads the header and index of a chain state up front, and decodes the effects on demand.
+
+        Only the header and index get read when constructing this; each effect's chunk
+        is only read when it's asked for, in any order, and only that chunk gets read.
+    */
+    class Reader final
+    {
+    public:
+        /** Creates a reader for the provided stream.
+
+            The stream must support seeking, and must outlive this reader.
+        */
+        Reader (InputStream& source);
+
+        //==============================================================================
+        /** @returns true if the header and index were read successfully. */
+        [[nodiscard]] bool isValid() const noexcept { return valid; }
+
+        /** @returns the format version the state was written with. */
+        [[nodiscard]] int getVersion() const noexcept { return version; }
+
+        /** @returns true if the whole chain was bypassed. */
+        [[nodiscard]] bool isChainBypassed() const noexcept { return chainBypassed; }
+
+        /** @returns the number of effects in the chain. */
+        [[nodiscard]] int getNumEffects() const noexcept { return (int) index.size(); }
+
+        //==============================================================================
+        /** Decodes a single effect.
+
+            @returns the effect, or nothing if the index is out of range or its chunk is corrupt.
+        */
+        [[nodiscard]] std::optional<Effect> readEffect (int effectIndex);
+
+    private:
+        //==============================================================================
+        struct Entry final
+        {
+            int64 offset = 0, size = 0;
+        };
+
+        InputStream& source;
+        const int64 startPosition = 0;
+        std::vector<Entry> index;
+        int version = 0;
+        bool chainBypassed = false, valid = false;
+
+        //==============================================================================
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Reader)
+    };
+
+private:
+    //==============================================================================
+    EffectProcessorChainState() = delete;
+
+    JUCE_DECLARE_NON_COPYABLE (EffectProcessorChainState)
+};
@@ -1,10 +1,118 @@
+class EffectProcessorFactory::PoolRefiller final : public Thread
+{
+public:
+    PoolRefiller (EffectProcessorFactory& f) :
+        Thread ("EffectProcessorFactory Pool Refiller"),
+        factory (f)
+    {
+        startThread();
+    }
+
+    ~PoolRefiller() override
+    {
+        stopThread (3000);
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            while (! threadShouldExit() && factory.refillNextPooledPlugin (false))
+            {
+            }
+
+            wait (-1);
+        }
+    }
+
+private:
+    EffectProcessorFactory& factory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PoolRefiller)
+};
+
+//==============================================================================
+class EffectProcessorFactory::MessageThreadRefiller final : public AsyncUpdater
+{
+public:
+    MessageThreadRefiller (EffectProcessorFactory& f) :
+        factory (f)
+    {
+    }
+
+    ~MessageThreadRefiller() override
+    {
+        cancelPendingUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        // One plugin at a time, so that the message thread gets to do other things in between:
+        if (factory.refillNextPooledPlugin (true))
+            triggerAsyncUpdate();
+    }
+
+private:
+    EffectProcessorFactory& factory;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MessageThreadRefiller)
+};
+
+//==============================================================================
 EffectProcessorFactory::EffectProcessorFactory (KnownPluginList& kpl) :
-    knownPluginList (kpl)
+    knownPluginList (kpl),
+    formatManager (new AudioPluginFormatManager(), true),
+    messageThreadRefiller (std::make_unique<MessageThreadRefiller> (*this))
+{
+}
+
+EffectProcessorFactory::EffectProcessorFactory (KnownPluginList& kpl, AudioPluginFormatManager& afm) :
+    knownPluginList (kpl),
+    formatManager (&afm, false),
+    messageThreadRefiller (std::make_unique<MessageThreadRefiller> (*this))
 {
 }
 
 EffectProcessorFactory::~EffectProcessorFactory()
 {
+    releasePools();
+}
+
+//==============================================================================
+void EffectProcessorFactory::setPlaybackConfiguration (const PlaybackConfiguration& configuration)
+{
+    const ScopedLock sl (poolLock);
+
+    if (playbackConfiguration == configuration)
+        return;
+
+    playbackConfiguration = configuration;
+
+    // Whatever's pooled now gets prepared again:
+    for (const auto& entry : pools)
+        if (! entry.second.ready.empty())
+            triggerRefill (entry.second.isCreatedOnAnyThread);
+}
+
+EffectProcessorFactory::PlaybackConfiguration EffectProcessorFactory::getPlaybackConfiguration() const
+{
+    const ScopedLock sl (poolLock);
+    return playbackConfiguration;
+}
+
+void EffectProcessorFactory::preparePlugin (AudioPluginInstance& plugin, const PlaybackConfiguration& configuration,
+                                            AudioPlayHead* playHead)
+{
+    // N.B.: Mono gets upmixed by the chain, so internal plugins are never narrowed past stereo.
+    //       Those that don't support the wider layout will simply refuse it, and stay as they are.
+    if (dynamic_cast<InternalProcessor*> (&plugin) != nullptr)
+    {
+        const auto numPluginChannels = jmax (2, configuration.numChannels);
+        resetBuses (plugin, numPluginChannels, numPluginChannels);
+    }
+
+    plugin.setPlayHead (playHead);
+    plugin.prepareToPlay (configuration.sampleRate, configuration.blockSize);
 }
 
 //==============================================================================
@@ -29,12 +137,51 @@ PluginDescription EffectProcessorFactory::createPluginDescription (const PluginD
 
 //==============================================================================
 std::shared_ptr<AudioPluginInstance> EffectProcessorFactory::createPlugin (const PluginDescription& description) const
+{
+    return createPluginInstance (description, getPlaybackConfiguration());
+}
+
+std::shared_ptr<AudioPluginInstance> EffectProcessorFactory::createPluginInstance (const PluginDescription& description,
+                                                                                   const PlaybackConfiguration& configuration) const
 {
     if (description.isInstrument)
         return nullptr;
 
+    // The internal plugins are created directly, because going through the format manager
+    // would bounce the creation over to the message thread when called from any other thread.
+    if (auto* internalFormat = findInternalFormat (description))
+    {
+        std::unique_ptr<AudioPluginInstance> plugin;
+
+        internalFormat->createPluginInstance (description, configuration.sampleRate, configuration.blockSize,
+                                              [&] (std::unique_ptr<AudioPluginInstance> api, const String&)
+                                              {
+                                                  plugin = std::move (api);
+                                              });
+
+        return plugin;
+    }
+
     String errorMessage;
-    return getAudioPluginFormatManager().createPluginInstance (description, 44100.0, 256, errorMessage);
+    return getAudioPluginFormatManager().createPluginInstance (description, configuration.sampleRate,
+                                                               configuration.blockSize, errorMessage);
+}
+
+bool EffectProcessorFactory::canCreatePluginOnAnyThread (const PluginDescription& description) const
+{
+    return findInternalFormat (description) != nullptr;
+}
+
+InternalAudioPluginFormat* EffectProcessorFactory::findInternalFormat (const PluginDescription& description) const
+{
+    if (description.pluginFormatName != getInternalProcessorTypeName())
+        return nullptr;
+
+    for (auto* format : getAudioPluginFormatManager().getFormats())
+        if (format->getName() == description.pluginFormatName)
+            return dynamic_cast<InternalAudioPluginFormat*> (format);
+
+    return nullptr;
 }
 
 std::shared_ptr<AudioPluginInstance> EffectProcessorFactory::createPlugin (const int listIndex) const
@@ -53,9 +200,11 @@ void EffectProcessorFactory::createPluginAsync (const PluginDescription& descrip
     if (description.isInstrument)
         return;
 
-    const_cast<AudioPluginFormatManager&> (getAudioPluginFormatManager())
-        .createPluginInstanceAsync (description, 44100.0, 256,
-            [&] (std::unique_ptr<AudioPluginInstance> api, const String& s)
+    const auto configuration = getPlaybackConfiguration();
+
+    getAudioPluginFormatManager()
+        .createPluginInstanceAsync (description, configuration.sampleRate, configuration.blockSize,
+            [callback] (std::unique_ptr<AudioPluginInstance> api, const String& s)
             {
                 if (callback != nullptr)
                     callback (std::move (api), s);
@@ -71,3 +220,217 @@ void EffectProcessorFactory::createPluginAsync (const String& fileOrIdentifier,
 {
     createPluginAsync (createPluginDescription (fileOrIdentifier), callback);
 }
+
+//==============================================================================
+void EffectProcessorFactory::setPoolSize (const PluginDescription& description, int numInstances)
+{
+    if (description.isInstrument)
+    {
+        jassertfalse; // Only effects can be created by this factory!
+        return;
+    }
+
+    const auto isCreatedOnAnyThread = canCreatePluginOnAnyThread (description);
+    std::vector<PooledPlugin> unwanted;
+
+    const ScopedLock sl (poolLock);
+
+    if (isCreatedOnAnyThread && numInstances > 0 && poolRefiller == nullptr)
+        poolRefiller = std::make_unique<PoolRefiller> (*this);
+
+    auto& pool = pools[description.createIdentifierString()];
+    pool.description = description;
+    pool.targetSize = jmax (0, numInstances);
+    pool.isCreatedOnAnyThread = isCreatedOnAnyThread;
+    pool.hasFailed = false;
+
+    while ((int) pool.ready.size() > pool.targetSize)
+    {
+        unwanted.emplace_back (std::move (pool.ready.back()));
+        pool.ready.pop_back();
+    }
+
+    triggerRefill (isCreatedOnAnyThread);
+}
+
+int EffectProcessorFactory::getNumPooledPlugins (const PluginDescription& description) const
+{
+    const ScopedLock sl (poolLock);
+
+    const auto it = pools.find (description.createIdentifierString());
+    if (it == pools.end())
+        return 0;
+
+    const auto& ready = it->second.ready;
+    return (int) std::count_if (ready.begin(), ready.end(),
+                                [&] (const PooledPlugin& pooled) { return pooled.configuration == playbackConfiguration; });
+}
+
+std::shared_ptr<AudioPluginInstance> EffectProcessorFactory::takePooledPlugin (const PluginDescription& description,
+                                                                               const PlaybackConfiguration& configuration)
+{
+    const ScopedLock sl (poolLock);
+
+    auto it = pools.find (description.createIdentifierString());
+    if (it == pools.end())
+        return {};
+
+    auto& pool = it->second;
+    auto match = std::find_if (pool.ready.begin(), pool.ready.end(),
+                               [&] (const PooledPlugin& pooled) { return pooled.configuration == configuration; });
+
+    if (match == pool.ready.end())
+        return {};
+
+    auto plugin = std::move (match->plugin);
+    pool.ready.erase (match);
+    triggerRefill (pool.isCreatedOnAnyThread);
+    return plugin;
+}
+
+void EffectProcessorFactory::recyclePlugin (const PluginDescription& description, std::shared_ptr<AudioPluginInstance> plugin)
+{
+    if (plugin == nullptr)
+        return;
+
+    const ScopedLock sl (poolLock);
+
+    auto it = pools.find (description.createIdentifierString());
+    if (it == pools.end())
+        return;
+
+    auto& pool = it->second;
+    const auto numPooled = (int) (pool.ready.size() + pool.recycled.size()) + pool.numInFlight;
+
+    if (numPooled < pool.targetSize)
+    {
+        pool.recycled.emplace_back (std::move (plugin));
+        triggerRefill (pool.isCreatedOnAnyThread);
+    }
+}
+
+void EffectProcessorFactory::releasePools()
+{
+    std::unique_ptr<PoolRefiller> refiller;
+
+    {
+        const ScopedLock sl (poolLock);
+        refiller = std::move (poolRefiller);
+    }
+
+    // N.B.: This waits for the plugin being refilled, so it mustn't happen under the lock.
+    refiller = nullptr;
+    messageThreadRefiller->cancelPendingUpdate();
+
+    std::map<String, Pool> released;
+
+    const ScopedLock sl (poolLock);
+    std::swap (released, pools);
+}
+
+void EffectProcessorFactory::triggerRefill (bool isCreatedOnAnyThread)
+{
+    if (! isCreatedOnAnyThread)
+        messageThreadRefiller->triggerAsyncUpdate();
+    else if (poolRefiller != nullptr)
+        poolRefiller->notify();
+}
+
+bool EffectProcessorFactory::refillNextPooledPlugin (bool isMessageThread)
+{
+    String key;
+    PluginDescription description;
+    PlaybackConfiguration configuration;
+    MemoryBlock pristineState;
+    std::shared_ptr<AudioPluginInstance> plugin;
+    bool needsReset = false;
+
+    {
+        const ScopedLock sl (poolLock);
+
+        configuration = playbackConfiguration;
+        Pool* pool = nullptr;
+
+        for (auto& [candidateKey, candidate] : pools)
+        {
+            if (candidate.isCreatedOnAnyThread == isMessageThread || candidate.hasFailed)
+                continue;
+
+            auto stale = std::find_if (candidate.ready.begin(), candidate.ready.end(),
+                                       [&] (const PooledPlugin& pooled) { return pooled.configuration != configuration; });
+
+            if (stale != candidate.ready.end())
+            {
+                plugin = std::move (stale->plugin);
+                candidate.ready.erase (stale);
+            }
+            else if (! candidate.recycled.empty())
+            {
+                plugin = std::move (candidate.recycled.back());
+                candidate.recycled.pop_back();
+                needsReset = true;
+            }
+            else if ((int) candidate.ready.size() + candidate.numInFlight >= candidate.targetSize)
+            {
+                continue;
+            }
+
+            key = candidateKey;
+            pool = &candidate;
+            break;
+        }
+
+        if (pool == nullptr)
+            return false;
+
+        ++pool->numInFlight;
+        description = pool->description;
+        pristineState = pool->pristineState;
+    }
+
+    const auto isFresh = plugin == nullptr;
+
+    if (isFresh)
+    {
+        plugin = createPluginInstance (description, configuration);
+
+        if (plugin != nullptr)
+            plugin->getStateInformation (pristineState);
+    }
+    else if (needsReset)
+    {
+        plugin->reset();
+
+        if (! pristineState.isEmpty())
+            plugin->setStateInformation (pristineState.getData(), (int) pristineState.getSize());
+    }
+
+    if (plugin != nullptr)
+        preparePlugin (*plugin, configuration, nullptr);
+
+    const ScopedLock sl (poolLock);
+
+    // The pools may have been released in the meantime:
+    auto it = pools.find (key);
+    if (it == pools.end())
+        return true;
+
+    auto& pool = it->second;
+    --pool.numInFlight;
+
+    if (plugin == nullptr)
+    {
+        // Stop trying, until the pool gets resized:
+        pool.hasFailed = true;
+        return true;
+    }
+
+    if (isFresh && pool.pristineState.isEmpty())
+        pool.pristineState = pristineState;
+
+    // N.B.: Anything prepared for an outdated configuration simply gets prepared again on the next round.
+    if ((int) pool.ready.size() < pool.targetSize)
+        pool.ready.push_back ({ std::move (plugin), configuration });
+
+    return true;
+}
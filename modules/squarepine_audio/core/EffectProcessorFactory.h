@@ -1,19 +1,71 @@
-/**
+/** Creates the plugins of an EffectProcessorChain.
+
+    Constructing and preparing a plugin can take long enough to be heard when an effect
+    gets dropped into a live chain, so the factory can keep a warm pool of instances
+    per plugin type: constructed, and prepared at the device's configuration,
+    ahead of time. Pools get refilled in the background; on a thread of their own
+    for the plugins that can be created on any thread, and on the message thread otherwise.
+    The plugins of removed effects get reset and handed back to their pools.
 
     @see EffectProcessorChain
 */
 class EffectProcessorFactory
 {
 public:
-    /** Constructor
+    /** Constructor, for a factory with a format manager of its own.
+
+        Subclasses add their formats to it with getAudioPluginFormatManager().
 
         @param knownPluginList The list of plugins to refer to.
     */
     EffectProcessorFactory (KnownPluginList&);
 
+    /** Constructor, for a factory that shares a format manager.
+
+        @param knownPluginList  The list of plugins to refer to.
+        @param formatManager    The formats to create plugins with.
+                                This must outlive the factory.
+    */
+    EffectProcessorFactory (KnownPluginList&, AudioPluginFormatManager&);
+
     /** Destructor. */
     virtual ~EffectProcessorFactory();
 
+    //==============================================================================
+    /** The configuration plugins get prepared with. */
+    struct PlaybackConfiguration final
+    {
+        double sampleRate = 44100.0;
+        int blockSize = 256;
+        int numChannels = 2;
+
+        bool operator== (const PlaybackConfiguration& other) const noexcept
+        {
+            return approximatelyEqual (sampleRate, other.sampleRate)
+                && blockSize == other.blockSize
+                && numChannels == other.numChannels;
+        }
+
+        bool operator!= (const PlaybackConfiguration& other) const noexcept { return ! operator== (other); }
+    };
+
+    /** Changes the configuration that plugins get created and pooled with.
+
+        Any pooled plugins get prepared again in the background.
+        This gets called by the EffectProcessorChain whenever it's prepared.
+    */
+    void setPlaybackConfiguration (const PlaybackConfiguration&);
+
+    /** @returns the configuration that plugins get created and pooled with. */
+    [[nodiscard]] PlaybackConfiguration getPlaybackConfiguration() const;
+
+    /** Prepares a plugin to be run by an EffectProcessorChain.
+
+        Internal plugins that support it get widened to the given channel count,
+        whereas the rest keep their own layout and are only ever handed that many channels.
+    */
+    static void preparePlugin (AudioPluginInstance&, const PlaybackConfiguration&, AudioPlayHead*);
+
     //==============================================================================
     /** */
     [[nodiscard]] PluginDescription createPluginDescription (int index) const;
@@ -34,6 +86,44 @@ public:
     /** */
     [[nodiscard]] std::shared_ptr<AudioPluginInstance> createPlugin (const PluginDescription&) const;
 
+    /** @returns true if the plugin can be created on any thread, as opposed to only the message thread.
+
+        This is the case for the plugins of the InternalAudioPluginFormat, which get created
+        directly rather than going through the message thread like other formats require.
+    */
+    [[nodiscard]] bool canCreatePluginOnAnyThread (const PluginDescription&) const;
+
+    //==============================================================================
+    /** Keeps the given number of instances of a plugin constructed and prepared ahead of time.
+
+        Call this from the message thread. A size of 0 empties the plugin's pool.
+    */
+    void setPoolSize (const PluginDescription&, int numInstances);
+
+    /** @returns the number of pooled instances of a plugin that are ready to be taken. */
+    [[nodiscard]] int getNumPooledPlugins (const PluginDescription&) const;
+
+    /** @returns a pooled instance of the plugin, already prepared with the given configuration,
+        or null if none are ready; in which case the plugin should be created as usual.
+
+        Taking an instance never blocks on anything but a short lock,
+        and the pool gets refilled in the background.
+    */
+    [[nodiscard]] std::shared_ptr<AudioPluginInstance> takePooledPlugin (const PluginDescription&, const PlaybackConfiguration&);
+
+    /** Hands a plugin that's no longer used back to its pool, which resets it in the background.
+
+        The plugin is simply released if it isn't pooled, or if its pool is already full,
+        so make sure nothing else is referring to it!
+    */
+    void recyclePlugin (const PluginDescription&, std::shared_ptr<AudioPluginInstance>);
+
+    /** Stops refilling the pools, and releases every pooled plugin.
+
+        Call this from the message thread.
+    */
+    void releasePools();
+
     //==============================================================================
     /** */
     using PluginCreationCallback = std::function<void (std::shared_ptr<AudioPluginInstance>, const String&)>;
@@ -52,10 +142,50 @@ protected:
     KnownPluginList& knownPluginList;
 
     //==============================================================================
-    /** */
-    virtual const AudioPluginFormatManager& getAudioPluginFormatManager() const = 0;
+    /** @returns the formats plugins get created with. */
+    [[nodiscard]] AudioPluginFormatManager& getAudioPluginFormatManager() noexcept { return *formatManager; }
+
+    /** @returns the formats plugins get created with. */
+    [[nodiscard]] const AudioPluginFormatManager& getAudioPluginFormatManager() const noexcept { return *formatManager; }
 
 private:
+    //==============================================================================
+    struct PooledPlugin final
+    {
+        std::shared_ptr<AudioPluginInstance> plugin;
+        PlaybackConfiguration configuration;
+    };
+
+    struct Pool final
+    {
+        PluginDescription description;
+        int targetSize = 0;
+        bool isCreatedOnAnyThread = false, hasFailed = false;
+        MemoryBlock pristineState;                                      // The state of a freshly created instance.
+        std::vector<PooledPlugin> ready;
+        std::vector<std::shared_ptr<AudioPluginInstance>> recycled;     // Waiting to be reset.
+        int numInFlight = 0;                                            // Being created, reset or prepared.
+    };
+
+    class PoolRefiller;
+    class MessageThreadRefiller;
+
+    // N.B.: The base holds on to the formats, rather than asking a subclass for them, so that
+    //       the pool refiller never needs anything that's gone by the time this destructor runs.
+    OptionalScopedPointer<AudioPluginFormatManager> formatManager;
+
+    mutable CriticalSection poolLock;
+    PlaybackConfiguration playbackConfiguration;                        // Guarded by the poolLock.
+    std::map<String, Pool> pools;                                       // Guarded by the poolLock.
+    std::unique_ptr<PoolRefiller> poolRefiller;
+    std::unique_ptr<MessageThreadRefiller> messageThreadRefiller;
+
+    //==============================================================================
+    [[nodiscard]] InternalAudioPluginFormat* findInternalFormat (const PluginDescription&) const;
+    [[nodiscard]] std::shared_ptr<AudioPluginInstance> createPluginInstance (const PluginDescription&, const PlaybackConfiguration&) const;
+    [[nodiscard]] bool refillNextPooledPlugin (bool isMessageThread);
+    void triggerRefill (bool isCreatedOnAnyThread);
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EffectProcessorFactory)
 };
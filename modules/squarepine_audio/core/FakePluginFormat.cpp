@@ -0,0 +1,128 @@
+namespace FakePluginFormatHelpers
+{
+    static const String identifierPrefix = "FakePlugin:";
+
+    static const StringArray behaviourNames = { "succeed", "slow", "fail", "hang", "crash" };
+
+    /** The identifiers look like "FakePlugin:behaviour:delayMs:name", where the name may contain anything. */
+    struct ParsedIdentifier final
+    {
+        FakePluginFormat::Behaviour behaviour = FakePluginFormat::Behaviour::fail;
+        int delayMs = 0;
+        String name;
+    };
+
+    static ParsedIdentifier parseIdentifier (const String& fileOrIdentifier)
+    {
+        ParsedIdentifier result;
+
+        if (! FakePluginFormat::isFakeIdentifier (fileOrIdentifier))
+            return result;
+
+        const auto details = fileOrIdentifier.fromFirstOccurrenceOf (identifierPrefix, false, false);
+        const auto behaviourIndex = behaviourNames.indexOf (details.upToFirstOccurrenceOf (":", false, false));
+
+        if (behaviourIndex >= 0)
+            result.behaviour = static_cast<FakePluginFormat::Behaviour> (behaviourIndex);
+
+        const auto delayAndName = details.fromFirstOccurrenceOf (":", false, false);
+        result.delayMs = jmax (0, delayAndName.upToFirstOccurrenceOf (":", false, false).getIntValue());
+        result.name = delayAndName.fromFirstOccurrenceOf (":", false, false);
+        return result;
+    }
+}
+
+//==============================================================================
+FakePluginFormat::FakePluginFormat (const StringArray& ids) :
+    identifiers (ids)
+{
+}
+
+//==============================================================================
+String FakePluginFormat::createIdentifier (Behaviour behaviour, const String& name, int delayMs)
+{
+    using namespace FakePluginFormatHelpers;
+
+    return identifierPrefix
+         + behaviourNames[static_cast<int> (behaviour)]
+         + ":" + String (jmax (0, delayMs))
+         + ":" + name;
+}
+
+bool FakePluginFormat::isFakeIdentifier (const String& fileOrIdentifier)
+{
+    return fileOrIdentifier.startsWith (FakePluginFormatHelpers::identifierPrefix);
+}
+
+String FakePluginFormat::getNameFromIdentifier (const String& fileOrIdentifier)
+{
+    return FakePluginFormatHelpers::parseIdentifier (fileOrIdentifier).name;
+}
+
+FakePluginFormat::Behaviour FakePluginFormat::getBehaviourFromIdentifier (const String& fileOrIdentifier)
+{
+    return FakePluginFormatHelpers::parseIdentifier (fileOrIdentifier).behaviour;
+}
+
+//==============================================================================
+String FakePluginFormat::getName() const                                                                        { return "Fake"; }
+bool FakePluginFormat::requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const noexcept   { return false; }
+bool FakePluginFormat::fileMightContainThisPluginType (const String& fileOrIdentifier)                          { return isFakeIdentifier (fileOrIdentifier); }
+String FakePluginFormat::getNameOfPluginFromIdentifier (const String& fileOrIdentifier)                         { return getNameFromIdentifier (fileOrIdentifier); }
+bool FakePluginFormat::pluginNeedsRescanning (const PluginDescription&)                                         { return false; }
+bool FakePluginFormat::doesPluginStillExist (const PluginDescription& description)                              { return isFakeIdentifier (description.fileOrIdentifier); }
+bool FakePluginFormat::canScanForPlugins() const                                                                { return true; }
+StringArray FakePluginFormat::searchPathsForPlugins (const FileSearchPath&, bool, bool)                         { return identifiers; }
+FileSearchPath FakePluginFormat::getDefaultLocationsToSearch()                                                  { return {}; }
+
+void FakePluginFormat::findAllTypesForFile (OwnedArray<PluginDescription>& results, const String& fileOrIdentifier)
+{
+    if (! isFakeIdentifier (fileOrIdentifier))
+        return;
+
+    const auto parsed = FakePluginFormatHelpers::parseIdentifier (fileOrIdentifier);
+
+    switch (parsed.behaviour)
+    {
+        case Behaviour::succeed:
+        break;
+
+        case Behaviour::slow:
+            Thread::sleep (parsed.delayMs);
+        break;
+
+        case Behaviour::fail:
+            return;
+
+        case Behaviour::hang:
+            for (;;)
+                Thread::sleep (1000);
+
+        case Behaviour::crash:
+            std::abort();
+
+        default:
+            jassertfalse;
+            return;
+    }
+
+    auto* description = results.add (new PluginDescription());
+    description->name = parsed.name;
+    description->descriptiveName = parsed.name;
+    description->pluginFormatName = getName();
+    description->category = "Effect";
+    description->manufacturerName = "SquarePine";
+    description->version = "1.0";
+    description->fileOrIdentifier = fileOrIdentifier;
+    description->lastFileModTime = Time();
+    description->lastInfoUpdateTime = Time::getCurrentTime();
+    description->deprecatedUid = fileOrIdentifier.hashCode();
+    description->uniqueId = description->deprecatedUid;
+    description->numInputChannels = 2;
+    description->numOutputChannels = 2;
+}
+
+void FakePluginFormat::createPluginInstance (const PluginDescription&, double, int, PluginCreationCallback callback)
+{
+    callback (nullptr, TRANS ("Fake plugins are only for testing scanning, and can't be created."));
+}
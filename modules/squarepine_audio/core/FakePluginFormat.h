@@ -0,0 +1,80 @@
+/** A plugin format whose "plugins" misbehave on purpose while being scanned,
+    for testing and benchmarking plugin scanning without a library of real plugins.
+
+    Each plugin is nothing but an identifier describing how its scan should go;
+    see createIdentifier(). Such plugins can't actually be instantiated.
+
+    @warning Scanning a plugin that crashes will take the scanning process down with it,
+             so only ever scan these out of process; eg: with a PluginScanService.
+
+    @see PluginScanService
+*/
+class FakePluginFormat final : public AudioPluginFormat
+{
+public:
+    /** How a fake plugin behaves when it gets scanned. */
+    enum class Behaviour
+    {
+        succeed = 0,    //< Found straight away.
+        slow,           //< Found, but only after a delay.
+        fail,           //< Nothing is found, as if the plugin failed to load.
+        hang,           //< The scan never finishes.
+        crash           //< The scanning process crashes.
+    };
+
+    //==============================================================================
+    /** Constructor.
+
+        @param identifiers The plugins that searchPathsForPlugins() returns, as made by createIdentifier().
+    */
+    explicit FakePluginFormat (const StringArray& identifiers = {});
+
+    //==============================================================================
+    /** @returns the identifier of a fake plugin, to scan with this format.
+
+        @param behaviour    What scanning the plugin should do.
+        @param name         The name of the plugin.
+        @param delayMs      For slow plugins, how long scanning takes.
+    */
+    [[nodiscard]] static String createIdentifier (Behaviour behaviour, const String& name, int delayMs = 0);
+
+    /** @returns true if the identifier was made by createIdentifier(). */
+    [[nodiscard]] static bool isFakeIdentifier (const String& fileOrIdentifier);
+
+    /** @returns the name given to createIdentifier(). */
+    [[nodiscard]] static String getNameFromIdentifier (const String& fileOrIdentifier);
+
+    /** @returns the behaviour given to createIdentifier(). */
+    [[nodiscard]] static Behaviour getBehaviourFromIdentifier (const String& fileOrIdentifier);
+
+    //==============================================================================
+    /** @internal */
+    String getName() const override;
+    /** @internal */
+    void findAllTypesForFile (OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void createPluginInstance (const PluginDescription&, double initialSampleRate, int initialBufferSize, PluginCreationCallback) override;
+    /** @internal */
+    bool requiresUnblockedMessageThreadDuringCreation (const PluginDescription&) const noexcept override;
+    /** @internal */
+    bool fileMightContainThisPluginType (const String&) override;
+    /** @internal */
+    String getNameOfPluginFromIdentifier (const String&) override;
+    /** @internal */
+    bool pluginNeedsRescanning (const PluginDescription&) override;
+    /** @internal */
+    bool doesPluginStillExist (const PluginDescription&) override;
+    /** @internal */
+    bool canScanForPlugins() const override;
+    /** @internal */
+    StringArray searchPathsForPlugins (const FileSearchPath&, bool, bool) override;
+    /** @internal */
+    FileSearchPath getDefaultLocationsToSearch() override;
+
+private:
+    //==============================================================================
+    const StringArray identifiers;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FakePluginFormat)
+};
@@ -9,14 +9,97 @@ public:
     }
 
     //==============================================================================
+    /** Everything needed to describe an internal processor, without having to create one.
+
+        Creating a processor just to ask it for its description means allocating its parameters,
+        filters and buffers, only to throw them away again; so the processors are described here
+        instead, and only ever get created once they're really needed.
+
+        These must match what the processors themselves report!
+    */
+    struct StaticDescription final
+    {
+        const char* identifier;         // The processor's getIdentifier().
+        const char* name;               // The processor's untranslated getName(), or null if that's the identifier.
+        bool isInstrument;
+        AudioPluginInstance* (*create)();
+    };
+
     template<class ClassName>
-    static void addPlugin (PluginCreationMap& pluginCreationMap,
-                           OwnedArray<PluginDescription>& descriptions)
+    static constexpr StaticDescription describe (const char* identifier, const char* name, bool isInstrument = false)
     {
-        std::unique_ptr<AudioPluginInstance> api (new ClassName());
+        return { identifier, name, isInstrument,
+                 &createInstance<ClassName> }; //N.B.: The lacking parentheses are entirely intentional!
+    }
+
+    static void addInternalPlugins (PluginCreationMap& pluginCreationMap,
+                                    OwnedArray<PluginDescription>& descriptions)
+    {
+        static constexpr StaticDescription internalPlugins[] =
+        {
+            // Effects:
+            describe<ADSRProcessor> ("ADSR", nullptr),
+            describe<BitCrusherProcessor> ("bitCrusher", "BitCrusher"),
+            describe<ChorusProcessor> ("chorus", "Chorus"),
+            describe<DitherProcessor> ("basicDither", "Basic Dither"),
+            //describe<EffectProcessorChain> (...),
+            //describe<JUCEReverbProcessor> ("simpleReverb", "Simple Reverb"),
+            //describe<LFOProcessor> ("LFO", nullptr, true),
+            describe<MuteProcessor> ("mute", "Mute"),
+            describe<PanProcessor> ("stereoPanner", "Stereophonic Panner"),
+            describe<PolarityInversionProcessor> ("polarityInverter", "Polarity Inverter"),
+            describe<SimpleDistortionProcessor> ("simpleDistortion", "Simple Distortion"),
+            describe<StereoWidthProcessor> ("stereoWidth", "Stereo Width"),
+            //describe<GainProcessor> (...),
+
+            // DAW effects, each described with the ID they're given by default:
+            //N.B.: djdawprocessor::BitCrusherProcessor reports the same "bitCrusher" identifier as the BitCrusherProcessor above,
+            //      so it can't be told apart by its identifier and is left out until one of the two is renamed.
+            describe<djdawprocessor::ButterSem> ("Butter Sem1", "Butter Sem"),
+            describe<djdawprocessor::CrushProcessor> ("Crush1", "Crush"),
+            describe<djdawprocessor::DelayProcessor> ("Delay1", "Delay"),
+            describe<djdawprocessor::DigitalSem> ("Digital Sem1", "Digital Sem"),
+            describe<djdawprocessor::DigitalSem2> ("Digital Sem Two1", "Digital Sem Two"),
+            describe<djdawprocessor::DubEchoProcessor> ("Dub Echo1", "Dub Echo"),
+            describe<djdawprocessor::EchoProcessor> ("Echo1", "Echo"),
+            describe<djdawprocessor::EffectiveTempoProcessor> ("effectiveTempoProcessor", "Effective Tempo Processor"),
+            describe<djdawprocessor::EQProcessor> ("equaliser", "Equaliser"),
+            describe<djdawprocessor::FlangerProcessor> ("Flanger1", "Flanger"),
+            describe<djdawprocessor::GainProcessor> ("gain1", "Gain"),
+            describe<djdawprocessor::HelixProcessor> ("Helix1", "Helix"),
+            describe<djdawprocessor::LFOFilterProcessor> ("LFO Filter1", "LFO Filter"),
+            describe<djdawprocessor::LongDelayProcessor> ("Long Delay1", "Long Delay"),
+            describe<djdawprocessor::NoiseProcessor> ("Noise1", "Noise"),
+            describe<djdawprocessor::PhaserProcessor> ("Phaser1", "Phaser"),
+            describe<djdawprocessor::PingPongProcessor> ("Ping Pong1", "Ping Pong"),
+            describe<djdawprocessor::PitchProcessor> ("Pitch1", "Pitch"),
+            describe<djdawprocessor::ReverbProcessor> ("Reverb1", "Reverb"),
+            describe<djdawprocessor::RevRollProcessor> ("Rev Roll1", "Rev Roll"),
+            describe<djdawprocessor::RollProcessor> ("Roll1", "Roll"),
+            describe<djdawprocessor::SEMFilter> ("SEM Filter1", "SEM Filter"),
+            describe<djdawprocessor::ShimmerProcessor> ("Shimmer1", "Shimmer"),
+            describe<djdawprocessor::ShortDelayProcessor> ("Short Delay1", "Short Delay"),
+            describe<djdawprocessor::SlipRollProcessor> ("Slip Roll1", "Slip Roll"),
+            describe<djdawprocessor::SpaceProcessor> ("Space1", "Space"),
+            describe<djdawprocessor::SpiralProcessor> ("Spiral1", "Spiral"),
+            describe<djdawprocessor::SweepProcessor> ("Sweep1", "Sweep"),
+            describe<djdawprocessor::TransEffectProcessor> ("Trans1", "Trans"),
+            describe<djdawprocessor::VariableBPMProcessor> ("variableBPMProcessor", "Variabe Tempo Processor"),
+            describe<djdawprocessor::VinylBreakProcessor> ("Vinyl Break1", "Vinyl Break"),
+
+            // Wrappers:
+            describe<AudioSourceProcessor> ("AudioSourceProcessor", nullptr, true),
+            describe<AudioTransportProcessor> ("AudioTransportProcessor", "Audio Transport", true)
+        };
+
+        for (const auto& plugin : internalPlugins)
+        {
+            const auto name = plugin.name != nullptr ? TRANS (plugin.name) : String (plugin.identifier);
 
-        addPlugin (pluginCreationMap, descriptions, api->getPluginDescription(),
-                   &createInstance<ClassName>); //N.B.: The lacking parentheses are entirely intentional!
+            addPlugin (pluginCreationMap, descriptions,
+                       InternalProcessor::createPluginDescription (name, plugin.identifier, plugin.isInstrument),
+                       plugin.create);
+        }
     }
 
     static void addGraphPlugins (PluginCreationMap& pluginCreationMap,
@@ -122,24 +205,8 @@ void InternalAudioPluginFormat::addInternalPluginDescriptions()
     CreationHelpers::addGraphPlugins (pluginCreationMap, descriptions);
     numGraphPlugins = descriptions.size();
 
-    // Effects:
-    CreationHelpers::addPlugin<ADSRProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<BitCrusherProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<ChorusProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<DitherProcessor> (pluginCreationMap, descriptions);
-    //CreationHelpers::addPlugin<EffectProcessorChain> (pluginCreationMap, descriptions);
-    //CreationHelpers::addPlugin<JUCEReverbProcessor> (pluginCreationMap, descriptions);
-    //CreationHelpers::addPlugin<LFOProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<MuteProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<PanProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<PolarityInversionProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<SimpleDistortionProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<StereoWidthProcessor> (pluginCreationMap, descriptions);
-  //  CreationHelpers::addPlugin<GainProcessor> (pluginCreationMap, descriptions);
-
-    //Wrappers:
-    CreationHelpers::addPlugin<AudioSourceProcessor> (pluginCreationMap, descriptions);
-    CreationHelpers::addPlugin<AudioTransportProcessor> (pluginCreationMap, descriptions);
+    // Effects and wrappers, none of which get created until they're needed:
+    CreationHelpers::addInternalPlugins (pluginCreationMap, descriptions);
 }
 
 void InternalAudioPluginFormat::addPluginDescriptions (KnownPluginList& knownPluginList)
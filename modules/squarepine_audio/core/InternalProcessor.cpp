@@ -65,6 +65,12 @@ InternalProcessor::InternalProcessor (bool applyDefaultBypassParam)
     return layout;
 }
 
+bool InternalProcessor::isAtMostStereo (const BusesLayout& layouts) noexcept
+{
+    return layouts.getMainInputChannels() <= 2
+        && layouts.getMainOutputChannels() <= 2;
+}
+
 //==============================================================================
 [[nodiscard]] ValueTree InternalProcessor::getState() const
 {
@@ -141,23 +147,51 @@ void InternalProcessor::setBypass (const bool shouldBeBypassed)
 void InternalProcessor::prepareToPlay (const double sampleRate, const int estimatedSamplesPerBlock)
 {
     setRateAndBufferSizeDetails (sampleRate, estimatedSamplesPerBlock);
+
+    const ScopedLock sl (getCallbackLock());
+    parameterSnapshot.attach (*this);
+}
+
+void InternalProcessor::updateParameterSnapshot()
+{
+    parameterSnapshot.update ([this] (int parameterIndex, float newValue)
+    {
+        parameterSnapshotChanged (parameterIndex, newValue);
+    });
+}
+
+void InternalProcessor::parameterSnapshotChanged (int, float)
+{
 }
 
 //==============================================================================
 void InternalProcessor::fillInPluginDescription (PluginDescription& description) const
 {
-    description.name                = getName().trim();
+    description = createPluginDescription (getName(), getIdentifier(), isInstrument(), getVersion(),
+                                           getTotalNumInputChannels(), getTotalNumOutputChannels());
+}
+
+PluginDescription InternalProcessor::createPluginDescription (const String& name,
+                                                              const Identifier& identifier,
+                                                              bool isInstrumentPlugin,
+                                                              const String& version,
+                                                              int numInputChannels,
+                                                              int numOutputChannels)
+{
+    PluginDescription description;
+    description.name                = name.trim();
     description.descriptiveName     = description.name;
     description.pluginFormatName    = getInternalProcessorTypeName();
-    description.category            = isInstrument() ? TRANS ("Synth") : TRANS ("Effect");
+    description.category            = isInstrumentPlugin ? TRANS ("Synth") : TRANS ("Effect");
     description.manufacturerName    = {};
-    description.version             = getVersion();
-    description.fileOrIdentifier    = getIdentifier().toString();
+    description.version             = version;
+    description.fileOrIdentifier    = identifier.toString();
     description.lastFileModTime     = Time::getCurrentTime();
     description.uniqueId            = description.name.hashCode();
-    description.isInstrument        = isInstrument();
-    description.numInputChannels    = getTotalNumInputChannels();
-    description.numOutputChannels   = getTotalNumOutputChannels();
+    description.isInstrument        = isInstrumentPlugin;
+    description.numInputChannels    = numInputChannels;
+    description.numOutputChannels   = numOutputChannels;
+    return description;
 }
 
 //==============================================================================
@@ -46,6 +46,16 @@ public:
     */
     virtual Identifier getIdentifier() const = 0;
 
+    /** @returns a description of an internal processor, as fillInPluginDescription() would make,
+        but without needing an instance of it; eg: to register a processor without creating one.
+    */
+    [[nodiscard]] static PluginDescription createPluginDescription (const String& name,
+                                                                    const Identifier& identifier,
+                                                                    bool isInstrumentPlugin,
+                                                                    const String& version = "1.0",
+                                                                    int numInputChannels = 2,
+                                                                    int numOutputChannels = 2);
+
     //==============================================================================
     /** @returns the APVTS directly if you want to more easily tie
         logic and UI controls to parameters. This may be null
@@ -208,8 +218,45 @@ protected:
 
     /** */
     [[nodiscard]] AudioProcessorValueTreeState::ParameterLayout createDefaultParameterLayout (bool addBypassParam = true);
+
+    /** @returns true if the main buses of a layout have no more than 2 channels.
+
+        Internal processors accept any layout by default, so those that are
+        inherently stereo can return this from isBusesLayoutSupported().
+    */
+    [[nodiscard]] static bool isAtMostStereo (const BusesLayout&) noexcept;
+
+    //==============================================================================
+    /** Brings the parameter snapshot up to date, calling parameterSnapshotChanged()
+        for every parameter that changed since the last block.
+
+        Call this at the top of your processBlock() so that the rest of the block
+        can read the parameters from getParameterSnapshot(), without locking.
+
+        @note The snapshot is attached to the parameters by InternalProcessor::prepareToPlay(),
+              so be sure to call that from any override.
+    */
+    void updateParameterSnapshot();
+
+    /** Called by updateParameterSnapshot(), on the audio thread, for each parameter that changed.
+
+        This is the place to push parameter changes into DSP state, seeing as nothing
+        else can be touching that state at the time. Any parameters that were moved
+        away from their defaults before the first prepareToPlay() are reported on the first block.
+
+        @param parameterIndex   The index of the parameter, in this processor.
+        @param newValue         The denormalised value of the parameter.
+    */
+    virtual void parameterSnapshotChanged (int parameterIndex, float newValue);
+
+    /** @returns the copy of the parameters taken by the last call to updateParameterSnapshot(),
+        or by prepareToPlay() before the first block.
+    */
+    [[nodiscard]] const ParameterSnapshot& getParameterSnapshot() const noexcept { return parameterSnapshot; }
+
 private:
     AudioParameterFloat* primaryParameter = nullptr;
+    ParameterSnapshot parameterSnapshot;
 
     bool effectiveInTimeDomain = false;
     //==============================================================================
@@ -0,0 +1,130 @@
+/** A fixed, whole-sample, multichannel delay used to line a signal up with a plugin's latency.
+
+    All of the storage is allocated in prepare(), so processing never allocates.
+    The ring holds exactly as many samples as the delay, and delaying a block is a matter of
+    swapping the block with the oldest samples in the ring, so there's nothing to copy around twice.
+
+    A delay of 0 samples makes every call a no-op.
+
+    @see EffectProcessor, EffectProcessorChain
+*/
+template<typename FloatType>
+class LatencyCompensationDelay final
+{
+public:
+    /** Constructor.
+
+        Nothing is allocated until prepare() is called.
+    */
+    LatencyCompensationDelay() = default;
+
+    //==============================================================================
+    /** Allocates and silences the delay.
+
+        @param numChannels  The number of channels to delay.
+        @param delaySamples The delay, in samples.
+    */
+    void prepare (int numChannels, int delaySamples)
+    {
+        jassert (numChannels >= 0);
+        jassert (delaySamples >= 0);
+
+        delay = jmax (0, delaySamples);
+        buffer.setSize (delay > 0 ? jmax (0, numChannels) : 0, delay, false, false, true);
+        reset();
+    }
+
+    /** Silences the delay. */
+    void reset() noexcept
+    {
+        buffer.clear();
+        writePosition = 0;
+    }
+
+    //==============================================================================
+    /** @returns the delay, in samples. */
+    [[nodiscard]] int getDelay() const noexcept { return delay; }
+
+    /** @returns the number of channels that get delayed. */
+    [[nodiscard]] int getNumChannels() const noexcept { return buffer.getNumChannels(); }
+
+    //==============================================================================
+    /** Delays the first few channels of a buffer, in place.
+
+        Any channels past the ones that were prepared are left as they are.
+    */
+    void process (juce::AudioBuffer<FloatType>& source, int numChannels, int numSamples) noexcept
+    {
+        forEachRun (source, numChannels, numSamples, [&] (int channel, FloatType* ring, int offset, int num)
+        {
+            auto* samples = source.getWritePointer (channel, offset);
+            std::swap_ranges (samples, samples + num, ring);
+        });
+    }
+
+    /** Feeds the first few channels of a buffer into the delay, without touching the buffer.
+
+        This keeps the delay's history up to date while its output isn't needed,
+        so that it's ready to be used the moment it is.
+    */
+    void push (const juce::AudioBuffer<FloatType>& source, int numChannels, int numSamples) noexcept
+    {
+        forEachRun (source, numChannels, numSamples, [&] (int channel, FloatType* ring, int offset, int num)
+        {
+            FloatVectorOperations::copy (ring, source.getReadPointer (channel, offset), num);
+        });
+    }
+
+    /** Feeds the first few channels into the delay, like push(), while delaying the channels after those in place, like process().
+
+        This is for when a plugin only processes some of the channels,
+        so that the ones it leaves be still line up with those it delays.
+    */
+    void pushAndProcess (juce::AudioBuffer<FloatType>& source, int numChannelsToPush, int numChannels, int numSamples) noexcept
+    {
+        forEachRun (source, numChannels, numSamples, [&] (int channel, FloatType* ring, int offset, int num)
+        {
+            if (channel < numChannelsToPush)
+            {
+                FloatVectorOperations::copy (ring, source.getReadPointer (channel, offset), num);
+            }
+            else
+            {
+                auto* samples = source.getWritePointer (channel, offset);
+                std::swap_ranges (samples, samples + num, ring);
+            }
+        });
+    }
+
+private:
+    //==============================================================================
+    juce::AudioBuffer<FloatType> buffer;
+    int delay = 0, writePosition = 0;
+
+    //==============================================================================
+    /** Every channel shares the same write position, so the ring gets walked one run at a time, up to where it wraps around. */
+    template<typename RunFunction>
+    void forEachRun (const juce::AudioBuffer<FloatType>& source, int numChannels, int numSamples, RunFunction&& function) noexcept
+    {
+        numChannels = jmin (numChannels, source.getNumChannels(), buffer.getNumChannels());
+
+        if (delay <= 0 || numChannels <= 0 || numSamples <= 0)
+            return;
+
+        jassert (numSamples <= source.getNumSamples());
+
+        for (int offset = 0; offset < numSamples;)
+        {
+            const auto numThisTime = jmin (numSamples - offset, delay - writePosition);
+
+            for (int i = 0; i < numChannels; ++i)
+                function (i, buffer.getWritePointer (i, writePosition), offset, numThisTime);
+
+            offset += numThisTime;
+            writePosition = (writePosition + numThisTime) % delay;
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LatencyCompensationDelay)
+};
@@ -0,0 +1,110 @@
+MeterBus::MeterBus (int maxChannels) :
+    maximumNumChannels (jmax (1, maxChannels)),
+    slots (std::make_unique<Slot[]> ((size_t) maximumNumChannels)),
+    scratch ((size_t) maximumNumChannels)
+{
+}
+
+float MeterBus::getLevel (const ChannelLevels& channel, Level level) noexcept
+{
+    switch (level)
+    {
+        case Level::peak:           return channel.peak;
+        case Level::rms:            return channel.rms;
+        case Level::truePeak:       return channel.truePeak;
+        case Level::gainReduction:  return channel.gainReduction;
+
+        default:
+            jassertfalse;
+        break;
+    };
+
+    return 0.0f;
+}
+
+//==============================================================================
+void MeterBus::publish (const ChannelLevels* levels, int numChannels) noexcept
+{
+    jassert (levels != nullptr || numChannels <= 0);
+
+    numChannels = jlimit (0, maximumNumChannels, numChannels);
+
+    const SequenceLock::ScopedWrite write (sequenceLock);
+
+    numChannelsPublished.store (numChannels, std::memory_order_relaxed);
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        const auto& source = levels[c];
+        auto& slot = slots[(size_t) c];
+
+        slot.peak.store (source.peak, std::memory_order_relaxed);
+        slot.rms.store (source.rms, std::memory_order_relaxed);
+        slot.truePeak.store (source.truePeak, std::memory_order_relaxed);
+        slot.gainReduction.store (source.gainReduction, std::memory_order_relaxed);
+        slot.clipped.store (source.clipped, std::memory_order_relaxed);
+
+        if (source.clipped)
+            slot.clipLatch.store (true, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+int MeterBus::read (ChannelLevels* destination, int maxNumChannels) const noexcept
+{
+    jassert (destination != nullptr || maxNumChannels <= 0);
+
+    return readSlots (maxNumChannels, [destination] (int c, const Slot& slot)
+    {
+        auto& channel = destination[c];
+
+        channel.peak = slot.peak.load (std::memory_order_relaxed);
+        channel.rms = slot.rms.load (std::memory_order_relaxed);
+        channel.truePeak = slot.truePeak.load (std::memory_order_relaxed);
+        channel.gainReduction = slot.gainReduction.load (std::memory_order_relaxed);
+        channel.clipped = slot.clipped.load (std::memory_order_relaxed);
+    });
+}
+
+void MeterBus::read (Array<float>& destination, Level level) const
+{
+    // N.B.: The array is sized for the channels that were last published, and the readings go
+    //       straight into it, so there's no limit to the channels short of the bus' own.
+    //       It only shrinks back down if the channel count changed while it was being read.
+    destination.resize (jlimit (0, maximumNumChannels, numChannelsPublished.load (std::memory_order_relaxed)));
+
+    auto* levels = destination.getRawDataPointer();
+
+    const auto numChannels = readSlots (destination.size(), [levels, level] (int c, const Slot& slot)
+    {
+        switch (level)
+        {
+            case Level::peak:           levels[c] = slot.peak.load (std::memory_order_relaxed); break;
+            case Level::rms:            levels[c] = slot.rms.load (std::memory_order_relaxed); break;
+            case Level::truePeak:       levels[c] = slot.truePeak.load (std::memory_order_relaxed); break;
+            case Level::gainReduction:  levels[c] = slot.gainReduction.load (std::memory_order_relaxed); break;
+
+            default:
+                jassertfalse;
+                levels[c] = 0.0f;
+            break;
+        };
+    });
+
+    destination.resize (numChannels);
+}
+
+//==============================================================================
+bool MeterBus::hasClipped (int channel) const noexcept
+{
+    if (isPositiveAndBelow (channel, maximumNumChannels))
+        return slots[(size_t) channel].clipLatch.load (std::memory_order_relaxed);
+
+    return false;
+}
+
+void MeterBus::resetClip (int channel) noexcept
+{
+    if (isPositiveAndBelow (channel, maximumNumChannels))
+        slots[(size_t) channel].clipLatch.store (false, std::memory_order_relaxed);
+}
@@ -0,0 +1,166 @@
+/** A lock-free channel for getting meter readings from the audio thread to any number of readers.
+
+    The audio thread (the single producer) publishes a frame of per-channel levels,
+    usually once per block, and readers copy out the latest complete frame whenever
+    they want to; eg: when a meter repaints. Neither side ever locks nor allocates.
+
+    The frame is guarded by a SequenceLock: the producer bumps a counter before
+    and after writing, and readers retry in the unlikely case they raced with it.
+    The producer never waits on the readers, so a slow or stalled UI can't hold up
+    the audio, and any number of readers can poll the same bus.
+
+    Clipping is latched per channel until a reader acknowledges it with resetClip(),
+    so a clip that only lasted a single block doesn't go unnoticed between repaints.
+
+    @code
+        MeterBus bus (2);
+
+        // On the audio thread:
+        bus.publish (buffer, 0, buffer.getNumSamples());
+
+        // On the message thread:
+        Array<float> levels;
+        bus.read (levels, MeterBus::Level::peak);
+    @endcode
+
+    @see Meter, LevelsProcessor
+*/
+class MeterBus final
+{
+public:
+    //==============================================================================
+    /** Everything known about a single channel, as of the last frame. */
+    struct ChannelLevels final
+    {
+        float peak = 0.0f;              //< The largest magnitude, as a gain.
+        float rms = 0.0f;               //< The RMS level, as a gain.
+        float truePeak = 0.0f;          //< The largest true-peak, as a gain.
+        float gainReduction = 1.0f;     //< Any gain reduction being applied, as a gain; 1 being none.
+        bool clipped = false;           //< Whether the channel clipped during the frame.
+    };
+
+    /** The readings a Meter can display. */
+    enum class Level
+    {
+        peak = 0,
+        rms,
+        truePeak,
+        gainReduction
+    };
+
+    /** @returns one of the readings of a channel. */
+    static float getLevel (const ChannelLevels& channel, Level level) noexcept;
+
+    //==============================================================================
+    /** Constructor.
+
+        @param maximumNumChannels The most channels that can be published at once.
+                                  This is the only time the bus allocates.
+    */
+    explicit MeterBus (int maximumNumChannels = 2);
+
+    /** @returns the most channels that can be published at once. */
+    [[nodiscard]] int getMaximumNumChannels() const noexcept { return maximumNumChannels; }
+
+    //==============================================================================
+    /** Publishes a new frame. This must only ever be called from a single thread at a time.
+
+        Any channels past the maximum are ignored.
+    */
+    void publish (const ChannelLevels* levels, int numChannels) noexcept;
+
+    /** Measures a range of a buffer and publishes the peak, RMS and clipping of its channels.
+        This must only ever be called from a single thread at a time.
+
+        @param buffer       The audio to measure.
+        @param startSample  The first sample to measure.
+        @param numSamples   The number of samples to measure.
+        @param measureRMS   Whether to bother measuring the RMS level, which is left at 0 otherwise.
+    */
+    template<typename FloatType>
+    void publish (const juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples, bool measureRMS = true) noexcept
+    {
+        const auto numChannels = jmin (buffer.getNumChannels(), maximumNumChannels);
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            auto& channel = scratch[(size_t) c];
+            channel = {};
+            channel.peak = (float) buffer.getMagnitude (c, startSample, numSamples);
+            channel.clipped = channel.peak >= 1.0f;
+
+            if (measureRMS)
+                channel.rms = (float) buffer.getRMSLevel (c, startSample, numSamples);
+        }
+
+        publish (scratch.data(), numChannels);
+    }
+
+    /** @returns a frame's worth of channels that the producer may fill in, and then publish().
+        This may only be used by the producer.
+    */
+    [[nodiscard]] ChannelLevels* getScratchChannels() noexcept { return scratch.data(); }
+
+    //==============================================================================
+    /** Copies the latest frame. This is lock-free, and can be called from any thread.
+
+        @returns the number of channels copied, which is no more than maxNumChannels.
+    */
+    int read (ChannelLevels* destination, int maxNumChannels) const noexcept;
+
+    /** Copies one of the readings of every channel of the latest frame, however many there are.
+        This may allocate if the array doesn't have the room for it.
+    */
+    void read (Array<float>& destination, Level level) const;
+
+    /** @returns a count of the frames published, which readers can compare to tell if there's anything new. */
+    [[nodiscard]] uint32 getNumFramesPublished() const noexcept { return sequenceLock.getNumWrites(); }
+
+    //==============================================================================
+    /** @returns true if the channel clipped since the last call to resetClip(). */
+    [[nodiscard]] bool hasClipped (int channel) const noexcept;
+
+    /** Acknowledges that a channel clipped, clearing the latch. */
+    void resetClip (int channel) noexcept;
+
+private:
+    //==============================================================================
+    /** The published state of a channel, with each field atomic so reading it while racing the producer is harmless. */
+    struct Slot final
+    {
+        std::atomic<float> peak { 0.0f }, rms { 0.0f }, truePeak { 0.0f }, gainReduction { 1.0f };
+        std::atomic<bool> clipped { false }, clipLatch { false };
+    };
+
+    /** The reading side of the sequence lock, handing each channel's slot to a callback.
+
+        The callback may be called more than once for the same channel if a read races
+        the producer, so it must simply overwrite whatever it wrote for that channel before.
+
+        @returns the number of channels read, which is no more than maxNumChannels.
+    */
+    template<typename ChannelReader>
+    int readSlots (int maxNumChannels, ChannelReader&& readChannel) const noexcept
+    {
+        int numChannels = 0;
+
+        sequenceLock.read ([&]
+        {
+            numChannels = jmin (numChannelsPublished.load (std::memory_order_relaxed), maxNumChannels);
+
+            for (int c = 0; c < numChannels; ++c)
+                readChannel (c, slots[(size_t) c]);
+        });
+
+        return numChannels;
+    }
+
+    const int maximumNumChannels;
+    std::unique_ptr<Slot[]> slots;
+    std::vector<ChannelLevels> scratch;
+    std::atomic<int> numChannelsPublished { 0 };
+    SequenceLock sequenceLock;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MeterBus)
+};
@@ -0,0 +1,267 @@
+class ParallelRenderScheduler::Worker final : public Thread
+{
+public:
+    Worker (ParallelRenderScheduler& o, int index) :
+        Thread ("Audio Worker " + String (index)),
+        owner (o),
+        rangeIndex (index)
+    {
+    }
+
+    ~Worker() override
+    {
+        stop();
+    }
+
+    //==============================================================================
+    void stop()
+    {
+        signalThreadShouldExit();
+        event.signal();
+        stopThread (3000);
+    }
+
+    void wakeUpIfAsleep()
+    {
+        if (asleep.load())
+            event.signal();
+    }
+
+    //==============================================================================
+    void run() override
+    {
+        const ScopedNoDenormals snd;
+
+        const auto spinTicks = Time::secondsToHighResolutionTicks (spinTimeoutMicroseconds / 1.0e6);
+        auto lastBlockNumber = owner.blockNumber.load();
+        auto lastActiveTicks = Time::getHighResolutionTicks();
+
+        while (! threadShouldExit())
+        {
+            const auto currentBlockNumber = owner.blockNumber.load();
+
+            if (currentBlockNumber != lastBlockNumber)
+            {
+                lastBlockNumber = currentBlockNumber;
+                owner.performJobs (rangeIndex);
+                lastActiveTicks = Time::getHighResolutionTicks();
+            }
+            else if (Time::getHighResolutionTicks() - lastActiveTicks < spinTicks)
+            {
+                // Any stragglers of the current block get picked up without a wake-up call.
+                Thread::yield();
+            }
+            else
+            {
+                // N.B.: The block number is checked again after advertising that this worker
+                //       is asleep, so a block can't get in between without a wake-up call.
+                asleep = true;
+
+                if (owner.blockNumber.load() == lastBlockNumber)
+                    event.wait (-1);
+
+                asleep = false;
+                lastActiveTicks = Time::getHighResolutionTicks();
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    /** How long a worker keeps spinning after its last job, before blocking until the next block.
+        This is much shorter than any block, so the cores aren't kept busy in between blocks.
+    */
+    static constexpr double spinTimeoutMicroseconds = 50.0;
+
+    ParallelRenderScheduler& owner;
+    const int rangeIndex;
+    WaitableEvent event;
+    std::atomic<bool> asleep { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+};
+
+//==============================================================================
+ParallelRenderScheduler::ParallelRenderScheduler (int numWorkerThreads)
+{
+    // Range 0 is reserved for the thread calling process().
+    for (int i = 0; i < numWorkerThreads; ++i)
+        workers.add (new Worker (*this, i + 1));
+
+    for (int i = 0; i <= numWorkerThreads; ++i)
+        ranges.emplace_back (std::make_unique<Range>());
+
+    for (auto* worker : workers)
+        worker->startThread (Thread::Priority::highest);
+}
+
+ParallelRenderScheduler::~ParallelRenderScheduler()
+{
+    for (auto* worker : workers)
+        worker->stop();
+}
+
+//==============================================================================
+void ParallelRenderScheduler::setProcessors (const Array<AudioProcessor*>& processors)
+{
+    // Nothing can be touching the jobs or ranges while they get shuffled around:
+    for (auto* worker : workers)
+        worker->stop();
+
+    jobs.clear();
+
+    for (auto* processor : processors)
+    {
+        jassert (processor != nullptr);
+
+        auto job = std::make_unique<Job>();
+        job->processor = processor;
+        jobs.emplace_back (std::move (job));
+    }
+
+    assignRanges();
+
+    for (auto* worker : workers)
+        worker->startThread (Thread::Priority::highest);
+}
+
+void ParallelRenderScheduler::assignRanges()
+{
+    const auto numJobs = (int) jobs.size();
+    const auto numRanges = (int) ranges.size();
+
+    for (int i = 0; i < numRanges; ++i)
+    {
+        auto& range = *ranges[(size_t) i];
+        range.begin = (i * numJobs) / numRanges;
+        range.end = ((i + 1) * numJobs) / numRanges;
+        range.next = range.end; // Nothing to do until the next block.
+    }
+}
+
+void ParallelRenderScheduler::prepareToPlay (double newSampleRate, int newMaximumBlockSize, int numChannels)
+{
+    jassert (newSampleRate > 0.0);
+    jassert (newMaximumBlockSize > 0);
+    jassert (numChannels > 0);
+
+    for (auto* worker : workers)
+        worker->stop();
+
+    sampleRate = newSampleRate;
+    maximumBlockSize = newMaximumBlockSize;
+
+    for (auto& job : jobs)
+    {
+        job->buffer.setSize (numChannels, maximumBlockSize);
+        job->buffer.clear();
+        job->midiBuffer.ensureSize (2048);
+        job->lastRenderTimeSeconds = 0.0;
+
+        job->processor->prepareToPlay (sampleRate, maximumBlockSize);
+    }
+
+    for (auto* worker : workers)
+        worker->startThread (Thread::Priority::highest);
+}
+
+//==============================================================================
+juce::AudioBuffer<float>& ParallelRenderScheduler::getBuffer (int index)
+{
+    jassert (isPositiveAndBelow (index, getNumProcessors()));
+    return jobs[(size_t) index]->buffer;
+}
+
+MidiBuffer& ParallelRenderScheduler::getMidiBuffer (int index)
+{
+    jassert (isPositiveAndBelow (index, getNumProcessors()));
+    return jobs[(size_t) index]->midiBuffer;
+}
+
+double ParallelRenderScheduler::getLastRenderTimeSeconds (int index) const
+{
+    if (isPositiveAndBelow (index, getNumProcessors()))
+        return jobs[(size_t) index]->lastRenderTimeSeconds.load (std::memory_order_relaxed);
+
+    return 0.0;
+}
+
+double ParallelRenderScheduler::getLastRenderLoad (int index) const
+{
+    const auto numSamples = blockSize.load (std::memory_order_relaxed);
+    if (numSamples <= 0)
+        return 0.0;
+
+    return getLastRenderTimeSeconds (index) / timeSamplesToSeconds (numSamples, sampleRate);
+}
+
+//==============================================================================
+void ParallelRenderScheduler::process (int numSamples)
+{
+    // You're trying to render more than what was prepared for!
+    jassert (numSamples <= maximumBlockSize);
+    numSamples = jmin (numSamples, maximumBlockSize);
+
+    if (jobs.empty() || numSamples <= 0)
+        return;
+
+    blockSize.store (numSamples);
+    numJobsRemaining.store ((int) jobs.size());
+
+    for (auto& range : ranges)
+        range->next.store (range->begin);
+
+    ++blockNumber;
+
+    for (auto* worker : workers)
+        worker->wakeUpIfAsleep();
+
+    performJobs (0);
+
+    // Join: whatever's left is being rendered by the workers.
+    while (numJobsRemaining.load() > 0)
+        Thread::yield();
+}
+
+void ParallelRenderScheduler::performJobs (int rangeIndex)
+{
+    const auto numRanges = (int) ranges.size();
+
+    // Start with the assigned range, and then steal from the others:
+    for (int i = 0; i < numRanges; ++i)
+    {
+        auto& range = *ranges[(size_t) ((rangeIndex + i) % numRanges)];
+
+        for (;;)
+        {
+            const auto jobIndex = range.next.fetch_add (1);
+            if (jobIndex >= range.end)
+                break;
+
+            runJob (*jobs[(size_t) jobIndex]);
+            --numJobsRemaining;
+        }
+    }
+}
+
+void ParallelRenderScheduler::runJob (Job& job)
+{
+    const auto numSamples = blockSize.load();
+
+    job.blockAlias.setDataToReferTo (job.buffer.getArrayOfWritePointers(), job.buffer.getNumChannels(), numSamples);
+
+    const auto startTicks = Time::getHighResolutionTicks();
+    processSafely (*job.processor, job.blockAlias, job.midiBuffer);
+    const auto elapsedTicks = Time::getHighResolutionTicks() - startTicks;
+
+    job.lastRenderTimeSeconds.store (Time::highResolutionTicksToSeconds (elapsedTicks), std::memory_order_relaxed);
+}
+
+void ParallelRenderScheduler::mixInto (juce::AudioBuffer<float>& destination, int numSamples) const
+{
+    numSamples = jmin (numSamples, destination.getNumSamples(), maximumBlockSize);
+
+    for (const auto& job : jobs)
+        for (int i = jmin (destination.getNumChannels(), job->buffer.getNumChannels()); --i >= 0;)
+            destination.addFrom (i, 0, job->buffer, i, 0, numSamples);
+}
@@ -0,0 +1,138 @@
+/** Renders a set of independent processors (eg: one EffectProcessorChain per deck
+    and per send) in parallel, on a pool of pre-spawned audio worker threads.
+
+    Each processor gets its own buffer that you fill before calling process(),
+    and read back from (or sum with mixInto()) afterwards. The thread calling
+    process() takes part in rendering, and only returns once every processor
+    has finished; that is, it joins before your mix bus.
+
+    The processors are split into contiguous ranges, one per thread, and any thread
+    that runs out of work steals the remaining processors from the other ranges.
+    All of this is done with atomics only, so there's no allocating nor locking
+    when rendering.
+
+    The workers spin (politely yielding) for a few microseconds after their last job,
+    and then block until process() publishes the next block and wakes them up,
+    so they don't keep any cores busy in between blocks.
+
+    @code
+        ParallelRenderScheduler scheduler;
+        scheduler.setProcessors ({ deckA.get(), deckB.get(), send.get() });
+        scheduler.prepareToPlay (sampleRate, blockSize, 2);
+
+        // And then, on the audio thread:
+        for (int i = 0; i < scheduler.getNumProcessors(); ++i)
+            fillWithDeckAudio (i, scheduler.getBuffer (i));
+
+        scheduler.process (numSamples);
+        scheduler.mixInto (mixBus, numSamples);
+    @endcode
+
+    @see EffectProcessorChain, InternalProcessor
+*/
+class ParallelRenderScheduler final
+{
+public:
+    /** Constructor.
+
+        @param numWorkerThreads The number of threads to spawn, besides the one calling process().
+                                By default, this will try to use every remaining CPU core.
+    */
+    ParallelRenderScheduler (int numWorkerThreads = jmax (0, SystemStats::getNumCpus() - 1));
+
+    /** Destructor. */
+    ~ParallelRenderScheduler();
+
+    //==============================================================================
+    /** Changes the set of processors to render.
+
+        The processors are not owned here, and must outlive this scheduler
+        or at least their spot in it.
+
+        @warning This must never be called while process() is being called!
+    */
+    void setProcessors (const Array<AudioProcessor*>& processors);
+
+    /** @returns the number of processors being rendered. */
+    [[nodiscard]] int getNumProcessors() const noexcept { return (int) jobs.size(); }
+
+    /** @returns the number of worker threads, excluding the one calling process(). */
+    [[nodiscard]] int getNumWorkerThreads() const noexcept { return workers.size(); }
+
+    /** Allocates every processor's buffer, and prepares the processors themselves.
+
+        @warning This must never be called while process() is being called!
+    */
+    void prepareToPlay (double sampleRate, int maximumBlockSize, int numChannels);
+
+    //==============================================================================
+    /** @returns the buffer of the processor at the specified index.
+
+        Fill this prior to calling process(), and read it back afterwards.
+    */
+    [[nodiscard]] juce::AudioBuffer<float>& getBuffer (int index);
+
+    /** @returns the MIDI buffer of the processor at the specified index. */
+    [[nodiscard]] MidiBuffer& getMidiBuffer (int index);
+
+    /** Renders every processor, in parallel, returning once they have all finished.
+
+        @param numSamples The number of samples to render, which can't be greater
+                          than the maximum block size provided to prepareToPlay().
+    */
+    void process (int numSamples);
+
+    /** Sums every processor's last rendered block into the destination buffer. */
+    void mixInto (juce::AudioBuffer<float>& destination, int numSamples) const;
+
+    //==============================================================================
+    /** @returns the time it took, in seconds, to render the last block
+        of the processor at the specified index.
+    */
+    [[nodiscard]] double getLastRenderTimeSeconds (int index) const;
+
+    /** @returns the proportion of the last block's duration that
+        the processor at the specified index took to render.
+
+        For example; 0.5 means the processor took half of the available time.
+    */
+    [[nodiscard]] double getLastRenderLoad (int index) const;
+
+private:
+    //==============================================================================
+    struct Job final
+    {
+        AudioProcessor* processor = nullptr;
+        juce::AudioBuffer<float> buffer, blockAlias;
+        MidiBuffer midiBuffer;
+        std::atomic<double> lastRenderTimeSeconds { 0.0 };
+    };
+
+    /** A contiguous range of jobs, initially assigned to a single thread. */
+    struct Range final
+    {
+        int begin = 0, end = 0;
+        std::atomic<int> next { 0 };
+    };
+
+    class Worker;
+
+    //==============================================================================
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::vector<std::unique_ptr<Range>> ranges;
+    OwnedArray<Worker> workers;
+
+    std::atomic<uint32> blockNumber { 0 };
+    std::atomic<int> numJobsRemaining { 0 };
+    std::atomic<int> blockSize { 0 };
+    double sampleRate = 44100.0;
+    int maximumBlockSize = 0;
+
+    //==============================================================================
+    void assignRanges();
+    void performJobs (int rangeIndex);
+    void runJob (Job&);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelRenderScheduler)
+};
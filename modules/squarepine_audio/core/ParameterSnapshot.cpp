@@ -0,0 +1,77 @@
+ParameterSnapshot::~ParameterSnapshot()
+{
+    detach();
+}
+
+//==============================================================================
+void ParameterSnapshot::attach (AudioProcessor& processor)
+{
+    const auto& processorParameters = processor.getParameters();
+
+    const auto isAlreadyAttached = parameters.size() == (size_t) processorParameters.size()
+                                && std::equal (parameters.begin(), parameters.end(), processorParameters.begin());
+
+    if (! isAlreadyAttached)
+    {
+        detach();
+
+        const auto numParameters = (size_t) processorParameters.size();
+
+        parameters.assign (processorParameters.begin(), processorParameters.end());
+        rangedParameters.resize (numParameters);
+        dirty = std::make_unique<std::atomic<bool>[]> (numParameters);
+        values.assign (numParameters, 0.0f);
+        changedIndices.clear();
+        changedIndices.reserve (numParameters);
+
+        for (size_t i = 0; i < numParameters; ++i)
+        {
+            auto* parameter = parameters[i];
+            rangedParameters[i] = dynamic_cast<RangedAudioParameter*> (parameter);
+            parameter->addListener (this);
+
+            values[i] = readValue (i);
+
+            // Nobody was listening to any changes made before now (eg: by restoring a preset),
+            // so anything that's been moved away from its default gets reported on the next update:
+            const auto hasChanged = ! approximatelyEqual (parameter->getValue(), parameter->getDefaultValue());
+            dirty[i].store (hasChanged, std::memory_order_relaxed);
+        }
+
+        changeCount.fetch_add (1, std::memory_order_release);
+    }
+}
+
+void ParameterSnapshot::detach()
+{
+    for (auto* parameter : parameters)
+        parameter->removeListener (this);
+
+    parameters.clear();
+    rangedParameters.clear();
+    values.clear();
+    changedIndices.clear();
+    dirty.reset();
+}
+
+//==============================================================================
+float ParameterSnapshot::readValue (size_t index) const noexcept
+{
+    const auto normalisedValue = parameters[index]->getValue();
+
+    if (auto* ranged = rangedParameters[index])
+        return ranged->convertFrom0to1 (normalisedValue);
+
+    return normalisedValue;
+}
+
+void ParameterSnapshot::parameterValueChanged (int parameterIndex, float)
+{
+    // N.B.: The value that's passed in isn't consistently normalised or denormalised,
+    //       depending on how the parameter was changed, so it's read back in update() instead.
+    if (isPositiveAndBelow (parameterIndex, size()))
+    {
+        dirty[(size_t) parameterIndex].store (true, std::memory_order_release);
+        changeCount.fetch_add (1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,142 @@
+/** A lock-free, per-block copy of every parameter of a processor.
+
+    Hosts and UIs change parameters from whichever thread they like, so reading
+    several of them over the course of a block, or reacting to a change while the
+    audio thread is midway through using the state it affects, is a race. Rather than
+    guarding all of that with the processor's callback lock, this listens to every
+    parameter and flags the ones that change, without ever locking nor allocating.
+
+    The audio thread then calls update() at the top of each block: any parameters that
+    changed since the last block are copied into the snapshot, and handed to a callback
+    so the processor can react to them, all on the audio thread. Everything read from
+    the snapshot for the rest of the block is coherent; nothing can change underneath it.
+
+    The values are kept denormalised (ie: in the parameter's own range),
+    which matches what AudioParameterFloat::get() and AudioParameterBool::get() return.
+
+    @code
+        // In prepareToPlay(), before any processing:
+        snapshot.attach (*this);
+
+        // At the top of processBlock():
+        snapshot.update ([&] (int parameterIndex, float newValue) { ... });
+
+        if (snapshot.getBool (fxOnParam))
+            ...
+    @endcode
+
+    @see InternalProcessor::updateParameterSnapshot
+*/
+class ParameterSnapshot final : private AudioProcessorParameter::Listener
+{
+public:
+    /** Constructor. */
+    ParameterSnapshot() = default;
+
+    /** Destructor. */
+    ~ParameterSnapshot() override;
+
+    //==============================================================================
+    /** Starts listening to every parameter of a processor, and copies their current values.
+
+        Seeing as any changes made before this couldn't be heard, every parameter that isn't at its
+        default value is flagged as changed, so the next call to update() reports it.
+        Attaching to the same processor again does nothing, so this is safe to call on every prepare.
+
+        This allocates when the parameters differ from the ones last attached, so it must not
+        be called while the processor is processing; prepareToPlay() is the place for it.
+    */
+    void attach (AudioProcessor& processor);
+
+    /** Stops listening to the parameters, and forgets about them. */
+    void detach();
+
+    /** @returns the number of parameters in the snapshot. */
+    [[nodiscard]] int size() const noexcept { return (int) parameters.size(); }
+
+    //==============================================================================
+    /** Copies any parameters that changed since the last call into the snapshot.
+        This is lock-free, and is meant to be called from the audio thread at the top of a block.
+
+        @param onChanged    Called with the index and the new (denormalised) value
+                            of every parameter that changed, on the calling thread,
+                            once the whole snapshot is up to date.
+
+        @returns true if any parameter changed.
+    */
+    template<typename ChangeCallback>
+    bool update (ChangeCallback&& onChanged)
+    {
+        const auto numChanges = changeCount.load (std::memory_order_acquire);
+
+        if (numChanges == lastChangeCount)
+            return false;
+
+        lastChangeCount = numChanges;
+        changedIndices.clear();
+
+        for (size_t i = 0; i < parameters.size(); ++i)
+        {
+            if (dirty[i].exchange (false, std::memory_order_acquire))
+            {
+                values[i] = readValue (i);
+                changedIndices.push_back ((int) i);
+            }
+        }
+
+        // The whole snapshot is brought up to date before reporting anything,
+        // so the callback can read any of the other parameters from it too:
+        for (auto index : changedIndices)
+            onChanged (index, values[(size_t) index]);
+
+        return true;
+    }
+
+    /** Copies any parameters that changed since the last call into the snapshot. */
+    bool update() { return update ([] (int, float) {}); }
+
+    //==============================================================================
+    /** @returns the snapshot of a parameter, by its index in the processor. */
+    [[nodiscard]] float get (int parameterIndex) const noexcept
+    {
+        if (isPositiveAndBelow (parameterIndex, size()))
+            return values[(size_t) parameterIndex];
+
+        jassertfalse; // Was the snapshot attached?
+        return 0.0f;
+    }
+
+    /** @returns the snapshot of a parameter of the attached processor. */
+    [[nodiscard]] float get (const AudioProcessorParameter* parameter) const noexcept
+    {
+        jassert (parameter != nullptr);
+        return parameter != nullptr ? get (parameter->getParameterIndex()) : 0.0f;
+    }
+
+    /** @returns the snapshot of a boolean parameter of the attached processor. */
+    [[nodiscard]] bool getBool (const AudioProcessorParameter* parameter) const noexcept
+    {
+        return get (parameter) >= 0.5f;
+    }
+
+private:
+    //==============================================================================
+    std::vector<AudioProcessorParameter*> parameters;
+    std::vector<RangedAudioParameter*> rangedParameters;   // Null for any that aren't ranged.
+    std::unique_ptr<std::atomic<bool>[]> dirty;
+    std::vector<float> values;
+    std::vector<int> changedIndices;    // Reserved up front, so update() never allocates.
+    std::atomic<uint32> changeCount { 0 };
+    uint32 lastChangeCount = 0;
+
+    //==============================================================================
+    float readValue (size_t index) const noexcept;
+
+    /** @internal */
+    void parameterValueChanged (int parameterIndex, float) override;
+    /** @internal */
+    void parameterGestureChanged (int, bool) override {}
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterSnapshot)
+};
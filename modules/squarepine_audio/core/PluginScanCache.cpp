@@ -0,0 +1,444 @@
+namespace PluginScanCacheHelpers
+{
+    /** The index is laid out as a header, then a table of fixed-size records sorted
+        by the hash of their keys, then each record's data: its key as null-terminated
+        UTF-8, followed by its descriptions. Everything is little-endian.
+    */
+    enum
+    {
+        magic           = 0x43505053, // 'SPPC'
+        version         = 1,
+        headerSize      = 16,   // Magic, version, number of records, reserved.
+        recordSize      = 48    // Key hash, size, modification time, content hash, data offset, data size.
+    };
+
+    /** How much of the start and of the end of a file gets hashed.
+        Bundles can hold a lot of files, so only a little of each of those is.
+    */
+    constexpr int fileSampleSize = 64 * 1024;
+    constexpr int bundleFileSampleSize = 4 * 1024;
+
+    //==============================================================================
+    /** 64-bit FNV-1a: not cryptographic, but far quicker than SHA1 and plenty to notice a change. */
+    static uint64 hash (const void* data, size_t numBytes, uint64 seed = 0xcbf29ce484222325ull) noexcept
+    {
+        auto h = seed;
+
+        for (auto* byte = static_cast<const uint8*> (data); numBytes > 0; --numBytes, ++byte)
+        {
+            h ^= *byte;
+            h *= 0x100000001b3ull;
+        }
+
+        return h;
+    }
+
+    static uint64 hash (const String& text, uint64 seed = 0xcbf29ce484222325ull) noexcept
+    {
+        return hash (text.toRawUTF8(), text.getNumBytesAsUTF8(), seed);
+    }
+
+    static uint64 hash (int64 value, uint64 seed) noexcept
+    {
+        uint8 bytes[8];
+
+        for (size_t i = 0; i < sizeof (bytes); ++i)
+            bytes[i] = (uint8) ((uint64) value >> (i * 8));
+
+        return hash (bytes, sizeof (bytes), seed);
+    }
+
+    /** Hashes the start and the end of a file, which is where executables keep their headers and signatures. */
+    static uint64 hashFileSample (const File& file, int64 fileSize, int sampleSize, uint64 seed)
+    {
+        FileInputStream in (file);
+
+        if (! in.openedOk())
+            return seed;
+
+        HeapBlock<char> buffer ((size_t) sampleSize);
+
+        auto h = hash (fileSize, seed);
+        h = hash (buffer, (size_t) jmax (0, in.read (buffer, sampleSize)), h);
+
+        if (fileSize > (int64) sampleSize * 2 && in.setPosition (fileSize - sampleSize))
+            h = hash (buffer, (size_t) jmax (0, in.read (buffer, sampleSize)), h);
+
+        return h;
+    }
+}
+
+//==============================================================================
+PluginScanCache::Fingerprint PluginScanCache::Fingerprint::create (const String& fileOrIdentifier)
+{
+    using namespace PluginScanCacheHelpers;
+
+    Fingerprint fingerprint;
+
+    if (! File::isAbsolutePath (fileOrIdentifier))
+    {
+        fingerprint.contentHash = hash (fileOrIdentifier);
+        return fingerprint;
+    }
+
+    const File file (fileOrIdentifier);
+
+    if (file.isDirectory())
+    {
+        // Sorted, seeing as the order the files are found in isn't guaranteed:
+        auto children = file.findChildFiles (File::findFiles, true);
+        children.sort();
+
+        auto h = hash (fileOrIdentifier);
+
+        for (const auto& child : children)
+        {
+            const auto childSize = child.getSize();
+
+            fingerprint.size += childSize;
+            fingerprint.modificationTime = jmax (fingerprint.modificationTime, child.getLastModificationTime().toMilliseconds());
+
+            h = hash (child.getRelativePathFrom (file), h);
+            h = hashFileSample (child, childSize, bundleFileSampleSize, h);
+        }
+
+        fingerprint.contentHash = h;
+    }
+    else if (file.existsAsFile())
+    {
+        fingerprint.size = file.getSize();
+        fingerprint.modificationTime = file.getLastModificationTime().toMilliseconds();
+        fingerprint.contentHash = hashFileSample (file, fingerprint.size, fileSampleSize, hash (fileOrIdentifier));
+    }
+    else
+    {
+        fingerprint.size = -1;
+    }
+
+    return fingerprint;
+}
+
+//==============================================================================
+/** A read-only view of an index file, straight out of a memory-mapped copy of it. */
+class PluginScanCache::MappedIndex final
+{
+public:
+    explicit MappedIndex (const File& file) :
+        mappedFile (file, MemoryMappedFile::readOnly)
+    {
+        using namespace PluginScanCacheHelpers;
+
+        data = static_cast<const uint8*> (mappedFile.getData());
+        dataSize = (uint64) mappedFile.getSize();
+
+        if (data == nullptr
+            || dataSize < (uint64) headerSize
+            || readUInt32 (0) != (uint32) magic
+            || readUInt32 (4) != (uint32) version)
+            return;
+
+        const auto numRecordsInFile = readUInt32 (8);
+
+        if ((uint64) headerSize + (uint64) numRecordsInFile * (uint64) recordSize <= dataSize)
+            numRecords = (int) numRecordsInFile;
+    }
+
+    //==============================================================================
+    /** @returns false if the file isn't an index, in which case it has no records. */
+    bool isValid() const noexcept { return numRecords >= 0; }
+
+    /** @returns the number of records. */
+    int getNumRecords() const noexcept { return jmax (0, numRecords); }
+
+    /** A record's fields, with its data checked to be within the file. */
+    struct Record final
+    {
+        uint64 keyHash = 0;
+        Fingerprint fingerprint;
+        String key;
+        const uint8* descriptions = nullptr;
+        size_t descriptionsSize = 0;
+    };
+
+    bool getRecord (int index, Record& record) const
+    {
+        using namespace PluginScanCacheHelpers;
+
+        if (! isPositiveAndBelow (index, numRecords))
+            return false;
+
+        const auto offset = (uint64) headerSize + (uint64) index * (uint64) recordSize;
+
+        record.keyHash                      = readUInt64 (offset);
+        record.fingerprint.size             = (int64) readUInt64 (offset + 8);
+        record.fingerprint.modificationTime = (int64) readUInt64 (offset + 16);
+        record.fingerprint.contentHash      = readUInt64 (offset + 24);
+
+        const auto recordDataOffset = readUInt64 (offset + 32);
+        const auto recordDataSize = readUInt64 (offset + 40);
+
+        if (recordDataOffset > dataSize || recordDataSize > dataSize - recordDataOffset)
+            return false;
+
+        const auto* recordData = data + recordDataOffset;
+        const auto* keyEnd = static_cast<const uint8*> (std::memchr (recordData, 0, (size_t) recordDataSize));
+
+        if (keyEnd == nullptr)
+            return false;
+
+        record.key = String::fromUTF8 (reinterpret_cast<const char*> (recordData), (int) (keyEnd - recordData));
+        record.descriptions = keyEnd + 1;
+        record.descriptionsSize = (size_t) (recordData + recordDataSize - record.descriptions);
+        return true;
+    }
+
+    /** @returns the index of the record with the key, or -1. */
+    int indexOf (const String& key) const
+    {
+        const auto keyHash = PluginScanCacheHelpers::hash (key);
+
+        // Binary search for the first record with the key's hash...
+        int low = 0, high = getNumRecords();
+
+        while (low < high)
+        {
+            const auto middle = low + (high - low) / 2;
+
+            if (readKeyHash (middle) < keyHash)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        // ... and then check each of them, in the unlikely case that several keys share it.
+        for (int i = low; i < getNumRecords() && readKeyHash (i) == keyHash; ++i)
+        {
+            Record record;
+
+            if (getRecord (i, record) && record.key == key)
+                return i;
+        }
+
+        return -1;
+    }
+
+private:
+    MemoryMappedFile mappedFile;
+    const uint8* data = nullptr;
+    uint64 dataSize = 0;
+    int numRecords = -1;
+
+    uint32 readUInt32 (uint64 offset) const noexcept { return ByteOrder::littleEndianInt (data + offset); }
+    uint64 readUInt64 (uint64 offset) const noexcept { return ByteOrder::littleEndianInt64 (data + offset); }
+
+    uint64 readKeyHash (int index) const noexcept
+    {
+        using namespace PluginScanCacheHelpers;
+        return readUInt64 ((uint64) headerSize + (uint64) index * (uint64) recordSize);
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MappedIndex)
+};
+
+//==============================================================================
+PluginScanCache::PluginScanCache (const File& file) :
+    indexFile (file)
+{
+    openIndex();
+}
+
+PluginScanCache::~PluginScanCache()
+{
+}
+
+//==============================================================================
+String PluginScanCache::createKey (const String& formatName, const String& fileOrIdentifier)
+{
+    return formatName + "\n" + fileOrIdentifier;
+}
+
+void PluginScanCache::openIndex()
+{
+    mappedIndex.reset();
+
+    if (indexFile.existsAsFile())
+    {
+        auto index = std::make_unique<MappedIndex> (indexFile);
+
+        if (index->isValid())
+            mappedIndex = std::move (index);
+    }
+}
+
+//==============================================================================
+bool PluginScanCache::find (const String& formatName, const String& fileOrIdentifier,
+                            const Fingerprint& fingerprint, OwnedArray<PluginDescription>& results) const
+{
+    const auto key = createKey (formatName, fileOrIdentifier);
+
+    const ScopedLock sl (lock);
+
+    const auto pending = pendingEntries.find (key);
+
+    if (pending != pendingEntries.end())
+    {
+        if (pending->second.fingerprint != fingerprint)
+            return false;
+
+        MemoryInputStream in (pending->second.descriptions, false);
+        return PluginScanProtocol::readDescriptions (in, results);
+    }
+
+    if (mappedIndex != nullptr)
+    {
+        MappedIndex::Record record;
+
+        if (mappedIndex->getRecord (mappedIndex->indexOf (key), record)
+            && record.fingerprint == fingerprint)
+        {
+            MemoryInputStream in (record.descriptions, record.descriptionsSize, false);
+            return PluginScanProtocol::readDescriptions (in, results);
+        }
+    }
+
+    return false;
+}
+
+void PluginScanCache::store (const String& formatName, const String& fileOrIdentifier,
+                             const Fingerprint& fingerprint, const OwnedArray<PluginDescription>& found)
+{
+    Entry entry;
+    entry.fingerprint = fingerprint;
+
+    {
+        MemoryOutputStream out (entry.descriptions, false);
+        PluginScanProtocol::writeDescriptions (out, found);
+    }
+
+    const auto key = createKey (formatName, fileOrIdentifier);
+
+    const ScopedLock sl (lock);
+    pendingEntries[key] = std::move (entry);
+    isDirty = true;
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+    mappedIndex.reset();
+    pendingEntries.clear();
+    isDirty = true;
+}
+
+int PluginScanCache::getNumEntries() const
+{
+    const ScopedLock sl (lock);
+
+    if (mappedIndex == nullptr)
+        return (int) pendingEntries.size();
+
+    auto numEntries = mappedIndex->getNumRecords();
+
+    for (const auto& pending : pendingEntries)
+        if (mappedIndex->indexOf (pending.first) < 0)
+            ++numEntries;
+
+    return numEntries;
+}
+
+//==============================================================================
+bool PluginScanCache::save()
+{
+    using namespace PluginScanCacheHelpers;
+
+    const ScopedLock sl (lock);
+
+    if (! isDirty)
+        return true;
+
+    // Everything gets gathered up in memory, so that the index can be unmapped before it's overwritten:
+    auto entries = pendingEntries;
+
+    if (mappedIndex != nullptr)
+    {
+        for (int i = 0; i < mappedIndex->getNumRecords(); ++i)
+        {
+            MappedIndex::Record record;
+
+            if (mappedIndex->getRecord (i, record) && entries.find (record.key) == entries.end())
+            {
+                auto& entry = entries[record.key];
+                entry.fingerprint = record.fingerprint;
+                entry.descriptions = MemoryBlock (record.descriptions, record.descriptionsSize);
+            }
+        }
+    }
+
+    std::vector<std::pair<uint64, decltype (entries)::const_iterator>> sorted;
+    sorted.reserve (entries.size());
+
+    for (auto it = entries.cbegin(); it != entries.cend(); ++it)
+        sorted.emplace_back (hash (it->first), it);
+
+    std::sort (sorted.begin(), sorted.end(),
+               [] (const auto& a, const auto& b) { return a.first < b.first; });
+
+    mappedIndex.reset();
+    indexFile.getParentDirectory().createDirectory();
+
+    TemporaryFile tempFile (indexFile);
+    bool wroteOk = false;
+
+    {
+        FileOutputStream out (tempFile.getFile());
+
+        if (out.openedOk())
+        {
+            out.writeInt ((int) magic);
+            out.writeInt ((int) version);
+            out.writeInt ((int) sorted.size());
+            out.writeInt (0);
+
+            auto dataOffset = (uint64) headerSize + (uint64) sorted.size() * (uint64) recordSize;
+
+            for (const auto& [keyHash, it] : sorted)
+            {
+                const auto& entry = it->second;
+                const auto dataSize = (uint64) it->first.getNumBytesAsUTF8() + 1 + (uint64) entry.descriptions.getSize();
+
+                out.writeInt64 ((int64) keyHash);
+                out.writeInt64 (entry.fingerprint.size);
+                out.writeInt64 (entry.fingerprint.modificationTime);
+                out.writeInt64 ((int64) entry.fingerprint.contentHash);
+                out.writeInt64 ((int64) dataOffset);
+                out.writeInt64 ((int64) dataSize);
+
+                dataOffset += dataSize;
+            }
+
+            for (const auto& [keyHash, it] : sorted)
+            {
+                ignoreUnused (keyHash);
+
+                out.write (it->first.toRawUTF8(), it->first.getNumBytesAsUTF8() + 1);
+                out.write (it->second.descriptions.getData(), it->second.descriptions.getSize());
+            }
+
+            out.flush();
+            wroteOk = out.getStatus().wasOk();
+        }
+    }
+
+    if (wroteOk && tempFile.overwriteTargetFileWithTemporary())
+    {
+        pendingEntries.clear();
+        isDirty = false;
+    }
+    else
+    {
+        wroteOk = false;
+    }
+
+    openIndex();
+    return wroteOk;
+}
@@ -0,0 +1,105 @@
+/** An on-disk cache of plugin scan results, so that plugins whose files haven't changed needn't be rescanned.
+
+    Each result is keyed by the plugin format and file (or identifier), and stored
+    alongside a Fingerprint of the file: its size, its modification time, and a fast
+    hash of a sample of its content. A cached result is only used when the file's
+    current fingerprint still matches, so new and changed plugins always get rescanned.
+
+    The cache is stored as a compact binary index, which is memory-mapped when
+    the cache is opened; looking something up only decodes the entry that's needed,
+    so opening even a large cache costs next to nothing. New results are kept in memory
+    until save() is called, which rewrites the index with everything merged together.
+
+    This is thread safe.
+
+    @see ChildProcessPluginScanner
+*/
+class PluginScanCache final
+{
+public:
+    //==============================================================================
+    /** What a plugin file looked like when it was scanned. */
+    struct Fingerprint final
+    {
+        /** Takes a fingerprint of a plugin.
+
+            Plugin bundles (ie: directories) fold in every file inside them.
+            Identifiers that aren't files (eg: Audio Unit identifiers) only hash the identifier,
+            and so stay cached until the cache is cleared.
+        */
+        static Fingerprint create (const String& fileOrIdentifier);
+
+        bool operator== (const Fingerprint& other) const noexcept
+        {
+            return size == other.size
+                && modificationTime == other.modificationTime
+                && contentHash == other.contentHash;
+        }
+
+        bool operator!= (const Fingerprint& other) const noexcept { return ! operator== (other); }
+
+        int64 size = 0;                 //< In bytes, or -1 if the file doesn't exist.
+        int64 modificationTime = 0;     //< In milliseconds since the epoch.
+        uint64 contentHash = 0;         //< A hash of the start and end of the content.
+    };
+
+    //==============================================================================
+    /** Opens a cache, memory-mapping the index file if there is one.
+        An index that's missing, or isn't valid, leaves the cache empty.
+    */
+    explicit PluginScanCache (const File& indexFile);
+
+    /** Destructor. This doesn't save anything; see save(). */
+    ~PluginScanCache();
+
+    //==============================================================================
+    /** Looks up the results of a previous scan.
+
+        @returns true, adding any plugins found back then to the results,
+                 if the plugin was scanned before and its fingerprint still matches.
+    */
+    bool find (const String& formatName, const String& fileOrIdentifier,
+               const Fingerprint& fingerprint, OwnedArray<PluginDescription>& results) const;
+
+    /** Keeps the results of a scan, replacing any previous ones for the same plugin. */
+    void store (const String& formatName, const String& fileOrIdentifier,
+                const Fingerprint& fingerprint, const OwnedArray<PluginDescription>& found);
+
+    /** Forgets about every plugin. */
+    void clear();
+
+    /** @returns the number of plugins in the cache. */
+    [[nodiscard]] int getNumEntries() const;
+
+    //==============================================================================
+    /** Writes the index, if anything changed since it was opened or last saved.
+        @returns false if the index couldn't be written.
+    */
+    bool save();
+
+    /** @returns the file the index is kept in. */
+    [[nodiscard]] const File& getIndexFile() const noexcept { return indexFile; }
+
+private:
+    //==============================================================================
+    struct Entry final
+    {
+        Fingerprint fingerprint;
+        MemoryBlock descriptions;   // As written by PluginScanProtocol::writeDescriptions().
+    };
+
+    class MappedIndex;
+
+    const File indexFile;
+    CriticalSection lock;
+    std::unique_ptr<MappedIndex> mappedIndex;
+    std::map<String, Entry> pendingEntries;   // Newer than anything in the mapped index.
+    bool isDirty = false;
+
+    //==============================================================================
+    static String createKey (const String& formatName, const String& fileOrIdentifier);
+    void openIndex();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
@@ -0,0 +1,604 @@
+namespace PluginScanHelpers
+{
+    static const char* const workerCommandLineID = "squarepinePluginScanWorker";
+
+    /** How often a waiting thread checks whether it's been asked to stop. */
+    static constexpr int cancellationPollMs = 50;
+
+    static bool shouldCancelScan()
+    {
+        if (auto* job = ThreadPoolJob::getCurrentThreadPoolJob())
+            if (job->shouldExit())
+                return true;
+
+        if (auto* thread = Thread::getCurrentThread())
+            return thread->threadShouldExit();
+
+        return false;
+    }
+}
+
+//==============================================================================
+namespace PluginScanProtocol
+{
+    enum
+    {
+        protocolVersion     = 1,
+        scanRequestType     = 1,
+        scanResultType      = 2,
+        endMarker           = 0x53505343, // 'SPSC', to catch any truncated messages.
+        maxNumDescriptions  = 4096
+    };
+
+    static void writeHeader (OutputStream& out, int type, int requestID)
+    {
+        out.writeInt (protocolVersion);
+        out.writeInt (type);
+        out.writeInt (requestID);
+    }
+
+    static bool readHeader (InputStream& in, int expectedType, int& requestID)
+    {
+        if (in.readInt() != protocolVersion || in.readInt() != expectedType)
+            return false;
+
+        requestID = in.readInt();
+        return true;
+    }
+
+    static void writeDescription (OutputStream& out, const PluginDescription& pd)
+    {
+        out.writeString (pd.name);
+        out.writeString (pd.descriptiveName);
+        out.writeString (pd.pluginFormatName);
+        out.writeString (pd.category);
+        out.writeString (pd.manufacturerName);
+        out.writeString (pd.version);
+        out.writeString (pd.fileOrIdentifier);
+        out.writeInt64 (pd.lastFileModTime.toMilliseconds());
+        out.writeInt64 (pd.lastInfoUpdateTime.toMilliseconds());
+        out.writeInt (pd.deprecatedUid);
+        out.writeInt (pd.uniqueId);
+        out.writeBool (pd.isInstrument);
+        out.writeInt (pd.numInputChannels);
+        out.writeInt (pd.numOutputChannels);
+        out.writeBool (pd.hasSharedContainer);
+    }
+
+    static void readDescription (InputStream& in, PluginDescription& pd)
+    {
+        pd.name                 = in.readString();
+        pd.descriptiveName      = in.readString();
+        pd.pluginFormatName     = in.readString();
+        pd.category             = in.readString();
+        pd.manufacturerName     = in.readString();
+        pd.version              = in.readString();
+        pd.fileOrIdentifier     = in.readString();
+        pd.lastFileModTime      = Time (in.readInt64());
+        pd.lastInfoUpdateTime   = Time (in.readInt64());
+        pd.deprecatedUid        = in.readInt();
+        pd.uniqueId             = in.readInt();
+        pd.isInstrument         = in.readBool();
+        pd.numInputChannels     = in.readInt();
+        pd.numOutputChannels    = in.readInt();
+        pd.hasSharedContainer   = in.readBool();
+    }
+
+    //==============================================================================
+    MemoryBlock createScanRequest (int requestID, const String& formatName, const String& fileOrIdentifier)
+    {
+        MemoryOutputStream out;
+        writeHeader (out, scanRequestType, requestID);
+        out.writeString (formatName);
+        out.writeString (fileOrIdentifier);
+        out.writeInt (endMarker);
+
+        return out.getMemoryBlock();
+    }
+
+    bool readScanRequest (const MemoryBlock& message, int& requestID, String& formatName, String& fileOrIdentifier)
+    {
+        MemoryInputStream in (message, false);
+
+        if (! readHeader (in, scanRequestType, requestID))
+            return false;
+
+        formatName = in.readString();
+        fileOrIdentifier = in.readString();
+
+        return in.readInt() == endMarker;
+    }
+
+    MemoryBlock createScanResult (int requestID, const OwnedArray<PluginDescription>& found)
+    {
+        MemoryOutputStream out;
+        writeHeader (out, scanResultType, requestID);
+        writeDescriptions (out, found);
+        out.writeInt (endMarker);
+
+        return out.getMemoryBlock();
+    }
+
+    bool readScanResult (const MemoryBlock& message, int& requestID, OwnedArray<PluginDescription>& found)
+    {
+        MemoryInputStream in (message, false);
+
+        if (! readHeader (in, scanResultType, requestID))
+            return false;
+
+        OwnedArray<PluginDescription> descriptions;
+
+        if (! readDescriptions (in, descriptions) || in.readInt() != endMarker)
+            return false;
+
+        found.addArray (descriptions);
+        descriptions.clear (false);
+        return true;
+    }
+
+    //==============================================================================
+    void writeDescriptions (OutputStream& out, const OwnedArray<PluginDescription>& descriptions)
+    {
+        const auto numDescriptions = jmin (descriptions.size(), (int) maxNumDescriptions);
+        out.writeInt (numDescriptions);
+
+        for (int i = 0; i < numDescriptions; ++i)
+            writeDescription (out, *descriptions.getUnchecked (i));
+    }
+
+    bool readDescriptions (InputStream& in, OwnedArray<PluginDescription>& descriptions)
+    {
+        const auto numDescriptions = in.readInt();
+
+        if (! isPositiveAndNotGreaterThan (numDescriptions, (int) maxNumDescriptions))
+            return false;
+
+        OwnedArray<PluginDescription> results;
+
+        for (int i = 0; i < numDescriptions; ++i)
+        {
+            if (in.isExhausted())
+                return false;
+
+            readDescription (in, *results.add (new PluginDescription()));
+        }
+
+        descriptions.addArray (results);
+        results.clear (false);
+        return true;
+    }
+}
+
+//==============================================================================
+/** The default connection, which runs the worker as a child process. */
+class PluginScanService::ChildProcessConnection final : public WorkerConnection,
+                                                        private ChildProcessCoordinator
+{
+public:
+    explicit ChildProcessConnection (const Options& o) :
+        options (o)
+    {
+    }
+
+    ~ChildProcessConnection() override
+    {
+        killWorkerProcess();
+    }
+
+    bool launch() override
+    {
+        // N.B.: The worker's output isn't wanted; leaving it to fill up a pipe would eventually block the worker.
+        return launchWorkerProcess (options.executable, PluginScanHelpers::workerCommandLineID, options.pingTimeoutMs, 0);
+    }
+
+    void kill() override                            { killWorkerProcess(); }
+    bool send (const MemoryBlock& message) override { return sendMessageToWorker (message); }
+
+private:
+    const Options& options;
+
+    void handleMessageFromWorker (const MemoryBlock& message) override
+    {
+        if (onMessage != nullptr)
+            onMessage (message);
+    }
+
+    void handleConnectionLost() override
+    {
+        if (onConnectionLost != nullptr)
+            onConnectionLost();
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChildProcessConnection)
+};
+
+//==============================================================================
+/** Looks after a single worker, from the service's side of the pipe. */
+class PluginScanService::WorkerProcess final
+{
+public:
+    explicit WorkerProcess (const Options& o) :
+        options (o),
+        connection (options.createConnection != nullptr ? options.createConnection()
+                                                        : std::make_unique<ChildProcessConnection> (options))
+    {
+        jassert (connection != nullptr);
+
+        connection->onMessage = [this] (const MemoryBlock& message) { handleMessageFromWorker (message); };
+        connection->onConnectionLost = [this] { handleConnectionLost(); };
+    }
+
+    ~WorkerProcess()
+    {
+        // N.B.: This must happen before any members go away,
+        //       seeing as the connection calls back into them.
+        connection->kill();
+    }
+
+    //==============================================================================
+    Outcome scan (const String& formatName, const String& fileOrIdentifier, OwnedArray<PluginDescription>& results)
+    {
+        if (! ensureRunning())
+            return Outcome::workerUnavailable;
+
+        const auto requestID = ++lastRequestID;
+
+        {
+            const ScopedLock sl (replyLock);
+            reply.reset();
+            hasReply = false;
+        }
+
+        replied.reset();
+
+        // The worker died before it was even asked, so that's not the plugin's fault:
+        if (! connection->send (PluginScanProtocol::createScanRequest (requestID, formatName, fileOrIdentifier)))
+        {
+            stop();
+            return Outcome::workerUnavailable;
+        }
+
+        const auto startTimeMs = Time::getMillisecondCounter();
+
+        for (;;)
+        {
+            // A reply, or losing the worker, wakes this straight away;
+            // the timeout is only for noticing a hang, or being cancelled.
+            replied.wait (PluginScanHelpers::cancellationPollMs);
+
+            {
+                const ScopedLock sl (replyLock);
+
+                if (hasReply)
+                    break;
+            }
+
+            if (connectionLost.load())
+            {
+                stop();
+                return Outcome::crashed;
+            }
+
+            if (PluginScanHelpers::shouldCancelScan())
+            {
+                stop();
+                return Outcome::cancelled;
+            }
+
+            if (Time::getMillisecondCounter() - startTimeMs >= (uint32) jmax (0, options.scanTimeoutMs))
+            {
+                stop();
+                return Outcome::timedOut;
+            }
+        }
+
+        MemoryBlock message;
+
+        {
+            const ScopedLock sl (replyLock);
+            message.swapWith (reply);
+        }
+
+        int replyID = 0;
+
+        if (PluginScanProtocol::readScanResult (message, replyID, results) && replyID == requestID)
+            return Outcome::scanned;
+
+        jassertfalse; // The worker replied with something it shouldn't have...
+        stop();
+        return Outcome::workerUnavailable;
+    }
+
+private:
+    //==============================================================================
+    const Options& options;
+    std::unique_ptr<WorkerConnection> connection;
+    bool isRunning = false;
+    std::atomic<bool> connectionLost { false };
+    int lastRequestID = 0;
+
+    CriticalSection replyLock;
+    MemoryBlock reply;
+    bool hasReply = false;
+    WaitableEvent replied;
+
+    //==============================================================================
+    bool ensureRunning()
+    {
+        if (isRunning && ! connectionLost.load())
+            return true;
+
+        stop();
+        connectionLost = false;
+
+        isRunning = connection->launch();
+        return isRunning;
+    }
+
+    void stop()
+    {
+        connection->kill();
+        isRunning = false;
+    }
+
+    //==============================================================================
+    void handleMessageFromWorker (const MemoryBlock& message)
+    {
+        const ScopedLock sl (replyLock);
+        reply = message;
+        hasReply = true;
+        replied.signal();
+    }
+
+    void handleConnectionLost()
+    {
+        connectionLost = true;
+        replied.signal();
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerProcess)
+};
+
+//==============================================================================
+PluginScanService::PluginScanService() :
+    PluginScanService (Options())
+{
+}
+
+PluginScanService::PluginScanService (const Options& o) :
+    options (o)
+{
+    for (int i = 0; i < jmax (1, options.numWorkers); ++i)
+        idleWorkers.add (workers.add (new WorkerProcess (options)));
+}
+
+PluginScanService::~PluginScanService()
+{
+    threadPool.reset();
+    workers.clear();
+}
+
+//==============================================================================
+PluginScanService::Outcome PluginScanService::scan (const String& formatName,
+                                                    const String& fileOrIdentifier,
+                                                    OwnedArray<PluginDescription>& results)
+{
+    if (isBlacklisted (fileOrIdentifier))
+        return Outcome::blacklisted;
+
+    auto* worker = acquireWorker();
+    if (worker == nullptr)
+        return Outcome::cancelled;
+
+    const auto outcome = worker->scan (formatName, fileOrIdentifier, results);
+    releaseWorker (worker);
+
+    if (outcome == Outcome::crashed || outcome == Outcome::timedOut)
+        addToBlacklist (fileOrIdentifier);
+
+    return outcome;
+}
+
+void PluginScanService::scanAll (const String& formatName, const StringArray& filesOrIdentifiers,
+                                 OwnedArray<PluginDescription>& results, ScanCallback onScanned)
+{
+    const auto numPlugins = filesOrIdentifiers.size();
+    if (numPlugins <= 0)
+        return;
+
+    std::vector<OwnedArray<PluginDescription>> found ((size_t) numPlugins);
+    std::atomic<int> nextIndex { 0 };
+
+    auto scanRemaining = [&]()
+    {
+        for (int i = nextIndex++; i < numPlugins; i = nextIndex++)
+        {
+            const auto& fileOrIdentifier = filesOrIdentifiers[i];
+            const auto outcome = scan (formatName, fileOrIdentifier, found[(size_t) i]);
+
+            if (onScanned != nullptr)
+                onScanned (fileOrIdentifier, outcome);
+        }
+    };
+
+    // The calling thread takes a worker too, so only the rest need a thread of their own.
+    const auto numHelpers = jmin (workers.size(), numPlugins) - 1;
+
+    if (numHelpers > 0)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (threadPool == nullptr)
+                threadPool = std::make_unique<ThreadPool> (workers.size() - 1);
+        }
+
+        WaitableEvent finished;
+        std::atomic<int> numRemaining { numHelpers };
+
+        for (int i = 0; i < numHelpers; ++i)
+        {
+            threadPool->addJob ([&]()
+            {
+                scanRemaining();
+
+                if (--numRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        scanRemaining();
+        finished.wait();
+    }
+    else
+    {
+        scanRemaining();
+    }
+
+    for (auto& descriptions : found)
+    {
+        results.addArray (descriptions);
+        descriptions.clear (false);
+    }
+}
+
+//==============================================================================
+PluginScanService::WorkerProcess* PluginScanService::acquireWorker()
+{
+    for (;;)
+    {
+        {
+            const ScopedLock sl (lock);
+
+            if (! idleWorkers.isEmpty())
+                return idleWorkers.removeAndReturn (idleWorkers.size() - 1);
+        }
+
+        if (PluginScanHelpers::shouldCancelScan())
+            return nullptr;
+
+        workerReleased.wait (PluginScanHelpers::cancellationPollMs);
+    }
+}
+
+void PluginScanService::releaseWorker (WorkerProcess* worker)
+{
+    jassert (worker != nullptr);
+
+    const ScopedLock sl (lock);
+    idleWorkers.add (worker);
+    workerReleased.signal();
+}
+
+//==============================================================================
+bool PluginScanService::isBlacklisted (const String& fileOrIdentifier) const
+{
+    const ScopedLock sl (lock);
+    return blacklist.contains (fileOrIdentifier);
+}
+
+StringArray PluginScanService::getBlacklist() const
+{
+    const ScopedLock sl (lock);
+    return blacklist;
+}
+
+void PluginScanService::setBlacklist (const StringArray& newBlacklist)
+{
+    const ScopedLock sl (lock);
+    blacklist = newBlacklist;
+}
+
+void PluginScanService::clearBlacklist()
+{
+    const ScopedLock sl (lock);
+    blacklist.clear();
+}
+
+void PluginScanService::addToBlacklist (const String& fileOrIdentifier)
+{
+    const ScopedLock sl (lock);
+    blacklist.addIfNotAlreadyThere (fileOrIdentifier);
+}
+
+//==============================================================================
+PluginScanWorker::PluginScanWorker (OwnedArray<AudioPluginFormat> customFormats)
+{
+    formatManager.addDefaultFormats();
+
+    for (auto i = customFormats.size(); --i >= 0;)
+        formatManager.addFormat (customFormats.removeAndReturn (i));
+}
+
+PluginScanWorker::~PluginScanWorker()
+{
+    cancelPendingUpdate();
+}
+
+bool PluginScanWorker::isWorkerCommandLine (const String& commandLine)
+{
+    return commandLine.contains (PluginScanHelpers::workerCommandLineID);
+}
+
+bool PluginScanWorker::initialiseFromCommandLine (const String& commandLine)
+{
+    return ChildProcessWorker::initialiseFromCommandLine (commandLine, PluginScanHelpers::workerCommandLineID);
+}
+
+//==============================================================================
+void PluginScanWorker::scan (const MemoryBlock& request)
+{
+    int requestID = 0;
+    String formatName, fileOrIdentifier;
+
+    if (! PluginScanProtocol::readScanRequest (request, requestID, formatName, fileOrIdentifier))
+    {
+        jassertfalse; // The service sent something that isn't understood...
+        return;
+    }
+
+    OwnedArray<PluginDescription> found;
+
+    for (int i = 0; i < formatManager.getNumFormats(); ++i)
+    {
+        auto* format = formatManager.getFormat (i);
+
+        if (format->getName() == formatName)
+        {
+            format->findAllTypesForFile (found, fileOrIdentifier);
+            break;
+        }
+    }
+
+    sendMessageToCoordinator (PluginScanProtocol::createScanResult (requestID, found));
+}
+
+void PluginScanWorker::handleMessageFromCoordinator (const MemoryBlock& message)
+{
+    {
+        const ScopedLock sl (pendingLock);
+        pendingRequests.push_back (message);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void PluginScanWorker::handleConnectionLost()
+{
+    // Without the service, there's nothing left for this process to do.
+    JUCEApplicationBase::quit();
+}
+
+void PluginScanWorker::handleAsyncUpdate()
+{
+    std::vector<MemoryBlock> requests;
+
+    {
+        const ScopedLock sl (pendingLock);
+        requests.swap (pendingRequests);
+    }
+
+    for (const auto& request : requests)
+        scan (request);
+}
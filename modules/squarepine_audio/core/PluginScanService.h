@@ -0,0 +1,252 @@
+/** The messages passed between a PluginScanService and its PluginScanWorker processes.
+
+    Each message is a small binary frame, sent over the pipe that connects the processes:
+    a protocol version, a message type and a request ID, followed by the payload.
+    Plugin descriptions are written field by field, so nothing goes through XML nor the disk.
+
+    @internal
+*/
+namespace PluginScanProtocol
+{
+    /** @returns a request to scan a plugin file or identifier, with the named format. */
+    MemoryBlock createScanRequest (int requestID, const String& formatName, const String& fileOrIdentifier);
+
+    /** Reads back a request made with createScanRequest().
+        @returns false if the message isn't a valid scan request.
+    */
+    bool readScanRequest (const MemoryBlock& message, int& requestID, String& formatName, String& fileOrIdentifier);
+
+    /** @returns the reply to a scan request, containing whatever was found. */
+    MemoryBlock createScanResult (int requestID, const OwnedArray<PluginDescription>& found);
+
+    /** Reads back a reply made with createScanResult(), adding any descriptions to the array.
+        @returns false if the message isn't a valid scan result.
+    */
+    bool readScanResult (const MemoryBlock& message, int& requestID, OwnedArray<PluginDescription>& found);
+
+    /** Writes a list of descriptions, in the same binary form as the scan results. */
+    void writeDescriptions (OutputStream& out, const OwnedArray<PluginDescription>& descriptions);
+
+    /** Reads back a list written by writeDescriptions(), adding them to the array.
+        @returns false if the data isn't a valid list, in which case nothing is added.
+    */
+    bool readDescriptions (InputStream& in, OwnedArray<PluginDescription>& descriptions);
+}
+
+//==============================================================================
+/** Scans plugins out of process, using a pool of long-lived worker processes.
+
+    Each worker is a copy of the current executable, started once and then handed
+    plugin after plugin to scan, so the cost of starting a process is paid
+    once per worker instead of once per plugin. The workers are started lazily,
+    and the scans are spread across all of them, so several can run in parallel.
+
+    When a plugin crashes its worker, or hangs it for longer than the timeout,
+    the worker is killed and restarted for the next scan, and the plugin's file
+    is blacklisted so it never gets scanned again (until the blacklist is cleared).
+
+    For this to work, the application must check its command line at startup,
+    and run a PluginScanWorker instead of its usual self when asked to:
+
+    @code
+        void initialise (const String& commandLine) override
+        {
+            if (PluginScanWorker::isWorkerCommandLine (commandLine))
+            {
+                scanWorker = std::make_unique<PluginScanWorker>();
+
+                if (scanWorker->initialiseFromCommandLine (commandLine))
+                    return;
+            }
+
+            ...
+        }
+    @endcode
+
+    This is thread safe: any number of threads can call scan() at once,
+    each one waiting for a worker to become available.
+
+    @see ChildProcessPluginScanner, PluginScanWorker, FakePluginFormat
+*/
+class PluginScanService final
+{
+public:
+    //==============================================================================
+    /** The ways a scan can end. */
+    enum class Outcome
+    {
+        scanned = 0,        //< The worker scanned the plugin; it may or may not have found anything.
+        crashed,            //< The worker died while scanning the plugin, which is now blacklisted.
+        timedOut,           //< The worker took too long, and was killed. The plugin is now blacklisted.
+        blacklisted,        //< The plugin was skipped, seeing as it previously crashed or hung.
+        cancelled,          //< The calling thread or job was asked to stop.
+        workerUnavailable   //< A worker process couldn't be started.
+    };
+
+    /** The pipe between the service and a single worker.
+
+        By default, each worker is a child process, but the service can be handed
+        connections of any other kind through Options::createConnection; eg: to test
+        how it copes with workers that crash or hang, without starting any processes.
+    */
+    class WorkerConnection
+    {
+    public:
+        /** Destructor. */
+        virtual ~WorkerConnection() = default;
+
+        /** Starts the worker. @returns false if it couldn't be started. */
+        virtual bool launch() = 0;
+
+        /** Kills the worker, if it's running. No more callbacks may happen once this returns. */
+        virtual void kill() = 0;
+
+        /** Sends a message to the worker. @returns false if the worker couldn't be reached. */
+        virtual bool send (const MemoryBlock& message) = 0;
+
+        /** Must be called with each message from the worker, from any thread. */
+        std::function<void (const MemoryBlock&)> onMessage;
+
+        /** Must be called when the worker dies or stops responding, from any thread. */
+        std::function<void()> onConnectionLost;
+    };
+
+    /** How the service runs its workers. */
+    struct Options final
+    {
+        /** The executable to run as a worker, which must handle the worker command line. */
+        File executable = File::getSpecialLocation (File::currentExecutableFile);
+
+        /** The number of worker processes to keep around. */
+        int numWorkers = jmax (1, SystemStats::getNumCpus() - 1);
+
+        /** How long a single plugin may take to scan before its worker gets killed. */
+        int scanTimeoutMs = 30000;
+
+        /** How long a worker may go without responding to pings before it's considered dead. */
+        int pingTimeoutMs = 8000;
+
+        /** Creates the connection to each worker, or launches the executable as a child process if null. */
+        std::function<std::unique_ptr<WorkerConnection>()> createConnection;
+    };
+
+    //==============================================================================
+    /** Constructor, using the default options. No worker processes are started until they're needed. */
+    PluginScanService();
+
+    /** Constructor. No worker processes are started until they're needed. */
+    explicit PluginScanService (const Options& options);
+
+    /** Destructor, which kills any worker processes. */
+    ~PluginScanService();
+
+    //==============================================================================
+    /** @returns the options the service was created with. */
+    [[nodiscard]] const Options& getOptions() const noexcept { return options; }
+
+    /** Scans a single plugin file or identifier, waiting for a worker to be free if need be.
+
+        @param formatName       The name of the AudioPluginFormat to scan with.
+        @param fileOrIdentifier The plugin to scan.
+        @param results          Where any plugins that are found get added.
+    */
+    Outcome scan (const String& formatName, const String& fileOrIdentifier, OwnedArray<PluginDescription>& results);
+
+    /** Called with the outcome of each plugin scanned by scanAll(), from one of the scanning threads. */
+    using ScanCallback = std::function<void (const String& fileOrIdentifier, Outcome outcome)>;
+
+    /** Scans a batch of plugins, in parallel across all of the workers, and waits for them all to finish.
+
+        The results are added in the same order as the plugins were given, regardless
+        of which ones happened to finish first.
+    */
+    void scanAll (const String& formatName, const StringArray& filesOrIdentifiers,
+                  OwnedArray<PluginDescription>& results, ScanCallback onScanned = nullptr);
+
+    //==============================================================================
+    /** @returns true if the plugin previously crashed or hung a worker. */
+    [[nodiscard]] bool isBlacklisted (const String& fileOrIdentifier) const;
+
+    /** @returns every plugin that crashed or hung a worker, eg: to store them in the app's settings. */
+    [[nodiscard]] StringArray getBlacklist() const;
+
+    /** Replaces the blacklist, eg: with one restored from the app's settings. */
+    void setBlacklist (const StringArray& newBlacklist);
+
+    /** Forgets about any plugins that crashed or hung, so they'll be scanned again. */
+    void clearBlacklist();
+
+private:
+    //==============================================================================
+    class ChildProcessConnection;
+    class WorkerProcess;
+
+    const Options options;
+    OwnedArray<WorkerProcess> workers;
+    Array<WorkerProcess*> idleWorkers;
+    WaitableEvent workerReleased;
+    CriticalSection lock;
+    StringArray blacklist;
+    std::unique_ptr<ThreadPool> threadPool;
+
+    //==============================================================================
+    WorkerProcess* acquireWorker();
+    void releaseWorker (WorkerProcess*);
+    void addToBlacklist (const String& fileOrIdentifier);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanService)
+};
+
+//==============================================================================
+/** The other end of a PluginScanService: this runs inside each worker process,
+    scanning whatever the service asks for with the formats it knows about.
+
+    The scans are run on the message thread, seeing as some plugin formats insist on it,
+    and the worker quits the application when it loses its connection to the service.
+
+    @see PluginScanService
+*/
+class PluginScanWorker final : private ChildProcessWorker,
+                               private AsyncUpdater
+{
+public:
+    /** Constructor.
+
+        @param customFormats Any formats to scan with besides JUCE's default ones.
+    */
+    explicit PluginScanWorker (OwnedArray<AudioPluginFormat> customFormats = {});
+
+    /** Destructor. */
+    ~PluginScanWorker() override;
+
+    //==============================================================================
+    /** @returns true if a command line was created by a PluginScanService to start a worker. */
+    [[nodiscard]] static bool isWorkerCommandLine (const String& commandLine);
+
+    /** Connects to the service that started this process.
+
+        @returns false if the command line isn't a worker's, in which case
+                 the application should carry on as usual.
+    */
+    bool initialiseFromCommandLine (const String& commandLine);
+
+private:
+    //==============================================================================
+    AudioPluginFormatManager formatManager;
+    CriticalSection pendingLock;
+    std::vector<MemoryBlock> pendingRequests;
+
+    //==============================================================================
+    void scan (const MemoryBlock& request);
+
+    /** @internal */
+    void handleMessageFromCoordinator (const MemoryBlock&) override;
+    /** @internal */
+    void handleConnectionLost() override;
+    /** @internal */
+    void handleAsyncUpdate() override;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanWorker)
+};
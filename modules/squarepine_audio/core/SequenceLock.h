@@ -0,0 +1,103 @@
+/** A sequence lock, for publishing a set of values from a single writer to any number of readers.
+
+    The writer bumps a counter before and after writing, making it odd while it's
+    mid-write, and readers retry in the unlikely case they raced with it.
+    The writer never waits on the readers, and neither side ever locks nor allocates,
+    so it's safe for publishing from the audio thread.
+
+    The values themselves should be relaxed atomics, so a read that races
+    the writer is harmless, and simply gets thrown away and retried.
+
+    @code
+        // On the audio thread:
+        {
+            const SequenceLock::ScopedWrite write (lock);
+            first.store (a, std::memory_order_relaxed);
+            second.store (b, std::memory_order_relaxed);
+        }
+
+        // On any other thread:
+        lock.read ([&]
+        {
+            a = first.load (std::memory_order_relaxed);
+            b = second.load (std::memory_order_relaxed);
+        });
+    @endcode
+
+    @see MeterBus, LoudnessMeter
+*/
+class SequenceLock final
+{
+public:
+    /** Constructor. */
+    SequenceLock() = default;
+
+    //==============================================================================
+    /** Marks the values as being written to for as long as it's in scope.
+        Only a single thread may be writing at a time.
+    */
+    class ScopedWrite final
+    {
+    public:
+        /** Tells the readers that the values are being written to. */
+        explicit ScopedWrite (SequenceLock& lockToUse) noexcept :
+            lock (lockToUse),
+            start (lock.sequence.load (std::memory_order_relaxed))
+        {
+            lock.sequence.store (start + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+        }
+
+        /** Tells the readers that the values are all there. */
+        ~ScopedWrite() noexcept
+        {
+            lock.sequence.store (start + 2, std::memory_order_release);
+        }
+
+    private:
+        SequenceLock& lock;
+        const uint32 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedWrite)
+    };
+
+    //==============================================================================
+    /** Calls a function that reads the values, for as many times as it takes
+        to get through it without the writer getting in the way.
+
+        The function may be called more than once, so it must simply
+        overwrite whatever it read the time before.
+    */
+    template<typename ReadFunction>
+    void read (ReadFunction&& readValues) const noexcept
+    {
+        for (;;)
+        {
+            const auto before = sequence.load (std::memory_order_acquire);
+
+            if ((before & 1) != 0)
+            {
+                // The writer is mid-write, which only takes a moment.
+                std::this_thread::yield();
+                continue;
+            }
+
+            readValues();
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (sequence.load (std::memory_order_relaxed) == before)
+                return;
+        }
+    }
+
+    /** @returns a count of the writes, which readers can compare to tell if there's anything new. */
+    [[nodiscard]] uint32 getNumWrites() const noexcept { return sequence.load (std::memory_order_acquire) / 2; }
+
+private:
+    //==============================================================================
+    std::atomic<uint32> sequence { 0 };
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE (SequenceLock)
+};
@@ -94,6 +94,10 @@ void DummyAudioIODevice::start (AudioIODeviceCallback* cb)
 
     if (callback != nullptr)
     {
+        allocateBuffers();
+        resetRenderStatistics();
+        numSamplesRendered = 0;
+
         callback->audioDeviceAboutToStart (this);
         startThread (juce::Thread::Priority::highest);
         playing = true;
@@ -103,6 +107,7 @@ void DummyAudioIODevice::start (AudioIODeviceCallback* cb)
 void DummyAudioIODevice::stop()
 {
     signalThreadShouldExit();
+    notify();
     waitForThreadToExit (3000);
 
     playing = false;
@@ -158,33 +163,181 @@ BigInteger DummyAudioIODevice::getActiveOutputChannels() const
     return getActiveInputChannels(); // All channels are available.
 }
 
+//==============================================================================
+void DummyAudioIODevice::setRenderMode (RenderMode newMode)
+{
+    renderMode = newMode;
+}
+
+void DummyAudioIODevice::setStressJitter (double proportionOfBlock)
+{
+    stressJitter = jlimit (0.0, 1.0, proportionOfBlock);
+}
+
+//==============================================================================
+double DummyAudioIODevice::RenderStatistics::getAverageSeconds() const noexcept
+{
+    return numCallbacks > 0 ? totalSeconds / (double) numCallbacks : 0.0;
+}
+
+double DummyAudioIODevice::RenderStatistics::getLoadPercentile (double percentile) const noexcept
+{
+    if (numCallbacks == 0)
+        return 0.0;
+
+    const auto target = (uint64) std::ceil (jlimit (0.0, 1.0, percentile) * (double) numCallbacks);
+    uint64 count = 0;
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        count += histogram[(size_t) i];
+
+        if (count >= target)
+            return (i + 1) * binWidth;
+    }
+
+    return numBins * binWidth;
+}
+
+DummyAudioIODevice::RenderStatistics DummyAudioIODevice::getRenderStatistics() const
+{
+    RenderStatistics stats;
+
+    for (size_t i = 0; i < histogram.size(); ++i)
+        stats.histogram[i] = histogram[i].load (std::memory_order_relaxed);
+
+    stats.numCallbacks = numCallbacks.load (std::memory_order_relaxed);
+    stats.numOverruns = numOverruns.load (std::memory_order_relaxed);
+    stats.minimumSeconds = minimumRenderSeconds.load (std::memory_order_relaxed);
+    stats.maximumSeconds = maximumRenderSeconds.load (std::memory_order_relaxed);
+    stats.totalSeconds = totalRenderSeconds.load (std::memory_order_relaxed);
+    return stats;
+}
+
+void DummyAudioIODevice::resetRenderStatistics()
+{
+    if (isThreadRunning())
+        statisticsResetPending = true;
+    else
+        clearRenderStatistics();
+}
+
+void DummyAudioIODevice::clearRenderStatistics()
+{
+    statisticsResetPending = false;
+
+    for (auto& bin : histogram)
+        bin = 0;
+
+    numCallbacks = 0;
+    numOverruns = 0;
+    minimumRenderSeconds = 0.0;
+    maximumRenderSeconds = 0.0;
+    totalRenderSeconds = 0.0;
+}
+
+void DummyAudioIODevice::recordRenderTime (double renderSeconds, double blockSeconds)
+{
+    const auto load = renderSeconds / blockSeconds;
+    const auto bin = jmin ((int) (load / RenderStatistics::binWidth), RenderStatistics::numBins);
+
+    // N.B.: Only this thread writes to these, so there's no need for anything fancier than relaxed stores.
+    const auto previousNumCallbacks = numCallbacks.load (std::memory_order_relaxed);
+
+    histogram[(size_t) bin].store (histogram[(size_t) bin].load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (load > 1.0)
+        numOverruns.store (numOverruns.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    if (previousNumCallbacks == 0 || renderSeconds < minimumRenderSeconds.load (std::memory_order_relaxed))
+        minimumRenderSeconds.store (renderSeconds, std::memory_order_relaxed);
+
+    if (renderSeconds > maximumRenderSeconds.load (std::memory_order_relaxed))
+        maximumRenderSeconds.store (renderSeconds, std::memory_order_relaxed);
+
+    totalRenderSeconds.store (totalRenderSeconds.load (std::memory_order_relaxed) + renderSeconds, std::memory_order_relaxed);
+    numCallbacks.store (previousNumCallbacks + 1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+void DummyAudioIODevice::allocateBuffers()
+{
+    const auto numChans = numChannels.load();
+    const auto numSamples = bufferSize.load();
+
+    inputBuffer.setSize (numChans, numSamples, false, false, true);
+    outputBuffer.setSize (numChans, numSamples, false, false, true);
+}
+
 void DummyAudioIODevice::run()
 {
     auto lastRenderTimeTicks = Time::getHighResolutionTicks();
+    auto lastMode = renderMode.load();
 
     while (! threadShouldExit())
     {
         const auto numSamples = bufferSize.load();
+        const auto blockSeconds = timeSamplesToSeconds (numSamples, sampleRate);
+        auto hasRendered = false;
+
+        if (statisticsResetPending.load())
+            clearRenderStatistics();
 
         {
             const ScopedLock sl (callbackLock);
             if (callback != nullptr)
             {
-                const auto numChans = numChannels.load();
+                hasRendered = true;
+
+                // This only ever allocates if the channel count or buffer size grew while playing.
+                allocateBuffers();
 
-                juce::AudioBuffer<float> input (numChans, numSamples);
-                input.clear();
+                inputBuffer.clear();
+                outputBuffer.clear();
 
-                juce::AudioBuffer<float> output (numChans, numSamples);
-                output.clear();
-                callback->audioDeviceIOCallbackWithContext (input.getArrayOfReadPointers(), numChans,
-                                                            output.getArrayOfWritePointers(), numChans,
+                const auto numChans = inputBuffer.getNumChannels();
+                const auto startTicks = Time::getHighResolutionTicks();
+
+                callback->audioDeviceIOCallbackWithContext (inputBuffer.getArrayOfReadPointers(), numChans,
+                                                            outputBuffer.getArrayOfWritePointers(), numChans,
                                                             numSamples, {});
+
+                recordRenderTime (Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks), blockSeconds);
+                numSamplesRendered += numSamples;
             }
         }
 
-        const auto sleepTime = Time::secondsToHighResolutionTicks (timeSamplesToSeconds (numSamples, sampleRate));
-        lastRenderTimeTicks += sleepTime;
-        waitUntilTime (lastRenderTimeTicks, 1);
+        const auto mode = renderMode.load();
+        if (mode != lastMode)
+        {
+            // Don't try to catch up with (or wait for) a schedule from another mode:
+            lastRenderTimeTicks = Time::getHighResolutionTicks();
+            lastMode = mode;
+        }
+
+        if (! hasRendered)
+        {
+            // Without a callback, there's nothing to run as fast as possible, nor to keep a schedule for.
+            wait (jmax (1, roundToInt (blockSeconds * 1000.0)));
+            lastRenderTimeTicks = Time::getHighResolutionTicks();
+            continue;
+        }
+
+        if (mode == RenderMode::freewheel)
+            continue;
+
+        lastRenderTimeTicks += Time::secondsToHighResolutionTicks (blockSeconds);
+
+        if (mode == RenderMode::stress)
+        {
+            // The jitter is applied around the regular schedule, so it doesn't accumulate:
+            const auto jitterSeconds = blockSeconds * stressJitter.load() * (random.nextDouble() * 2.0 - 1.0);
+            const auto targetTicks = lastRenderTimeTicks + Time::secondsToHighResolutionTicks (jitterSeconds);
+            waitUntilTime (targetTicks, 1);
+        }
+        else
+        {
+            waitUntilTime (lastRenderTimeTicks, 1);
+        }
     }
 }
@@ -1,5 +1,14 @@
 /** Use this class for doing things like faking an audio device
     when needing a placeholder driver or rendering to an audio to a file.
+
+    Besides running in realtime, the device can render as fast as possible
+    (eg: for offline rendering), or with jittered callback timing to stress
+    whatever is being called back (eg: for load testing an effect chain).
+
+    The render time of every callback is recorded, so you can look at
+    how close to (or past!) the deadline the callback is getting.
+
+    @see RenderMode, RenderStatistics
 */
 class DummyAudioIODevice final : public AudioIODevice,
                                  public Thread
@@ -40,6 +49,70 @@ public:
     */
     int getNumChannels() const;
 
+    //==============================================================================
+    /** The ways the device can pace its callbacks. */
+    enum class RenderMode
+    {
+        realtime,   /**< Calls back once per block duration, like a real audio device. */
+        freewheel,  /**< Calls back as fast as possible, without ever waiting. */
+        stress      /**< Calls back in realtime on average, but with each callback
+                         jittered to come in early or late. @see setStressJitter */
+    };
+
+    /** Changes the way callbacks are paced; this can be changed while playing. */
+    void setRenderMode (RenderMode newMode);
+
+    /** @returns the way callbacks are currently being paced. */
+    [[nodiscard]] RenderMode getRenderMode() const noexcept { return renderMode; }
+
+    /** Changes how far off the regular schedule callbacks can be pushed in RenderMode::stress.
+
+        @param proportionOfBlock The maximum offset, as a proportion of the block duration.
+                                 For example; 0.5 means up to half a block early or late.
+    */
+    void setStressJitter (double proportionOfBlock);
+
+    /** @returns the total number of samples rendered since the device was last started. */
+    [[nodiscard]] int64 getNumSamplesRendered() const noexcept { return numSamplesRendered; }
+
+    //==============================================================================
+    /** A summary of how long the callbacks have been taking to render. */
+    struct RenderStatistics final
+    {
+        /** The number of histogram bins, where each bin covers binWidth of the block duration.
+            An extra bin at the end collects anything beyond numBins * binWidth.
+        */
+        static constexpr int numBins = 40;
+        static constexpr double binWidth = 0.05;
+
+        std::array<uint64, numBins + 1> histogram {};
+        uint64 numCallbacks = 0;
+        uint64 numOverruns = 0;         /**< Callbacks that took longer than the block duration. */
+        double minimumSeconds = 0.0;
+        double maximumSeconds = 0.0;
+        double totalSeconds = 0.0;
+
+        /** @returns the mean render time of a callback, in seconds. */
+        [[nodiscard]] double getAverageSeconds() const noexcept;
+
+        /** @returns an estimate of the render load, as a proportion of the block duration,
+            below which the specified percentile (eg: 0.99) of callbacks fall.
+        */
+        [[nodiscard]] double getLoadPercentile (double percentile) const noexcept;
+    };
+
+    /** @returns the render time statistics collected since the device was
+        last started, or since resetRenderStatistics() was last called.
+    */
+    [[nodiscard]] RenderStatistics getRenderStatistics() const;
+
+    /** Clears the render time statistics.
+
+        While playing, they're cleared by the rendering thread before its next callback,
+        seeing as it's the only thread that ever writes to them.
+    */
+    void resetRenderStatistics();
+
     //==============================================================================
     /** @internal */
     StringArray getOutputChannelNames() override;
@@ -87,9 +160,26 @@ private:
     std::atomic<int> numChannels, bufferSize;
     std::atomic<double> sampleRate;
     std::atomic<bool> opened { false }, playing { false };
+    std::atomic<RenderMode> renderMode { RenderMode::realtime };
+    std::atomic<double> stressJitter { 0.5 };
+    std::atomic<int64> numSamplesRendered { 0 };
     CriticalSection callbackLock;
     AudioIODeviceCallback* callback = nullptr;
 
+    // Only touched by the rendering thread, or while it isn't running:
+    juce::AudioBuffer<float> inputBuffer, outputBuffer;
+    Random random;
+
+    std::array<std::atomic<uint64>, RenderStatistics::numBins + 1> histogram {};
+    std::atomic<uint64> numCallbacks { 0 }, numOverruns { 0 };
+    std::atomic<double> minimumRenderSeconds { 0.0 }, maximumRenderSeconds { 0.0 }, totalRenderSeconds { 0.0 };
+    std::atomic<bool> statisticsResetPending { false };
+
+    //==============================================================================
+    void allocateBuffers();
+    void clearRenderStatistics();
+    void recordRenderTime (double renderSeconds, double blockSeconds);
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DummyAudioIODevice)
 };
@@ -0,0 +1,334 @@
+/** A cascade of biquad sections that processes many channels at once.
+
+    Every section is run on every channel, in the order they were added, so a
+    bank can stand in for a chain of filters; eg: the bands of an EQ or the
+    pairs of Butterworth biquads that make up a Linkwitz-Riley crossover.
+
+    The channels are processed in groups, one channel per SIMD lane (eg: 4 floats
+    or 2 doubles at a time with SSE or NEON), and the filter states are stored per
+    group, section after section, so every section of a group is a single vector
+    operation per sample. Any number of channels is supported.
+
+    The coefficients can be swept, in which case they are interpolated linearly,
+    sample by sample, from where they are now to where they are headed.
+    The sections are transposed direct form II, which copes well with that.
+
+    @code
+        BiquadBank<float> bank;
+        const auto lowShelf = bank.addSection();
+        const auto highShelf = bank.addSection();
+        bank.prepare (numChannels);
+
+        // And then, on the audio thread:
+        bank.setCoefficients (lowShelf, newLowShelfCoefficients, buffer.getNumSamples());
+        bank.process (buffer, 0, buffer.getNumSamples());
+    @endcode
+
+    @see DigitalFilter, MultibandCrossover
+*/
+template<typename FloatType>
+class BiquadBank final
+{
+public:
+    /** The coefficients of a biquad section, normalised so that a0 is 1. */
+    struct Coefficients final
+    {
+        FloatType b0 = FloatType (1), b1 = FloatType(), b2 = FloatType(),
+                  a1 = FloatType(), a2 = FloatType();
+
+        /** @returns the coefficients of a biquad, normalised by its a0. */
+        static Coefficients fromUnnormalised (FloatType b0, FloatType b1, FloatType b2,
+                                              FloatType a0, FloatType a1, FloatType a2) noexcept
+        {
+            jassert (a0 != FloatType());
+
+            const auto scale = FloatType (1) / a0;
+            return { b0 * scale, b1 * scale, b2 * scale, a1 * scale, a2 * scale };
+        }
+
+        /** @returns the coefficients of a biquad from an array of b0, b1, b2, a0, a1 and a2;
+            the layout used by dsp::IIR::ArrayCoefficients.
+        */
+        static Coefficients fromUnnormalised (const std::array<FloatType, 6>& c) noexcept
+        {
+            return fromUnnormalised (c[0], c[1], c[2], c[3], c[4], c[5]);
+        }
+    };
+
+    //==============================================================================
+    /** Constructor.
+
+        The bank starts out without any sections, which makes processing a no-op.
+    */
+    BiquadBank() = default;
+
+    //==============================================================================
+    /** Adds a section to the end of the cascade.
+
+        This allocates, so it should not be called from the audio thread.
+
+        @returns the index of the new section, which is what setCoefficients() expects.
+    */
+    int addSection (const Coefficients& coefficients = {})
+    {
+        Section section;
+        section.current = section.target = coefficients;
+        sections.push_back (section);
+        workingSections.resize (sections.size());
+
+        allocateStates();
+        return (int) sections.size() - 1;
+    }
+
+    /** Removes every section.
+
+        This deallocates, so it should not be called from the audio thread.
+    */
+    void clearSections()
+    {
+        sections.clear();
+        workingSections.clear();
+        states.clear();
+    }
+
+    /** @returns the number of sections in the cascade. */
+    [[nodiscard]] int getNumSections() const noexcept { return (int) sections.size(); }
+
+    //==============================================================================
+    /** Prepares the bank to process the specified number of channels. */
+    void prepare (int newNumChannels)
+    {
+        jassert (newNumChannels > 0);
+
+        numChannels = jmax (1, newNumChannels);
+        allocateStates();
+    }
+
+    /** Clears the state of every section, and jumps to the coefficients that are being swept towards. */
+    void reset() noexcept
+    {
+        std::fill (states.begin(), states.end(), State());
+
+        for (auto& section : sections)
+        {
+            section.current = section.target;
+            section.numRampSamples = 0;
+        }
+    }
+
+    //==============================================================================
+    /** Changes the coefficients of a section.
+
+        @param section              The index of the section, as returned by addSection().
+        @param newCoefficients      The new coefficients.
+        @param numSamplesToRamp     The number of samples to sweep the coefficients over.
+                                    The coefficients are interpolated linearly, per sample, from
+                                    wherever they are now. 0 changes them immediately.
+    */
+    void setCoefficients (int section, const Coefficients& newCoefficients, int numSamplesToRamp = 0) noexcept
+    {
+        if (! isPositiveAndBelow (section, getNumSections()))
+        {
+            jassertfalse;
+            return;
+        }
+
+        auto& s = sections[(size_t) section];
+        s.target = newCoefficients;
+        s.numRampSamples = jmax (0, numSamplesToRamp);
+
+        if (s.numRampSamples == 0)
+        {
+            s.current = newCoefficients;
+            return;
+        }
+
+        const auto scale = FloatType (1) / (FloatType) s.numRampSamples;
+
+        s.step = { (s.target.b0 - s.current.b0) * scale,
+                   (s.target.b1 - s.current.b1) * scale,
+                   (s.target.b2 - s.current.b2) * scale,
+                   (s.target.a1 - s.current.a1) * scale,
+                   (s.target.a2 - s.current.a2) * scale };
+    }
+
+    /** @returns the coefficients a section has, or is being swept towards. */
+    [[nodiscard]] Coefficients getCoefficients (int section) const noexcept
+    {
+        if (isPositiveAndBelow (section, getNumSections()))
+            return sections[(size_t) section].target;
+
+        jassertfalse;
+        return {};
+    }
+
+    /** @returns true if any of the sections are being swept. */
+    [[nodiscard]] bool isSweeping() const noexcept
+    {
+        return std::any_of (sections.begin(), sections.end(), [] (const Section& s) { return s.numRampSamples > 0; });
+    }
+
+    //==============================================================================
+    /** Runs every section, in order, over a range of a buffer, in place.
+
+        Any channels past the ones that were prepared are left as they are.
+    */
+    void process (juce::AudioBuffer<FloatType>& buffer, int startSample, int numSamples) noexcept
+    {
+        const auto numChannelsToProcess = jmin (numChannels, buffer.getNumChannels());
+
+        jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+        if (sections.empty() || numSamples <= 0)
+            return;
+
+        const auto sweeping = isSweeping();
+
+        for (int firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += laneWidth)
+        {
+            const auto numLanes = jmin (laneWidth, numChannelsToProcess - firstChannel);
+            std::array<FloatType*, laneWidth> channels {};
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                channels[(size_t) lane] = buffer.getWritePointer (firstChannel + lane, startSample);
+
+            auto* groupStates = getGroupStates (firstChannel / laneWidth);
+
+            if (sweeping)
+            {
+                // Every group sweeps from the same starting point, so each one gets its own copy to step through.
+                std::copy (sections.begin(), sections.end(), workingSections.begin());
+                processGroup<true> (channels, numLanes, groupStates, workingSections.data(), numSamples);
+            }
+            else
+            {
+                processGroup<false> (channels, numLanes, groupStates, sections.data(), numSamples);
+            }
+        }
+
+        if (sweeping)
+            for (auto& section : sections)
+                advance (section, numSamples);
+    }
+
+private:
+    //==============================================================================
+    using Vector = dsp::SIMDRegister<FloatType>;
+
+    /** The number of channels processed together. */
+    static constexpr int laneWidth = (int) Vector::size();
+
+    /** The transposed direct form II state of a single section, for a group of channels. */
+    struct State final
+    {
+        Vector s1 = Vector::expand (FloatType()),
+               s2 = Vector::expand (FloatType());
+    };
+
+    struct Section final
+    {
+        Coefficients current, target, step;
+        int numRampSamples = 0;
+    };
+
+    //==============================================================================
+    std::vector<Section> sections, workingSections;
+    std::vector<State> states;              // Planar per group of channels: every section's state for the first group, then the next, etc.
+    int numChannels = 2;
+
+    //==============================================================================
+    int getNumGroups() const noexcept
+    {
+        return (numChannels + laneWidth - 1) / laneWidth;
+    }
+
+    State* getGroupStates (int group) noexcept
+    {
+        return states.data() + (size_t) (group * getNumSections());
+    }
+
+    void allocateStates()
+    {
+        states.assign ((size_t) (getNumGroups() * getNumSections()), State());
+    }
+
+    static void step (Section& section) noexcept
+    {
+        if (section.numRampSamples <= 0)
+            return;
+
+        if (--section.numRampSamples == 0)
+        {
+            section.current = section.target;
+            return;
+        }
+
+        auto& c = section.current;
+        const auto& s = section.step;
+        c.b0 += s.b0;
+        c.b1 += s.b1;
+        c.b2 += s.b2;
+        c.a1 += s.a1;
+        c.a2 += s.a2;
+    }
+
+    static void advance (Section& section, int numSamples) noexcept
+    {
+        if (section.numRampSamples <= 0)
+            return;
+
+        if (numSamples >= section.numRampSamples)
+        {
+            section.current = section.target;
+            section.numRampSamples = 0;
+            return;
+        }
+
+        const auto n = (FloatType) numSamples;
+        auto& c = section.current;
+        const auto& s = section.step;
+        c.b0 += s.b0 * n;
+        c.b1 += s.b1 * n;
+        c.b2 += s.b2 * n;
+        c.a1 += s.a1 * n;
+        c.a2 += s.a2 * n;
+        section.numRampSamples -= numSamples;
+    }
+
+    template<bool sweeping>
+    void processGroup (const std::array<FloatType*, laneWidth>& channels, int numLanes,
+                       State* groupStates, Section* groupSections, int numSamples) noexcept
+    {
+        const auto numSections = getNumSections();
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            // N.B.: Any unused lanes are left at 0, which keeps their filters silent.
+            auto x = Vector::expand (FloatType());
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                x.set ((size_t) lane, channels[(size_t) lane][n]);
+
+            for (int i = 0; i < numSections; ++i)
+            {
+                auto& section = groupSections[i];
+                auto& state = groupStates[i];
+                const auto& c = section.current;
+
+                const auto y = x * c.b0 + state.s1;
+                state.s1 = x * c.b1 - y * c.a1 + state.s2;
+                state.s2 = x * c.b2 - y * c.a2;
+                x = y;
+
+                if constexpr (sweeping)
+                    step (section);
+            }
+
+            for (int lane = 0; lane < numLanes; ++lane)
+                channels[(size_t) lane][n] = x.get ((size_t) lane);
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BiquadBank)
+};
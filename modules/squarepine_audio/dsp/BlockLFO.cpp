@@ -0,0 +1,111 @@
+LFOWavetable::LFOWavetable (Shape shape) :
+    tables ((size_t) numLevels * tableStride, 0.0f)
+{
+    std::vector<double> sine ((size_t) tableSize), harmonics ((size_t) tableSize);
+
+    for (int i = 0; i < tableSize; ++i)
+        sine[(size_t) i] = std::sin (MathConstants<double>::twoPi * (double) i / (double) tableSize);
+
+    // The Fourier series of a rising saw is -2/π Σ sin (hθ) / h,
+    // and that of a square is 4/π Σ sin (hθ) / h over the odd harmonics only.
+    const auto scale = shape == Shape::saw ? -2.0 / MathConstants<double>::pi
+                                           : 4.0 / MathConstants<double>::pi;
+
+    for (int level = 0; level < numLevels; ++level)
+    {
+        std::fill (harmonics.begin(), harmonics.end(), 0.0);
+
+        const auto numHarmonics = 1 << level;
+
+        for (int h = 1; h <= numHarmonics; ++h)
+        {
+            if (shape == Shape::square && (h % 2) == 0)
+                continue;
+
+            const auto amplitude = scale / (double) h;
+
+            // N.B.: sin (2πhi / N) is simply the base sine at (h * i) mod N.
+            for (int i = 0; i < tableSize; ++i)
+                harmonics[(size_t) i] += amplitude * sine[(size_t) ((h * i) & (tableSize - 1))];
+        }
+
+        // Normalises away the Gibbs overshoot, so that modulation never goes past its depth:
+        auto peak = 0.0;
+        for (auto sample : harmonics)
+            peak = jmax (peak, std::abs (sample));
+
+        const auto gain = peak > 0.0 ? 1.0 / peak : 1.0;
+        auto* table = tables.data() + (size_t) level * tableStride;
+
+        for (int i = 0; i < tableSize; ++i)
+            table[i] = static_cast<float> (harmonics[(size_t) i] * gain);
+
+        table[tableSize] = table[0];
+        table[tableSize + 1] = table[1];
+    }
+}
+
+const LFOWavetable& LFOWavetable::getSaw()
+{
+    static const LFOWavetable saw (Shape::saw);
+    return saw;
+}
+
+const LFOWavetable& LFOWavetable::getSquare()
+{
+    static const LFOWavetable square (Shape::square);
+    return square;
+}
+
+int LFOWavetable::getLevelFor (double frequency, double sampleRate) noexcept
+{
+    if (frequency <= 0.0 || sampleRate <= 0.0)
+        return numLevels - 1;
+
+    const auto maxNumHarmonics = (sampleRate * 0.5) / frequency;
+    if (maxNumHarmonics < 2.0)
+        return 0;
+
+    return jmin (numLevels - 1, static_cast<int> (std::log2 (maxNumHarmonics)));
+}
+
+//==============================================================================
+void BlockLFO::prepare (double newSampleRate)
+{
+    jassert (newSampleRate > 0.0);
+
+    // Builds the shared tables now, rather than on the audio thread:
+    [[maybe_unused]] const auto& saw = LFOWavetable::getSaw();
+    [[maybe_unused]] const auto& square = LFOWavetable::getSquare();
+
+    sampleRate = newSampleRate;
+    update();
+}
+
+void BlockLFO::setFrequency (double newFrequency) noexcept
+{
+    jassert (newFrequency >= 0.0);
+
+    if (! approximatelyEqual (frequency, newFrequency))
+    {
+        frequency = newFrequency;
+        update();
+    }
+}
+
+void BlockLFO::setPhase (double newPhase) noexcept
+{
+    phase = newPhase - std::floor (newPhase);
+}
+
+void BlockLFO::update() noexcept
+{
+    phaseIncrement = frequency / sampleRate;
+    level = LFOWavetable::getLevelFor (frequency, sampleRate);
+}
+
+void BlockLFO::advance (int numSamples) noexcept
+{
+    phase += phaseIncrement * (double) jmax (0, numSamples);
+    phase -= std::floor (phase);
+}
@@ -0,0 +1,283 @@
+/** A set of band-limited wavetables for one of the discontinuous LFO waveforms.
+
+    Each level of the set is built from twice as many harmonics as the one before,
+    from a plain sine up to 512 harmonics, and the level used is the richest one
+    whose harmonics all stay below the Nyquist frequency; so that an LFO running
+    at audio rates doesn't alias, while a slow one still has sharp edges.
+    Every level is normalised to peak at 1.
+
+    The tables are built once, the first time they're asked for,
+    which is what BlockLFO::prepare() does.
+
+    @see BlockLFO
+*/
+class LFOWavetable final
+{
+public:
+    /** */
+    enum class Shape
+    {
+        saw,    //< Rises from -1 to 1 over a cycle.
+        square  //< 1 for the first half of a cycle, -1 for the second.
+    };
+
+    /** Builds the tables of a shape, which allocates and takes a moment.
+        Prefer the shared sets; ie: getSaw() and getSquare().
+    */
+    explicit LFOWavetable (Shape);
+
+    //==============================================================================
+    /** @returns the shared set of saw tables. */
+    static const LFOWavetable& getSaw();
+
+    /** @returns the shared set of square tables. */
+    static const LFOWavetable& getSquare();
+
+    //==============================================================================
+    /** The number of samples in a cycle of a table. */
+    static constexpr int tableSize = 2048;
+
+    /** The number of levels in a set. */
+    static constexpr int numLevels = 10;
+
+    /** @returns the level to use for an LFO of the given frequency. */
+    [[nodiscard]] static int getLevelFor (double frequency, double sampleRate) noexcept;
+
+    /** @returns the table of a level, which can be handed to lookup(). */
+    [[nodiscard]] const float* getTable (int level) const noexcept
+    {
+        return tables.data() + (size_t) jlimit (0, numLevels - 1, level) * tableStride;
+    }
+
+    /** @returns the linearly interpolated value of a table, at a phase between 0 and 1. */
+    template<typename FloatType>
+    [[nodiscard]] static FloatType lookup (const float* table, FloatType phase) noexcept
+    {
+        const auto position = phase * static_cast<FloatType> (tableSize);
+        const auto index = static_cast<int> (position);
+        const auto fraction = position - static_cast<FloatType> (index);
+        const auto a = static_cast<FloatType> (table[index]);
+        const auto b = static_cast<FloatType> (table[index + 1]);
+        return a + fraction * (b - a);
+    }
+
+private:
+    //==============================================================================
+    // N.B.: Each table has 2 guard points, wrapping around to its start,
+    //       so that lookups never need to wrap, even at a phase that rounds up to 1.
+    static constexpr size_t tableStride = (size_t) tableSize + 2;
+
+    std::vector<float> tables;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LFOWavetable)
+};
+
+//==============================================================================
+/** The waveforms a BlockLFO can render.
+
+    Each of them is bipolar, between -1 and 1, starts its cycle at 0
+    and goes up from there, except for the saw which starts at -1.
+*/
+namespace LFOWaveforms
+{
+    /** A sine, from a polynomial that's accurate to within 1e-6 and that vectorises,
+        unlike std::sin.
+    */
+    struct Sine final
+    {
+        static constexpr bool isBandLimited = false;
+
+        template<typename FloatType>
+        [[nodiscard]] static FloatType evaluate (FloatType phase) noexcept
+        {
+            // sin (2πp) = -sin (2πx), where x = p - 0.5 is folded over to [-0.25, 0.25]; ie: [-π/2, π/2].
+            auto x = phase - FloatType (0.5);
+            x = x > FloatType (0.25) ? FloatType (0.5) - x
+                                     : (x < FloatType (-0.25) ? FloatType (-0.5) - x : x);
+
+            const auto angle = x * MathConstants<FloatType>::twoPi;
+            const auto a2 = angle * angle;
+
+            return -angle * (FloatType (1)
+                             + a2 * (FloatType (-1.0 / 6.0)
+                             + a2 * (FloatType (1.0 / 120.0)
+                             + a2 * (FloatType (-1.0 / 5040.0)
+                             + a2 * (FloatType (1.0 / 362880.0)
+                             + a2 * FloatType (-1.0 / 39916800.0))))));
+        }
+    };
+
+    /** A triangle, which is continuous and so doesn't need band-limiting to speak of. */
+    struct Triangle final
+    {
+        static constexpr bool isBandLimited = false;
+
+        template<typename FloatType>
+        [[nodiscard]] static FloatType evaluate (FloatType phase) noexcept
+        {
+            auto shifted = phase + FloatType (0.25);
+            shifted -= static_cast<FloatType> (static_cast<int> (shifted));
+            return FloatType (1) - FloatType (4) * std::abs (shifted - FloatType (0.5));
+        }
+    };
+
+    /** A band-limited saw. */
+    struct Saw final
+    {
+        static constexpr bool isBandLimited = true;
+
+        [[nodiscard]] static const LFOWavetable& getWavetable() { return LFOWavetable::getSaw(); }
+    };
+
+    /** A band-limited square. */
+    struct Square final
+    {
+        static constexpr bool isBandLimited = true;
+
+        [[nodiscard]] static const LFOWavetable& getWavetable() { return LFOWavetable::getSquare(); }
+    };
+}
+
+//==============================================================================
+/** The ways a BlockLFO can apply its modulation to the samples it renders into. */
+namespace LFOOperations
+{
+    #define CREATE_LFO_OPERATION(name, expression) \
+        struct name final \
+        { \
+            template<typename FloatType> \
+            static void perform (FloatType& sample, FloatType value) noexcept { expression; } \
+        };
+
+    CREATE_LFO_OPERATION (Equals, sample = value)
+    CREATE_LFO_OPERATION (Add, sample += value)
+    CREATE_LFO_OPERATION (Subtract, sample -= value)
+    CREATE_LFO_OPERATION (Multiply, sample *= value)
+    CREATE_LFO_OPERATION (Divide, sample /= value)
+
+    #undef CREATE_LFO_OPERATION
+}
+
+//==============================================================================
+/** An LFO that renders a block of modulation at a time.
+
+    The waveform and the operation are template parameters of the rendering,
+    so each combination compiles down to a single loop without any calls,
+    which the compiler can vectorise. Only the phase and the frequency are state,
+    so switching waveforms from one block to the next doesn't make the LFO jump in time.
+
+    The usual way of using this is to render the modulation into a control buffer,
+    once per block, and to share it across every channel that's being modulated:
+
+    @code
+        // Once, off the audio thread:
+        lfo.prepare (sampleRate);
+        controlBuffer.setSize (1, maximumBlockSize);
+
+        // Then on the audio thread:
+        lfo.setFrequency (rateHz);
+        lfo.render<LFOWaveforms::Sine> (controlBuffer.getWritePointer (0), numSamples, depth, offset);
+    @endcode
+
+    @see LFOWaveforms, LFOOperations, LFOWavetable
+*/
+class BlockLFO final
+{
+public:
+    /** Constructor. */
+    BlockLFO() = default;
+
+    //==============================================================================
+    /** Prepares the LFO, and builds the shared wavetables if they haven't been already,
+        which is why this should be called off the audio thread.
+    */
+    void prepare (double newSampleRate);
+
+    /** Changes the frequency, in Hz, from the next rendered sample on. */
+    void setFrequency (double newFrequency) noexcept;
+
+    /** @returns the frequency, in Hz. */
+    [[nodiscard]] double getFrequency() const noexcept { return frequency; }
+
+    /** Moves the LFO to a phase, normalised so that a cycle goes from 0 to 1. */
+    void setPhase (double newPhase) noexcept;
+
+    /** Moves the LFO to an angle, in radians. */
+    void setAngle (double angleInRadians) noexcept { setPhase (angleInRadians / MathConstants<double>::twoPi); }
+
+    /** @returns the phase of the next sample to be rendered, between 0 and 1. */
+    [[nodiscard]] double getPhase() const noexcept { return phase; }
+
+    /** Moves the LFO back to the start of its cycle. */
+    void reset() noexcept { phase = 0.0; }
+
+    //==============================================================================
+    /** Renders the next samples of the LFO, scaled by the depth and shifted by the offset,
+        and applies them to the destination with the operation.
+    */
+    template<typename Waveform, typename Operation = LFOOperations::Equals, typename FloatType>
+    void render (FloatType* destination, int numSamples, double depth = 1.0, double offset = 0.0) noexcept
+    {
+        jassert (destination != nullptr || numSamples <= 0);
+
+        const auto start = static_cast<FloatType> (phase);
+        const auto increment = static_cast<FloatType> (phaseIncrement);
+        const auto scale = static_cast<FloatType> (depth);
+        const auto shift = static_cast<FloatType> (offset);
+
+        if constexpr (Waveform::isBandLimited)
+        {
+            const auto* table = Waveform::getWavetable().getTable (level);
+
+            for (int i = 0; i < numSamples; ++i)
+                Operation::perform (destination[i], shift + scale * LFOWavetable::lookup (table, wrap (start + increment * static_cast<FloatType> (i))));
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                Operation::perform (destination[i], shift + scale * Waveform::evaluate (wrap (start + increment * static_cast<FloatType> (i))));
+        }
+
+        advance (numSamples);
+    }
+
+    /** Applies a rendered block of modulation to every channel of a buffer, with the operation. */
+    template<typename Operation, typename FloatType>
+    static void apply (juce::AudioBuffer<FloatType>& buffer, const FloatType* modulation,
+                       int startSample, int numSamples) noexcept
+    {
+        jassert (modulation != nullptr || numSamples <= 0);
+        jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+        {
+            auto* samples = buffer.getWritePointer (c, startSample);
+
+            for (int i = 0; i < numSamples; ++i)
+                Operation::perform (samples[i], modulation[i]);
+        }
+    }
+
+private:
+    //==============================================================================
+    double sampleRate = 44100.0,
+           frequency = 1.0,
+           phase = 0.0,
+           phaseIncrement = 1.0 / 44100.0;
+    int level = LFOWavetable::numLevels - 1;
+
+    //==============================================================================
+    void update() noexcept;
+    void advance (int numSamples) noexcept;
+
+    /** Wraps a positive phase back into [0, 1), which vectorises unlike std::floor. */
+    template<typename FloatType>
+    [[nodiscard]] static FloatType wrap (FloatType value) noexcept
+    {
+        return value - static_cast<FloatType> (static_cast<int> (value));
+    }
+
+    //==============================================================================
+    JUCE_LEAK_DETECTOR (BlockLFO)
+};
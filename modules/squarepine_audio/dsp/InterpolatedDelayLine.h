@@ -0,0 +1,370 @@
+/** The kinds of interpolation an InterpolatedDelayLine can read fractional delays with. */
+enum class DelayInterpolation
+{
+    none,       /**< Truncates the delay to a whole number of samples. */
+    linear,     /**< Two-point linear interpolation. */
+    cubic,      /**< Four-point, third-order Lagrange interpolation. */
+    allpass     /**< First-order Thiran allpass interpolation; flat magnitude, but stateful. */
+};
+
+//==============================================================================
+/** A multichannel delay line whose capacity is derived from the actual
+    sample rate and maximum delay, rather than from a worst-case constant.
+
+    The storage is allocated on the heap, in prepare(), and is rounded up to
+    a power of two so that wrapping around is a matter of masking the indices.
+    The channels are stored planar so that block reads are contiguous.
+
+    Each channel has its own write position, so you can process a buffer
+    one channel at a time or one frame at a time; whichever suits the effect.
+
+    A delay of 0 samples returns the sample that was just written.
+
+    @code
+        InterpolatedDelayLine<float> delayLine;
+        delayLine.setInterpolation (DelayInterpolation::cubic);
+        delayLine.prepare (sampleRate, 2.0, 2, maximumBlockSize);
+
+        // Per sample, with a modulated delay:
+        const auto y = delayLine.processSample (channel, x, lfo.getNextSample());
+
+        // Or per block, with a fixed delay:
+        delayLine.processBlock (channel, buffer.getWritePointer (channel), numSamples, delaySamples);
+    @endcode
+*/
+template<typename FloatType>
+class InterpolatedDelayLine final
+{
+public:
+    /** Constructor.
+
+        Nothing is allocated until prepare() is called.
+    */
+    InterpolatedDelayLine() = default;
+
+    //==============================================================================
+    /** Changes the interpolation used when reading fractional delays. */
+    void setInterpolation (DelayInterpolation newInterpolation) noexcept
+    {
+        interpolation = newInterpolation;
+        resetInterpolatorState();
+    }
+
+    /** @returns the interpolation used when reading fractional delays. */
+    [[nodiscard]] DelayInterpolation getInterpolation() const noexcept { return interpolation; }
+
+    //==============================================================================
+    /** Allocates enough room to delay by the specified number of seconds at the specified sample rate.
+
+        @param sampleRate           The sample rate the delay line will be running at.
+        @param maximumDelaySeconds  The longest delay that will be read.
+        @param numChannels          The number of channels to allocate.
+        @param maximumBlockSize     The largest block that will be passed to processBlock() or writeBlock().
+                                    This can be left at 0 when only processing single samples.
+    */
+    void prepare (double sampleRate, double maximumDelaySeconds, int numChannels, int maximumBlockSize = 0)
+    {
+        jassert (sampleRate > 0.0);
+        jassert (maximumDelaySeconds >= 0.0);
+
+        allocate (numChannels, (int) std::ceil (maximumDelaySeconds * sampleRate), maximumBlockSize);
+    }
+
+    /** Allocates enough room to delay by the specified number of samples.
+
+        The storage is only reallocated when the required capacity changes,
+        but its contents and the write positions are always reset.
+
+        @param numChannels          The number of channels to allocate.
+        @param maximumDelaySamples  The longest delay that will be read.
+        @param maximumBlockSize     The largest block that will be passed to processBlock() or writeBlock().
+                                    This can be left at 0 when only processing single samples.
+    */
+    void allocate (int numChannels, int maximumDelaySamples, int maximumBlockSize = 0)
+    {
+        jassert (numChannels > 0);
+        jassert (maximumDelaySamples >= 0);
+        jassert (maximumBlockSize >= 0);
+
+        maximumDelay = jmax (0, maximumDelaySamples);
+
+        // N.B.: The extra room covers the block that was just written before reading it back,
+        //       as well as the neighbouring samples the interpolators read past the delay.
+        const auto capacity = nextPowerOfTwo (maximumDelay + jmax (1, maximumBlockSize) + numInterpolationSamples);
+
+        buffer.setSize (jmax (1, numChannels), capacity, false, false, true);
+        mask = capacity - 1;
+
+        writePositions.assign ((size_t) buffer.getNumChannels(), 0);
+        allpassStates.assign ((size_t) buffer.getNumChannels(), FloatType());
+
+        clear();
+    }
+
+    /** Frees the storage. */
+    void release()
+    {
+        buffer.setSize (0, 0);
+        writePositions.clear();
+        allpassStates.clear();
+        maximumDelay = 0;
+        mask = 0;
+    }
+
+    /** Silences the delay line, without moving its write positions. */
+    void clear() noexcept
+    {
+        buffer.clear();
+        resetInterpolatorState();
+    }
+
+    //==============================================================================
+    /** @returns true if prepare() or allocate() have been called. */
+    [[nodiscard]] bool isPrepared() const noexcept              { return ! writePositions.empty(); }
+
+    /** @returns the number of channels that were allocated. */
+    [[nodiscard]] int getNumChannels() const noexcept           { return (int) writePositions.size(); }
+
+    /** @returns the longest delay, in samples, that can be read. */
+    [[nodiscard]] int getMaximumDelaySamples() const noexcept   { return maximumDelay; }
+
+    /** @returns the number of samples allocated per channel. */
+    [[nodiscard]] int getCapacity() const noexcept              { return isPrepared() ? mask + 1 : 0; }
+
+    //==============================================================================
+    /** Pushes a sample into a channel. */
+    void pushSample (int channel, FloatType sample) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, getNumChannels()));
+
+        auto& position = writePositions[(size_t) channel];
+        buffer.setSample (channel, position, sample);
+        position = (position + 1) & mask;
+    }
+
+    /** @returns the sample pushed the specified number of samples ago,
+        where a delay of 0 is the most recently pushed sample.
+
+        The delay gets clamped to the maximum delay that was allocated.
+    */
+    [[nodiscard]] FloatType readSample (int channel, FloatType delaySamples) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, getNumChannels()));
+
+        return read (channel, writePositions[(size_t) channel] - 1, delaySamples);
+    }
+
+    /** Pushes a sample into a channel, and reads the delayed sample back.
+
+        This is the per-sample equivalent of processBlock().
+    */
+    [[nodiscard]] FloatType processSample (int channel, FloatType sample, FloatType delaySamples) noexcept
+    {
+        pushSample (channel, sample);
+        return readSample (channel, delaySamples);
+    }
+
+    //==============================================================================
+    /** Pushes a block of samples into a channel. */
+    void writeBlock (int channel, const FloatType* source, int numSamples) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, getNumChannels()));
+        jassert (source != nullptr);
+        jassert (numSamples <= getCapacity() - maximumDelay - numInterpolationSamples);
+
+        auto& position = writePositions[(size_t) channel];
+        auto* dest = buffer.getWritePointer (channel);
+
+        const auto numBeforeWrap = jmin (numSamples, mask + 1 - position);
+        FloatVectorOperations::copy (dest + position, source, numBeforeWrap);
+        FloatVectorOperations::copy (dest, source + numBeforeWrap, numSamples - numBeforeWrap);
+
+        position = (position + numSamples) & mask;
+    }
+
+    /** Reads back the delayed version of the block that was last written with writeBlock().
+
+        @param channel      The channel to read from.
+        @param dest         Where to write the delayed block to.
+        @param numSamples   The size of the block that was last written.
+        @param delaySamples The delay, in samples, which is held for the entire block.
+    */
+    void readBlock (int channel, FloatType* dest, int numSamples, FloatType delaySamples) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, getNumChannels()));
+        jassert (dest != nullptr);
+
+        const auto startPosition = writePositions[(size_t) channel] - numSamples;
+
+        if (interpolation == DelayInterpolation::none || interpolation == DelayInterpolation::linear)
+        {
+            delaySamples = clampDelay (delaySamples);
+            const auto delayInt = (int) delaySamples;
+            const auto frac = interpolation == DelayInterpolation::linear
+                                ? delaySamples - (FloatType) delayInt
+                                : FloatType();
+
+            copyFrom (channel, dest, startPosition - delayInt, numSamples, FloatType (1) - frac, false);
+
+            if (frac > FloatType())
+                copyFrom (channel, dest, startPosition - delayInt - 1, numSamples, frac, true);
+
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = read (channel, startPosition + i, delaySamples);
+    }
+
+    /** Reads back the delayed version of the block that was last written with writeBlock(),
+        using a different delay for every sample (eg: one coming from an LFO).
+    */
+    void readBlock (int channel, FloatType* dest, int numSamples, const FloatType* delaySamples) noexcept
+    {
+        jassert (isPositiveAndBelow (channel, getNumChannels()));
+        jassert (dest != nullptr && delaySamples != nullptr);
+
+        const auto startPosition = writePositions[(size_t) channel] - numSamples;
+
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = read (channel, startPosition + i, delaySamples[i]);
+    }
+
+    /** Delays a block of samples, in place, by a fixed delay. */
+    void processBlock (int channel, FloatType* samples, int numSamples, FloatType delaySamples) noexcept
+    {
+        writeBlock (channel, samples, numSamples);
+        readBlock (channel, samples, numSamples, delaySamples);
+    }
+
+    /** Delays a block of samples, in place, using a different delay for every sample. */
+    void processBlock (int channel, FloatType* samples, int numSamples, const FloatType* delaySamples) noexcept
+    {
+        writeBlock (channel, samples, numSamples);
+        readBlock (channel, samples, numSamples, delaySamples);
+    }
+
+private:
+    //==============================================================================
+    enum { numInterpolationSamples = 3 };
+
+    juce::AudioBuffer<FloatType> buffer;
+    std::vector<int> writePositions;
+    std::vector<FloatType> allpassStates;
+    DelayInterpolation interpolation = DelayInterpolation::linear;
+    int maximumDelay = 0, mask = 0;
+
+    //==============================================================================
+    void resetInterpolatorState() noexcept
+    {
+        std::fill (allpassStates.begin(), allpassStates.end(), FloatType());
+    }
+
+    FloatType clampDelay (FloatType delaySamples) const noexcept
+    {
+        return jlimit (FloatType(), (FloatType) maximumDelay, delaySamples);
+    }
+
+    FloatType getSample (const FloatType* data, int position) const noexcept
+    {
+        return data[position & mask];
+    }
+
+    /** Copies (or adds) a run of samples starting at an unwrapped position, applying a gain. */
+    void copyFrom (int channel, FloatType* dest, int position, int numSamples, FloatType gain, bool add) const noexcept
+    {
+        const auto* source = buffer.getReadPointer (channel);
+        position &= mask;
+
+        const auto numBeforeWrap = jmin (numSamples, mask + 1 - position);
+        const auto numAfterWrap = numSamples - numBeforeWrap;
+
+        if (add)
+        {
+            FloatVectorOperations::addWithMultiply (dest, source + position, gain, numBeforeWrap);
+            FloatVectorOperations::addWithMultiply (dest + numBeforeWrap, source, gain, numAfterWrap);
+        }
+        else
+        {
+            FloatVectorOperations::copyWithMultiply (dest, source + position, gain, numBeforeWrap);
+            FloatVectorOperations::copyWithMultiply (dest + numBeforeWrap, source, gain, numAfterWrap);
+        }
+    }
+
+    /** Reads a sample delayed from the specified position, which is that of a sample already written. */
+    FloatType read (int channel, int position, FloatType delaySamples) noexcept
+    {
+        const auto* data = buffer.getReadPointer (channel);
+
+        delaySamples = clampDelay (delaySamples);
+        const auto delayInt = (int) delaySamples;
+        const auto frac = delaySamples - (FloatType) delayInt;
+        const auto readPosition = position - delayInt;
+
+        switch (interpolation)
+        {
+            case DelayInterpolation::none:
+                return getSample (data, readPosition);
+
+            case DelayInterpolation::linear:
+            {
+                const auto a = getSample (data, readPosition);
+                const auto b = getSample (data, readPosition - 1);
+                return a + frac * (b - a);
+            }
+
+            case DelayInterpolation::cubic:
+            {
+                // The Lagrange kernel needs a sample on each side of the delay,
+                // which doesn't exist yet for delays under a sample:
+                if (delayInt < 1)
+                {
+                    const auto a = getSample (data, readPosition);
+                    const auto b = getSample (data, readPosition - 1);
+                    return a + frac * (b - a);
+                }
+
+                const auto ym1 = getSample (data, readPosition + 1);
+                const auto y0  = getSample (data, readPosition);
+                const auto y1  = getSample (data, readPosition - 1);
+                const auto y2  = getSample (data, readPosition - 2);
+
+                const auto d1 = frac - FloatType (1);
+                const auto d2 = frac - FloatType (2);
+                const auto d3 = frac + FloatType (1);
+
+                const auto c0 = -frac * d1 * d2 / FloatType (6);
+                const auto c1 = d3 * d1 * d2 / FloatType (2);
+                const auto c2 = -d3 * frac * d2 / FloatType (2);
+                const auto c3 = d3 * frac * d1 / FloatType (6);
+
+                return c0 * ym1 + c1 * y0 + c2 * y1 + c3 * y2;
+            }
+
+            case DelayInterpolation::allpass:
+            {
+                auto& state = allpassStates[(size_t) channel];
+                const auto a = getSample (data, readPosition);
+
+                if (frac <= FloatType())
+                {
+                    state = a;
+                    return a;
+                }
+
+                const auto b = getSample (data, readPosition - 1);
+                const auto coefficient = (FloatType (1) - frac) / (FloatType (1) + frac);
+
+                state = b + coefficient * (a - state);
+                return state;
+            }
+
+            default:
+                jassertfalse;
+                return FloatType();
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InterpolatedDelayLine)
+};
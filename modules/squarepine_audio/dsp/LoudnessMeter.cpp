@@ -0,0 +1,527 @@
+//==============================================================================
+void LoudnessMeter::Histogram::reset() noexcept
+{
+    counts.fill (0);
+    powers.fill (0.0);
+}
+
+void LoudnessMeter::Histogram::add (double power) noexcept
+{
+    const auto loudness = (double) toLoudness (power);
+
+    // The absolute gate:
+    if (loudness < minimumLoudness)
+        return;
+
+    const auto index = (size_t) getBinIndex (loudness);
+    ++counts[index];
+    powers[index] += power;
+}
+
+int LoudnessMeter::Histogram::getBinIndex (double loudness) noexcept
+{
+    return jlimit (0, numBins - 1, (int) ((loudness - minimumLoudness) * binsPerLU));
+}
+
+double LoudnessMeter::Histogram::getBinLoudness (int index) noexcept
+{
+    return minimumLoudness + ((double) index + 0.5) / binsPerLU;
+}
+
+int LoudnessMeter::Histogram::getFirstBinAboveRelativeGate (double relativeGate) const noexcept
+{
+    int64 count = 0;
+    auto power = 0.0;
+
+    for (int i = 0; i < numBins; ++i)
+    {
+        count += counts[(size_t) i];
+        power += powers[(size_t) i];
+    }
+
+    if (count <= 0)
+        return -1;
+
+    return getBinIndex ((double) toLoudness (power / (double) count) + relativeGate);
+}
+
+float LoudnessMeter::Histogram::getGatedLoudness (double relativeGate) const noexcept
+{
+    const auto firstBin = getFirstBinAboveRelativeGate (relativeGate);
+    if (firstBin < 0)
+        return silence;
+
+    int64 count = 0;
+    auto power = 0.0;
+
+    for (int i = firstBin; i < numBins; ++i)
+    {
+        count += counts[(size_t) i];
+        power += powers[(size_t) i];
+    }
+
+    return count > 0 ? toLoudness (power / (double) count) : silence;
+}
+
+float LoudnessMeter::Histogram::getRange (double relativeGate) const noexcept
+{
+    const auto firstBin = getFirstBinAboveRelativeGate (relativeGate);
+    if (firstBin < 0)
+        return 0.0f;
+
+    int64 count = 0;
+    for (int i = firstBin; i < numBins; ++i)
+        count += counts[(size_t) i];
+
+    if (count <= 0)
+        return 0.0f;
+
+    auto getPercentile = [&] (double percentile)
+    {
+        const auto target = (int64) (percentile * (double) (count - 1));
+        int64 cumulative = 0;
+
+        for (int i = firstBin; i < numBins; ++i)
+        {
+            cumulative += counts[(size_t) i];
+
+            if (cumulative > target)
+                return getBinLoudness (i);
+        }
+
+        return getBinLoudness (numBins - 1);
+    };
+
+    return (float) (getPercentile (0.95) - getPercentile (0.1));
+}
+
+//==============================================================================
+void LoudnessMeter::Accumulator::prepare (double sampleRate, int numChannels, int maximumBlockSize, const AudioChannelSet& layout)
+{
+    jassert (sampleRate > 0.0 && numChannels > 0 && maximumBlockSize > 0);
+
+    numChannels = jmax (1, numChannels);
+    maximumBlockSize = jmax (1, maximumBlockSize);
+
+    // The K-weighting filters, from BS.1770's 48 kHz coefficients, redesigned for any sample rate.
+    kWeighting.clearSections();
+
+    {
+        // The pre-filter: a high shelf, accounting for the acoustic effects of the head.
+        constexpr auto frequency = 1681.974450955533, gain = 3.999843853973347, q = 0.7071752369554196;
+
+        const auto k = std::tan (MathConstants<double>::pi * frequency / sampleRate);
+        const auto vh = std::pow (10.0, gain / 20.0);
+        const auto vb = std::pow (vh, 0.4996667741545416);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        kWeighting.addSection ({ (float) ((vh + vb * k / q + k * k) / a0),
+                                 (float) (2.0 * (k * k - vh) / a0),
+                                 (float) ((vh - vb * k / q + k * k) / a0),
+                                 (float) (2.0 * (k * k - 1.0) / a0),
+                                 (float) ((1.0 - k / q + k * k) / a0) });
+    }
+
+    {
+        // The RLB filter: a high pass. N.B.: BS.1770 leaves its numerator unnormalised.
+        constexpr auto frequency = 38.13547087602444, q = 0.5003270373238773;
+
+        const auto k = std::tan (MathConstants<double>::pi * frequency / sampleRate);
+        const auto a0 = 1.0 + k / q + k * k;
+
+        kWeighting.addSection ({ 1.0f, -2.0f, 1.0f,
+                                 (float) (2.0 * (k * k - 1.0) / a0),
+                                 (float) ((1.0 - k / q + k * k) / a0) });
+    }
+
+    kWeighting.prepare (numChannels);
+    truePeak.prepare (numChannels, maximumBlockSize);
+    weighted.setSize (numChannels, maximumBlockSize, false, true, false);
+
+    channelWeights.assign ((size_t) numChannels, 1.0);
+
+    if (layout.size() == numChannels)
+    {
+        for (int c = 0; c < numChannels; ++c)
+        {
+            switch (layout.getTypeOfChannel (c))
+            {
+                case AudioChannelSet::LFE:
+                case AudioChannelSet::LFE2:
+                    channelWeights[(size_t) c] = 0.0;
+                break;
+
+                case AudioChannelSet::leftSurround:
+                case AudioChannelSet::rightSurround:
+                case AudioChannelSet::leftSurroundSide:
+                case AudioChannelSet::rightSurroundSide:
+                case AudioChannelSet::leftSurroundRear:
+                case AudioChannelSet::rightSurroundRear:
+                    channelWeights[(size_t) c] = 1.41;
+                break;
+
+                default:
+                break;
+            };
+        }
+    }
+
+    stepSize = jmax (1, roundToInt (sampleRate / 10.0));
+    reset();
+}
+
+void LoudnessMeter::Accumulator::reset() noexcept
+{
+    kWeighting.reset();
+    truePeak.reset();
+    weighted.clear();
+    stepPower = 0.0;
+    stepPosition = 0;
+}
+
+template<typename SampleType, typename StepFunction>
+void LoudnessMeter::Accumulator::process (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                                          StepFunction&& onStep) noexcept
+{
+    // You need to call prepare() first!
+    jassert (stepSize > 0);
+
+    if (stepSize <= 0 || numSamples <= 0)
+        return;
+
+    truePeak.analyse (buffer, startSample, numSamples);
+
+    const auto numChannels = weighted.getNumChannels();
+    const auto numInputChannels = jmin (numChannels, buffer.getNumChannels());
+    const auto maximumBlockSize = weighted.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += maximumBlockSize)
+    {
+        const auto numThisTime = jmin (maximumBlockSize, numSamples - start);
+
+        for (int c = 0; c < numInputChannels; ++c)
+        {
+            const auto* source = buffer.getReadPointer (c, startSample + start);
+            auto* destination = weighted.getWritePointer (c);
+
+            for (int n = 0; n < numThisTime; ++n)
+                destination[n] = (float) source[n];
+        }
+
+        for (int c = numInputChannels; c < numChannels; ++c)
+            weighted.clear (c, 0, numThisTime);
+
+        kWeighting.process (weighted, 0, numThisTime);
+
+        for (int offset = 0; offset < numThisTime;)
+        {
+            const auto numInStep = jmin (numThisTime - offset, stepSize - stepPosition);
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                const auto weight = channelWeights[(size_t) c];
+                if (weight == 0.0)
+                    continue;
+
+                const auto* samples = weighted.getReadPointer (c, offset);
+                auto sum = 0.0;
+
+                for (int n = 0; n < numInStep; ++n)
+                    sum += (double) (samples[n] * samples[n]);
+
+                stepPower += weight * sum;
+            }
+
+            offset += numInStep;
+            stepPosition += numInStep;
+
+            if (stepPosition >= stepSize)
+            {
+                onStep (stepPower / (double) stepSize);
+                stepPower = 0.0;
+                stepPosition = 0;
+            }
+        }
+    }
+}
+
+//==============================================================================
+void LoudnessMeter::prepare (double sampleRate, int numChannels, int maximumBlockSize, const AudioChannelSet& layout)
+{
+    accumulator.prepare (sampleRate, numChannels, maximumBlockSize, layout);
+    reset();
+}
+
+void LoudnessMeter::reset()
+{
+    accumulator.reset();
+    momentaryHistogram.reset();
+    shortTermHistogram.reset();
+    recentSteps.fill (0.0);
+    numSteps = 0;
+
+    latest = {};
+    publishResults();
+}
+
+//==============================================================================
+void LoudnessMeter::process (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    measure (buffer, startSample, numSamples);
+}
+
+void LoudnessMeter::process (const juce::AudioBuffer<double>& buffer, int startSample, int numSamples) noexcept
+{
+    measure (buffer, startSample, numSamples);
+}
+
+template<typename SampleType>
+void LoudnessMeter::measure (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples) noexcept
+{
+    const auto numStepsBefore = numSteps;
+
+    accumulator.process (buffer, startSample, numSamples, [this] (double power) { addStep (power); });
+
+    // N.B.: The gating only changes when a step completes, and it scans the histograms,
+    //       so it's done once for however many steps this block completed.
+    if (numSteps != numStepsBefore)
+        updateGatedResults();
+
+    auto peak = 0.0f;
+    for (int c = 0; c < accumulator.truePeak.getNumChannels(); ++c)
+        peak = jmax (peak, accumulator.truePeak.getPeak (c));
+
+    updateTruePeak (peak);
+    publishResults();
+}
+
+//==============================================================================
+LoudnessMeter::Results LoudnessMeter::getResults() const noexcept
+{
+    Results results;
+
+    resultsLock.read ([&]
+    {
+        results.momentary = momentary.load (std::memory_order_relaxed);
+        results.shortTerm = shortTerm.load (std::memory_order_relaxed);
+        results.integrated = integrated.load (std::memory_order_relaxed);
+        results.range = range.load (std::memory_order_relaxed);
+        results.truePeak = maximumTruePeak.load (std::memory_order_relaxed);
+    });
+
+    return results;
+}
+
+void LoudnessMeter::publishResults() noexcept
+{
+    const SequenceLock::ScopedWrite write (resultsLock);
+
+    momentary.store (latest.momentary, std::memory_order_relaxed);
+    shortTerm.store (latest.shortTerm, std::memory_order_relaxed);
+    integrated.store (latest.integrated, std::memory_order_relaxed);
+    range.store (latest.range, std::memory_order_relaxed);
+    maximumTruePeak.store (latest.truePeak, std::memory_order_relaxed);
+}
+
+//==============================================================================
+float LoudnessMeter::toLoudness (double power) noexcept
+{
+    if (power <= 0.0)
+        return silence;
+
+    return (float) (-0.691 + 10.0 * std::log10 (power));
+}
+
+double LoudnessMeter::getRecentPower (int numRecentSteps) const noexcept
+{
+    jassert (isPositiveAndNotGreaterThan (numRecentSteps, stepsPerShortTermBlock));
+
+    auto power = 0.0;
+
+    for (int i = 1; i <= numRecentSteps; ++i)
+        power += recentSteps[(size_t) ((numSteps - i) % stepsPerShortTermBlock)];
+
+    return power / (double) numRecentSteps;
+}
+
+void LoudnessMeter::addStep (double power) noexcept
+{
+    recentSteps[(size_t) (numSteps % stepsPerShortTermBlock)] = power;
+    ++numSteps;
+
+    if (numSteps >= stepsPerMomentaryBlock)
+    {
+        const auto blockPower = getRecentPower (stepsPerMomentaryBlock);
+        momentaryHistogram.add (blockPower);
+        latest.momentary = toLoudness (blockPower);
+    }
+
+    if (numSteps >= stepsPerShortTermBlock)
+    {
+        const auto blockPower = getRecentPower (stepsPerShortTermBlock);
+        shortTermHistogram.add (blockPower);
+        latest.shortTerm = toLoudness (blockPower);
+    }
+}
+
+void LoudnessMeter::updateGatedResults() noexcept
+{
+    latest.integrated = momentaryHistogram.getGatedLoudness (-10.0);
+    latest.range = shortTermHistogram.getRange (-20.0);
+}
+
+void LoudnessMeter::updateTruePeak (float peak) noexcept
+{
+    latest.truePeak = peak > 0.0f ? Decibels::gainToDecibels (peak, -1000.0f) : silence;
+}
+
+//==============================================================================
+LoudnessMeter::Results LoudnessMeter::analyse (AudioFormatManager& formatManager, const File& file, ThreadPool* threadPool)
+{
+    std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (file));
+
+    if (reader == nullptr)
+    {
+        jassertfalse;
+        return {};
+    }
+
+    auto createReader = [&formatManager, file]() -> ReadFunction
+    {
+        // Each segment gets a reader of its own, so they can all read at the same time.
+        std::shared_ptr<AudioFormatReader> segmentReader (formatManager.createReaderFor (file));
+
+        return [segmentReader] (juce::AudioBuffer<float>& destination, int64 startSample, int numSamples)
+        {
+            if (segmentReader != nullptr)
+                segmentReader->read (&destination, 0, numSamples, startSample, true, true);
+            else
+                destination.clear (0, numSamples);
+        };
+    };
+
+    return analyse (reader->lengthInSamples, reader->sampleRate, (int) reader->numChannels,
+                    reader->getChannelLayout(), threadPool, createReader);
+}
+
+LoudnessMeter::Results LoudnessMeter::analyse (const juce::AudioBuffer<float>& buffer, double sampleRate, ThreadPool* threadPool)
+{
+    auto createReader = [&buffer]() -> ReadFunction
+    {
+        return [&buffer] (juce::AudioBuffer<float>& destination, int64 startSample, int numSamples)
+        {
+            for (int c = 0; c < destination.getNumChannels(); ++c)
+                destination.copyFrom (c, 0, buffer, c, (int) startSample, numSamples);
+        };
+    };
+
+    return analyse ((int64) buffer.getNumSamples(), sampleRate, buffer.getNumChannels(), {}, threadPool, createReader);
+}
+
+LoudnessMeter::Results LoudnessMeter::analyse (int64 lengthInSamples, double sampleRate, int numChannels, const AudioChannelSet& layout,
+                                               ThreadPool* threadPool, const std::function<ReadFunction()>& createReader)
+{
+    if (lengthInSamples <= 0 || sampleRate <= 0.0 || numChannels <= 0)
+        return {};
+
+    const auto stepSize = jmax (1, roundToInt (sampleRate / 10.0));
+    const auto totalNumSteps = lengthInSamples / stepSize;  // Like in realtime, a trailing partial step isn't measured.
+    const auto blockSize = stepSize * 4;
+
+    // This is ample time for the K-weighting and the true-peak filters to settle.
+    const auto numPreRollSamples = (int64) blockSize;
+
+    const auto numSegments = (int) jlimit ((int64) 1, jmax ((int64) 1, totalNumSteps),
+                                           (int64) (threadPool != nullptr ? threadPool->getNumThreads() + 1 : 1));
+    const auto stepsPerSegment = (totalNumSteps + numSegments - 1) / numSegments;
+
+    std::vector<double> steps ((size_t) totalNumSteps, 0.0);
+    std::vector<float> segmentPeaks ((size_t) numSegments, 0.0f);
+
+    auto analyseSegment = [&] (int segment)
+    {
+        const auto firstStep = (int64) segment * stepsPerSegment;
+        const auto endStep = jmin (totalNumSteps, firstStep + stepsPerSegment);
+        const auto segmentStart = firstStep * stepSize;
+        const auto segmentEnd = segment == numSegments - 1 ? lengthInSamples : endStep * stepSize;
+
+        if (segmentEnd <= segmentStart)
+            return;
+
+        auto read = createReader();
+        juce::AudioBuffer<float> block (numChannels, blockSize);
+
+        Accumulator accumulator;
+        accumulator.prepare (sampleRate, numChannels, blockSize, layout);
+
+        for (auto position = jmax ((int64) 0, segmentStart - numPreRollSamples); position < segmentStart;)
+        {
+            const auto numThisTime = (int) jmin ((int64) blockSize, segmentStart - position);
+            read (block, position, numThisTime);
+            accumulator.process (block, 0, numThisTime, [] (double) {});
+            position += numThisTime;
+        }
+
+        // Only the filter states are carried over from the pre-roll.
+        accumulator.stepPower = 0.0;
+        accumulator.stepPosition = 0;
+
+        for (int c = 0; c < numChannels; ++c)
+            accumulator.truePeak.getAndResetPeak (c);
+
+        auto stepIndex = firstStep;
+
+        for (auto position = segmentStart; position < segmentEnd;)
+        {
+            const auto numThisTime = (int) jmin ((int64) blockSize, segmentEnd - position);
+            read (block, position, numThisTime);
+
+            accumulator.process (block, 0, numThisTime, [&] (double power)
+            {
+                if (stepIndex < endStep)
+                    steps[(size_t) stepIndex++] = power;
+            });
+
+            position += numThisTime;
+        }
+
+        for (int c = 0; c < numChannels; ++c)
+            segmentPeaks[(size_t) segment] = jmax (segmentPeaks[(size_t) segment], accumulator.truePeak.getPeak (c));
+    };
+
+    if (threadPool != nullptr && numSegments > 1)
+    {
+        WaitableEvent finished;
+        std::atomic<int> numRemaining { numSegments - 1 };
+
+        for (int segment = 1; segment < numSegments; ++segment)
+        {
+            threadPool->addJob ([&, segment]()
+            {
+                analyseSegment (segment);
+
+                if (--numRemaining == 0)
+                    finished.signal();
+            });
+        }
+
+        // The calling thread does its share too.
+        analyseSegment (0);
+        finished.wait();
+    }
+    else
+    {
+        for (int segment = 0; segment < numSegments; ++segment)
+            analyseSegment (segment);
+    }
+
+    // The gating needs every step, in order, so it's done here; it's cheap in comparison.
+    auto meter = std::make_unique<LoudnessMeter>();
+
+    for (const auto power : steps)
+        meter->addStep (power);
+
+    meter->updateGatedResults();
+    meter->updateTruePeak (*std::max_element (segmentPeaks.begin(), segmentPeaks.end()));
+    return meter->latest;
+}
@@ -0,0 +1,186 @@
+/** Measures programme loudness, following ITU-R BS.1770-4 and EBU R128.
+
+    Every channel is K-weighted (with a BiquadBank, so the channels are filtered
+    in SIMD groups), and the weighted power is summed up in 100 ms steps. From those:
+    - the momentary loudness is the last 400 ms,
+    - the short-term loudness is the last 3 s,
+    - the integrated loudness gates the 400 ms blocks at -70 LUFS and then 10 LU below
+      their loudness, as per BS.1770,
+    - the loudness range gates the short-term values at -70 LUFS and then 20 LU below
+      their loudness, and spans their 10th to 95th percentile, as per EBU Tech 3342.
+
+    The true-peak of every channel is measured with a TruePeakDetector.
+
+    The gating is done on a pair of fixed-size histograms, so nothing is allocated
+    nor kept around per block, however long the programme runs for. The results are
+    published once per call to process(), behind a SequenceLock, so any thread can read
+    a consistent set of them with getResults() without locking.
+
+    For offline use, see analyse(), which splits the programme up across a ThreadPool.
+
+    @see LevelsProcessor, TruePeakDetector
+*/
+class LoudnessMeter final
+{
+public:
+    /** Constructor. */
+    LoudnessMeter() = default;
+
+    //==============================================================================
+    /** The loudness value reported when there's nothing to measure yet, or when there's only silence. */
+    static constexpr float silence = -std::numeric_limits<float>::infinity();
+
+    /** A snapshot of everything measured. */
+    struct Results final
+    {
+        float momentary = silence;      //< In LUFS.
+        float shortTerm = silence;      //< In LUFS.
+        float integrated = silence;     //< In LUFS.
+        float range = 0.0f;             //< In LU.
+        float truePeak = silence;       //< In dBTP, the largest of every channel.
+    };
+
+    //==============================================================================
+    /** Allocates everything needed to measure the specified number of channels.
+
+        @param sampleRate       The sample rate of the audio to measure.
+        @param numChannels      The number of channels to measure.
+        @param maximumBlockSize The largest number of samples expected per call to process().
+        @param layout           If this matches the number of channels, it's used to weigh
+                                the channels as per BS.1770: the LFE is ignored, and the
+                                surrounds are boosted by 1.5 dB. Otherwise, every channel
+                                has the same weight.
+    */
+    void prepare (double sampleRate, int numChannels, int maximumBlockSize,
+                  const AudioChannelSet& layout = {});
+
+    /** Starts the measurements over. */
+    void reset();
+
+    //==============================================================================
+    /** Measures a range of a buffer. */
+    void process (const juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+    /** Measures a range of a buffer. */
+    void process (const juce::AudioBuffer<double>& buffer, int startSample, int numSamples) noexcept;
+
+    //==============================================================================
+    /** @returns the latest measurements, all from the same call to process().
+        This is lock-free, and can be called from any thread.
+    */
+    [[nodiscard]] Results getResults() const noexcept;
+
+    /** @returns the largest true-peak of a channel since the last reset, as a gain.
+        This is lock-free, and can be called from any thread.
+    */
+    [[nodiscard]] float getTruePeak (int channel) const noexcept { return accumulator.truePeak.getPeak (channel); }
+
+    /** @returns the largest true-peak of a channel in the last block, as a gain.
+        This is only meant to be called from the audio thread.
+    */
+    [[nodiscard]] float getBlockTruePeak (int channel) const noexcept { return accumulator.truePeak.getBlockPeak (channel); }
+
+    //==============================================================================
+    /** Measures a whole file, which tends to be much faster than realtime.
+
+        The file is split into as many segments as there are threads in the pool, and
+        each segment is K-weighted and summed up on its own thread, with its own reader.
+        Every segment starts filtering a little ahead of time so its filters have settled
+        by the time they're needed. The gating is then done on the calling thread.
+
+        @param formatManager    Used to create a reader for each segment.
+        @param file             The file to measure.
+        @param threadPool       The pool to split the work across. If null, everything
+                                is measured on the calling thread.
+
+        @returns the measurements of the whole file, where the momentary and short-term
+                 values are the ones at the very end.
+    */
+    static Results analyse (AudioFormatManager& formatManager, const File& file, ThreadPool* threadPool = nullptr);
+
+    /** Measures a whole buffer in one go, in the same way as the file version.
+
+        @see analyse
+    */
+    static Results analyse (const juce::AudioBuffer<float>& buffer, double sampleRate, ThreadPool* threadPool = nullptr);
+
+private:
+    //==============================================================================
+    /** Tallies loudness values, within 0.1 LU, so they can be gated after the fact. */
+    class Histogram final
+    {
+    public:
+        void reset() noexcept;
+        void add (double power) noexcept;
+
+        /** @returns the loudness of everything over the absolute gate, and then over the relative gate, in LUFS. */
+        float getGatedLoudness (double relativeGate) const noexcept;
+
+        /** @returns the spread between the 10th and 95th percentiles of everything above the gates, in LU. */
+        float getRange (double relativeGate) const noexcept;
+
+    private:
+        static constexpr double minimumLoudness = -70.0, maximumLoudness = 10.0, binsPerLU = 10.0;
+        static constexpr int numBins = (int) ((maximumLoudness - minimumLoudness) * binsPerLU);
+
+        std::array<int64, numBins> counts {};
+        std::array<double, numBins> powers {};
+
+        static int getBinIndex (double loudness) noexcept;
+        static double getBinLoudness (int index) noexcept;
+        int getFirstBinAboveRelativeGate (double relativeGate) const noexcept;
+    };
+
+    //==============================================================================
+    /** K-weights the audio, sums up its power in 100 ms steps, and measures its true-peak. */
+    struct Accumulator final
+    {
+        void prepare (double sampleRate, int numChannels, int maximumBlockSize, const AudioChannelSet& layout);
+        void reset() noexcept;
+
+        /** Calls onStep with the mean weighted power of every 100 ms step that's completed. */
+        template<typename SampleType, typename StepFunction>
+        void process (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                      StepFunction&& onStep) noexcept;
+
+        BiquadBank<float> kWeighting;
+        TruePeakDetector truePeak;
+        juce::AudioBuffer<float> weighted;
+        std::vector<double> channelWeights;
+        double stepPower = 0.0;
+        int stepSize = 0, stepPosition = 0;
+    };
+
+    //==============================================================================
+    static constexpr int stepsPerMomentaryBlock = 4, stepsPerShortTermBlock = 30;
+
+    Accumulator accumulator;
+    Histogram momentaryHistogram, shortTermHistogram;
+    std::array<double, stepsPerShortTermBlock> recentSteps {};
+    int64 numSteps = 0;
+
+    Results latest;     // Only touched by the thread doing the measuring.
+
+    SequenceLock resultsLock;
+    std::atomic<float> momentary { silence }, shortTerm { silence }, integrated { silence },
+                       range { 0.0f }, maximumTruePeak { silence };
+
+    //==============================================================================
+    void addStep (double power) noexcept;
+    void updateGatedResults() noexcept;
+    void updateTruePeak (float peak) noexcept;
+    void publishResults() noexcept;
+
+    template<typename SampleType>
+    void measure (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples) noexcept;
+
+    double getRecentPower (int numRecentSteps) const noexcept;
+    static float toLoudness (double power) noexcept;
+    /** Reads a range of the programme into the start of a buffer. */
+    using ReadFunction = std::function<void (juce::AudioBuffer<float>& destination, int64 startSample, int numSamples)>;
+
+    static Results analyse (int64 lengthInSamples, double sampleRate, int numChannels, const AudioChannelSet& layout,
+                            ThreadPool* threadPool, const std::function<ReadFunction()>& createReader);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LoudnessMeter)
+};
@@ -0,0 +1,333 @@
+/** Splits a signal into any number of frequency bands using 4th-order
+    Linkwitz-Riley crossovers, and sums back the bands that are enabled.
+
+    The bands are split off one crossover at a time: each crossover's low-pass
+    output is a band, and its high-pass output feeds the next crossover.
+    Every band is then run through the allpass equivalent of the crossovers above
+    it so that all of the bands line up in phase. The result is that summing every
+    band gives back a flat, allpassed, version of the input, and that summing any
+    subset of the bands has no phase cancellation around the crossover points.
+
+    Everything is computed in a single pass; the input is read once and the sum of
+    the enabled bands is written straight to the destination. Only the filters
+    feeding an enabled band are run at all.
+
+    The channels are processed in groups, one channel per SIMD lane (eg: 4 floats
+    or 2 doubles at a time with SSE or NEON), so wide layouts cost a fraction of
+    running every channel on its own. Any number of channels is supported.
+
+    @code
+        MultibandCrossover<float> crossover ({ 300.0f, 5000.0f }); // 3 bands
+        crossover.prepare (sampleRate, 2);
+
+        // And then, on the audio thread:
+        crossover.setBandEnabled (1, false); // Lose the mids.
+        crossover.process (buffer, buffer, buffer.getNumChannels(), buffer.getNumSamples());
+    @endcode
+*/
+template<typename FloatType>
+class MultibandCrossover final
+{
+public:
+    /** Constructor.
+
+        @param crossoverFrequencies The crossover frequencies, in Hz and in ascending order.
+                                    N crossover frequencies will make N + 1 bands.
+    */
+    MultibandCrossover (const std::vector<FloatType>& crossoverFrequencies = {})
+    {
+        setCrossoverFrequencies (crossoverFrequencies);
+    }
+
+    //==============================================================================
+    /** Changes the crossover frequencies.
+
+        This allocates if the number of bands changes, so it should not be called
+        from the audio thread in that case.
+
+        @param crossoverFrequencies The crossover frequencies, in Hz and in ascending order.
+                                    N crossover frequencies will make N + 1 bands.
+    */
+    void setCrossoverFrequencies (const std::vector<FloatType>& crossoverFrequencies)
+    {
+        jassert (std::is_sorted (crossoverFrequencies.begin(), crossoverFrequencies.end()));
+
+        const auto numBandsChanged = bandsEnabled.empty() || crossoverFrequencies.size() != frequencies.size();
+
+        frequencies = crossoverFrequencies;
+        crossovers.resize (frequencies.size());
+
+        if (numBandsChanged)
+        {
+            bandsEnabled.assign ((size_t) getNumBands(), true);
+            bandsActive.assign ((size_t) getNumBands(), false);
+            highPassesActive.assign (frequencies.size(), false);
+            allocateStates();
+        }
+
+        updateCoefficients();
+    }
+
+    /** @returns the number of bands, which is one more than the number of crossovers. */
+    [[nodiscard]] int getNumBands() const noexcept { return (int) frequencies.size() + 1; }
+
+    //==============================================================================
+    /** Prepares the crossover to process the specified number of channels. */
+    void prepare (double newSampleRate, int newNumChannels)
+    {
+        jassert (newSampleRate > 0.0);
+        jassert (newNumChannels > 0);
+
+        sampleRate = newSampleRate;
+        numChannels = jmax (1, newNumChannels);
+
+        allocateStates();
+        updateCoefficients();
+    }
+
+    /** Clears the state of every filter. */
+    void reset() noexcept
+    {
+        std::fill (states.begin(), states.end(), State());
+    }
+
+    //==============================================================================
+    /** Enables or disables a band, where band 0 is the lowest. */
+    void setBandEnabled (int band, bool shouldBeEnabled) noexcept
+    {
+        if (isPositiveAndBelow (band, getNumBands()))
+            bandsEnabled[(size_t) band] = shouldBeEnabled;
+    }
+
+    /** @returns true if the band is enabled, where band 0 is the lowest. */
+    [[nodiscard]] bool isBandEnabled (int band) const noexcept
+    {
+        return isPositiveAndBelow (band, getNumBands()) && bandsEnabled[(size_t) band];
+    }
+
+    //==============================================================================
+    /** Writes the sum of the enabled bands to the destination.
+
+        The source and destination can be the same buffer.
+    */
+    void process (const juce::AudioBuffer<FloatType>& source, juce::AudioBuffer<FloatType>& destination,
+                  int numChannelsToProcess, int numSamples) noexcept
+    {
+        numChannelsToProcess = jmin (numChannelsToProcess, numChannels,
+                                     source.getNumChannels(), destination.getNumChannels());
+
+        jassert (numSamples <= source.getNumSamples() && numSamples <= destination.getNumSamples());
+
+        updateActiveFilters();
+
+        const auto numCrossovers = (int) crossovers.size();
+        const auto lastBand = numCrossovers;
+        const auto lastBandActive = bandsActive[(size_t) lastBand];
+
+        for (int firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += laneWidth)
+        {
+            const auto numLanes = jmin (laneWidth, numChannelsToProcess - firstChannel);
+            std::array<const FloatType*, laneWidth> inputs {};
+            std::array<FloatType*, laneWidth> outputs {};
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                inputs[(size_t) lane] = source.getReadPointer (firstChannel + lane);
+                outputs[(size_t) lane] = destination.getWritePointer (firstChannel + lane);
+            }
+
+            auto* groupStates = getGroupStates (firstChannel / laneWidth);
+
+            for (int n = 0; n < numSamples; ++n)
+            {
+                // N.B.: Any unused lanes are left at 0, which keeps their filters silent.
+                auto remaining = Vector::expand (FloatType());
+                auto sum = Vector::expand (FloatType());
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                    remaining.set ((size_t) lane, inputs[(size_t) lane][n]);
+
+                for (int i = 0; i < numCrossovers; ++i)
+                {
+                    const auto& crossover = crossovers[(size_t) i];
+                    auto* crossoverStates = groupStates + getFirstStateIndex (i);
+
+                    if (bandsActive[(size_t) i])
+                    {
+                        auto band = crossover.lowPass.process (crossoverStates[0], remaining);
+                        band = crossover.lowPass.process (crossoverStates[1], band);
+
+                        for (int j = i + 1; j < numCrossovers; ++j)
+                            band = crossovers[(size_t) j].allPass.process (crossoverStates[4 + j - (i + 1)], band);
+
+                        sum += band;
+                    }
+
+                    if (! highPassesActive[(size_t) i])
+                        break;
+
+                    remaining = crossover.highPass.process (crossoverStates[2], remaining);
+                    remaining = crossover.highPass.process (crossoverStates[3], remaining);
+                }
+
+                if (lastBandActive)
+                    sum += remaining;
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                    outputs[(size_t) lane][n] = sum.get ((size_t) lane);
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    using Vector = dsp::SIMDRegister<FloatType>;
+
+    /** The number of channels processed together. */
+    static constexpr int laneWidth = (int) Vector::size();
+
+    /** The transposed direct form II state of a single biquad, for a group of channels. */
+    struct State final
+    {
+        Vector s1 = Vector::expand (FloatType()),
+               s2 = Vector::expand (FloatType());
+    };
+
+    struct Biquad final
+    {
+        FloatType b0 = FloatType (1), b1 = FloatType(), b2 = FloatType(),
+                  a1 = FloatType(), a2 = FloatType();
+
+        Vector process (State& state, Vector x) const noexcept
+        {
+            const auto y = x * b0 + state.s1;
+            state.s1 = x * b1 - y * a1 + state.s2;
+            state.s2 = x * b2 - y * a2;
+            return y;
+        }
+    };
+
+    /** A Linkwitz-Riley crossover is a pair of cascaded Butterworth biquads per side,
+        and the sum of both sides is a single 2nd-order allpass.
+    */
+    struct Crossover final
+    {
+        Biquad lowPass, highPass, allPass;
+    };
+
+    //==============================================================================
+    std::vector<FloatType> frequencies;
+    std::vector<Crossover> crossovers;
+    std::vector<State> states;              // Planar per group of channels: every state of the first group, then the next, etc.
+    std::vector<int> stateOffsets { 0 };
+    std::vector<bool> bandsEnabled, bandsActive, highPassesActive;
+    double sampleRate = 44100.0;
+    int numChannels = 2;
+
+    //==============================================================================
+    /** Each crossover has 2 low-pass and 2 high-pass states,
+        followed by one allpass state per crossover above it.
+    */
+    int getNumStatesForCrossover (int index) const noexcept
+    {
+        return 4 + (int) crossovers.size() - (index + 1);
+    }
+
+    int getFirstStateIndex (int crossoverIndex) const noexcept
+    {
+        return stateOffsets[(size_t) crossoverIndex];
+    }
+
+    int getNumStatesPerChannel() const noexcept
+    {
+        return stateOffsets.back();
+    }
+
+    int getNumGroups() const noexcept
+    {
+        return (numChannels + laneWidth - 1) / laneWidth;
+    }
+
+    State* getGroupStates (int group) noexcept
+    {
+        return states.data() + (size_t) (group * getNumStatesPerChannel());
+    }
+
+    void allocateStates()
+    {
+        stateOffsets.assign (crossovers.size() + 1, 0);
+
+        for (size_t i = 0; i < crossovers.size(); ++i)
+            stateOffsets[i + 1] = stateOffsets[i] + getNumStatesForCrossover ((int) i);
+
+        states.assign ((size_t) (getNumGroups() * getNumStatesPerChannel()), State());
+    }
+
+    void updateCoefficients() noexcept
+    {
+        constexpr auto butterworthQ = 1.0 / MathConstants<double>::sqrt2;
+        const auto nyquist = sampleRate * 0.5;
+
+        for (size_t i = 0; i < crossovers.size(); ++i)
+        {
+            const auto frequency = jlimit (1.0, nyquist * 0.95, (double) frequencies[i]);
+            const auto w0 = MathConstants<double>::twoPi * frequency / sampleRate;
+            const auto cosW0 = std::cos (w0);
+            const auto alpha = std::sin (w0) / (2.0 * butterworthQ);
+            const auto a0 = 1.0 + alpha;
+
+            auto& crossover = crossovers[i];
+
+            auto setCoefficients = [&] (Biquad& biquad, double b0, double b1, double b2)
+            {
+                biquad.b0 = (FloatType) (b0 / a0);
+                biquad.b1 = (FloatType) (b1 / a0);
+                biquad.b2 = (FloatType) (b2 / a0);
+                biquad.a1 = (FloatType) ((-2.0 * cosW0) / a0);
+                biquad.a2 = (FloatType) ((1.0 - alpha) / a0);
+            };
+
+            setCoefficients (crossover.lowPass, (1.0 - cosW0) * 0.5, 1.0 - cosW0, (1.0 - cosW0) * 0.5);
+            setCoefficients (crossover.highPass, (1.0 + cosW0) * 0.5, -(1.0 + cosW0), (1.0 + cosW0) * 0.5);
+            setCoefficients (crossover.allPass, 1.0 - alpha, -2.0 * cosW0, 1.0 + alpha);
+        }
+    }
+
+    /** Works out which filters need running, and clears the state of those
+        that weren't running in the previous block so they don't pop back in.
+    */
+    void updateActiveFilters() noexcept
+    {
+        const auto numCrossovers = (int) crossovers.size();
+        auto anyEnabledAbove = false;
+
+        for (int band = numCrossovers; band >= 0; --band)
+        {
+            const auto enabled = bandsEnabled[(size_t) band];
+
+            if (band < numCrossovers)
+            {
+                const auto highPassActive = anyEnabledAbove;
+
+                if (highPassActive && ! highPassesActive[(size_t) band])
+                    for (int g = 0; g < getNumGroups(); ++g)
+                        for (int s = 2; s < 4; ++s)
+                            getGroupStates (g)[getFirstStateIndex (band) + s] = {};
+
+                highPassesActive[(size_t) band] = highPassActive;
+
+                if (enabled && ! bandsActive[(size_t) band])
+                    for (int g = 0; g < getNumGroups(); ++g)
+                        for (int s = 0; s < getNumStatesForCrossover (band); ++s)
+                            if (s < 2 || s >= 4)
+                                getGroupStates (g)[getFirstStateIndex (band) + s] = {};
+            }
+
+            bandsActive[(size_t) band] = enabled;
+            anyEnabledAbove = anyEnabledAbove || enabled;
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultibandCrossover)
+};
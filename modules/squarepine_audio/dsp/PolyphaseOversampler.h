@@ -0,0 +1,585 @@
+/** Oversamples by 2, 4 or 8 using a cascade of polyphase half-band filters.
+
+    Each stage doubles the sample rate on the way up and halves it on the way
+    down, and only ever computes the polyphase branches that are actually needed;
+    the zeros that upsampling would stuff in, and the samples that downsampling
+    would throw away, are never touched.
+
+    There are two kinds of kernels to pick from:
+    - Phase::linear uses half-band FIRs. Every other tap is 0, and the rest are
+      symmetric, so each stage costs a quarter of the multiplies of a plain FIR.
+      The latency is the same at every frequency.
+    - Phase::minimum uses pairs of allpass paths, which is far cheaper still and
+      has a much lower latency, at the cost of a non-linear phase response.
+
+    The channels are processed in groups, one channel per SIMD lane (eg: 4 floats
+    or 2 doubles at a time with SSE or NEON), so wide layouts cost a fraction of
+    running every channel on its own. Any number of channels is supported.
+
+    All of the kernels are designed upfront and all of the storage is allocated
+    in prepare(), so the factor and the kind of kernels can be changed from the
+    audio thread.
+
+    @code
+        PolyphaseOversampler<float> oversampler (4);
+        oversampler.prepare (numChannels, maximumBlockSize);
+        setLatencySamples (roundToInt (oversampler.getLatencyInSamples()));
+
+        // And then, on the audio thread:
+        oversampler.process (buffer, buffer.getNumChannels(), buffer.getNumSamples(),
+                             [] (juce::AudioBuffer<float>& oversampled)
+        {
+            DistortionFunctions::performSimple (oversampled, 1.0f);
+        });
+    @endcode
+*/
+template<typename FloatType>
+class PolyphaseOversampler final
+{
+public:
+    /** The kinds of kernels the oversampler can use. */
+    enum class Phase
+    {
+        linear,     /**< Half-band FIRs: the same latency at every frequency. */
+        minimum     /**< Polyphase allpass IIRs: cheaper, and a lot less latency. */
+    };
+
+    /** The highest oversampling factor supported. */
+    static constexpr int maximumFactor = 8;
+
+    //==============================================================================
+    /** Constructor.
+
+        @param initialFactor    The oversampling factor; 1, 2, 4 or 8.
+        @param initialPhase     The kind of kernels to use.
+    */
+    PolyphaseOversampler (int initialFactor = 2, Phase initialPhase = Phase::linear) :
+        phase (initialPhase)
+    {
+        designKernels();
+        setFactor (initialFactor);
+    }
+
+    //==============================================================================
+    /** Allocates everything needed to process up to the specified number of channels and samples. */
+    void prepare (int newNumChannels, int newMaximumBlockSize)
+    {
+        jassert (newNumChannels > 0);
+        jassert (newMaximumBlockSize > 0);
+
+        numChannels = jmax (1, newNumChannels);
+        maximumBlockSize = jmax (1, newMaximumBlockSize);
+
+        for (int i = 0; i < (int) buffers.size(); ++i)
+            buffers[(size_t) i].setSize (numChannels, maximumBlockSize << i, false, true, false);
+
+        for (auto& stage : stages)
+            stage.states.assign ((size_t) (getNumGroups() * stage.getNumStatesPerGroup()), Vector::expand (FloatType()));
+
+        reset();
+    }
+
+    /** Clears the state of every filter. */
+    void reset() noexcept
+    {
+        for (auto& stage : stages)
+        {
+            std::fill (stage.states.begin(), stage.states.end(), Vector::expand (FloatType()));
+            stage.upPosition = stage.downPosition = 0;
+        }
+
+        for (auto& buffer : buffers)
+            buffer.clear();
+    }
+
+    //==============================================================================
+    /** Changes the oversampling factor; 1, 2, 4 or 8.
+
+        This resets the filters if the factor changes, but doesn't allocate.
+    */
+    void setFactor (int newFactor) noexcept
+    {
+        jassert (newFactor == 1 || newFactor == 2 || newFactor == 4 || newFactor == maximumFactor);
+
+        const auto newNumStages = newFactor >= 8 ? 3 : newFactor >= 4 ? 2 : newFactor >= 2 ? 1 : 0;
+
+        if (numStages != newNumStages)
+        {
+            numStages = newNumStages;
+            reset();
+        }
+    }
+
+    /** @returns the oversampling factor. */
+    [[nodiscard]] int getFactor() const noexcept { return 1 << numStages; }
+
+    /** Changes the kind of kernels in use.
+
+        This resets the filters if the kind changes, but doesn't allocate.
+    */
+    void setPhase (Phase newPhase) noexcept
+    {
+        if (phase != newPhase)
+        {
+            phase = newPhase;
+            reset();
+        }
+    }
+
+    /** @returns the kind of kernels in use. */
+    [[nodiscard]] Phase getPhase() const noexcept { return phase; }
+
+    /** @returns the latency of going up and back down, in samples at the original rate.
+
+        With linear phase kernels this is exact at every frequency.
+        With minimum phase kernels this is the group delay at DC.
+
+        This is usually fractional, so round it to report it to a host.
+    */
+    [[nodiscard]] double getLatencyInSamples() const noexcept
+    {
+        auto latency = 0.0;
+
+        for (int i = 0; i < numStages; ++i)
+            latency += stages[(size_t) i].getLatency (phase) / (double) (1 << i);
+
+        return latency;
+    }
+
+    //==============================================================================
+    /** Upsamples the first few channels of a buffer.
+
+        @returns the oversampled signal, of which the first numSamples * getFactor()
+                 samples are valid. It can be processed in place before calling processDown().
+    */
+    juce::AudioBuffer<FloatType>& processUp (const juce::AudioBuffer<FloatType>& source,
+                                             int numChannelsToProcess, int numSamples) noexcept
+    {
+        jassert (numSamples <= maximumBlockSize);
+
+        numChannelsToProcess = jmin (numChannelsToProcess, numChannels, source.getNumChannels());
+        numSamples = jmin (numSamples, maximumBlockSize);
+
+        if (numStages == 0)
+        {
+            for (int i = 0; i < numChannelsToProcess; ++i)
+                buffers[0].copyFrom (i, 0, source, i, 0, numSamples);
+
+            return buffers[0];
+        }
+
+        const auto* input = &source;
+
+        for (int i = 0; i < numStages; ++i)
+        {
+            auto& output = buffers[(size_t) i + 1];
+            processUpStage (stages[(size_t) i], *input, output, numChannelsToProcess, numSamples << i);
+            input = &output;
+        }
+
+        return buffers[(size_t) numStages];
+    }
+
+    /** Downsamples what processUp() returned back into the first few channels of a buffer. */
+    void processDown (juce::AudioBuffer<FloatType>& destination, int numChannelsToProcess, int numSamples) noexcept
+    {
+        jassert (numSamples <= maximumBlockSize);
+
+        numChannelsToProcess = jmin (numChannelsToProcess, numChannels, destination.getNumChannels());
+        numSamples = jmin (numSamples, maximumBlockSize);
+
+        if (numStages == 0)
+        {
+            for (int i = 0; i < numChannelsToProcess; ++i)
+                destination.copyFrom (i, 0, buffers[0], i, 0, numSamples);
+
+            return;
+        }
+
+        for (int i = numStages; --i >= 0;)
+        {
+            auto& output = i == 0 ? destination : buffers[(size_t) i];
+            processDownStage (stages[(size_t) i], buffers[(size_t) i + 1], output, numChannelsToProcess, numSamples << i);
+        }
+    }
+
+    /** Upsamples, calls the function with the oversampled signal to process in place,
+        and then downsamples the result back into the buffer.
+
+        Buffers longer than the maximum block size are handled a block at a time,
+        so the function can be called more than once. It is passed a
+        juce::AudioBuffer<FloatType>& whose size is exactly the number of channels
+        and oversampled samples to process.
+
+        @warning This refers to the channels through temporary juce::AudioBuffers,
+                 which keep up to 31 channel pointers inline but allocate them beyond that.
+                 So processing 32 channels or more allocates on every call;
+                 use processUp() and processDown() directly for layouts that wide.
+    */
+    template<typename ProcessFunction>
+    void process (juce::AudioBuffer<FloatType>& buffer, int numChannelsToProcess, int numSamples,
+                  ProcessFunction&& function) noexcept
+    {
+        // You need to call prepare() first!
+        jassert (maximumBlockSize > 0);
+
+        numChannelsToProcess = jmin (numChannelsToProcess, numChannels, buffer.getNumChannels());
+
+        if (maximumBlockSize <= 0 || numChannelsToProcess <= 0)
+            return;
+
+        for (int start = 0; start < numSamples; start += maximumBlockSize)
+        {
+            const auto numThisTime = jmin (maximumBlockSize, numSamples - start);
+
+            // N.B.: Referring to existing channels only avoids allocating below 32 channels. See the warning above.
+            juce::AudioBuffer<FloatType> block (buffer.getArrayOfWritePointers(), numChannelsToProcess, start, numThisTime);
+            auto& oversampled = processUp (block, numChannelsToProcess, numThisTime);
+
+            juce::AudioBuffer<FloatType> view (oversampled.getArrayOfWritePointers(), numChannelsToProcess, numThisTime * getFactor());
+            function (view);
+
+            processDown (block, numChannelsToProcess, numThisTime);
+        }
+    }
+
+private:
+    //==============================================================================
+    using Vector = dsp::SIMDRegister<FloatType>;
+
+    /** The number of channels processed together. */
+    static constexpr int laneWidth = (int) Vector::size();
+
+    /** A single 2x stage, with both kinds of kernels and the state for either.
+
+        The linear phase kernel is a half-band FIR of 4k + 3 taps. Its odd taps are all 0
+        apart from the centre one, which is 1/2, and its M = 2k + 2 even taps are symmetric.
+        Going up, the even output samples are the even taps run over the input (doubled,
+        to make up for the zeros that weren't stuffed in), and the odd ones are the input,
+        delayed by k. Going down is the same thing the other way around.
+        Together, they delay the signal by 2k + 1 samples at the lower rate.
+
+        The minimum phase kernel is a pair of allpass paths, A0 and A1; one per polyphase branch.
+        Together, they amount to A0 * A1 at the lower rate, which is an allpass.
+    */
+    struct Stage final
+    {
+        std::vector<FloatType> taps;        // The first half of the even taps.
+        int numEvenTaps = 0;                // M
+        int centre = 0;                     // k
+        std::vector<FloatType> path0, path1;
+
+        // Per group of channels: the FIR histories going up, down (even) and down (odd),
+        // each one twice as long as it needs to be so they can be read without wrapping around,
+        // followed by the allpass states going up, then down, as pairs of x[n - 1] and y[n - 1].
+        std::vector<Vector> states;
+        int upPosition = 0, downPosition = 0;
+
+        int getNumStatesPerGroup() const noexcept       { return 6 * numEvenTaps + 4 * (int) (path0.size() + path1.size()); }
+        int getFirstAllpassState() const noexcept       { return 6 * numEvenTaps; }
+
+        double getLatency (Phase p) const noexcept
+        {
+            if (p == Phase::linear)
+                return (double) (2 * centre + 1);
+
+            // The group delay of (a + z^-1) / (1 + a z^-1), at DC, is (1 - a) / (1 + a).
+            auto latency = 0.0;
+
+            for (const auto* path : { &path0, &path1 })
+                for (auto a : *path)
+                    latency += (1.0 - (double) a) / (1.0 + (double) a);
+
+            return latency;
+        }
+    };
+
+    //==============================================================================
+    std::array<Stage, 3> stages;
+    std::array<juce::AudioBuffer<FloatType>, 4> buffers;   // One per rate; the original rate's is only used when not oversampling.
+    Phase phase = Phase::linear;
+    int numStages = 1, numChannels = 2, maximumBlockSize = 0;
+
+    //==============================================================================
+    int getNumGroups() const noexcept
+    {
+        return (numChannels + laneWidth - 1) / laneWidth;
+    }
+
+    /** The first stage has to be the steepest, as it's the only one whose transition band
+        sits right at the original Nyquist; the later stages only have to reject images
+        well above it.
+    */
+    void designKernels()
+    {
+        // Linear phase: Kaiser windowed sincs, at about 80 dB of rejection.
+        designHalfBandFIR (stages[0], 15);
+        designHalfBandFIR (stages[1], 7);
+        designHalfBandFIR (stages[2], 3);
+
+        // Minimum phase: the transition bands are relative to the higher rate of each stage.
+        designHalfBandIIR (stages[0], 12, 0.02);
+        designHalfBandIIR (stages[1], 6, 0.1);
+        designHalfBandIIR (stages[2], 4, 0.15);
+    }
+
+    static void designHalfBandFIR (Stage& stage, int k)
+    {
+        const auto numTaps = 4 * k + 3;
+        const auto centre = 2 * k + 1;
+
+        std::vector<FloatType> window ((size_t) numTaps);
+        dsp::WindowingFunction<FloatType>::fillWindowingTables (window.data(), (size_t) numTaps,
+                                                               dsp::WindowingFunction<FloatType>::kaiser,
+                                                               false, (FloatType) 8);
+
+        stage.centre = k;
+        stage.numEvenTaps = 2 * k + 2;
+        stage.taps.resize ((size_t) (k + 1));
+
+        auto sum = 0.0;
+
+        for (int j = 0; j <= k; ++j)
+        {
+            const auto distance = (double) (2 * j - centre) * 0.5;
+            const auto x = MathConstants<double>::pi * distance;
+            const auto tap = 0.5 * (std::sin (x) / x) * (double) window[(size_t) (2 * j)];
+
+            stage.taps[(size_t) j] = (FloatType) tap;
+            sum += 2.0 * tap;
+        }
+
+        // Normalise the even taps to sum to 1/2, for exactly unity gain at DC.
+        for (auto& tap : stage.taps)
+            tap = (FloatType) ((double) tap * 0.5 / sum);
+    }
+
+    /** The allpass coefficients come from the elliptic half-band design of
+        Valenzuela and Constantinides, as popularised by Laurent de Soras' HIIR.
+    */
+    static void designHalfBandIIR (Stage& stage, int numCoefficients, double transitionBandwidth)
+    {
+        jassert (numCoefficients > 0 && transitionBandwidth > 0.0 && transitionBandwidth < 0.5);
+
+        auto k = std::tan ((1.0 - transitionBandwidth * 2.0) * MathConstants<double>::pi / 4.0);
+        k *= k;
+
+        const auto kksqrt = std::pow (1.0 - k * k, 0.25);
+        const auto e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const auto e4 = std::pow (e, 4.0);
+        const auto q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+        const auto order = numCoefficients * 2 + 1;
+
+        stage.path0.clear();
+        stage.path1.clear();
+
+        for (int i = 0; i < numCoefficients; ++i)
+        {
+            const auto c = i + 1;
+
+            auto numerator = 0.0;
+            for (int n = 0;; ++n)
+            {
+                const auto term = std::pow (q, (double) (n * (n + 1)))
+                                * std::sin ((double) (n * 2 + 1) * c * MathConstants<double>::pi / order)
+                                * (n % 2 == 0 ? 1.0 : -1.0);
+                numerator += term;
+
+                if (std::abs (term) <= 1.0e-100)
+                    break;
+            }
+
+            auto denominator = 0.0;
+            for (int n = 1;; ++n)
+            {
+                const auto term = std::pow (q, (double) (n * n))
+                                * std::cos ((double) (n * 2) * c * MathConstants<double>::pi / order)
+                                * (n % 2 == 0 ? 1.0 : -1.0);
+                denominator += term;
+
+                if (std::abs (term) <= 1.0e-100)
+                    break;
+            }
+
+            const auto ww = (numerator * std::pow (q, 0.25)) / (denominator + 0.5);
+            const auto wwsq = ww * ww;
+            const auto x = std::sqrt ((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            const auto coefficient = (FloatType) ((1.0 - x) / (1.0 + x));
+
+            (i % 2 == 0 ? stage.path0 : stage.path1).push_back (coefficient);
+        }
+    }
+
+    //==============================================================================
+    /** Calls the function once per group of channels, with the pointers to the group's input and output channels. */
+    template<typename GroupFunction>
+    void forEachGroup (const juce::AudioBuffer<FloatType>& source, juce::AudioBuffer<FloatType>& destination,
+                       int numChannelsToProcess, GroupFunction&& function) noexcept
+    {
+        for (int firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += laneWidth)
+        {
+            const auto numLanes = jmin (laneWidth, numChannelsToProcess - firstChannel);
+            std::array<const FloatType*, laneWidth> inputs {};
+            std::array<FloatType*, laneWidth> outputs {};
+
+            for (int lane = 0; lane < numLanes; ++lane)
+            {
+                inputs[(size_t) lane] = source.getReadPointer (firstChannel + lane);
+                outputs[(size_t) lane] = destination.getWritePointer (firstChannel + lane);
+            }
+
+            function (inputs, outputs, numLanes, firstChannel / laneWidth);
+        }
+    }
+
+    static Vector gather (const std::array<const FloatType*, laneWidth>& channels, int numLanes, int index) noexcept
+    {
+        // N.B.: Any unused lanes are left at 0, which keeps their filters silent.
+        auto v = Vector::expand (FloatType());
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            v.set ((size_t) lane, channels[(size_t) lane][index]);
+
+        return v;
+    }
+
+    static void scatter (const std::array<FloatType*, laneWidth>& channels, int numLanes, int index, Vector v) noexcept
+    {
+        for (int lane = 0; lane < numLanes; ++lane)
+            channels[(size_t) lane][index] = v.get ((size_t) lane);
+    }
+
+    static Vector processAllpasses (const std::vector<FloatType>& coefficients, Vector* state, Vector x) noexcept
+    {
+        for (auto a : coefficients)
+        {
+            const auto y = (x - state[1]) * a + state[0];
+            state[0] = x;
+            state[1] = y;
+            state += 2;
+            x = y;
+        }
+
+        return x;
+    }
+
+    /** Steps a position back through a history of the given length, where the newest sample is at the position. */
+    static int stepBack (int position, int length) noexcept
+    {
+        return (position == 0 ? length : position) - 1;
+    }
+
+    //==============================================================================
+    void processUpStage (Stage& stage, const juce::AudioBuffer<FloatType>& source, juce::AudioBuffer<FloatType>& destination,
+                         int numChannelsToProcess, int numSamples) noexcept
+    {
+        const auto m = stage.numEvenTaps;
+        const auto half = m / 2;
+        const auto k = stage.centre;
+        const auto numStatesPerGroup = stage.getNumStatesPerGroup();
+        auto endPosition = stage.upPosition;
+
+        forEachGroup (source, destination, numChannelsToProcess, [&] (const auto& inputs, const auto& outputs, int numLanes, int group)
+        {
+            auto* groupStates = stage.states.data() + (size_t) (group * numStatesPerGroup);
+
+            if (phase == Phase::linear)
+            {
+                auto* history = groupStates;
+                auto position = stage.upPosition;
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    const auto x = gather (inputs, numLanes, n);
+
+                    position = stepBack (position, m);
+                    history[position] = history[position + m] = x;
+
+                    const auto* w = history + position;
+                    auto sum = Vector::expand (FloatType());
+
+                    for (int j = 0; j < half; ++j)
+                        sum += (w[j] + w[m - 1 - j]) * stage.taps[(size_t) j];
+
+                    scatter (outputs, numLanes, 2 * n, sum * (FloatType) 2);
+                    scatter (outputs, numLanes, 2 * n + 1, w[k]);
+                }
+
+                endPosition = position;
+            }
+            else
+            {
+                auto* states0 = groupStates + stage.getFirstAllpassState();
+                auto* states1 = states0 + 2 * stage.path0.size();
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    const auto x = gather (inputs, numLanes, n);
+
+                    scatter (outputs, numLanes, 2 * n, processAllpasses (stage.path0, states0, x));
+                    scatter (outputs, numLanes, 2 * n + 1, processAllpasses (stage.path1, states1, x));
+                }
+            }
+        });
+
+        stage.upPosition = endPosition;
+    }
+
+    void processDownStage (Stage& stage, const juce::AudioBuffer<FloatType>& source, juce::AudioBuffer<FloatType>& destination,
+                           int numChannelsToProcess, int numSamples) noexcept
+    {
+        const auto m = stage.numEvenTaps;
+        const auto half = m / 2;
+        const auto k = stage.centre;
+        const auto numStatesPerGroup = stage.getNumStatesPerGroup();
+        auto endPosition = stage.downPosition;
+
+        forEachGroup (source, destination, numChannelsToProcess, [&] (const auto& inputs, const auto& outputs, int numLanes, int group)
+        {
+            auto* groupStates = stage.states.data() + (size_t) (group * numStatesPerGroup);
+
+            if (phase == Phase::linear)
+            {
+                auto* evenHistory = groupStates + 2 * m;
+                auto* oddHistory = evenHistory + 2 * m;
+                auto position = stage.downPosition;
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    position = stepBack (position, m);
+                    evenHistory[position] = evenHistory[position + m] = gather (inputs, numLanes, 2 * n);
+                    oddHistory[position] = oddHistory[position + m] = gather (inputs, numLanes, 2 * n + 1);
+
+                    const auto* w = evenHistory + position;
+                    auto sum = oddHistory[position + k + 1] * (FloatType) 0.5;
+
+                    for (int j = 0; j < half; ++j)
+                        sum += (w[j] + w[m - 1 - j]) * stage.taps[(size_t) j];
+
+                    scatter (outputs, numLanes, n, sum);
+                }
+
+                endPosition = position;
+            }
+            else
+            {
+                auto* states0 = groupStates + stage.getFirstAllpassState() + 2 * (stage.path0.size() + stage.path1.size());
+                auto* states1 = states0 + 2 * stage.path0.size();
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    const auto a = processAllpasses (stage.path0, states0, gather (inputs, numLanes, 2 * n + 1));
+                    const auto b = processAllpasses (stage.path1, states1, gather (inputs, numLanes, 2 * n));
+
+                    scatter (outputs, numLanes, n, (a + b) * (FloatType) 0.5);
+                }
+            }
+        });
+
+        stage.downPosition = endPosition;
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseOversampler)
+};
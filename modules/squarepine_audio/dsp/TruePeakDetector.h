@@ -0,0 +1,285 @@
+/** A block based true-peak detector, following Annex 2 of ITU-R BS.1770-4.
+
+    The signal is oversampled 4 times with the recommendation's 48 tap polyphase
+    interpolation filter, and the largest magnitude found is the true-peak.
+
+    Rather than walking a circular buffer one phase at a time, every channel keeps
+    a linear history: the last few samples of the previous block, followed by the
+    current block. The four phases are interleaved tap by tap, so each interpolated
+    output sample is a single 4 lane dot product over contiguous memory.
+
+    Any number of channels is supported. The per-block results are available to the
+    audio thread straight away, and the largest peak per channel since it was last
+    read is published to a lock-free feed that any other thread can poll.
+
+    @code
+        TruePeakDetector detector;
+        detector.prepare (numChannels, maximumBlockSize);
+
+        // On the audio thread:
+        detector.analyse (buffer, 0, buffer.getNumSamples());
+
+        // And on the message thread:
+        const auto truePeak = detector.getAndResetPeak (channel);
+    @endcode
+
+    @see TruePeakAnalysis, LevelsProcessor
+*/
+class TruePeakDetector final
+{
+public:
+    /** Constructor. */
+    TruePeakDetector() = default;
+
+    //==============================================================================
+    /** The amount of oversampling used to find the peaks between samples. */
+    static constexpr int oversamplingFactor = 4;
+
+    /** The number of taps in each phase of the interpolation filter. */
+    static constexpr int numTapsPerPhase = 12;
+
+    /** The delay, in samples, between the input and the centre of the interpolation filter. */
+    static constexpr int latencyInSamples = 6;
+
+    //==============================================================================
+    /** Allocates everything needed to analyse the specified number of channels. */
+    void prepare (int newNumChannels, int newMaximumBlockSize)
+    {
+        jassert (newNumChannels > 0 && newMaximumBlockSize > 0);
+
+        numChannels = jmax (1, newNumChannels);
+        maximumBlockSize = jmax (1, newMaximumBlockSize);
+        historyStride = historyLength + maximumBlockSize;
+
+        history.assign ((size_t) (numChannels * historyStride), 0.0f);
+        blockPeaks.assign ((size_t) numChannels, 0.0f);
+        publishedPeaks = std::vector<std::atomic<float>> ((size_t) numChannels);
+
+        reset();
+    }
+
+    /** Clears the filter history and every peak. */
+    void reset() noexcept
+    {
+        std::fill (history.begin(), history.end(), 0.0f);
+        std::fill (blockPeaks.begin(), blockPeaks.end(), 0.0f);
+
+        for (auto& peak : publishedPeaks)
+            peak.store (0.0f, std::memory_order_relaxed);
+
+        blockPeak = 0.0f;
+    }
+
+    /** @returns the number of channels that were prepared. */
+    [[nodiscard]] int getNumChannels() const noexcept { return numChannels; }
+
+    //==============================================================================
+    /** Measures the true-peak of a range of a buffer.
+
+        @param buffer       The audio to analyse. Any channels past the ones that were prepared are ignored.
+        @param startSample  The first sample to analyse.
+        @param numSamples   The number of samples to analyse, which may be more than the prepared block size.
+        @param framePeaks   If not null, this receives the largest true-peak across every channel,
+                            for each of the samples. It must have room for numSamples values.
+    */
+    template<typename SampleType>
+    void analyse (const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples,
+                  float* framePeaks = nullptr) noexcept
+    {
+        run<false> (buffer, startSample, numSamples, framePeaks);
+    }
+
+    /** Measures the true-peak of a range of a buffer, and then delays that range by latencyInSamples,
+        so it lines up with the frame peaks.
+
+        @see analyse
+    */
+    void analyseAndDelay (juce::AudioBuffer<float>& buffer, int startSample, int numSamples,
+                          float* framePeaks = nullptr) noexcept
+    {
+        run<true> (buffer, startSample, numSamples, framePeaks);
+    }
+
+    //==============================================================================
+    /** @returns the largest true-peak of the last block, across every channel.
+        This is only meant to be called from the audio thread.
+    */
+    [[nodiscard]] float getBlockPeak() const noexcept { return blockPeak; }
+
+    /** @returns the largest true-peak of the last block, for a single channel.
+        This is only meant to be called from the audio thread.
+    */
+    [[nodiscard]] float getBlockPeak (int channel) const noexcept
+    {
+        return isPositiveAndBelow (channel, (int) blockPeaks.size()) ? blockPeaks[(size_t) channel] : 0.0f;
+    }
+
+    /** @returns the largest true-peak of a channel since it was last reset, without resetting it.
+        This can be called from any thread, but not while prepare() is running.
+    */
+    [[nodiscard]] float getPeak (int channel) const noexcept
+    {
+        if (isPositiveAndBelow (channel, (int) publishedPeaks.size()))
+            return publishedPeaks[(size_t) channel].load (std::memory_order_relaxed);
+
+        return 0.0f;
+    }
+
+    /** @returns the largest true-peak of a channel since this was last called, and starts over.
+        This can be called from any thread, but not while prepare() is running.
+    */
+    float getAndResetPeak (int channel) noexcept
+    {
+        if (isPositiveAndBelow (channel, (int) publishedPeaks.size()))
+            return publishedPeaks[(size_t) channel].exchange (0.0f, std::memory_order_relaxed);
+
+        return 0.0f;
+    }
+
+private:
+    //==============================================================================
+    using Vector = dsp::SIMDRegister<float>;
+
+    static_assert (Vector::size() == (size_t) oversamplingFactor,
+                   "Each phase of the interpolation filter is expected to have a lane of its own.");
+
+    /** The number of samples of the previous block that are kept in front of the next one. */
+    static constexpr int historyLength = numTapsPerPhase - 1;
+
+    //==============================================================================
+    std::vector<float> history;             // Planar: every channel's history, followed by room for a block.
+    std::vector<float> blockPeaks;
+    std::vector<std::atomic<float>> publishedPeaks;
+    float blockPeak = 0.0f;
+    int numChannels = 0, maximumBlockSize = 0, historyStride = 0;
+
+    /** The interpolation filter, with the four phases interleaved per tap. */
+    const std::array<Vector, numTapsPerPhase> taps = createTaps();
+
+    //==============================================================================
+    static std::array<Vector, numTapsPerPhase> createTaps() noexcept
+    {
+        // From ITU-R BS.1770-4, Annex 2, Table 1. Each row is a tap, and each column is a phase.
+        constexpr float coefficients[numTapsPerPhase][oversamplingFactor] =
+        {
+            { -0.0083007812500f, -0.0189208984375f, -0.0291748046875f,  0.0017089843750f },
+            {  0.0148925781250f,  0.0330810546875f,  0.0292968750000f,  0.0109863281250f },
+            { -0.0266113281250f, -0.0582275390625f, -0.0517578125000f, -0.0196533203125f },
+            {  0.0476074218750f,  0.1015625000000f,  0.0891113281250f,  0.0332031250000f },
+            { -0.1022949218750f, -0.2003173828125f, -0.1665039062500f, -0.0594482421875f },
+            {  0.9721679687500f,  0.7797851562500f,  0.4650878906250f,  0.1373291015625f },
+            {  0.1373291015625f,  0.4650878906250f,  0.7797851562500f,  0.9721679687500f },
+            { -0.0594482421875f, -0.1665039062500f, -0.2003173828125f, -0.1022949218750f },
+            {  0.0332031250000f,  0.0891113281250f,  0.1015625000000f,  0.0476074218750f },
+            { -0.0196533203125f, -0.0517578125000f, -0.0582275390625f, -0.0266113281250f },
+            {  0.0109863281250f,  0.0292968750000f,  0.0330810546875f,  0.0148925781250f },
+            {  0.0017089843750f, -0.0291748046875f, -0.0189208984375f, -0.0083007812500f }
+        };
+
+        std::array<Vector, numTapsPerPhase> result;
+
+        for (size_t i = 0; i < result.size(); ++i)
+            for (size_t phase = 0; phase < (size_t) oversamplingFactor; ++phase)
+                result[i].set (phase, coefficients[i][phase]);
+
+        return result;
+    }
+
+    static float getLargestLane (const Vector& v) noexcept
+    {
+        return jmax (v.get (0), v.get (1), v.get (2), v.get (3));
+    }
+
+    //==============================================================================
+    template<bool delayInput, typename BufferType>
+    void run (BufferType& buffer, int startSample, int numSamples, float* framePeaks) noexcept
+    {
+        // You need to call prepare() first!
+        jassert (maximumBlockSize > 0);
+        jassert (startSample >= 0 && startSample + numSamples <= buffer.getNumSamples());
+
+        const auto numChannelsToProcess = jmin (numChannels, buffer.getNumChannels());
+
+        std::fill (blockPeaks.begin(), blockPeaks.end(), 0.0f);
+        blockPeak = 0.0f;
+
+        if (maximumBlockSize <= 0 || numSamples <= 0)
+            return;
+
+        if (framePeaks != nullptr)
+            FloatVectorOperations::clear (framePeaks, numSamples);
+
+        for (int c = 0; c < numChannelsToProcess; ++c)
+        {
+            auto* channelHistory = history.data() + (size_t) (c * historyStride);
+            auto peak = Vector::expand (0.0f);
+
+            for (int start = 0; start < numSamples; start += maximumBlockSize)
+            {
+                const auto numThisTime = jmin (maximumBlockSize, numSamples - start);
+                const auto* samples = buffer.getReadPointer (c, startSample + start);
+                auto* block = channelHistory + historyLength;
+
+                for (int n = 0; n < numThisTime; ++n)
+                    block[n] = (float) samples[n];
+
+                if (framePeaks != nullptr)
+                {
+                    auto* destination = framePeaks + start;
+
+                    for (int n = 0; n < numThisTime; ++n)
+                    {
+                        const auto magnitude = Vector::abs (interpolate (block + n));
+                        peak = Vector::max (peak, magnitude);
+                        destination[n] = jmax (destination[n], getLargestLane (magnitude));
+                    }
+                }
+                else
+                {
+                    for (int n = 0; n < numThisTime; ++n)
+                        peak = Vector::max (peak, Vector::abs (interpolate (block + n)));
+                }
+
+                if constexpr (delayInput)
+                {
+                    auto* delayed = buffer.getWritePointer (c, startSample + start);
+
+                    for (int n = 0; n < numThisTime; ++n)
+                        delayed[n] = block[n - latencyInSamples];
+                }
+
+                // Keep the tail of this block in front of the next one.
+                std::copy (block + numThisTime - historyLength, block + numThisTime, channelHistory);
+            }
+
+            const auto channelPeak = getLargestLane (peak);
+            blockPeaks[(size_t) c] = channelPeak;
+            blockPeak = jmax (blockPeak, channelPeak);
+            publish (publishedPeaks[(size_t) c], channelPeak);
+        }
+    }
+
+    /** @returns the four interpolated phases that lie between a sample and the one before it. */
+    Vector interpolate (const float* newestSample) const noexcept
+    {
+        auto result = taps[0] * newestSample[0];
+
+        for (int i = 1; i < numTapsPerPhase; ++i)
+            result += taps[(size_t) i] * newestSample[-i];
+
+        return result;
+    }
+
+    static void publish (std::atomic<float>& destination, float peak) noexcept
+    {
+        auto current = destination.load (std::memory_order_relaxed);
+
+        while (peak > current
+               && ! destination.compare_exchange_weak (current, peak, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TruePeakDetector)
+};
@@ -22,12 +22,7 @@ ChorusProcessor::ChorusProcessor() :
 //==============================================================================
 void ChorusProcessor::setRate (float newRateHz)
 {
-    if (rate->get() != newRateHz)
-        rate->setValueNotifyingHost (newRateHz);
-
-    const ScopedLock sl (getCallbackLock());
-    floatChorus.setRate (rate->get());
-    doubleChorus.setRate ((double) rate->get());
+    rate->operator= (newRateHz);
 }
 
 float ChorusProcessor::getRate() const noexcept
@@ -38,12 +33,7 @@ float ChorusProcessor::getRate() const noexcept
 //==============================================================================
 void ChorusProcessor::setDepth (float newDepth)
 {
-    if (depth->get() != newDepth)
-        depth->setValueNotifyingHost (newDepth);
-
-    const ScopedLock sl (getCallbackLock());
-    floatChorus.setDepth (depth->get());
-    doubleChorus.setDepth ((double) depth->get());
+    depth->operator= (newDepth);
 }
 
 float ChorusProcessor::getDepth() const noexcept
@@ -54,12 +44,7 @@ float ChorusProcessor::getDepth() const noexcept
 //==============================================================================
 void ChorusProcessor::setCentreDelay (float newDelayMs)
 {
-    if (centreDelay->get() != newDelayMs)
-        centreDelay->setValueNotifyingHost (newDelayMs);
-
-    const ScopedLock sl (getCallbackLock());
-    floatChorus.setCentreDelay (centreDelay->get());
-    doubleChorus.setCentreDelay ((double) centreDelay->get());
+    centreDelay->operator= (newDelayMs);
 }
 
 float ChorusProcessor::getCentreDelay() const noexcept
@@ -70,12 +55,7 @@ float ChorusProcessor::getCentreDelay() const noexcept
 //==============================================================================
 void ChorusProcessor::setFeedback (float newFeedback)
 {
-    if (feedback->get() != newFeedback)
-        feedback->setValueNotifyingHost (newFeedback);
-
-    const ScopedLock sl (getCallbackLock());
-    floatChorus.setFeedback (feedback->get());
-    doubleChorus.setFeedback ((double) feedback->get());
+    feedback->operator= (newFeedback);
 }
 
 float ChorusProcessor::getFeedback() const noexcept
@@ -86,12 +66,7 @@ float ChorusProcessor::getFeedback() const noexcept
 //==============================================================================
 void ChorusProcessor::setMix (float newMix)
 {
-    if (mix->get() != newMix)
-        mix->setValueNotifyingHost (newMix);
-
-    const ScopedLock sl (getCallbackLock());
-    floatChorus.setMix (mix->get());
-    doubleChorus.setMix ((double) mix->get());
+    mix->operator= (newMix);
 }
 
 float ChorusProcessor::getMix() const noexcept
@@ -106,7 +81,7 @@ void ChorusProcessor::prepareToPlay (double sampleRate, int bufferSize)
 
     setRateAndBufferSizeDetails (sampleRate, bufferSize);
 
-    const auto numChans = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+    const auto numChans = jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
 
     const dsp::ProcessSpec spec =
     {
@@ -115,36 +90,94 @@ void ChorusProcessor::prepareToPlay (double sampleRate, int bufferSize)
         (uint32) numChans
     };
 
-    floatChorus.prepare (spec);
-    doubleChorus.prepare (spec);
+    const auto maximumDelayInSamples = (int) std::ceil ((maximumCentreDelayMs + maximumModulationMs) * sampleRate / 1000.0) + 1;
+
+    floatState.prepare (spec, maximumDelayInSamples);
+    doubleState.prepare (spec, maximumDelayInSamples);
+
+    lfo.prepare (sampleRate);
+    lfo.setFrequency ((double) rate->get());
+    lfo.reset();
+
+    depthSmoother.reset (sampleRate, 0.05);
+    depthSmoother.setCurrentAndTargetValue (depth->get());
+    feedbackSmoother.reset (sampleRate, 0.05);
+    feedbackSmoother.setCurrentAndTargetValue (feedback->get());
+    mixSmoother.reset (sampleRate, 0.05);
+    mixSmoother.setCurrentAndTargetValue (mix->get());
 }
 
 void ChorusProcessor::releaseResources()
 {
     const ScopedLock sl (getCallbackLock());
 
-    floatChorus.reset();
-    doubleChorus.reset();
+    floatState.reset();
+    doubleState.reset();
 }
 
 //==============================================================================
 void ChorusProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
-    process (buffer, floatChorus);
+    process (buffer, floatState);
 }
 
 void ChorusProcessor::processBlock (juce::AudioBuffer<double>& buffer, MidiBuffer&)
 {
-    process (buffer, doubleChorus);
+    process (buffer, doubleState);
 }
 
 template<typename FloatType>
-void ChorusProcessor::process (juce::AudioBuffer<FloatType>& buffer, dsp::Chorus<FloatType>& chorus)
+void ChorusProcessor::process (juce::AudioBuffer<FloatType>& buffer, DelayState<FloatType>& state)
 {
+    using State = DelayState<FloatType>;
+
     const ScopedLock sl (getCallbackLock());
 
-    dsp::AudioBlock<FloatType> block (buffer);
-    dsp::ProcessContextReplacing<FloatType> context (block);
-    context.isBypassed = isBypassed();
-    chorus.process (context);
+    lfo.setFrequency ((double) rate->get());
+    depthSmoother.setTargetValue (depth->get());
+    feedbackSmoother.setTargetValue (feedback->get());
+    mixSmoother.setTargetValue (mix->get());
+
+    const auto numChannels = jmin (buffer.getNumChannels(), (int) state.lastOutputs.size());
+    const auto numSamples = buffer.getNumSamples();
+
+    if (isBypassed() || numChannels <= 0 || numSamples <= 0)
+        return;
+
+    // Every channel is modulated the same way, so the controls are rendered once for all of them,
+    // with the LFO's output turned straight into a delay in samples:
+    state.controls.setSize (State::numControls, numSamples, false, false, true);
+    auto* delays = state.controls.getWritePointer (State::delayControl);
+    auto* feedbacks = state.controls.getWritePointer (State::feedbackControl);
+    auto* mixes = state.controls.getWritePointer (State::mixControl);
+
+    const auto centreMs = jlimit (1.0f, maximumCentreDelayMs, centreDelay->get());
+    const auto samplesPerMs = (float) (getSampleRate() / 1000.0);
+
+    lfo.render<LFOWaveforms::Sine> (delays, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto delayMs = centreMs + maximumModulationMs * depthSmoother.getNextValue() * (float) delays[i];
+        delays[i] = (FloatType) (jmax (1.0f, delayMs) * samplesPerMs);
+        feedbacks[i] = (FloatType) feedbackSmoother.getNextValue();
+        mixes[i] = (FloatType) mixSmoother.getNextValue();
+    }
+
+    for (int c = 0; c < numChannels; ++c)
+    {
+        auto* samples = buffer.getWritePointer (c);
+        auto& lastOutput = state.lastOutputs[(size_t) c];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto dry = samples[i];
+
+            state.delayLine.pushSample (c, dry - lastOutput);
+            const auto wet = state.delayLine.popSample (c, delays[i]);
+            lastOutput = wet * feedbacks[i];
+
+            samples[i] = dry + mixes[i] * (wet - dry);
+        }
+    }
 }
@@ -62,8 +62,49 @@ public:
 
 private:
     //==============================================================================
-    dsp::Chorus<float> floatChorus;
-    dsp::Chorus<double> doubleChorus;
+    /** The delay line and the per-block control buffer for one precision. */
+    template<typename FloatType>
+    struct DelayState final
+    {
+        DelayState() = default;
+
+        void prepare (const dsp::ProcessSpec& spec, int maximumDelayInSamples)
+        {
+            delayLine.setMaximumDelayInSamples (maximumDelayInSamples);
+            delayLine.prepare (spec);
+            lastOutputs.assign ((size_t) spec.numChannels, FloatType());
+            controls.setSize (numControls, (int) spec.maximumBlockSize, false, false, true);
+        }
+
+        void reset()
+        {
+            delayLine.reset();
+            std::fill (lastOutputs.begin(), lastOutputs.end(), FloatType());
+        }
+
+        enum
+        {
+            delayControl = 0,
+            feedbackControl,
+            mixControl,
+            numControls
+        };
+
+        dsp::DelayLine<FloatType, dsp::DelayLineInterpolationTypes::Linear> delayLine;
+        std::vector<FloatType> lastOutputs;     // Per channel, for the feedback path.
+        juce::AudioBuffer<FloatType> controls;  // The delay, in samples, the feedback and the mix for the current block.
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayState)
+    };
+
+    //==============================================================================
+    static constexpr auto maximumModulationMs = 10.0f;
+    static constexpr auto maximumCentreDelayMs = 100.0f;
+
+    BlockLFO lfo;
+    DelayState<float> floatState;
+    DelayState<double> doubleState;
+    LinearSmoothedValue<float> depthSmoother, feedbackSmoother, mixSmoother;
 
     using FloatParam = AudioParameterFloat*;
     FloatParam rate = nullptr, depth = nullptr,
@@ -71,7 +112,7 @@ private:
                mix = nullptr;
 
     template<typename FloatType>
-    void process (juce::AudioBuffer<FloatType>&, dsp::Chorus<FloatType>&);
+    void process (juce::AudioBuffer<FloatType>&, DelayState<FloatType>&);
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChorusProcessor)
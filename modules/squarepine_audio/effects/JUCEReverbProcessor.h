@@ -11,6 +11,8 @@ public:
     /** @internal */
     Identifier getIdentifier() const override { return "simpleReverb"; }
     /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
+    /** @internal */
     void prepareToPlay (double sampleRate, int bufferSize) override;
     /** @internal */
     void releaseResources() override;
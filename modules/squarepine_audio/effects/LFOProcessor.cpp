@@ -1,21 +1,30 @@
-LFOProcessor::LFOProcessor() :
-    lfo (new SineLFO())
+LFOProcessor::LFOProcessor()
 {
     AudioProcessor::addParameter (frequency = new AudioParameterFloat ("frequency", "Frequency", 1.0f, 20000.f, 440.f));
 }
 
 //==============================================================================
+void LFOProcessor::setWaveform (const Waveform newWaveform)
+{
+    // N.B.: The LFO keeps its phase, so the new waveform carries on from where the last one was.
+    waveform.store (newWaveform);
+}
+
 void LFOProcessor::setLFOType (LFO* const newLfo)
 {
     jassert (newLfo != nullptr);
 
-    const ScopedLock sl (getCallbackLock());
+    // N.B.: This used to take ownership of the LFO, so it still has to be deleted.
+    const std::unique_ptr<LFO> legacyLfo (newLfo);
 
-    if (lfo.get() != newLfo)
-    {
-        lfo.reset (newLfo);
-        prepareToPlay (getSampleRate(), getBlockSize());
-    }
+    if (dynamic_cast<TriangleLFO*> (newLfo) != nullptr)
+        setWaveform (Waveform::triangle);
+    else if (dynamic_cast<SawLFO*> (newLfo) != nullptr || dynamic_cast<RampLFO*> (newLfo) != nullptr)
+        setWaveform (Waveform::saw);
+    else if (dynamic_cast<SquareLFO*> (newLfo) != nullptr)
+        setWaveform (Waveform::square);
+    else
+        setWaveform (Waveform::sine);
 }
 
 void LFOProcessor::setFrequency (const double newFrequency)
@@ -27,10 +36,8 @@ void LFOProcessor::setFrequency (const double newFrequency)
     *frequency = newF;
 
     const ScopedLock sl (getCallbackLock());
-    configuration.frequency = newF;
-
-    //@todo if the frequency is set using getParameters(), the phase will not be reset.
-    configuration.currentPhase = 0.0;
+    lfo.setFrequency (newF);
+    lfo.reset();
 }
 
 void LFOProcessor::setFrequencyFromMidiNote (const int midiNote)
@@ -41,11 +48,11 @@ void LFOProcessor::setFrequencyFromMidiNote (const int midiNote)
 //==============================================================================
 void LFOProcessor::prepareToPlay (const double newSampleRate, const int estimatedSamplesPerBlock)
 {
-    setRateAndBufferSizeDetails (newSampleRate, estimatedSamplesPerBlock);
-
     const ScopedLock sl (getCallbackLock());
     setRateAndBufferSizeDetails (newSampleRate, estimatedSamplesPerBlock);
-    configuration.prepare (newSampleRate, configuration.frequency);
+    lfo.prepare (newSampleRate);
+    lfo.setFrequency (frequency->get());
+    lfo.reset();
 }
 
 void LFOProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midiMessages)
@@ -60,10 +67,27 @@ void LFOProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& m
 
     const ScopedLock sl (getCallbackLock());
 
-    if (lfo != nullptr && result.isNoteOn())
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = buffer.getNumSamples();
+
+    if (! result.isNoteOn() || numChannels <= 0)
+        return;
+
+    setFrequencyFromMidiNote (result.getNoteNumber());
+    lfo.setFrequency (frequency->get());
+
+    // The waveform is picked once per block; the rendering itself has no calls left in it.
+    auto* output = buffer.getWritePointer (0);
+
+    switch (waveform.load())
     {
-        setFrequencyFromMidiNote (result.getNoteNumber());
-        configuration.frequency = frequency->get();
-        configuration.currentPhase = lfo->process (buffer, configuration);
-    }
+        case Waveform::sine:        lfo.render<LFOWaveforms::Sine> (output, numSamples); break;
+        case Waveform::triangle:    lfo.render<LFOWaveforms::Triangle> (output, numSamples); break;
+        case Waveform::saw:         lfo.render<LFOWaveforms::Saw> (output, numSamples); break;
+        case Waveform::square:      lfo.render<LFOWaveforms::Square> (output, numSamples); break;
+        default:                    jassertfalse; break;
+    };
+
+    for (int c = 1; c < numChannels; ++c)
+        buffer.copyFrom (c, 0, output, numSamples);
 }
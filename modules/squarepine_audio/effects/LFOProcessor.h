@@ -7,6 +7,25 @@ public:
 
     //==============================================================================
     /** */
+    enum class Waveform
+    {
+        sine,
+        triangle,
+        saw,
+        square
+    };
+
+    /** */
+    void setWaveform (Waveform newWaveform);
+
+    /** */
+    Waveform getWaveform() const noexcept { return waveform.load(); }
+
+    /** Picks the closest Waveform to one of the legacy LFO classes, and deletes it.
+
+        @deprecated The LFO is rendered by a BlockLFO now, so use setWaveform() instead.
+    */
+    [[deprecated ("Use setWaveform() instead.")]]
     void setLFOType (LFO* newLfo);
 
     /** */
@@ -16,7 +35,7 @@ public:
     void setFrequencyFromMidiNote (int midiNote);
 
     /** */
-    double getFrequency() const noexcept { return configuration.frequency; }
+    double getFrequency() const noexcept { return (double) frequency->get(); }
 
     //==============================================================================
     /** @internal */
@@ -30,8 +49,8 @@ public:
 
 private:
     //==============================================================================
-    std::unique_ptr<LFO> lfo;
-    LFO::Configuration configuration;
+    BlockLFO lfo;
+    std::atomic<Waveform> waveform { Waveform::sine };
 
     AudioParameterFloat* frequency = nullptr;
 
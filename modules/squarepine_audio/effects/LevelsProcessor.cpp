@@ -14,15 +14,26 @@ MeteringMode LevelsProcessor::getMode() const noexcept
     return mode.load (std::memory_order_relaxed);
 }
 
+//==============================================================================
+LoudnessMeter::Results LevelsProcessor::getLoudness() const noexcept
+{
+    return loudnessMeter.getResults();
+}
+
+void LevelsProcessor::resetLoudness() noexcept
+{
+    loudnessResetPending.store (true, std::memory_order_relaxed);
+}
+
 //==============================================================================
 void LevelsProcessor::getChannelLevels (Array<float>& destData)
 {
-    getChannelLevels (destData, floatChannelDetails);
+    getChannelLevelsInternal (destData);
 }
 
 void LevelsProcessor::getChannelLevels (Array<double>& destData)
 {
-    getChannelLevels (destData, doubleChannelDetails);
+    getChannelLevelsInternal (destData);
 }
 
 //==============================================================================
@@ -34,17 +45,16 @@ void LevelsProcessor::prepareToPlay (double newSampleRate, int bufferSize)
 
     const auto numChannels = jmax (2, getTotalNumInputChannels(), getTotalNumOutputChannels());
 
-    floatChannelDetails.prepare (numChannels);
-    doubleChannelDetails.prepare (numChannels);
+    loudnessMeter.prepare (newSampleRate, numChannels, bufferSize, getBusesLayout().getMainInputChannelSet());
 }
 
 //==============================================================================
 void LevelsProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
-    process (buffer, floatChannelDetails);
+    process (buffer);
 }
 
 void LevelsProcessor::processBlock (juce::AudioBuffer<double>& buffer, MidiBuffer&)
 {
-    process (buffer, doubleChannelDetails);
+    process (buffer);
 }
@@ -7,13 +7,17 @@ enum class MeteringMode
 {
     peak = 0,
     rms,
-    midSide
+    midSide,
+    loudness    //< Measures the programme loudness, and reports the true-peak of every channel.
 };
 
 //==============================================================================
 /** Use an instance of this within an audio callback of some kind,
-    and call getChannelLevels (on the main thread) to get the
+    and call getChannelLevels (from any thread) to get the
     last known audio levels.
+
+    The levels are published to a MeterBus once per block, so reading
+    them never contends with the audio thread.
 */
 class LevelsProcessor final : public InternalProcessor
 {
@@ -22,11 +26,14 @@ public:
     LevelsProcessor();
 
     //==============================================================================
-    /** */
+    /** Copies the last known levels, as per the metering mode. This is lock-free. */
     void getChannelLevels (Array<float>& destData);
-    /** */
+    /** Copies the last known levels, as per the metering mode. This is lock-free. */
     void getChannelLevels (Array<double>& destData);
 
+    /** @returns the bus the levels are published to, which a Meter can read from directly. */
+    const MeterBus& getMeterBus() const noexcept { return meterBus; }
+
     //==============================================================================
     /** Changes the mode of analysis for the audio levels. */
     void setMode (MeteringMode mode);
@@ -34,6 +41,19 @@ public:
     /** @returns the current mode for audio levels analysis. */
     MeteringMode getMode() const noexcept;
 
+    //==============================================================================
+    /** @returns the latest loudness measurements.
+
+        These are only measured while in MeteringMode::loudness.
+        This is lock-free, and can be called from any thread.
+    */
+    LoudnessMeter::Results getLoudness() const noexcept;
+
+    /** Starts the loudness measurements over, at the start of the next block.
+        This can be called from any thread.
+    */
+    void resetLoudness() noexcept;
+
     //==============================================================================
     /** @internal */
     const String getName() const override { return TRANS ("Levels Meter"); }
@@ -53,70 +73,74 @@ public:
     void processBlock (juce::AudioBuffer<double>&, MidiBuffer&) override;
 
 private:
+    //==============================================================================
+    std::atomic<MeteringMode> mode { MeteringMode::peak };
+    MeterBus meterBus { AudioChannelSet::maxChannelsOfNamedLayout };
+    LoudnessMeter loudnessMeter;
+    std::atomic<bool> loudnessResetPending { false };
+
     //==============================================================================
     template<typename FloatType>
-    struct ChannelDetails final
+    void getChannelLevelsInternal (Array<FloatType>& destData)
     {
-        void prepare (int numChannels)
+        Array<float> levels;
+
+        switch (mode.load (std::memory_order_relaxed))
         {
-            channels.resize (numChannels);
-            channels.clearQuick();
+            case MeteringMode::peak:        meterBus.read (levels, MeterBus::Level::peak); break;
+            case MeteringMode::rms:         meterBus.read (levels, MeterBus::Level::rms); break;
+            case MeteringMode::loudness:    meterBus.read (levels, MeterBus::Level::truePeak); break;
 
-            tempBuffer.resize (numChannels);
-            tempBuffer.clearQuick();
-        }
+            case MeteringMode::midSide:
+                meterBus.read (levels, MeterBus::Level::peak);
 
-        Array<FloatType> channels, tempBuffer;
-    };
+                for (auto& level : levels)
+                    level = square (level);
+            break;
 
-    std::atomic<MeteringMode> mode { MeteringMode::peak };
-    ChannelDetails<float> floatChannelDetails;
-    ChannelDetails<double> doubleChannelDetails;
+            default:
+                jassertfalse;
+            break;
+        };
 
-    //==============================================================================
-    template<typename FloatType>
-    void getChannelLevels (Array<FloatType>& destData, ChannelDetails<FloatType>& details)
-    {
         destData.clearQuick();
 
-        const ScopedLock lock (getCallbackLock());
-        destData.addArray (details.channels);
+        for (const auto level : levels)
+            destData.add ((FloatType) level);
     }
 
     template<typename FloatType>
-    void process (juce::AudioBuffer<FloatType>& buffer, ChannelDetails<FloatType>& details)
+    void process (juce::AudioBuffer<FloatType>& buffer)
     {
         const auto numChannels = jmin (buffer.getNumChannels(), getTotalNumInputChannels(), getTotalNumOutputChannels());
+        const auto numSamples = buffer.getNumSamples();
+        const auto currentMode = mode.load (std::memory_order_relaxed);
 
-        details.tempBuffer.clearQuick();
-
-        switch (mode.load (std::memory_order_relaxed))
+        if (currentMode == MeteringMode::loudness)
         {
-            case MeteringMode::peak:
-                for (int i = 0; i < numChannels; ++i)
-                    details.tempBuffer.add (buffer.getMagnitude (i, 0, buffer.getNumSamples()));
-            break;
+            if (loudnessResetPending.exchange (false, std::memory_order_relaxed))
+                loudnessMeter.reset();
 
-            case MeteringMode::rms:
-                for (int i = 0; i < numChannels; ++i)
-                    details.tempBuffer.add (buffer.getRMSLevel (i, 0, buffer.getNumSamples()));
-            break;
+            loudnessMeter.process (buffer, 0, numSamples);
+        }
 
-            case MeteringMode::midSide:
-                for (int i = 0; i < numChannels; ++i)
-                {
-                    const auto v = buffer.getMagnitude (i, 0, buffer.getNumSamples());
-                    details.tempBuffer.add (square (v));
-                }
-            break;
+        auto* channels = meterBus.getScratchChannels();
+        const auto numChannelsToPublish = jmin (numChannels, meterBus.getMaximumNumChannels());
 
-            default:
-                jassertfalse;
-            break;
-        };
+        for (int i = 0; i < numChannelsToPublish; ++i)
+        {
+            auto& channel = channels[i];
+            channel = {};
+            channel.peak = (float) buffer.getMagnitude (i, 0, numSamples);
+            channel.clipped = channel.peak >= 1.0f;
+
+            if (currentMode == MeteringMode::rms)
+                channel.rms = (float) buffer.getRMSLevel (i, 0, numSamples);
+            else if (currentMode == MeteringMode::loudness)
+                channel.truePeak = loudnessMeter.getBlockTruePeak (i);
+        }
 
-        const ScopedLock lock (getCallbackLock());
-        details.channels.swapWith (details.tempBuffer);
+        meterBus.publish (channels, numChannelsToPublish);
     }
 
     //==============================================================================
@@ -17,10 +17,11 @@ public:
         angleChange = frequency * 2.0f * f_PI / Fs;
     }
     
-    void prepare (double sampleRate, int )
+    void prepare (double sampleRate, int, int numChannels = 2)
     {
         Fs = static_cast<float> (sampleRate);
         angleChange = frequency * 2.0f * f_PI / Fs;
+        currentAngle.resize ((size_t) jmax (0, numChannels), 0.0f);
     }
     
     void setCurrentAngle (float angleInRadians, int channel)
@@ -33,7 +34,7 @@ private:
     float f_PI = static_cast<float> (M_PI);
     
     float pix2 = 2.0f * f_PI;
-    float currentAngle[2] = {0.0f};
+    std::vector<float> currentAngle = std::vector<float> (2, 0.0f); // Per channel
     float angleChange = 0.0f;
     float frequency = 1.0f;
     float Fs = 44100.0f;
@@ -27,6 +27,17 @@ SimpleDistortionProcessor::SimpleDistortionProcessor() :
 }
 
 //==============================================================================
+void SimpleDistortionProcessor::prepareToPlay (const double newSampleRate, const int estimatedSamplesPerBlock)
+{
+    setRateAndBufferSizeDetails (newSampleRate, estimatedSamplesPerBlock);
+
+    const auto numChannels = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    const ScopedLock sl (getCallbackLock());
+    oversampler.prepare (jmax (1, numChannels), estimatedSamplesPerBlock);
+    setLatencySamples (roundToInt (oversampler.getLatencyInSamples()));
+}
+
 void SimpleDistortionProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
     auto localAmount = 1.0f;
@@ -36,5 +47,8 @@ void SimpleDistortionProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         localAmount = amountParam->get();
     }
 
-    DistortionFunctions::performSimple (buffer, localAmount);
+    oversampler.process (buffer, buffer.getNumChannels(), buffer.getNumSamples(), [localAmount] (juce::AudioBuffer<float>& oversampled)
+    {
+        DistortionFunctions::performSimple (oversampled, localAmount);
+    });
 }
@@ -11,6 +11,8 @@ public:
     /** @internal */
     Identifier getIdentifier() const override { return "simpleDistortion"; }
     /** @internal */
+    void prepareToPlay (double, int) override;
+    /** @internal */
     void processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midiMessages) override;
 
 private:
@@ -18,6 +20,9 @@ private:
     class AmountParameter;
     AmountParameter* amountParam;
 
+    // Distorting at 4x keeps most of the harmonics from folding back down as aliasing.
+    PolyphaseOversampler<float> oversampler { 4 };
+
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleDistortionProcessor)
 };
@@ -39,6 +39,8 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override { return true; }
     /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
+    /** @internal */
     void prepareToPlay (double, int) override;
     /** @internal */
     void processBlock (juce::AudioBuffer<float>&, MidiBuffer&) override;
@@ -4,15 +4,6 @@ namespace djdawprocessor
 BandProcessor::BandProcessor()
 {
 }
-BandProcessor::~BandProcessor()
-{
-    if (lowFrequencyToggleParam != nullptr)
-        lowFrequencyToggleParam->removeListener (this);
-    if (midFrequencyToggleParam != nullptr)
-        midFrequencyToggleParam->removeListener (this);
-    if (highFrequencyToggleParam != nullptr)
-        lowFrequencyToggleParam->removeListener (this);
-}
 
 void BandProcessor::setupBandParameters (AudioProcessorValueTreeState::ParameterLayout& layout)
 {
@@ -41,99 +32,69 @@ void BandProcessor::setupBandParameters (AudioProcessorValueTreeState::Parameter
                                                                      });
 
     lowFrequencyToggleParam = lowFrequencyToggle.get();
-    lowFrequencyToggleParam->addListener (this);
-
     midFrequencyToggleParam = midFrequencyToggle.get();
-    midFrequencyToggleParam->addListener (this);
-
     highFrequencyToggleParam = highFrequencyToggle.get();
-    highFrequencyToggleParam->addListener (this);
 
     layout.add (std::move (lowFrequencyToggle));
     layout.add (std::move (midFrequencyToggle));
     layout.add (std::move (highFrequencyToggle));
 }
 
-void BandProcessor::parameterValueChanged (int paramIndex, float)
-{
-    const ScopedLock sl (getCallbackLock());
-    switch (paramIndex)
-    {
-        case (1):
-            //Low frequency toggle changed
-            break;
-        case (2):
-            //Mid frequency toggle changed
-            break;
-        case (3):
-            //High frequency toggle changed
-            break;
-    }
-}
-
 void BandProcessor::prepareToPlay (double Fs, int bufferSize)
 {
-    setRateAndBufferSizeDetails (Fs, bufferSize);
+    InternalProcessor::prepareToPlay (Fs, bufferSize);
 
-    int numChannels = 2;
-    multibandBuffer.setSize (numChannels, bufferSize);
-    tempBuffer.setSize (numChannels, bufferSize);
+    numPreparedChannels = jmax (2, getTotalNumInputChannels(), getTotalNumOutputChannels());
+    multibandBuffer.setSize (numPreparedChannels, bufferSize);
+    crossover.prepare (Fs, numPreparedChannels);
 }
 void BandProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midi)
 {
+    // Any parameter changes get applied here, on the audio thread, before the effect runs:
+    updateParameterSnapshot();
+
     // Called for each individual effect's processing
-    processAudioBlock (buffer, midi);
+    if (buffer.getNumChannels() <= numPreparedChannels)
+    {
+        processAudioBlock (buffer, midi);
+        return;
+    }
+
+    // Any extra channels are passed through, untouched, using a view
+    // onto the buffer's channels so as to avoid allocating anything:
+    juce::AudioBuffer<float> preparedChannels (buffer.getArrayOfWritePointers(), numPreparedChannels, buffer.getNumSamples());
+    processAudioBlock (preparedChannels, midi);
 }
 
 void BandProcessor::fillMultibandBuffer (juce::AudioBuffer<float>& buffer)
 {
-    bool lowOn;
-    bool midOn;
-    bool highOn;
+    const auto& parameters = getParameterSnapshot();
+    const auto lowOn = parameters.getBool (lowFrequencyToggleParam);
+    const auto midOn = parameters.getBool (midFrequencyToggleParam);
+    const auto highOn = parameters.getBool (highFrequencyToggleParam);
+
+    const int numChannels = jmin (buffer.getNumChannels(), multibandBuffer.getNumChannels());
+    const int numSamples = jmin (buffer.getNumSamples(), multibandBuffer.getNumSamples());
+
+    if (lowOn && midOn && highOn)
     {
-        const ScopedLock sl (getCallbackLock());
-        lowOn = lowFrequencyToggleParam->get();
-        midOn = midFrequencyToggleParam->get();
-        highOn = highFrequencyToggleParam->get();
-    }
+        for (int c = 0; c < numChannels; ++c)
+            multibandBuffer.copyFrom (c, 0, buffer, c, 0, numSamples);
 
-    if (! lowOn || ! midOn || ! highOn)
+        crossover.reset(); // So the bands start afresh when they next get toggled.
+    }
+    else if (! lowOn && ! midOn && ! highOn)
     {
         multibandBuffer.clear();
-        if (lowOn)
-        {
-            tempBuffer.clear();
-            lowbandFilter.processToOutputBuffer (buffer, tempBuffer);
-            int numChannels = buffer.getNumChannels();
-            int numSamples = buffer.getNumSamples();
-            for (int c = 0; c < numChannels; ++c)
-                multibandBuffer.addFrom (c, 0, tempBuffer.getWritePointer (c), numSamples);
-        }
-        if (midOn)
-        {
-            tempBuffer.clear();
-            midbandFilter.processToOutputBuffer (buffer, tempBuffer);
-            int numChannels = buffer.getNumChannels();
-            int numSamples = buffer.getNumSamples();
-            for (int c = 0; c < numChannels; ++c)
-                multibandBuffer.addFrom (c, 0, tempBuffer.getWritePointer (c), numSamples);
-        }
-        if (highOn)
-        {
-            tempBuffer.clear();
-            highbandFilter.processToOutputBuffer (buffer, tempBuffer);
-            int numChannels = buffer.getNumChannels();
-            int numSamples = buffer.getNumSamples();
-            for (int c = 0; c < numChannels; ++c)
-                multibandBuffer.addFrom (c, 0, tempBuffer.getWritePointer (c), numSamples);
-        }
+        crossover.reset();
     }
     else
     {
-        int numChannels = buffer.getNumChannels();
-        int numSamples = buffer.getNumSamples();
-        for (int c = 0; c < numChannels; ++c)
-            multibandBuffer.copyFrom (c, 0, buffer.getWritePointer (c), numSamples);
+        // Splits and sums the enabled bands in a single pass, straight into the multiband buffer:
+        crossover.setBandEnabled (0, lowOn);
+        crossover.setBandEnabled (1, midOn);
+        crossover.setBandEnabled (2, highOn);
+        crossover.process (buffer, multibandBuffer, numChannels, numSamples);
     }
 }
 
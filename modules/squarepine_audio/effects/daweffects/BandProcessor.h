@@ -5,12 +5,13 @@ namespace djdawprocessor
 ///The Band Processor class has three main parameters, a toggle for each frequency band the processing should be applied to.
 ///Currently this class doesn't perform any of the processing
 ///
-class BandProcessor : public InternalProcessor,
-                      public AudioProcessorParameter::Listener
+///The parameters are snapshotted at the top of every block, so inherited classes should read them from
+///getParameterSnapshot() and react to their changes in parameterSnapshotChanged(), both on the audio thread.
+///
+class BandProcessor : public InternalProcessor
 {
 public:
     BandProcessor();
-    ~BandProcessor() override;
 
     void prepareToPlay (double Fs, int bufferSize) override;
     void processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midi) override;
@@ -22,20 +23,87 @@ public:
 
     void setupBandParameters (AudioProcessorValueTreeState::ParameterLayout& layout);
 
-    virtual void parameterValueChanged (int paramNum, float value) override;
 protected:
+    /** @returns the number of channels the last call to prepareToPlay() sized everything for,
+        which is the most that processAudioBlock() will ever be handed.
+        Inherited classes should size their per-channel state from this.
+    */
+    int getNumPreparedChannels() const noexcept { return numPreparedChannels; }
+
     AudioBuffer<float> multibandBuffer;
 
 private:
-    AudioParameterBool *lowFrequencyToggleParam, *midFrequencyToggleParam, *highFrequencyToggleParam;
+    AudioParameterBool *lowFrequencyToggleParam = nullptr, *midFrequencyToggleParam = nullptr, *highFrequencyToggleParam = nullptr;
 
     static constexpr float lowCutoff = 300.f;
     static constexpr float highCutoff = 5000.f;
-    CrossoverFilter lowbandFilter { DigitalFilter::FilterType::LPF, lowCutoff };
-    CrossoverBPF midbandFilter { lowCutoff, highCutoff };
-    CrossoverFilter highbandFilter { DigitalFilter::FilterType::HPF, highCutoff };
+    MultibandCrossover<float> crossover { { lowCutoff, highCutoff } };
+    int numPreparedChannels = 2;
+};
+
+//==============================================================================
+/** The JUCE reverb only handles up to stereo, so this runs one per pair of channels,
+    with any odd channel out getting a mono reverb of its own.
+
+    Up to stereo, this sounds exactly like a single JUCE reverb.
+*/
+class MultichannelReverb final
+{
+public:
+    MultichannelReverb() = default;
+
+    void prepare (double sampleRate, int numChannels)
+    {
+        const auto numReverbs = jmax (1, (numChannels + 1) / 2);
+
+        while (reverbs.size() < numReverbs)
+            reverbs.add (new Reverb());
+
+        reverbs.removeLast (reverbs.size() - numReverbs);
+
+        for (auto* reverb : reverbs)
+        {
+            reverb->reset();
+            reverb->setSampleRate (sampleRate);
+            reverb->setParameters (parameters);
+        }
+    }
+
+    void reset()
+    {
+        for (auto* reverb : reverbs)
+            reverb->reset();
+    }
+
+    /** The parameters are kept around, so any reverbs added by prepare() pick them up too. */
+    void setParameters (const Reverb::Parameters& newParameters)
+    {
+        parameters = newParameters;
+
+        for (auto* reverb : reverbs)
+            reverb->setParameters (parameters);
+    }
+
+    void process (float* const* channels, int numChannels, int numSamples)
+    {
+        numChannels = jmin (numChannels, reverbs.size() * 2);
+
+        for (int c = 0; c < numChannels; c += 2)
+        {
+            auto* reverb = reverbs.getUnchecked (c / 2);
+
+            if (c + 1 < numChannels)
+                reverb->processStereo (channels[c], channels[c + 1], numSamples);
+            else
+                reverb->processMono (channels[c], numSamples);
+        }
+    }
+
+private:
+    OwnedArray<Reverb> reverbs;
+    Reverb::Parameters parameters;
 
-    AudioBuffer<float> tempBuffer;
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MultichannelReverb)
 };
 
 }
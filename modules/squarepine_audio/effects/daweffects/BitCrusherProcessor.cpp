@@ -94,21 +94,49 @@ float BitCrusherProcessor::getBitDepth() const noexcept
 }
 
 //==============================================================================
+void BitCrusherProcessor::prepareToPlay (const double newSampleRate, const int estimatedSamplesPerBlock)
+{
+    InternalProcessor::prepareToPlay (newSampleRate, estimatedSamplesPerBlock);
+
+    const auto numChannels = jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    const ScopedLock sl (getCallbackLock());
+    oversampler.prepare (jmax (1, numChannels), estimatedSamplesPerBlock);
+    isCrushing = getBitDepth() < maximumBitDepth;
+    updateLatency();
+}
+
 void BitCrusherProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
-    float localBitDepth = 32.f;
+    updateParameterSnapshot();
+
+    const auto localBitDepth = getParameterSnapshot().get (bitDepth);
 
+    // N.B.: At full depth there's nothing to crush, so the audio is left untouched
+    //       rather than paying for the oversampler's latency and filtering.
+    const auto shouldCrush = localBitDepth < maximumBitDepth;
+
+    if (shouldCrush != isCrushing)
     {
-        const ScopedLock sl (getCallbackLock());
-        localBitDepth = bitDepth->get();
+        isCrushing = shouldCrush;
+        oversampler.reset();
+        updateLatency();
     }
 
-    if (buffer.hasBeenCleared() || localBitDepth >= 32.f)
-        return;// Nothing to do here.
+    if (! shouldCrush)
+        return;
 
-    for (auto channel: AudioBufferView<float> (buffer))
-        for (auto& sample: channel)
-            sample = (float) crushBit ((double) sample, localBitDepth);
+    oversampler.process (buffer, buffer.getNumChannels(), buffer.getNumSamples(), [localBitDepth] (juce::AudioBuffer<float>& oversampled)
+    {
+        for (auto channel : AudioBufferView<float> (oversampled))
+            for (auto& sample : channel)
+                sample = (float) crushBit ((double) sample, localBitDepth);
+    });
+}
+
+void BitCrusherProcessor::updateLatency()
+{
+    setLatencySamples (isCrushing ? roundToInt (oversampler.getLatencyInSamples()) : 0);
 }
 
 }
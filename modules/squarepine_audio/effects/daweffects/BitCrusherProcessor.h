@@ -21,10 +21,23 @@ public:
     /** @internal */
     Identifier getIdentifier() const override { return "bitCrusher"; }
     /** @internal */
+    void prepareToPlay (double, int) override;
+    /** @internal */
     void processBlock (juce::AudioBuffer<float>&, MidiBuffer&) override;
 private:
     //==============================================================================
-    AudioParameterFloat* bitDepth = new AudioParameterFloat ("bitDepth", "Bit-Depth", 1.f, 32.f, 32.f);
+    // At the maximum depth nothing gets crushed, which is passed through as is, without any latency.
+    static constexpr auto maximumBitDepth = 32.0f;
+
+    AudioParameterFloat* bitDepth = new AudioParameterFloat ("bitDepth", "Bit-Depth", 1.f, maximumBitDepth, maximumBitDepth);
+
+    // Quantising at 2x keeps some of the steps' harmonics from folding back down as aliasing.
+    // The oversampler's latency is only reported while crushing.
+    PolyphaseOversampler<float> oversampler { 2 };
+    bool isCrushing = false;
+
+    //==============================================================================
+    void updateLatency();
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BitCrusherProcessor)
@@ -9,73 +9,121 @@ namespace djdawprocessor
 // putting two 2nd-order butterworth filters in series.
 // A butterworth filter can be made from a "DigitalFilter"
 // by setting the Q=0.7071
+// The filters are registered with a BiquadBank,
+// so the whole cascade runs in a single pass over the channels.
 
 class CrossoverFilter
 {
 public:
     CrossoverFilter (DigitalFilter::FilterType type, float cutoffFreq)
     {
-        filter1.setFilterType (type);
-        filter2.setFilterType (type);
-        filter1.setFreq (cutoffFreq);
-        filter2.setFreq (cutoffFreq);
-        filter1.setQValue (0.7071f);
-        filter2.setQValue (0.7071f);
+        for (auto* f : { &filter1, &filter2 })
+        {
+            f->setFilterType (type);
+            f->setFreq (cutoffFreq);
+            f->setQValue (0.7071f);
+            f->registerWith (bank);
+        }
     }
 
-    void prepareToPlay (double Fs, int)
+    void prepareToPlay (double Fs, int, int numChannels = 2)
     {
-        filter1.setFs (Fs);
-        filter2.setFs (Fs);
+        for (auto* f : { &filter1, &filter2 })
+            f->setFs (Fs, numChannels);
+
+        bank.prepare (numChannels);
+        bank.reset();
     }
 
-    void processBuffer (juce::AudioBuffer<float>& buffer, MidiBuffer& midi)
+    void processBuffer (juce::AudioBuffer<float>& buffer, MidiBuffer&)
     {
-        filter1.processBuffer (buffer, midi);
-        filter2.processBuffer (buffer, midi);
+        process (buffer);
     }
 
     void processToOutputBuffer (juce::AudioBuffer<float>& inBuffer, juce::AudioBuffer<float>& outBuffer)
     {
-        filter1.processToOutputBuffer (inBuffer, outBuffer);
-        filter2.processToOutputBuffer (inBuffer, outBuffer);
+        for (int c = 0; c < jmin (inBuffer.getNumChannels(), outBuffer.getNumChannels()); ++c)
+            outBuffer.copyFrom (c, 0, inBuffer, c, 0, inBuffer.getNumSamples());
+
+        process (outBuffer);
     }
 private:
     DigitalFilter filter1;
     DigitalFilter filter2;
+    BiquadBank<float> bank;
+
+    void process (juce::AudioBuffer<float>& buffer)
+    {
+        const auto numSamples = buffer.getNumSamples();
+
+        for (auto* f : { &filter1, &filter2 })
+            f->updateBank (numSamples);
+
+        bank.process (buffer, 0, numSamples);
+    }
 };
 
-// CrossoverBPF is just a combination of a Linkwitz-Riley LPF and HPF
+// CrossoverBPF is just a combination of a Linkwitz-Riley LPF and HPF,
+// so all four of its butterworth filters share a single bank
 class CrossoverBPF
 {
 public:
     CrossoverBPF (float hpfFreq, float lpfFreq)
-        : lpf (DigitalFilter::FilterType::LPF, lpfFreq),
-          hpf (DigitalFilter::FilterType::HPF, hpfFreq)
     {
+        for (auto* f : { &lpf1, &lpf2 })
+        {
+            f->setFilterType (DigitalFilter::FilterType::LPF);
+            f->setFreq (lpfFreq);
+        }
+
+        for (auto* f : { &hpf1, &hpf2 })
+        {
+            f->setFilterType (DigitalFilter::FilterType::HPF);
+            f->setFreq (hpfFreq);
+        }
+
+        for (auto* f : { &lpf1, &lpf2, &hpf1, &hpf2 })
+        {
+            f->setQValue (0.7071f);
+            f->registerWith (bank);
+        }
     }
 
-    void prepareToPlay (double Fs, int samplesPerBuffer)
+    void prepareToPlay (double Fs, int, int numChannels = 2)
     {
-        lpf.prepareToPlay (Fs, samplesPerBuffer);
-        hpf.prepareToPlay (Fs, samplesPerBuffer);
+        for (auto* f : { &lpf1, &lpf2, &hpf1, &hpf2 })
+            f->setFs (Fs, numChannels);
+
+        bank.prepare (numChannels);
+        bank.reset();
     }
 
-    void processBuffer (juce::AudioBuffer<float>& buffer, MidiBuffer& midi)
+    void processBuffer (juce::AudioBuffer<float>& buffer, MidiBuffer&)
     {
-        lpf.processBuffer (buffer, midi);
-        hpf.processBuffer (buffer, midi);
+        process (buffer);
     }
 
     void processToOutputBuffer (juce::AudioBuffer<float>& inBuffer, juce::AudioBuffer<float>& outBuffer)
     {
-        lpf.processToOutputBuffer (inBuffer, outBuffer);
-        hpf.processToOutputBuffer (inBuffer, outBuffer);
+        for (int c = 0; c < jmin (inBuffer.getNumChannels(), outBuffer.getNumChannels()); ++c)
+            outBuffer.copyFrom (c, 0, inBuffer, c, 0, inBuffer.getNumSamples());
+
+        process (outBuffer);
     }
-    
+
 private:
-    CrossoverFilter lpf;
-    CrossoverFilter hpf;
+    DigitalFilter lpf1, lpf2, hpf1, hpf2;
+    BiquadBank<float> bank;
+
+    void process (juce::AudioBuffer<float>& buffer)
+    {
+        const auto numSamples = buffer.getNumSamples();
+
+        for (auto* f : { &lpf1, &lpf2, &hpf1, &hpf2 })
+            f->updateBank (numSamples);
+
+        bank.process (buffer, 0, numSamples);
+    }
 };
 
 }
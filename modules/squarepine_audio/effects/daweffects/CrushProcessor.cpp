@@ -55,16 +55,12 @@ CrushProcessor::CrushProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     colourParam = colour.get();
-    colourParam->addListener (this);
 
     otherParam = other.get();
-    otherParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -77,17 +73,11 @@ CrushProcessor::CrushProcessor (int idNum)
     setPrimaryParameter (colourParam);
 }
 
-CrushProcessor::~CrushProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    colourParam->removeListener (this);
-    otherParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void CrushProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (sampleRate, bufferSize);
+
     Fs = sampleRate;
     
     downSampler.setRatio (sampleRate, sampleRate);
@@ -103,18 +93,18 @@ void CrushProcessor::prepareToPlay (double sampleRate, int bufferSize)
 }
 void CrushProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midi)
 {
+    updateParameterSnapshot();
+
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     float wet = 0.5f;
     bool bypass;
     float colour;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        colour = colourParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    colour = parameters.get (colourParam);
 
     if (bypass || isBypassed())
         return;
@@ -159,10 +149,8 @@ Identifier CrushProcessor::getIdentifier() const { return "Crush" + String (idNu
 /** @internal */
 bool CrushProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void CrushProcessor::parameterValueChanged (int paramNum, float value)
+void CrushProcessor::parameterSnapshotChanged (int paramNum, float value)
 {
-    const ScopedLock sl (getCallbackLock());
-
     if (paramNum == 2) {}// wet/dry
     else if (paramNum == 3) // "color"
     {
@@ -28,13 +28,11 @@ namespace djdawprocessor
 /// thing, only in an opposite direction. I suspect that the gate/comp was implemented this way so that it would behave
 /// consistently for a wide range of input signals (some that have been mastered and so at a much lower LUFS).
 
-class CrushProcessor final : public InternalProcessor,
-                             public AudioProcessorParameter::Listener
+class CrushProcessor final : public InternalProcessor
 {
 public:
     //Constructor with ID
     CrushProcessor (int idNum = 1);
-    ~CrushProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -45,9 +43,10 @@ public:
     Identifier getIdentifier() const override;
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
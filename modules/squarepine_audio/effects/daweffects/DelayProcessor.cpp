@@ -3,56 +3,30 @@ namespace djdawprocessor
 
 float ModulatedDelay::processSample (float x, int channel)
 {
-    if (delay < 1.f)
-    {
-        return x;
-    }
-    else
-    {
-        // Delay Buffer
-        // "delay" can be fraction
-        int d1 = (int) floor (delay);
-        int d2 = d1 + 1;
-        float g2 = delay - (float) d1;
-        float g1 = 1.0f - g2;
-
-        int indexD1 = index[channel] - d1;
-        if (indexD1 < 0)
-        {
-            indexD1 += MAX_BUFFER_SIZE;
-        }
+    // setFs() needs to be called first, to allocate the delay line!
+    jassert (delayLine.isPrepared());
 
-        int indexD2 = index[channel] - d2;
-        if (indexD2 < 0)
-        {
-            indexD2 += MAX_BUFFER_SIZE;
-        }
-
-        float y = g1 * delayBuffer[indexD1][channel] + g2 * delayBuffer[indexD2][channel];
-
-        delayBuffer[index[channel]][channel] = x;
-
-        if (index[channel] < MAX_BUFFER_SIZE - 1)
-        {
-            index[channel]++;
-        }
-        else
-        {
-            index[channel] = 0;
-        }
+    if (! isPositiveAndBelow (channel, delayLine.getNumChannels()))
+        return x;
 
-        return y;
-    }
+    // "delay" can be fraction
+    return delayLine.processSample (channel, x, delay);
 }
 
-void ModulatedDelay::setFs (float _Fs)
+void ModulatedDelay::setFs (float _Fs, int numChannels)
 {
     this->Fs = _Fs;
+    delayLine.prepare ((double) Fs, (double) maxDelaySeconds, numChannels);
+}
+
+void ModulatedDelay::setMaximumDelaySeconds (float seconds)
+{
+    maxDelaySeconds = jmax (0.f, seconds);
 }
 
 void ModulatedDelay::setDelaySamples (float _delay)
 {
-    if (delay >= 1.f)
+    if (_delay >= 1.f)
     {
         delay = _delay;
     }
@@ -64,64 +38,33 @@ void ModulatedDelay::setDelaySamples (float _delay)
 
 void ModulatedDelay::clearDelay()
 {
-    for (int i = 0; i < MAX_BUFFER_SIZE; ++i)
-    {
-        for (int c = 0; c < 2; ++c)
-        {
-            delayBuffer[i][c] = 0;
-        }
-    }
+    delayLine.clear();
 }
 
 float FractionalDelay::processSample (float x, int channel)
 {
-    smoothDelay[channel] = 0.999f * smoothDelay[channel] + 0.001f * delay;
+    // setFs() needs to be called first, to allocate the delay line!
+    jassert (delayLine.isPrepared());
 
-    if (smoothDelay[channel] < 1.f)
-    {
+    if (! isPositiveAndBelow (channel, delayLine.getNumChannels()))
         return x;
-    }
-    else
-    {
-        // Delay Buffer
-        // "delay" can be fraction
-        int d1 = (int) floor (smoothDelay[channel]);
-        int d2 = d1 + 1;
-        float g2 = smoothDelay[channel] - (float) d1;
-        float g1 = 1.0f - g2;
-
-        int indexD1 = index[channel] - d1;
-        if (indexD1 < 0)
-        {
-            indexD1 += MAX_BUFFER_SIZE;
-        }
-
-        int indexD2 = index[channel] - d2;
-        if (indexD2 < 0)
-        {
-            indexD2 += MAX_BUFFER_SIZE;
-        }
-
-        float y = g1 * delayBuffer[indexD1][channel] + g2 * delayBuffer[indexD2][channel];
-
-        delayBuffer[index[channel]][channel] = x;
 
-        if (index[channel] < MAX_BUFFER_SIZE - 1)
-        {
-            index[channel]++;
-        }
-        else
-        {
-            index[channel] = 0;
-        }
+    smoothDelay[channel] = 0.999f * smoothDelay[channel] + 0.001f * delay;
 
-        return y;
-    }
+    // "delay" can be fraction
+    return delayLine.processSample (channel, x, smoothDelay[channel]);
 }
 
-void FractionalDelay::setFs (float _Fs)
+void FractionalDelay::setFs (float _Fs, int numChannels)
 {
     this->Fs = _Fs;
+    delayLine.prepare ((double) Fs, (double) maxDelaySeconds, numChannels);
+    smoothDelay.resize ((size_t) jmax (0, numChannels), 5.f);
+}
+
+void FractionalDelay::setMaximumDelaySeconds (float seconds)
+{
+    maxDelaySeconds = jmax (0.f, seconds);
 }
 
 void FractionalDelay::setDelaySamples (float _delay)
@@ -138,25 +81,24 @@ void FractionalDelay::setDelaySamples (float _delay)
 
 void FractionalDelay::clearDelay()
 {
-    for (int i = 0; i < MAX_BUFFER_SIZE; ++i)
-    {
-        for (int c = 0; c < 2; ++c)
-        {
-            delayBuffer[i][c] = 0;
-        }
-    }
+    delayLine.clear();
 }
 
 float AllPassDelay::processSample (float x, int channel)
 {
+    if (! isPositiveAndBelow (channel, (int) feedbackSample.size()))
+        return x;
+
     float y = -feedbackAmount * x + feedbackSample[channel];
     feedbackSample[channel] = delayBlock.processSample(x + feedbackAmount * feedbackSample[channel], channel);
     return y;
 }
 
-void AllPassDelay::setFs (float _Fs)
+void AllPassDelay::setFs (float _Fs, int numChannels)
 {
     this->Fs = _Fs;
+    delayBlock.setFs (_Fs, numChannels);
+    feedbackSample.resize ((size_t) jmax (0, numChannels), 0.0);
 }
 
 void AllPassDelay::setDelaySamples (float _delay)
@@ -216,13 +158,10 @@ DelayProcessor::DelayProcessor (int idNum)
     delayTime.setTargetValue (initialDelayTime);
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -236,21 +175,14 @@ DelayProcessor::DelayProcessor (int idNum)
     setEffectiveInTimeDomain (true);
 }
 
-DelayProcessor::~DelayProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void DelayProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     const ScopedLock lock (getCallbackLock());
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
-    delayUnit.setFs ((float) Fs);
-    delayUnit2.setFs ((float) Fs);
+    delayUnit.setFs ((float) Fs, getNumPreparedChannels());
+    delayUnit2.setFs ((float) Fs, getNumPreparedChannels());
     wetDry.reset (Fs, 0.5f);
     delayTime.reset (Fs, 1.f);
     setRateAndBufferSizeDetails (Fs, bufferSize);
@@ -263,10 +195,8 @@ void DelayProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
     const auto numSamples = buffer.getNumSamples();
 
     bool bypass;
-    {
-        const ScopedLock lock (getCallbackLock());
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -298,12 +228,8 @@ Identifier DelayProcessor::getIdentifier() const { return "Delay" + String (idNu
 /** @internal */
 bool DelayProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void DelayProcessor::parameterValueChanged (int paramIndex, float value)
+void DelayProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
-
-    BandProcessor::parameterValueChanged (paramIndex, value);
-
     switch (paramIndex)
     {
         case (1):
@@ -13,7 +13,15 @@ class ModulatedDelay
 public:
     float processSample (float x, int channel);
 
-    void setFs (float _Fs);
+    /** Allocates the delay line, for as many channels as will be processed,
+        so this must be called before processing.
+    */
+    void setFs (float _Fs, int numChannels = 2);
+
+    /** Sets the longest delay that will be asked for, which is what the delay line
+        gets sized from. This takes effect on the next call to setFs().
+    */
+    void setMaximumDelaySeconds (float seconds);
 
     void setDelaySamples (float _delay);
 
@@ -22,10 +30,9 @@ private:
     float Fs = 48000.f;
 
     float delay = 5.f;
+    float maxDelaySeconds = 4.f;
 
-    static const int MAX_BUFFER_SIZE = 384000;
-    float delayBuffer[MAX_BUFFER_SIZE][2] = { { 0.0f } };
-    int index[2] = { 0 };
+    InterpolatedDelayLine<float> delayLine;
 };
 
 class FractionalDelay
@@ -34,7 +41,13 @@ class FractionalDelay
 public:
     float processSample (float x, int channel);
 
-    void setFs (float _Fs);
+    /** @see ModulatedDelay::setFs */
+    void setFs (float _Fs, int numChannels = 2);
+
+    /** Sets the longest delay that will be asked for, which is what the delay line
+        gets sized from. This takes effect on the next call to setFs().
+    */
+    void setMaximumDelaySeconds (float seconds);
 
     void setDelaySamples (float _delay);
 
@@ -43,11 +56,10 @@ private:
     float Fs = 48000.f;
 
     float delay = 5.f;
-    float smoothDelay[2] = { 5.f };
+    std::vector<float> smoothDelay;     // Per channel, sized by setFs().
+    float maxDelaySeconds = 4.f;
 
-    static const int MAX_BUFFER_SIZE = 384000;
-    float delayBuffer[MAX_BUFFER_SIZE][2] = { { 0.0f } };
-    int index[2] = { 0 };
+    InterpolatedDelayLine<float> delayLine;
 };
 
 class AllPassDelay
@@ -55,7 +67,11 @@ class AllPassDelay
 public:
     float processSample (float x, int channel);
 
-    void setFs (float _Fs);
+    /** @see ModulatedDelay::setFs */
+    void setFs (float _Fs, int numChannels = 2);
+
+    /** @see FractionalDelay::setMaximumDelaySeconds */
+    void setMaximumDelaySeconds (float seconds) { delayBlock.setMaximumDelaySeconds (seconds); }
 
     void setDelaySamples (float _delay);
 
@@ -67,7 +83,7 @@ private:
 
     FractionalDelay delayBlock;
     double feedbackAmount = 0.0;
-    double feedbackSample[2] = { 0.0 };
+    std::vector<double> feedbackSample;     // Per channel, sized by setFs().
 };
 
 //This is a wrapper around Eric Tarr's Fractional Delay class that can be integrated with Juce/Squarepine processors
@@ -80,7 +96,6 @@ class DelayProcessor final : public BandProcessor
 public:
     //Constructor with ID
     DelayProcessor (int idNum = 1);
-    ~DelayProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -94,8 +109,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -62,19 +62,14 @@ DubEchoProcessor::DubEchoProcessor (int idNum)
                                                                      });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     echoColourParam = colour.get();
-    echoColourParam->addListener (this);
 
     feedbackParam = feedback.get();
-    feedbackParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -108,19 +103,15 @@ DubEchoProcessor::DubEchoProcessor (int idNum)
     setEffectiveInTimeDomain (true);
 }
 
-DubEchoProcessor::~DubEchoProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    echoColourParam->removeListener (this);
-    feedbackParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
-void DubEchoProcessor::prepareToPlay (double Fs, int /* bufferSize */)
+void DubEchoProcessor::prepareToPlay (double Fs, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (Fs, bufferSize);
+
     sampleRate = Fs;
+    // The longest echo time, plus room for the modulation depth:
+    delayBlock.setMaximumDelaySeconds (4.1f);
+    delayUnit2.setMaximumDelaySeconds (4.1f);
     delayBlock.setFs (static_cast<float> (sampleRate));
     delayUnit2.setFs (static_cast<float> (sampleRate));
     delayTime.reset (Fs, 1.f);
@@ -130,18 +121,18 @@ void DubEchoProcessor::prepareToPlay (double Fs, int /* bufferSize */)
 
 void DubEchoProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
+    updateParameterSnapshot();
+
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     bool bypass;
     float colour;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wetTarget = wetDryParam->get();
-        feedbackTarget = feedbackParam->get();
-        bypass = ! fxOnParam->get();
-        colour = echoColourParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wetTarget = parameters.get (wetDryParam);
+    feedbackTarget = parameters.get (feedbackParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    colour = parameters.get (echoColourParam);
 
     if (bypass || isBypassed())
         return;
@@ -168,9 +159,8 @@ Identifier DubEchoProcessor::getIdentifier() const { return "Dub Echo" + String
 /** @internal */
 bool DubEchoProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void DubEchoProcessor::parameterValueChanged (int paramIndex, float value)
+void DubEchoProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
@@ -23,7 +23,6 @@ class DubEchoProcessor final : public V10SendProcessor
 public:
     //Constructor with ID
     DubEchoProcessor (int idNum = 1);
-    ~DubEchoProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -35,8 +34,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -8,11 +8,17 @@ public:
     InternalFilter (FilterType filterType,
                     NotifiableAudioParameterFloat* g,
                     NotifiableAudioParameterFloat* c,
-                    NotifiableAudioParameterFloat* r)
+                    NotifiableAudioParameterFloat* r,
+                    BiquadBank<float>& fb,
+                    BiquadBank<double>& db)
         : type (filterType),
           gain (g),
           cutoff (c),
-          resonance (r)
+          resonance (r),
+          floatBank (fb),
+          doubleBank (db),
+          floatSection (fb.addSection()),
+          doubleSection (db.addSection())
     {
         updateCoefficients();
 
@@ -22,45 +28,24 @@ public:
     }
 
     //==============================================================================
-    void prepare (double newSampleRate, int bufferSize, int numChannels)
+    void prepare (double newSampleRate)
     {
         sampleRate = newSampleRate;
 
-        const dsp::ProcessSpec spec {
-            sampleRate,
-            (uint32) jmax (0, bufferSize),
-            (uint32) jmax (0, numChannels)
-        };
-
         floatGain.reset (newSampleRate, 0.01);
         doubleGain.reset (newSampleRate, 0.01);
 
-        floatProcessor.prepare (spec);
-        doubleProcessor.prepare (spec);
-
         updateCoefficients();
     }
 
-    void reset()
-    {
-        floatProcessor.reset();
-        doubleProcessor.reset();
-    }
-
-    void process (juce::AudioBuffer<float>& buffer, bool wholeProcIsBypassed)
-    {
-        if (floatGain.isSmoothing())
-            updateParamsFor (floatProcessor, floatGain.skip (buffer.getNumSamples()));
-
-        process (floatProcessor, buffer, wholeProcIsBypassed);
-    }
-
-    void process (juce::AudioBuffer<double>& buffer, bool wholeProcIsBypassed)
+    /** Sweeps this filter's section of the bank along with the gain, over the next block. */
+    template<typename SampleType>
+    void update (int numSamples)
     {
-        if (doubleGain.isSmoothing())
-            updateParamsFor (doubleProcessor, doubleGain.skip (buffer.getNumSamples()));
+        auto& smoothedGain = getGain<SampleType>();
 
-        process (doubleProcessor, buffer, wholeProcIsBypassed);
+        if (smoothedGain.isSmoothing())
+            updateParamsFor<SampleType> (smoothedGain.skip (numSamples), numSamples);
     }
 
     void updateParams()
@@ -71,8 +56,8 @@ public:
 
     void updateCoefficients()
     {
-        updateParamsFor (floatProcessor, floatGain.getCurrentValue());
-        updateParamsFor (doubleProcessor, doubleGain.getCurrentValue());
+        updateParamsFor<float> (floatGain.getCurrentValue(), 0);
+        updateParamsFor<double> (doubleGain.getCurrentValue(), 0);
     }
 
     //==============================================================================
@@ -81,9 +66,6 @@ public:
     ExponentialSmoothing<float> floatGain { 1.0f };
     ExponentialSmoothing<double> doubleGain { 1.0 };
 
-    ProcessorDuplicator<float> floatProcessor;
-    ProcessorDuplicator<double> doubleProcessor;
-
     // NB: These are owned by the parent EQ processor.
     NotifiableAudioParameterFloat* gain = nullptr;
     NotifiableAudioParameterFloat* cutoff = nullptr;
@@ -92,6 +74,21 @@ public:
     std::vector<NotifiableAudioParameterFloat*> parameters;
 private:
     //==============================================================================
+    // NB: These are owned by the parent EQ processor too.
+    BiquadBank<float>& floatBank;
+    BiquadBank<double>& doubleBank;
+    const int floatSection, doubleSection;
+
+    //==============================================================================
+    template<typename SampleType>
+    ExponentialSmoothing<SampleType>& getGain() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, float>)
+            return floatGain;
+        else
+            return doubleGain;
+    }
+
     template<typename SampleType>
     void updateSmoothedValue (ExponentialSmoothing<SampleType>& smoothedValue)
     {
@@ -100,16 +97,16 @@ private:
         smoothedValue.setTargetValue (g);
     }
 
+    /** The coefficients are worked out without allocating, so this is safe to call from the audio thread. */
     template<typename SampleType>
-    void updateParamsFor (ProcessorDuplicator<SampleType>& processor,
-                          SampleType currentGain)
+    void updateParamsFor (SampleType currentGain, int numSamplesToRamp)
     {
         const auto g = currentGain;
         float freqLimit = jmin (cutoff->get(), (static_cast<float> (sampleRate) / 2.f) * 0.95f);
         const auto c = (SampleType) freqLimit;
         const auto r = (SampleType) resonance->get();
-        using Coeffs = Coefficients<SampleType>;
-        typename Coeffs::Ptr coeffs;
+        using Coeffs = ArrayCoefficients<SampleType>;
+        std::array<SampleType, 6> coeffs { (SampleType) 1, {}, {}, (SampleType) 1, {}, {} };
 
         switch (type)
         {
@@ -127,19 +124,12 @@ private:
                 break;
         };
 
-        *processor.state = *coeffs;
-    }
-
-    template<typename SampleType>
-    void process (ProcessorDuplicator<SampleType>& processor,
-                  juce::AudioBuffer<SampleType>& buffer,
-                  bool wholeProcIsBypassed)
-    {
-        dsp::AudioBlock<SampleType> block (buffer);
-        Context<SampleType> context (block);
-        context.isBypassed = wholeProcIsBypassed;
+        const auto bankCoefficients = BiquadBank<SampleType>::Coefficients::fromUnnormalised (coeffs);
 
-        processor.process (context);
+        if constexpr (std::is_same_v<SampleType, float>)
+            floatBank.setCoefficients (floatSection, bankCoefficients, numSamplesToRamp);
+        else
+            doubleBank.setCoefficients (doubleSection, bankCoefficients, numSamplesToRamp);
     }
 
     //==============================================================================
@@ -172,7 +162,12 @@ void EQProcessor::prepareToPlay (const double newSampleRate, const int bufferSiz
     const ScopedLock sl (getCallbackLock());
 
     for (auto* f: filters)
-        f->prepare (newSampleRate, bufferSize, numChans);
+        f->prepare (newSampleRate);
+
+    floatBank.prepare (jmax (1, numChans));
+    doubleBank.prepare (jmax (1, numChans));
+    floatBank.reset();
+    doubleBank.reset();
 }
 
 void EQProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&) { process (buffer); }
@@ -192,7 +187,15 @@ void EQProcessor::process (juce::AudioBuffer<SampleType>& buffer)
     const ScopedLock sl (getCallbackLock());
 
     for (auto* f: filters)
-        f->process (buffer, isWholeProcBypassed);
+        f->template update<SampleType> (numSamples);
+
+    if (isWholeProcBypassed)
+        return;
+
+    if constexpr (std::is_same_v<SampleType, float>)
+        floatBank.process (buffer, 0, numSamples);
+    else
+        doubleBank.process (buffer, 0, numSamples);
 }
 
 //==============================================================================
@@ -270,7 +273,7 @@ AudioProcessorValueTreeState::ParameterLayout EQProcessor::createParameterLayout
                                                                           1.0f / MathConstants<float>::sqrt2,
                                                                           false);
 
-        filters.add (new InternalFilter (c.type, gain.get(), cutoff.get(), resonance.get()));
+        filters.add (new InternalFilter (c.type, gain.get(), cutoff.get(), resonance.get(), floatBank, doubleBank));
         for (auto* p: filters.getLast()->parameters)
         {
             p->addListener (this);
@@ -46,20 +46,15 @@ private:
     using FilterType = dsp::StateVariableTPTFilterType;
 
     template<typename SampleType>
-    using Context = dsp::ProcessContextReplacing<SampleType>;
-
-    template<typename SampleType>
-    using Filter = dsp::IIR::Filter<SampleType>;
-
-    template<typename SampleType>
-    using Coefficients = dsp::IIR::Coefficients<SampleType>;
-
-    template<typename SampleType>
-    using ProcessorDuplicator = dsp::ProcessorDuplicator<Filter<SampleType>, Coefficients<SampleType>>;
+    using ArrayCoefficients = dsp::IIR::ArrayCoefficients<SampleType>;
 
     template<typename SampleType>
     using ExponentialSmoothing = SmoothedValue<SampleType, ValueSmoothingTypes::Multiplicative>;
 
+    // Every band is a section of the same bank, so the whole EQ is a single pass over the channels.
+    BiquadBank<float> floatBank;
+    BiquadBank<double> doubleBank;
+
     class InternalFilter;
     OwnedArray<InternalFilter> filters;
 
@@ -46,13 +46,10 @@ EchoProcessor::EchoProcessor (int idNum)
     delayTime.setTargetValue (initialDelayTime);
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -66,13 +63,6 @@ EchoProcessor::EchoProcessor (int idNum)
     setEffectiveInTimeDomain (true);
 }
 
-EchoProcessor::~EchoProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void EchoProcessor::prepareToPlay (double Fs, int bufferSize)
 {
@@ -80,8 +70,11 @@ void EchoProcessor::prepareToPlay (double Fs, int bufferSize)
 
     const ScopedLock lock (getCallbackLock());
 
-    delayUnit.setFs (static_cast<float> (Fs));
-    delayUnit2.setFs (static_cast<float> (Fs));
+    const auto numChannels = getNumPreparedChannels();
+    delayUnit.setFs (static_cast<float> (Fs), numChannels);
+    delayUnit2.setFs (static_cast<float> (Fs), numChannels);
+    z.resize ((size_t) numChannels, 0.f);
+    zUnit2.resize ((size_t) numChannels, 0.f);
     wetDry.reset (Fs, 0.5f);
     delayTime.reset (Fs, 1.f);
     setRateAndBufferSizeDetails (Fs, bufferSize);
@@ -95,10 +88,8 @@ void EchoProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuf
     const auto numSamples = buffer.getNumSamples();
 
     bool bypass;
-    {
-        const ScopedLock lock (getCallbackLock());
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -130,12 +121,10 @@ Identifier EchoProcessor::getIdentifier() const { return "Echo" + String (idNumb
 /** @internal */
 bool EchoProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void EchoProcessor::parameterValueChanged (int paramIndex, float value)
+void EchoProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    BandProcessor::parameterValueChanged (paramIndex, value);
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
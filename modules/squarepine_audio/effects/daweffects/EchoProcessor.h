@@ -13,7 +13,6 @@ class EchoProcessor final : public BandProcessor
 public:
     //Constructor with ID
     EchoProcessor (int idNum = 1);
-    ~EchoProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -25,8 +24,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -45,8 +43,7 @@ private:
     ModulatedDelay delayUnit;
     ModulatedDelay delayUnit2;// used for stepped processing for cross-fade to avoid doppler changes
 
-    float z[2] = { 0.f };
-    float zUnit2[2] = { 0.f };
+    std::vector<float> z, zUnit2;     // Per channel, sized in prepareToPlay().
 
     float getDelayedSample (float x, int channel);
 
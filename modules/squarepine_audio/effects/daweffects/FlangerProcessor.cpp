@@ -52,16 +52,12 @@ FlangerProcessor::FlangerProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     xPadParam = other.get();
-    xPadParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -74,16 +70,8 @@ FlangerProcessor::FlangerProcessor (int idNum)
     setPrimaryParameter (wetDryParam);
     setEffectiveInTimeDomain (true);
 
-    phase.setFrequency (1.f / (timeParam->get() / 1000.f));
-    phaseWarble.setFrequency (2.f);
-}
-
-FlangerProcessor::~FlangerProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-    xPadParam->removeListener (this);
+    lfo.setFrequency (1.f / (timeParam->get() / 1000.f));
+    warbleLFO.setFrequency (2.f);
 }
 
 //============================================================================== Audio processing
@@ -92,9 +80,14 @@ void FlangerProcessor::prepareToPlay (double Fs, int bufferSize)
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
     const ScopedLock sl (getCallbackLock());
-    phase.prepare (Fs, bufferSize);
-    phaseWarble.prepare (Fs, bufferSize);
-    delayBlock.setFs (static_cast<float> (Fs));
+    const auto numChannels = getNumPreparedChannels();
+    lfo.prepare (Fs);
+    warbleLFO.prepare (Fs);
+    modulationBuffer.setSize (2, bufferSize);
+    delayBlock.setMaximumDelaySeconds (0.01f); // The LFO sweeps a few dozen samples at most.
+    delayBlock.setFs (static_cast<float> (Fs), numChannels);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+    warbleSmooth.resize ((size_t) numChannels, 1.f);
 }
 void FlangerProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
@@ -105,38 +98,38 @@ void FlangerProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Midi
     float wet;
     bool bypass;
     float warble;
-    float periodOfCycle = timeParam->get() / 1000.f;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        phase.setFrequency (1.f / periodOfCycle);
-        bypass = ! fxOnParam->get();
-        warble = xPadParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    float periodOfCycle = parameters.get (timeParam) / 1000.f;
+    wet = parameters.get (wetDryParam);
+    lfo.setFrequency (1.f / periodOfCycle);
+    bypass = ! parameters.getBool (fxOnParam);
+    warble = parameters.get (xPadParam);
 
     if (bypass || isBypassed())
         return;
 
     fillMultibandBuffer (buffer);
 
-    double lfoSample;
-    double warbleSample;
-    
     // effectPhaseRelativeToProjectDownBeat needs to be set once per buffer
     // based on the transport in Track::process
-    
+    lfo.setAngle (effectPhaseRelativeToProjectDownBeat);
+
+    // Every channel gets modulated the same way, so the LFOs are rendered once for all of them:
+    modulationBuffer.setSize (2, numSamples, false, false, true);
+    auto* delayTimes = modulationBuffer.getWritePointer (0);
+    auto* warbleSamples = modulationBuffer.getWritePointer (1);
+
+    float offset = depth + 5.f;
+    lfo.render<LFOWaveforms::Sine> (delayTimes, numSamples, depth, offset);
+    warbleLFO.render<LFOWaveforms::Sine> (warbleSamples, numSamples, 2.0);
+
     for (int c = 0; c < numChannels; ++c)
     {
-        phase.setCurrentAngle(effectPhaseRelativeToProjectDownBeat,c);
         for (int n = 0; n < numSamples; ++n)
         {
-            lfoSample = phase.getNextSample (c);
-            warbleSample = phaseWarble.getNextSample (c);
             float x = multibandBuffer.getWritePointer (c)[n];
 
-            float offset = depth + 5.f;
-            float warbleLFO = static_cast<float> (2.f * warbleSmooth[c] * sin (warbleSample));
-            float delayTime = static_cast<float> (depth * sin (lfoSample) + offset + warbleLFO);
+            float delayTime = delayTimes[n] + warbleSmooth[c] * warbleSamples[n];
 
             delayBlock.setDelaySamples (delayTime);
 
@@ -159,14 +152,11 @@ Identifier FlangerProcessor::getIdentifier() const { return "Flanger" + String (
 /** @internal */
 bool FlangerProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void FlangerProcessor::parameterValueChanged (int paramIndex, float value)
+void FlangerProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
-    BandProcessor::parameterValueChanged (paramIndex, value);
-
     //Subtract the number of new parameters in this processor
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
@@ -10,7 +10,6 @@ class FlangerProcessor final : public BandProcessor
 public:
     //Constructor with ID
     FlangerProcessor (int idNum = 1);
-    ~FlangerProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -23,8 +22,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -33,12 +31,11 @@ private:
     NotifiableAudioParameterBool* fxOnParam = nullptr;
 
     int idNumber = 1;
-    PhaseIncrementer phase;
-    PhaseIncrementer phaseWarble;
+    BlockLFO lfo, warbleLFO;
+    juce::AudioBuffer<float> modulationBuffer;      // The LFOs' output for the current block, shared by every channel.
     ModulatedDelay delayBlock;
     
-    float wetSmooth[2] = {0.f};
-    float warbleSmooth[2] = {1.f};
+    std::vector<float> wetSmooth, warbleSmooth;     // Per channel, sized in prepareToPlay().
 };
 
 }
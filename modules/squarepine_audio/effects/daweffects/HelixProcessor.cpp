@@ -40,13 +40,10 @@ HelixProcessor::HelixProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -62,22 +59,18 @@ HelixProcessor::HelixProcessor (int idNum)
     delayUnit.setDelaySamples (200 * 48);
 }
 
-HelixProcessor::~HelixProcessor()
-{
-    wetDryParam->removeListener (this);
-    timeParam->removeListener (this);
-    fxOnParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void HelixProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     sampleRate = static_cast<float> (Fs);
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
-    delayUnit.setFs ((float) Fs);
+    const auto numChannels = getNumPreparedChannels();
+    delayUnit.setFs ((float) Fs, numChannels);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+    z.resize ((size_t) numChannels, 0.f);
 
-    effectBuffer = AudioBuffer<float> (2, bufferSize);
+    effectBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #if SQUAREPINE_USE_ELASTIQUE
 
@@ -85,7 +78,7 @@ void HelixProcessor::prepareToPlay (double Fs, int bufferSize)
                           ? CElastiqueProV3If::kV3Pro
                           : CElastiqueProV3If::kV3Eff;
 
-    elastique = zplane::createElastiquePtr (bufferSize, 2, Fs, mode);
+    elastique = zplane::createElastiquePtr (bufferSize, numChannels, Fs, mode);
 
     if (elastique == nullptr)
     {
@@ -98,7 +91,7 @@ void HelixProcessor::prepareToPlay (double Fs, int bufferSize)
     auto localRatio = (float) std::clamp (1.0, 0.01, 10.0);
     zplane::isValid (elastique->SetStretchPitchQFactor (localRatio, pitchFactor, useElastiquePro));
 
-    outputBuffer = AudioBuffer<float> (2, bufferSize);
+    outputBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #endif
 }
@@ -109,14 +102,12 @@ void HelixProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        float delayMS = timeParam->get();
-        float samplesOfDelay = delayMS / 1000.f * sampleRate;
-        delayUnit.setDelaySamples (samplesOfDelay);
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    float delayMS = parameters.get (timeParam);
+    float samplesOfDelay = delayMS / 1000.f * sampleRate;
+    delayUnit.setDelaySamples (samplesOfDelay);
 
     if (bypass || isBypassed())
         return;
@@ -131,7 +122,7 @@ void HelixProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
     }
     const auto numSamplesToRead = elastique->GetFramesNeeded (static_cast<int> (numSamples));
 
-    effectBuffer.setSize (2, numSamplesToRead, false, true, true);
+    effectBuffer.setSize (getNumPreparedChannels(), numSamplesToRead, false, true, true);
 
     for (int c = 0; c < numChannels; ++c)
     {
@@ -155,8 +146,6 @@ void HelixProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
     auto outChannels = outputBuffer.getArrayOfWritePointers();
     zplane::isValid (elastique->ProcessData ((float**) inChannels, numSamplesToRead, (float**) outChannels));
 
-    const ScopedLock sl (getCallbackLock());
-
     float feedbackAmp = 0.5;
     for (int c = 0; c < numChannels; ++c)
     {
@@ -179,11 +168,10 @@ Identifier HelixProcessor::getIdentifier() const { return "Helix" + String (idNu
 /** @internal */
 bool HelixProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void HelixProcessor::parameterValueChanged (int paramIndex, float)
+void HelixProcessor::parameterSnapshotChanged (int paramIndex, float)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
@@ -24,7 +24,6 @@ class HelixProcessor final : public BandProcessor
 public:
     //Constructor with ID
     HelixProcessor (int idNum = 1);
-    ~HelixProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -36,8 +35,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -48,7 +46,7 @@ private:
 
     AudioBuffer<float> effectBuffer;
 
-    float wetSmooth[2] = { 0.f };
+    std::vector<float> wetSmooth;     // Per channel, sized in prepareToPlay().
 
     bool useElastiquePro = false;
     zplane::ElastiquePtr elastique;
@@ -60,7 +58,7 @@ private:
 
     FractionalDelay delayUnit;
 
-    float z[2] = { 0.f };
+    std::vector<float> z;             // Per channel, sized in prepareToPlay().
     float sampleRate = 44100.f;
 };
 
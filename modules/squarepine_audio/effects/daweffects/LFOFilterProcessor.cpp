@@ -51,16 +51,12 @@ LFOFilterProcessor::LFOFilterProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     xPadParam = other.get();
-    xPadParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -73,19 +69,12 @@ LFOFilterProcessor::LFOFilterProcessor (int idNum)
     setPrimaryParameter (wetDryParam);
     setEffectiveInTimeDomain (true);
 
-    phase.setFrequency (1.f / (timeParam->get() / 1000.f));
-    phaseWarble.setFrequency (3.f);
+    lfo.setFrequency (1.f / (timeParam->get() / 1000.f));
+    warbleLFO.setFrequency (3.f);
 
     bpf.setFilterType (DigitalFilter::FilterType::BPF2);
     bpf.setQValue (3.0f);
-}
-
-LFOFilterProcessor::~LFOFilterProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-    xPadParam->removeListener (this);
+    bpf.registerWith (filterBank);
 }
 
 //============================================================================== Audio processing
@@ -94,9 +83,15 @@ void LFOFilterProcessor::prepareToPlay (double Fs, int bufferSize)
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
     const ScopedLock sl (getCallbackLock());
-    bpf.setFs (Fs);
-    phase.prepare (Fs, bufferSize);
-    phaseWarble.prepare (Fs, bufferSize);
+    const auto numChannels = getNumPreparedChannels();
+    bpf.setFs (Fs, numChannels);
+    filterBank.prepare (numChannels);
+    filterBank.reset();
+    lfo.prepare (Fs);
+    warbleLFO.prepare (Fs);
+    modulationBuffer.setSize (2, bufferSize);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+    warbleSmooth.resize ((size_t) numChannels, 5.f);
 }
 void LFOFilterProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
@@ -106,59 +101,62 @@ void LFOFilterProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Mi
     float wet;
     bool bypass;
     float warble;
-    float periodOfCycle = timeParam->get() / 1000.f;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        warble = xPadParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    float periodOfCycle = parameters.get (timeParam) / 1000.f;
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    warble = parameters.get (xPadParam);
 
     if (bypass || isBypassed())
         return;
 
     fillMultibandBuffer (buffer);
 
-    float lfoSample;
-    float warbleSample;
-    //
-    
     // effectPhaseRelativeToProjectDownBeat needs to be set once per buffer
     // based on the transport in Track::process
-    
-    for (int c = 0; c < numChannels; ++c)
+    lfo.setAngle (effectPhaseRelativeToProjectDownBeat);
+
+    // Every channel gets modulated the same way, so the LFOs are rendered once for all of them:
+    modulationBuffer.setSize (2, numSamples, false, false, true);
+    auto* lfoSamples = modulationBuffer.getWritePointer (0);
+    auto* warbleSamples = modulationBuffer.getWritePointer (1);
+    lfo.render<LFOWaveforms::Sine> (lfoSamples, numSamples, 0.5, 0.5);
+    warbleLFO.render<LFOWaveforms::Sine> (warbleSamples, numSamples, 0.05);
+
+    // The filter follows the LFO at the end of every few samples,
+    // and the bank sweeps the coefficients in between.
+    for (int start = 0; start < numSamples; start += UPDATEFILTERS)
     {
-        phase.setCurrentAngle(effectPhaseRelativeToProjectDownBeat,c);
-        for (int n = 0; n < numSamples; ++n)
-        {
-            lfoSample = static_cast<float> (phase.getNextSample (c));
-            warbleSample = static_cast<float> (phaseWarble.getNextSample (c));
-            float x = multibandBuffer.getWritePointer (c)[n];
+        const int numThisTime = jmin ((int) UPDATEFILTERS, numSamples - start);
+        const int last = start + numThisTime - 1;
 
-            if (count < UPDATEFILTERS)
-                count++;// we want to avoid re-calulating filters every sample
-            else
-            {
-                float normLFO = 0.5f * sinf (lfoSample) + 0.5f;
-                float warbleLFO = 0.05f * warbleSmooth[c] * sinf (warbleSample);
-                float value = normLFO * 0.5f + 0.5f + warbleLFO;
-                float freqHz = 2.f * std::powf (10.f, (1.7f * value) + 2.f);// 200 - 10000
-                bpf.setFreq (freqHz);
-                count = 0;
-            }
+        float normLFO = lfoSamples[last];
+        float warbleOffset = warbleSmooth[0] * warbleSamples[last];
+        float value = normLFO * 0.5f + 0.5f + warbleOffset;
+        float freqHz = 2.f * std::powf (10.f, (1.7f * value) + 2.f);// 200 - 10000
+        bpf.setFreq (freqHz);
+        bpf.updateBank (numThisTime);
 
-            float wetSample = static_cast<float> (bpf.processSample (x, c));
+        filterBank.process (multibandBuffer, start, numThisTime);
 
-            float y = wetSmooth[c] * wetSample;
+        for (int c = 0; c < numChannels; ++c)
+        {
+            auto* wetSamples = multibandBuffer.getWritePointer (c, start);
+            auto* drySamples = buffer.getWritePointer (c, start);
+
+            for (int n = 0; n < numThisTime; ++n)
+            {
+                wetSamples[n] *= wetSmooth[c];
 
-            wetSmooth[c] = 0.999f * wetSmooth[c] + 0.001f * wet;
-            warbleSmooth[c] = 0.999f * warbleSmooth[c] + 0.001f * warble;
-            multibandBuffer.getWritePointer (c)[n] = y;
-            buffer.getWritePointer (c)[n] *= (1.f - wetSmooth[c]);
+                wetSmooth[c] = 0.999f * wetSmooth[c] + 0.001f * wet;
+                warbleSmooth[c] = 0.999f * warbleSmooth[c] + 0.001f * warble;
+                drySamples[n] *= (1.f - wetSmooth[c]);
+            }
         }
+    }
 
+    for (int c = 0; c < numChannels; ++c)
         buffer.addFrom (c, 0, multibandBuffer.getWritePointer (c), numSamples);
-    }
 }
 
 const String LFOFilterProcessor::getName() const { return TRANS ("LFO Filter"); }
@@ -167,12 +165,11 @@ Identifier LFOFilterProcessor::getIdentifier() const { return "LFO Filter" + Str
 /** @internal */
 bool LFOFilterProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void LFOFilterProcessor::parameterValueChanged (int paramIndex, float value)
+void LFOFilterProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
@@ -188,7 +185,7 @@ void LFOFilterProcessor::parameterValueChanged (int paramIndex, float value)
         }
         case (3):
         {
-            phase.setFrequency (1.f / (value / 1000.f));
+            lfo.setFrequency (1.f / (value / 1000.f));
             break;// time
         }
         case (4):
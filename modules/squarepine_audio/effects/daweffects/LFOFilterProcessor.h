@@ -13,7 +13,6 @@ class LFOFilterProcessor final : public BandProcessor
 public:
     //Constructor with ID
     LFOFilterProcessor (int idNum = 1);
-    ~LFOFilterProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -25,8 +24,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -36,15 +34,14 @@ private:
 
     int idNumber = 1;
 
-    PhaseIncrementer phase;
-    PhaseIncrementer phaseWarble;
+    BlockLFO lfo, warbleLFO;
+    juce::AudioBuffer<float> modulationBuffer;      // The LFOs' output for the current block, shared by every channel.
     DigitalFilter bpf;
+    BiquadBank<float> filterBank;// Sweeps the bpf's coefficients from one update to the next
 
-    int count = 0;
     static const int UPDATEFILTERS = 8;
 
-    float wetSmooth[2] = { 0.0 };
-    float warbleSmooth[2] = { 5.0 };
+    std::vector<float> wetSmooth, warbleSmooth;     // Per channel, sized in prepareToPlay().
 };
 
 }
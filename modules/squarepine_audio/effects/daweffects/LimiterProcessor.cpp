@@ -37,10 +37,11 @@ void LimiterProcessor::processBuffer (AudioBuffer<float>& buffer)
         for (int c = 0; c < numChannels; ++c)
             buffer.copyFrom (c, 0, bypassBuffer.getWritePointer (c), numSamples);
 
+        combinedLinearGR = 1.0f;
+        publishMeters();
         return;
     }
 
-    combinedLinearGR = 1.0f;// Reset for each buffer, so it can be referenced for meters
     autoCompGR = 1.0f;// updated in processAutoComp function
     limiterGR = 1.0f;
 
@@ -58,17 +59,10 @@ void LimiterProcessor::processBuffer (AudioBuffer<float>& buffer)
     {
         if (overSamplingOn)
         {
-            float* channelData = nullptr;
-            float* osChannelData = nullptr;
-            for (int c = 0; c < numChannels; ++c)
-            {
-                channelData = lookaheadBuffer.getWritePointer (c);
-                osChannelData = upbuffer.getWritePointer (c);
-                upsampling.process (channelData, osChannelData, c, numSamples);
-            }
+            auto& upbuffer = oversampling.processUp (lookaheadBuffer, numChannels, numSamples);
+            auto* osLeft = upbuffer.getWritePointer (0);
+            auto* osRight = upbuffer.getWritePointer (1);
 
-            float xL;
-            float xR;
             float yL;
             float yR;
             for (int i = 0; i < numSamples; ++i)
@@ -77,22 +71,15 @@ void LimiterProcessor::processBuffer (AudioBuffer<float>& buffer)
                 for (int j = 0; j < OSFactor; ++j)
                 {
                     int index = OSFactor * i + j;
-                    xL = upbuffer.getWritePointer (0)[index];
-                    xR = upbuffer.getWritePointer (1)[index];
 
-                    processStereoSample (xL, xR, detectSample, yL, yR);
+                    processStereoSample (osLeft[index], osRight[index], detectSample, yL, yR);
 
-                    upbuffer.getWritePointer (0)[index] = yL;
-                    upbuffer.getWritePointer (1)[index] = yR;
+                    osLeft[index] = yL;
+                    osRight[index] = yR;
                 }
             }
 
-            for (int c = 0; c < numChannels; ++c)
-            {
-                channelData = lookaheadBuffer.getWritePointer (c);
-                osChannelData = upbuffer.getWritePointer (c);
-                downsampling.process (osChannelData, channelData, c, buffer.getNumSamples());
-            }
+            oversampling.processDown (lookaheadBuffer, numChannels, numSamples);
         }
         else
         {
@@ -157,6 +144,31 @@ void LimiterProcessor::processBuffer (AudioBuffer<float>& buffer)
     outputMeterValue = getPeakMeterValue (buffer, false);// should this be before input gain?
 
     combinedLinearGR = autoCompGR * limiterGR;// store one value per buffer for the GR meter
+    publishMeters();
+}
+
+void LimiterProcessor::publishMeters()
+{
+    auto* meters = meterBus.getScratchChannels();
+
+    meters[inputMeter] = {};
+    meters[inputMeter].peak = Decibels::decibelsToGain (inputMeterValue, METERFLOORVALUE);
+
+    meters[outputMeter] = {};
+    meters[outputMeter].peak = Decibels::decibelsToGain (outputMeterValue, METERFLOORVALUE);
+    meters[outputMeter].gainReduction = combinedLinearGR;
+
+    meterBus.publish (meters, numMeters);
+}
+
+float LimiterProcessor::readMeter (int index) const
+{
+    MeterBus::ChannelLevels meters[numMeters];
+
+    if (meterBus.read (meters, numMeters) <= index)
+        return METERFLOORVALUE;
+
+    return Decibels::gainToDecibels (meters[index].peak, METERFLOORVALUE);
 }
 
 void LimiterProcessor::processStereoSample (float xL, float xR, float detectSample, float& yL, float& yR)
@@ -353,12 +365,10 @@ void LimiterProcessor::setOversampling (bool isOn)
         overSamplingOn = isOn;
         reset();
         if (isOn)
-        {
-            upsampling.prepare (OSFactor, OSQuality);
-            downsampling.prepare (OSFactor, OSQuality);
-        }
+            oversampling.setFactor (OSFactor);
         setAttack (attack);
         setRelease (release);
+        updateLatency();
     }
 }
 
@@ -371,16 +381,50 @@ void LimiterProcessor::setOverSamplingLevel (int level)
     {
         OSFactor = newOSFactor;
         reset();
-        //if (overSamplingOn)
-        //{
-        upsampling.prepare (OSFactor, OSQuality);
-        downsampling.prepare (OSFactor, OSQuality);
-        //}
+        oversampling.setFactor (OSFactor);
         setAttack (attack);
         setRelease (release);
+        updateLatency();
     }
 }
 
+void LimiterProcessor::setOverSamplingPhase (PolyphaseOversampler<float>::Phase phase)
+{
+    // Linear phase matches the old top quality setting; minimum phase trades that for a lot less latency.
+    if (oversampling.getPhase() != phase)
+    {
+        reset();
+        oversampling.setPhase (phase);
+        updateLatency();
+    }
+}
+
+void LimiterProcessor::setAutoCompOn (bool isOn)
+{
+    if (autoCompIsOn != isOn)
+    {
+        autoCompIsOn = isOn;
+        updateLatency();
+    }
+}
+
+void LimiterProcessor::updateLatency()
+{
+    latencyInSamples = lookAheadSamples;
+
+    if (autoCompIsOn)
+        latencyInSamples += static_cast<int> (round (Fs * .1f));// The auto-comp's own delay, see prepare()
+
+    if (overSamplingOn)
+        latencyInSamples += roundToInt (oversampling.getLatencyInSamples());
+
+    // The bypassed signal and the output gain have to be delayed by as much as the limited signal, to line up with it
+    for (int c = 0; c < 2; ++c)
+        indexBYWrite[c] = (indexBYRead[c] + latencyInSamples) % LASIZE;
+
+    indexOGWrite = (indexOGRead + latencyInSamples) % LASIZE;
+}
+
 void LimiterProcessor::setOfflineOS (bool isOn)
 {
     offlineOSOn = isOn;
@@ -396,17 +440,16 @@ void LimiterProcessor::prepare (float sampleRate, int bufferSize)
     setRelease (release);
     truePeakFrameBuffer = AudioBuffer<float> (1, bufferSize);
     truePeakPostBuffer = AudioBuffer<float> (1, bufferSize);
+    truePeakAnalysis.prepare (2, bufferSize);
+    truePeakPostAnalysis.prepare (2, bufferSize);
 
     lookaheadBuffer = AudioBuffer<float> (2, bufferSize);// (numChannels, numSamples)
     bypassBuffer = AudioBuffer<float> (2, bufferSize);// (numChannels, numSamples)
     autoCompBuffer = AudioBuffer<float> (2, bufferSize);// (numChannels, numSamples)
 
-    const int MAX_OS_LEVEL = 8;
-    upbuffer = AudioBuffer<float> (2, bufferSize * MAX_OS_LEVEL);// (numChannels, numSamples)
-    upsampling.prepare (OSFactor, OSQuality);
-    downsampling.prepare (OSFactor, OSQuality);
+    oversampling.prepare (2, bufferSize);// (numChannels, numSamples)
+    oversampling.setFactor (OSFactor);
 
-    int lookAheadSamples = 16;
     indexLAWrite[0] = lookAheadSamples;
     indexLAWrite[1] = lookAheadSamples;
     indexLARead[0] = 0;
@@ -418,13 +461,10 @@ void LimiterProcessor::prepare (float sampleRate, int bufferSize)
     indexACRead[0] = 0;
     indexACRead[1] = 0;
 
-    indexBYWrite[0] = lookAheadSamples;
-    indexBYWrite[1] = lookAheadSamples;
     indexBYRead[0] = 0;
     indexBYRead[1] = 0;
-
-    indexOGWrite = lookAheadSamples;
     indexOGRead = 0;
+    updateLatency();// Also sets where the bypass and output gain delays write
 
     // Meter rise and fall values similar to many DAWs (logic, ableton, pro tools)
     meterAttack = std::exp (-log (9.f) / (Fs * 0.01f));
@@ -516,11 +556,14 @@ float LimiterProcessor::getOutputGain()
 
 float LimiterProcessor::getGainReduction (bool linear)
 {
+    MeterBus::ChannelLevels meters[numMeters];
+    const auto gainReduction = meterBus.read (meters, numMeters) > outputMeter ? meters[outputMeter].gainReduction : 1.0f;
+
     if (linear)
-        return combinedLinearGR;
+        return gainReduction;
     // This method can be find the amount of gain reduction at a given time
     // if the interface has a meter or display.
-    return 20.f * log10 (combinedLinearGR);
+    return 20.f * log10 (gainReduction);
 }
 
 float LimiterProcessor::enhanceProcess (float x)
@@ -606,9 +649,9 @@ float LimiterProcessor::getPeakMeterValue (AudioBuffer<float>& buffer, bool isIn
     float peakValue = 0.f;
     float smoothedValue;
     if (isInput)
-        smoothedValue = std::pow (10.f, inputMeterValue.load() / 20.f);// smooth using linear value
+        smoothedValue = std::pow (10.f, inputMeterValue / 20.f);// smooth using linear value
     else
-        smoothedValue = std::pow (10.f, outputMeterValue.load() / 20.f);
+        smoothedValue = std::pow (10.f, outputMeterValue / 20.f);
 
     float g = 0.9f;
     for (int n = 0; n < numSamples; ++n)
@@ -706,7 +749,7 @@ void LimiterProcessor::processAutoComp (AudioBuffer<float>& buffer, AudioBuffer<
 
 void LimiterProcessor::reset()
 {
-    upbuffer.clear();
+    oversampling.reset();
     lookaheadBuffer.clear();
     bypassBuffer.clear();
     truePeakFrameBuffer.clear();
@@ -43,12 +43,26 @@ public:
     void setEnhanceAmount (float amount) { enhanceAmount = amount / 100.f; }// convert from %
     void setEnhanceOn (bool isOn) { enhanceIsOn = isOn; }
     void setTruePeakOn (bool isOn) { truePeakIsOn = isOn; }
-    void setAutoCompOn (bool isOn) { autoCompIsOn = isOn; }
+    void setAutoCompOn (bool isOn);
     void setOverSamplingLevel (int level);
+    void setOverSamplingPhase (PolyphaseOversampler<float>::Phase phase);
 
+    // The delay that the lookahead and oversampling add, for the owning processor to pass to setLatencySamples().
+    // This changes with the oversampling settings, so should be read again after changing them.
+    int getLatencyInSamples() const noexcept { return latencyInSamples; }
+
+    // Meters are published once per buffer, and can be read lock-free from any thread
+    enum MeterIndex
+    {
+        inputMeter = 0,
+        outputMeter,// Also carries the gain reduction
+        numMeters
+    };
+
+    const MeterBus& getMeterBus() const noexcept { return meterBus; }
     float getGainReduction (bool linear);
-    float getInputMeterValue () { return inputMeterValue; }
-    float getOutputMeterValue () { return outputMeterValue; }
+    float getInputMeterValue() { return readMeter (inputMeter); }
+    float getOutputMeterValue() { return readMeter (outputMeter); }
     
     void reset();
 private:
@@ -88,16 +102,20 @@ private:
     float gainSmoothPrev[2] = { 0.0f };// Variable for smoothing on dB scale
 
     float linA = 1.0f;// Linear gain multiplied by the input signal at the end of the detection path
-    std::atomic<float> combinedLinearGR = 1.0f; // Combination of Auto-Comp and Limiter Gain Reduction, use this for meters
+    float combinedLinearGR = 1.0f; // Combination of Auto-Comp and Limiter Gain Reduction, published for the meters
     float autoCompGR = 1.0f;
     float limiterGR = 1.0f;
     
     static constexpr float METERFLOORVALUE = -66.f; // in dB
-    std::atomic<float> inputMeterValue = METERFLOORVALUE;
-    std::atomic<float> outputMeterValue = METERFLOORVALUE;
+    float inputMeterValue = METERFLOORVALUE;// Smoothed on the audio thread, in dB
+    float outputMeterValue = METERFLOORVALUE;
     float meterAttack = 0.9f; // set in prepare
     float meterRelease = 0.9f;
     float getPeakMeterValue (AudioBuffer<float>& buffer, bool isInput);
+
+    MeterBus meterBus { numMeters };
+    void publishMeters();
+    float readMeter (int index) const;
     
 
     bool truePeakIsOn = true;
@@ -108,12 +126,13 @@ private:
     AudioBuffer<float> truePeakPostBuffer;
 
     int OSFactor = 2;
-    static const int OSQuality = 3;
     bool overSamplingOn = true;
     bool offlineOSOn = true;
-    AudioBuffer<float> upbuffer;
-    UpSampling2Stage upsampling;
-    DownSampling2Stage downsampling;
+    PolyphaseOversampler<float> oversampling { OSFactor };
+
+    static constexpr int lookAheadSamples = 16;
+    int latencyInSamples = lookAheadSamples;
+    void updateLatency();
 
     static const int LASIZE = 48000;
     float lookahead[LASIZE][2] = { { 0.f } };
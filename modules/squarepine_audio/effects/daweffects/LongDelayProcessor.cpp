@@ -51,16 +51,12 @@ LongDelayProcessor::LongDelayProcessor (int idNum)
                                                                      });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     feedbackParam = feedback.get();
-    feedbackParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -80,18 +76,13 @@ LongDelayProcessor::LongDelayProcessor (int idNum)
 
 }
 
-LongDelayProcessor::~LongDelayProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    feedbackParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
-void LongDelayProcessor::prepareToPlay (double sampleRate, int)
+void LongDelayProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (sampleRate, bufferSize);
+
     Fs = static_cast<float> (sampleRate);
+    delayUnit.setMaximumDelaySeconds (1.f);
     delayUnit.setFs (Fs);
     wetDry.reset (Fs, 0.5f);
     delayTime.reset (Fs, 0.5f);
@@ -99,20 +90,20 @@ void LongDelayProcessor::prepareToPlay (double sampleRate, int)
 }
 void LongDelayProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
+    updateParameterSnapshot();
+
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
     bool bypass;
     float feedback;
-    {
-        const ScopedLock sl (getCallbackLock());
-        bypass = ! fxOnParam->get();
-        feedback = feedbackParam->get() * 0.75f;// max feedback gain is 0.75
-        float timeMS = timeParam->get();
-        float samplesOfDelay = timeMS / 1000.f * Fs;
-        delayTime.setTargetValue (samplesOfDelay);
-        delayUnit.setDelaySamples (delayTime.getNextValue());
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
+    feedback = parameters.get (feedbackParam) * 0.75f;// max feedback gain is 0.75
+    float timeMS = parameters.get (timeParam);
+    float samplesOfDelay = timeMS / 1000.f * Fs;
+    delayTime.setTargetValue (samplesOfDelay);
+    delayUnit.setDelaySamples (delayTime.getNextValue());
 
     if (bypass || isBypassed())
         return;
@@ -139,9 +130,8 @@ Identifier LongDelayProcessor::getIdentifier() const { return "Long Delay" + Str
 /** @internal */
 bool LongDelayProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void LongDelayProcessor::parameterValueChanged (int paramIndex, float value)
+void LongDelayProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
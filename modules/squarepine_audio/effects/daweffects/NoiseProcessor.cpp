@@ -41,13 +41,10 @@ NoiseProcessor::NoiseProcessor (int idNum)
                                                                        ;
                                                                    });
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     colourParam = colour.get();
-    colourParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -66,16 +63,11 @@ NoiseProcessor::NoiseProcessor (int idNum)
     lpf.setQValue (DEFAULTQ);
 }
 
-NoiseProcessor::~NoiseProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    colourParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
-void NoiseProcessor::prepareToPlay (double Fs, int)
+void NoiseProcessor::prepareToPlay (double Fs, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (Fs, bufferSize);
+
     sampleRate = Fs;
     hpf.setFs (sampleRate);
     lpf.setFs (sampleRate);
@@ -83,18 +75,18 @@ void NoiseProcessor::prepareToPlay (double Fs, int)
 }
 void NoiseProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
+    updateParameterSnapshot();
+
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     float wet;
     bool bypass;
     float colour;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        colour = colourParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    colour = parameters.get (colourParam);
 
     if (bypass || isBypassed())
         return;
@@ -127,9 +119,8 @@ Identifier NoiseProcessor::getIdentifier() const { return "Noise" + String (idNu
 /** @internal */
 bool NoiseProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void NoiseProcessor::parameterValueChanged (int paramIndex, float value)
+void NoiseProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
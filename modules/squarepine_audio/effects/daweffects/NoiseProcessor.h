@@ -4,13 +4,11 @@ namespace djdawprocessor
 /// FREQ Range is 20-20k
 /// Extra parameter: controls the amplitude of the additive noise (0 min to 1 max)
 
-class NoiseProcessor final : public InternalProcessor,
-                             public AudioProcessorParameter::Listener
+class NoiseProcessor final : public InternalProcessor
 {
 public:
     //Constructor with ID
     NoiseProcessor (int idNum = 1);
-    ~NoiseProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -21,9 +19,10 @@ public:
     Identifier getIdentifier() const override;
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -52,16 +52,12 @@ PhaserProcessor::PhaserProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     xPadParam = other.get();
-    xPadParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -74,8 +70,8 @@ PhaserProcessor::PhaserProcessor (int idNum)
     setPrimaryParameter (wetDryParam);
     setEffectiveInTimeDomain (true);
 
-    phase.setFrequency (1.f / (timeParam->get() / 1000.f));
-    phaseWarble.setFrequency (2.f);
+    lfo.setFrequency (1.f / (timeParam->get() / 1000.f));
+    warbleLFO.setFrequency (2.f);
 
     apf1.setFilterType (DigitalFilter::FilterType::APF);
     apf1.setQValue (1.f);
@@ -85,24 +81,20 @@ PhaserProcessor::PhaserProcessor (int idNum)
     apf3.setQValue (1.f);
 }
 
-PhaserProcessor::~PhaserProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-    xPadParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void PhaserProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     BandProcessor::prepareToPlay (Fs, bufferSize);
     const ScopedLock sl (getCallbackLock());
-    apf1.setFs (Fs);
-    apf2.setFs (Fs);
-    apf3.setFs (Fs);
-    phase.prepare (Fs, bufferSize);
-    phaseWarble.prepare (Fs, bufferSize);
+    const auto numChannels = getNumPreparedChannels();
+    apf1.setFs (Fs, numChannels);
+    apf2.setFs (Fs, numChannels);
+    apf3.setFs (Fs, numChannels);
+    lfo.prepare (Fs);
+    warbleLFO.prepare (Fs);
+    modulationBuffer.setSize (2, bufferSize);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+    warbleSmooth.resize ((size_t) numChannels, 1.f);
 }
 void PhaserProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
@@ -112,44 +104,42 @@ void PhaserProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiB
     float wet;
     bool bypass;
     float warble;
-    float periodOfCycle = timeParam->get() / 1000.f;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        phase.setFrequency (1.f / periodOfCycle);
-        bypass = ! fxOnParam->get();
-        warble = xPadParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    float periodOfCycle = parameters.get (timeParam) / 1000.f;
+    wet = parameters.get (wetDryParam);
+    lfo.setFrequency (1.f / periodOfCycle);
+    bypass = ! parameters.getBool (fxOnParam);
+    warble = parameters.get (xPadParam);
 
     if (bypass || isBypassed())
         return;
 
     fillMultibandBuffer (buffer);
 
-    float lfoSample;
-    float warbleSample;
-    //
-    
     // effectPhaseRelativeToProjectDownBeat needs to be set once per buffer
     // based on the transport in Track::process
-    
+    lfo.setAngle (effectPhaseRelativeToProjectDownBeat);
+
+    // Every channel gets modulated the same way, so the LFOs are rendered once for all of them:
+    modulationBuffer.setSize (2, numSamples, false, false, true);
+    auto* lfoSamples = modulationBuffer.getWritePointer (0);
+    auto* warbleSamples = modulationBuffer.getWritePointer (1);
+    lfo.render<LFOWaveforms::Sine> (lfoSamples, numSamples, 0.5, 0.5);
+    warbleLFO.render<LFOWaveforms::Sine> (warbleSamples, numSamples, 0.05);
+
     for (int c = 0; c < numChannels; ++c)
     {
-        phase.setCurrentAngle(effectPhaseRelativeToProjectDownBeat,c);
         for (int n = 0; n < numSamples; ++n)
         {
-            lfoSample = phase.getNextSample (c);
-            warbleSample = phaseWarble.getNextSample (c);
-
             float x = multibandBuffer.getWritePointer (c)[n];
 
             if (count < UPDATEFILTERS)
                 count++;// we want to avoid re-calulating filters every sample
             else
             {
-                float normLFO = 0.5f * sin (lfoSample) + 0.5f;
-                float warbleLFO = .05f * warbleSmooth[c] * sin (warbleSample);
-                float value = static_cast<float> (normLFO * 0.5 + 0.5 + warbleLFO);
+                float normLFO = lfoSamples[n];
+                float warbleOffset = warbleSmooth[c] * warbleSamples[n];
+                float value = normLFO * 0.5f + 0.5f + warbleOffset;
                 float freqHz = 4.f * std::powf (10.f, value + 2.f);// 400 - 4000
 
                 apf1.setFreq (freqHz);
@@ -179,14 +169,11 @@ Identifier PhaserProcessor::getIdentifier() const { return "Phaser" + String (id
 /** @internal */
 bool PhaserProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void PhaserProcessor::parameterValueChanged (int paramIndex, float value)
+void PhaserProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
     
-    BandProcessor::parameterValueChanged (paramIndex, value);
-
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
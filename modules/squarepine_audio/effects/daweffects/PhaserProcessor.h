@@ -36,7 +36,6 @@ class PhaserProcessor final : public BandProcessor
 public:
     //Constructor with ID
     PhaserProcessor (int idNum = 1);
-    ~PhaserProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -48,8 +47,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -59,8 +57,8 @@ private:
 
     int idNumber = 1;
 
-    PhaseIncrementer phase;
-    PhaseIncrementer phaseWarble;
+    BlockLFO lfo, warbleLFO;
+    juce::AudioBuffer<float> modulationBuffer;      // The LFOs' output for the current block, shared by every channel.
     DigitalFilter apf1;
     DigitalFilter apf2;
     DigitalFilter apf3;
@@ -68,8 +66,7 @@ private:
     int count = 0;
     static const int UPDATEFILTERS = 8;
 
-    float wetSmooth[2] = { 0.0 };
-    float warbleSmooth[2] = { 1.0 };
+    std::vector<float> wetSmooth, warbleSmooth;     // Per channel, sized in prepareToPlay().
 };
 
 }
@@ -39,13 +39,10 @@ PingPongProcessor::PingPongProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -58,13 +55,6 @@ PingPongProcessor::PingPongProcessor (int idNum)
     setEffectiveInTimeDomain (true);
 }
 
-PingPongProcessor::~PingPongProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void PingPongProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
@@ -90,11 +80,9 @@ void PingPongProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Mid
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -119,7 +107,8 @@ void PingPongProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Mid
         buffer.getWritePointer (1)[n] *= (drySmooth);
     }
 
-    for (int c = 0; c < numChannels; ++c)
+    // The ping pong bounces between the front left and right channels, leaving any others be.
+    for (int c = 0; c < jmin (2, numChannels); ++c)
         buffer.addFrom (c, 0, multibandBuffer.getWritePointer (c), numSamples);
 }
 
@@ -129,12 +118,11 @@ Identifier PingPongProcessor::getIdentifier() const { return "Ping Pong" + Strin
 /** @internal */
 bool PingPongProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void PingPongProcessor::parameterValueChanged (int paramIndex, float value)
+void PingPongProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
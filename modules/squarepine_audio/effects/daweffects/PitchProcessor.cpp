@@ -39,13 +39,10 @@ PitchProcessor::PitchProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     pitchParam = pitch.get();
-    pitchParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -57,22 +54,17 @@ PitchProcessor::PitchProcessor (int idNum)
     setPrimaryParameter (wetDryParam);
 }
 
-PitchProcessor::~PitchProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    pitchParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void PitchProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
+    const auto numChannels = getNumPreparedChannels();
     pitchShifter.setFs (static_cast<float> (Fs));
     pitchShifter.setPitch (12.f);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
 
-    effectBuffer = AudioBuffer<float> (2, bufferSize);
+    effectBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #if SQUAREPINE_USE_ELASTIQUE
 
@@ -80,7 +72,7 @@ void PitchProcessor::prepareToPlay (double Fs, int bufferSize)
                           ? CElastiqueProV3If::kV3Pro
                           : CElastiqueProV3If::kV3Eff;
 
-    elastique = zplane::createElastiquePtr (bufferSize, 2, Fs, mode);
+    elastique = zplane::createElastiquePtr (bufferSize, numChannels, Fs, mode);
 
     if (elastique == nullptr)
     {
@@ -93,7 +85,7 @@ void PitchProcessor::prepareToPlay (double Fs, int bufferSize)
     auto localRatio = (float) std::clamp (1.0, 0.01, 10.0);
     zplane::isValid (elastique->SetStretchPitchQFactor (localRatio, pitchFactor, useElastiquePro));
 
-    outputBuffer = AudioBuffer<float> (2, bufferSize);
+    outputBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #endif
 }
@@ -104,11 +96,9 @@ void PitchProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -117,7 +107,7 @@ void PitchProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
     //
     const auto numSamplesToRead = elastique->GetFramesNeeded (static_cast<int> (numSamples));
 
-    effectBuffer.setSize (2, numSamplesToRead, false, true, true);
+    effectBuffer.setSize (getNumPreparedChannels(), numSamplesToRead, false, true, true);
 
     for (int c = 0; c < numChannels; ++c)
     {
@@ -142,8 +132,6 @@ void PitchProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBu
     auto outChannels = outputBuffer.getArrayOfWritePointers();
     zplane::isValid (elastique->ProcessData ((float**) inChannels, numSamplesToRead, (float**) outChannels));
 
-    const ScopedLock sl (getCallbackLock());
-
     for (int c = 0; c < numChannels; ++c)
         buffer.addFrom (c, 0, outputBuffer.getWritePointer (c), numSamples);
 }
@@ -154,7 +142,7 @@ Identifier PitchProcessor::getIdentifier() const { return "Pitch" + String (idNu
 /** @internal */
 bool PitchProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void PitchProcessor::parameterValueChanged (int paramIndex, float value)
+void PitchProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
@@ -162,7 +150,6 @@ void PitchProcessor::parameterValueChanged (int paramIndex, float value)
     //Subtract the number of new parameters in this processor
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
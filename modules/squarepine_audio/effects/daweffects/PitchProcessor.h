@@ -12,7 +12,6 @@ class PitchProcessor final : public BandProcessor
 public:
     //Constructor with ID
     PitchProcessor (int idNum = 1);
-    ~PitchProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -24,8 +23,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* pitchParam = nullptr;
@@ -37,7 +35,7 @@ private:
     PitchShifter pitchShifter;
     AudioBuffer<float> effectBuffer;
 
-    float wetSmooth[2] = { 0.f };
+    std::vector<float> wetSmooth;     // Per channel, sized in prepareToPlay().
 
     bool useElastiquePro = false;
     zplane::ElastiquePtr elastique;
@@ -39,13 +39,10 @@ RevRollProcessor::RevRollProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -64,13 +61,6 @@ RevRollProcessor::RevRollProcessor (int idNum)
 
 }
 
-RevRollProcessor::~RevRollProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void RevRollProcessor::prepareToPlay (double Fs, int bufferSize)
 {
@@ -79,7 +69,7 @@ void RevRollProcessor::prepareToPlay (double Fs, int bufferSize)
     sampleRate = Fs;
     delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
 
-    int numChannels = 2;
+    const auto numChannels = getNumPreparedChannels();
     int segmentLenSec = 16;
     maxSegmentIndex = static_cast<int> (Fs) * segmentLenSec;
     segmentBuffer.setSize (numChannels, maxSegmentIndex);
@@ -96,12 +86,10 @@ void RevRollProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Midi
     bool bypass;
     float wet;
     float dry;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        dry = 1.f - wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    dry = 1.f - parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -126,24 +114,21 @@ Identifier RevRollProcessor::getIdentifier() const { return "Rev Roll" + String
 /** @internal */
 bool RevRollProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void RevRollProcessor::parameterValueChanged (int id, float value)
+void RevRollProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
-
-    const ScopedLock sl (getCallbackLock());
     switch (id)
     {
         case (1):
         {
-            bool effectIsOn = fxOnParam->get();
+            bool effectIsOn = getParameterSnapshot().getBool (fxOnParam);
             if (effectIsOn)
             {
                 fillSegmentFlag = true;// for this effect, only reset when change in on/off
-                delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+                delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
                 segmentFillIndex = 0;
                 segmentPlayIndex = delayTimeInSamples;
             }
@@ -157,7 +142,7 @@ void RevRollProcessor::parameterValueChanged (int id, float value)
         }
         case (3):
         {
-            delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+            delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
             break;// time
         }
     }
@@ -49,16 +49,12 @@ ReverbProcessor::ReverbProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     filterParam = filterAmount.get();
-    filterParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -74,30 +70,26 @@ ReverbProcessor::ReverbProcessor (int idNum)
     hpf.setFreq (200.f);
     lpf.setFilterType (DigitalFilter::FilterType::LPF);
     lpf.setFreq (10000.f);
+    lpf.registerWith (filterBank);
+    hpf.registerWith (filterBank);
     
     setEffectiveInTimeDomain (true);
 
 }
 
-ReverbProcessor::~ReverbProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    filterParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void ReverbProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     setRateAndBufferSizeDetails (Fs, bufferSize);
     BandProcessor::prepareToPlay (Fs, bufferSize);
-    reverb.reset();
-    reverb.setSampleRate (Fs);
-    hpf.setFs (Fs);
-    lpf.setFs (Fs);
+    const auto numChannels = getNumPreparedChannels();
+    reverb.prepare (Fs, numChannels);
+    hpf.setFs (Fs, numChannels);
+    lpf.setFs (Fs, numChannels);
+    filterBank.prepare (numChannels);
+    filterBank.reset();
 }
-void ReverbProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midi)
+void ReverbProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
@@ -105,12 +97,10 @@ void ReverbProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiB
     float wet;
     float dry;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        bypass = ! fxOnParam->get();
-        wet = wetDryParam->get();
-        dry = 1.f - wetDryParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
+    wet = parameters.get (wetDryParam);
+    dry = 1.f - parameters.get (wetDryParam);
 
     if (bypass || isBypassed())
         return;
@@ -120,24 +110,11 @@ void ReverbProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiB
     fillMultibandBuffer (buffer);
     auto chans = multibandBuffer.getArrayOfWritePointers();
 
-    const ScopedLock sl (getCallbackLock());
-
-    switch (numChannels)
-    {
-        case 1:
-            reverb.processMono (chans[0], numSamples);
-            break;
-
-        case 2:
-            reverb.processStereo (chans[0], chans[1], numSamples);
-            break;
+    reverb.process (chans, numChannels, numSamples);
 
-        default:
-            break;
-    }
-
-    lpf.processBuffer (multibandBuffer, midi);
-    hpf.processBuffer (multibandBuffer, midi);
+    lpf.updateBank (numSamples);
+    hpf.updateBank (numSamples);
+    filterBank.process (multibandBuffer, 0, numSamples);
 
     multibandBuffer.applyGain (wet);
     buffer.applyGain (dry);
@@ -152,7 +129,7 @@ Identifier ReverbProcessor::getIdentifier() const { return "Reverb" + String (id
 /** @internal */
 bool ReverbProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void ReverbProcessor::parameterValueChanged (int id, float value)
+void ReverbProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
@@ -178,7 +155,6 @@ void ReverbProcessor::parameterValueChanged (int id, float value)
         }
     }
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
 }
 void ReverbProcessor::releaseResources()
 {
@@ -190,16 +166,13 @@ void ReverbProcessor::updateReverbParams()
 {
     Reverb::Parameters localParams;
 
-    localParams.roomSize = timeParam->get();
+    localParams.roomSize = getParameterSnapshot().get (timeParam);
     localParams.damping = 1.f;
     localParams.wetLevel = 1.f;
     localParams.dryLevel = 0.f;
     localParams.width = 1;
     localParams.freezeMode = 0;
 
-    {
-        const ScopedLock sl (getCallbackLock());
-        reverb.setParameters (localParams);
-    }
+    reverb.setParameters (localParams);
 }
 }
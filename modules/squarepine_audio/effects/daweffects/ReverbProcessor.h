@@ -9,7 +9,6 @@ class ReverbProcessor final : public BandProcessor
 public:
     //Constructor with ID
     ReverbProcessor (int idNum = 1);
-    ~ReverbProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -23,8 +22,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* filterParam = nullptr;
@@ -32,12 +30,13 @@ private:
     NotifiableAudioParameterFloat* wetDryParam = nullptr;
     AudioParameterBool* fxOnParam = nullptr;
     //Using the Juce reverb
-    Reverb reverb;
+    MultichannelReverb reverb;
     void updateReverbParams();
 
     int idNumber = 1;
     DigitalFilter hpf;
     DigitalFilter lpf;
+    BiquadBank<float> filterBank;// Runs the lpf and hpf in a single pass
 };
 
 }
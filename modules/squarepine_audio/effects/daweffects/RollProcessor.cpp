@@ -39,13 +39,10 @@ RollProcessor::RollProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -64,13 +61,6 @@ RollProcessor::RollProcessor (int idNum)
 
 }
 
-RollProcessor::~RollProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void RollProcessor::prepareToPlay (double Fs, int bufferSize)
 {
@@ -79,7 +69,8 @@ void RollProcessor::prepareToPlay (double Fs, int bufferSize)
     sampleRate = Fs;
     delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
 
-    int numChannels = 2;
+    const auto numChannels = getNumPreparedChannels();
+    wetSmooth.resize ((size_t) numChannels, 0.f);
     int segmentLenSec = 16;
     maxSegmentIndex = static_cast<int> (Fs) * segmentLenSec;
     segmentBuffer.setSize (numChannels, maxSegmentIndex);
@@ -95,11 +86,9 @@ void RollProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuf
 
     bool bypass;
     float wet;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -130,24 +119,21 @@ Identifier RollProcessor::getIdentifier() const { return "Roll" + String (idNumb
 /** @internal */
 bool RollProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void RollProcessor::parameterValueChanged (int id, float value)
+void RollProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
-
-    const ScopedLock sl (getCallbackLock());
     switch (id)
     {
         case (1):
         {
-            bool effectIsOn = fxOnParam->get();
+            bool effectIsOn = getParameterSnapshot().getBool (fxOnParam);
             if (effectIsOn)
             {
                 fillSegmentFlag = true;// for this effect, only reset when change in on/off
-                delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+                delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
                 segmentFillIndex = 0;
                 segmentPlayIndex = 0;
             }
@@ -161,7 +147,7 @@ void RollProcessor::parameterValueChanged (int id, float value)
         }
         case (3):
         {
-            delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+            delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
             break;// time
         }
     }
@@ -6,7 +6,6 @@ class RollProcessor final : public BandProcessor
 public:
     //Constructor with ID
     RollProcessor (int idNum = 1);
-    ~RollProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -18,8 +17,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -41,7 +39,7 @@ private:
     AudioBuffer<float> tempBuffer;// used to multiband processing
     void fillTempBuffer();
 
-    float wetSmooth[2] = { 0.0 };
+    std::vector<float> wetSmooth;     // Per channel, sized in prepareToPlay().
 };
 
 }
@@ -232,16 +232,21 @@ public:
 
     float processSample (float x, int channel)
     {
+        // setFs() needs to be called with enough channels first!
+        jassert (isPositiveAndBelow (channel, (int) states.size()));
+
         performSmoothing();
 
+        auto& state = states[(size_t) channel];
+
         // Output, processed sample (Direct Form 1)
-        float y = b0 * x + b1 * x1[channel] + b2 * x2[channel]
-                  + (-a1) * y1[channel] + (-a2) * y2[channel];
+        float y = b0 * x + b1 * state.x1 + b2 * state.x2
+                  + (-a1) * state.y1 + (-a2) * state.y2;
 
-        x2[channel] = x1[channel];// store delay samples for next process step
-        x1[channel] = x;
-        y2[channel] = y1[channel];
-        y1[channel] = y;
+        state.x2 = state.x1;// store delay samples for next process step
+        state.x1 = x;
+        state.y2 = state.y1;
+        state.y1 = y;
 
         return y;
     }
@@ -252,9 +257,10 @@ public:
         freqTarget = jmin (freqTarget, (Fs / 2.f) * 0.95f);
         updateCoefficients();
     }
-    void setFs (double newFs)
+    void setFs (double newFs, int numChannels = 2)
     {
         Fs = static_cast<float> (newFs);
+        states.resize ((size_t) jmax (0, numChannels));
         updateCoefficients();// Need to update if Fs changes
     }
 
@@ -275,6 +281,39 @@ public:
     {
         ampdB = newAmpdB;
     }
+
+    /** @returns the current coefficients, in the form a BiquadBank takes them. */
+    BiquadBank<float>::Coefficients getCoefficients() const noexcept
+    {
+        return { b0, b1, b2, a1, a2 };
+    }
+
+    /** Adds this filter to the end of a bank, which then does the processing for every channel
+        in place of processSample(). Call updateBank() once per block to keep the bank up to date.
+    */
+    void registerWith (BiquadBank<float>& newBank)
+    {
+        bank = &newBank;
+        bankSection = newBank.addSection (getCoefficients());
+    }
+
+    /** Advances the frequency and Q smoothing by a whole block, as processSample() would have,
+        and has the bank sweep this filter's section to the resulting coefficients over that block.
+    */
+    void updateBank (int numSamples)
+    {
+        jassert (bank != nullptr);
+
+        if (bank == nullptr || numSamples <= 0)
+            return;
+
+        const auto decay = std::pow (smoothingAlpha, (float) numSamples);
+        freqSmooth = freqTarget + (freqSmooth - freqTarget) * decay;
+        qSmooth = qTarget + (qSmooth - qTarget) * decay;
+
+        updateCoefficients();
+        bank->setCoefficients (bankSection, getCoefficients(), numSamples);
+    }
 private:
     FilterType filterType = LPF;
 
@@ -288,11 +327,16 @@ private:
     float ampdB = 0.0f;// Amplitude on dB scale
 
     // Variables for Biquad Implementation
-    // 2 channels - L,R : Up to 2nd Order
-    float x1[2] = { 0.0f };// 1 sample of delay feedforward
-    float x2[2] = { 0.0f };// 2 samples of delay feedforward
-    float y1[2] = { 0.0f };// 1 sample of delay feedback
-    float y2[2] = { 0.0f };// 2 samples of delay feedback
+    // One per channel, sized by setFs() : Up to 2nd Order
+    struct State
+    {
+        float x1 = 0.0f;// 1 sample of delay feedforward
+        float x2 = 0.0f;// 2 samples of delay feedforward
+        float y1 = 0.0f;// 1 sample of delay feedback
+        float y2 = 0.0f;// 2 samples of delay feedback
+    };
+
+    std::vector<State> states = std::vector<State> (2);
 
     // Filter coefficients
     float b0 = 1.0f;// initialized to pass signal
@@ -302,13 +346,16 @@ private:
     float a1 = 0.0f;
     float a2 = 0.0f;
 
+    BiquadBank<float>* bank = nullptr;// Only set when registered with a bank
+    int bankSection = -1;
+
     int smoothingCount = 0;
     const int SAMPLESFORSMOOTHING = 256;
+    static constexpr float smoothingAlpha = 0.9999f;
     void performSmoothing()
     {
-        float alpha = 0.9999f;
-        freqSmooth = alpha * freqSmooth + (1.f - alpha) * freqTarget;
-        qSmooth = alpha * qSmooth + (1.f - alpha) * qTarget;
+        freqSmooth = smoothingAlpha * freqSmooth + (1.f - smoothingAlpha) * freqTarget;
+        qSmooth = smoothingAlpha * qSmooth + (1.f - smoothingAlpha) * qTarget;
 
         smoothingCount++;
         if (smoothingCount >= SAMPLESFORSMOOTHING)
@@ -791,6 +838,8 @@ public:
     Identifier getIdentifier() const override { return "SEM Filter" + String (idNumber); }
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override { return false; }
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
     /** */
     float frequencyFromNormRange (const float& value)
     {
@@ -1368,6 +1417,8 @@ public:
     Identifier getIdentifier() const override { return "Butter Sem" + String (idNumber); }
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override { return false; }
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
 
     void parameterValueChanged (int paramNum, float value) override
     {
@@ -1596,6 +1647,8 @@ public:
     Identifier getIdentifier() const override { return "Digital Sem" + String (idNumber); }
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override { return false; }
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
 
     void parameterValueChanged (int paramNum, float value) override
     {
@@ -1824,6 +1877,8 @@ public:
     Identifier getIdentifier() const override { return "Digital Sem Two" + String (idNumber); }
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override { return false; }
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
 
     void parameterValueChanged (int paramNum, float value) override
     {
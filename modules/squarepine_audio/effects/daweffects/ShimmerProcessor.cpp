@@ -62,19 +62,14 @@ ShimmerProcessor::ShimmerProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     reverbAmountParam = reverbAmount.get();
-    reverbAmountParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     xPadParam = other.get();
-    xPadParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -90,24 +85,20 @@ ShimmerProcessor::ShimmerProcessor (int idNum)
 
 }
 
-ShimmerProcessor::~ShimmerProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    reverbAmountParam->removeListener (this);
-    timeParam->removeListener (this);
-    xPadParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void ShimmerProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
+    const auto numChannels = getNumPreparedChannels();
     pitchShifter.setFs (static_cast<float> (Fs));
     pitchShifter.setPitch (12.f);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+
+    reverb.prepare (Fs, numChannels);
+    updateReverbParams();
 
-    effectBuffer = AudioBuffer<float> (2, bufferSize);
+    effectBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #if SQUAREPINE_USE_ELASTIQUE
 
@@ -115,7 +106,7 @@ void ShimmerProcessor::prepareToPlay (double Fs, int bufferSize)
                           ? CElastiqueProV3If::kV3Pro
                           : CElastiqueProV3If::kV3Eff;
 
-    elastique = zplane::createElastiquePtr (bufferSize, 2, Fs, mode);
+    elastique = zplane::createElastiquePtr (bufferSize, numChannels, Fs, mode);
 
     if (elastique == nullptr)
     {
@@ -131,7 +122,7 @@ void ShimmerProcessor::prepareToPlay (double Fs, int bufferSize)
     auto localRatio = (float) std::clamp (1.0, 0.01, 10.0);
     zplane::isValid (elastique->SetStretchPitchQFactor (localRatio, pitchFactor, useElastiquePro));
 
-    outputBuffer = AudioBuffer<float> (2, bufferSize);
+    outputBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #endif
 }
@@ -142,18 +133,16 @@ void ShimmerProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Midi
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
 
     const auto numSamplesToRead = elastique->GetFramesNeeded (static_cast<int> (numSamples));
 
-    effectBuffer.setSize (2, numSamplesToRead, false, true, true);
+    effectBuffer.setSize (getNumPreparedChannels(), numSamplesToRead, false, true, true);
 
     fillMultibandBuffer (buffer);
 
@@ -179,21 +168,7 @@ void ShimmerProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Midi
 
     auto chans = outputBuffer.getArrayOfWritePointers();
 
-    const ScopedLock sl (getCallbackLock());
-
-    switch (numChannels)
-    {
-        case 1:
-            reverb.processMono (chans[0], numSamples);
-            break;
-
-        case 2:
-            reverb.processStereo (chans[0], chans[1], numSamples);
-            break;
-
-        default:
-            break;
-    }
+    reverb.process (chans, numChannels, numSamples);
 
     outputBuffer.applyGain (wet);
     buffer.applyGain (1.f - wet);
@@ -208,25 +183,25 @@ Identifier ShimmerProcessor::getIdentifier() const { return "Shimmer" + String (
 /** @internal */
 bool ShimmerProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void ShimmerProcessor::parameterValueChanged (int id, float value)
+void ShimmerProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
-    BandProcessor::parameterValueChanged (id, value);
+    updateReverbParams();
+}
 
+void ShimmerProcessor::updateReverbParams()
+{
     Reverb::Parameters localParams;
 
-    localParams.roomSize = timeParam->get();
-    localParams.damping = 1.f - reverbAmountParam->get();
+    localParams.roomSize = getParameterSnapshot().get (timeParam);
+    localParams.damping = 1.f - getParameterSnapshot().get (reverbAmountParam);
     localParams.wetLevel = 1.f;
     localParams.dryLevel = 0.f;
     localParams.width = 1;
     localParams.freezeMode = 0;
 
-    {
-        const ScopedLock sl (getCallbackLock());
-        reverb.setParameters (localParams);
-    }
+    reverb.setParameters (localParams);
 }
 
 }
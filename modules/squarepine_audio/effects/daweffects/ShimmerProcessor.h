@@ -7,7 +7,6 @@ class ShimmerProcessor final : public BandProcessor
 public:
     //Constructor with ID
     ShimmerProcessor (int idNum = 1);
-    ~ShimmerProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -19,8 +18,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* reverbAmountParam = nullptr;
@@ -32,11 +30,12 @@ private:
     int idNumber = 1;
 
     //Using the Juce reverb
-    Reverb reverb;
+    MultichannelReverb reverb;
+    void updateReverbParams();
     PitchShifter pitchShifter;
     AudioBuffer<float> effectBuffer;
 
-    float wetSmooth[2] = { 0.f };
+    std::vector<float> wetSmooth;     // Per channel, sized in prepareToPlay().
 
     bool useElastiquePro = false;
     zplane::ElastiquePtr elastique;
@@ -49,16 +49,12 @@ ShortDelayProcessor::ShortDelayProcessor (int idNum)
                                                                      });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     feedbackParam = feedback.get();
-    feedbackParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -77,18 +73,13 @@ ShortDelayProcessor::ShortDelayProcessor (int idNum)
 
 }
 
-ShortDelayProcessor::~ShortDelayProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    feedbackParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
-void ShortDelayProcessor::prepareToPlay (double sampleRate, int)
+void ShortDelayProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (sampleRate, bufferSize);
+
     Fs = static_cast<float> (sampleRate);
+    delayUnit.setMaximumDelaySeconds (0.25f);
     delayUnit.setFs (Fs);
     wetDry.reset (Fs, 0.5f);
     delayTime.reset (Fs, 0.5f);
@@ -96,20 +87,20 @@ void ShortDelayProcessor::prepareToPlay (double sampleRate, int)
 }
 void ShortDelayProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
+    updateParameterSnapshot();
+
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
     bool bypass;
     float feedback;
-    {
-        const ScopedLock sl (getCallbackLock());
-        bypass = ! fxOnParam->get();
-        feedback = feedbackParam->get() * 0.75f;// max feedback gain is 0.75
-        float timeMS = timeParam->get();
-        float samplesOfDelay = timeMS / 1000.f * Fs;
-        delayTime.setTargetValue (samplesOfDelay);
-        delayUnit.setDelaySamples (delayTime.getNextValue());
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
+    feedback = parameters.get (feedbackParam) * 0.75f;// max feedback gain is 0.75
+    float timeMS = parameters.get (timeParam);
+    float samplesOfDelay = timeMS / 1000.f * Fs;
+    delayTime.setTargetValue (samplesOfDelay);
+    delayUnit.setDelaySamples (delayTime.getNextValue());
 
     if (bypass || isBypassed())
         return;
@@ -137,9 +128,8 @@ Identifier ShortDelayProcessor::getIdentifier() const { return "Short Delay" + S
 /** @internal */
 bool ShortDelayProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void ShortDelayProcessor::parameterValueChanged (int paramIndex, float value)
+void ShortDelayProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
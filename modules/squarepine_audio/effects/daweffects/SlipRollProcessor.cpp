@@ -39,13 +39,10 @@ SlipRollProcessor::SlipRollProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -66,13 +63,6 @@ SlipRollProcessor::SlipRollProcessor (int idNum)
 
 }
 
-SlipRollProcessor::~SlipRollProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void SlipRollProcessor::prepareToPlay (double Fs, int bufferSize)
 {
@@ -81,7 +71,8 @@ void SlipRollProcessor::prepareToPlay (double Fs, int bufferSize)
     sampleRate = Fs;
     delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
 
-    int numChannels = 2;
+    const auto numChannels = getNumPreparedChannels();
+    wetSmooth.resize ((size_t) numChannels, 0.f);
     int segmentLenSec = 16;
     maxSegmentIndex = static_cast<int> (Fs) * segmentLenSec;
     segmentBuffer.setSize (numChannels, maxSegmentIndex);
@@ -97,11 +88,9 @@ void SlipRollProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, Mid
 
     bool bypass;
     float wet;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -131,24 +120,21 @@ Identifier SlipRollProcessor::getIdentifier() const { return "Slip Roll" + Strin
 /** @internal */
 bool SlipRollProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void SlipRollProcessor::parameterValueChanged (int id, float value)
+void SlipRollProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
-
-    const ScopedLock sl (getCallbackLock());
     switch (id)
     {
         case (1):
         {
-            bool effectIsOn = fxOnParam->get();
+            bool effectIsOn = getParameterSnapshot().getBool (fxOnParam);
             if (effectIsOn)
             {
                 fillSegmentFlag = true;
-                delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+                delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
                 segmentIndex = 0;
             }
             break;
@@ -161,7 +147,7 @@ void SlipRollProcessor::parameterValueChanged (int id, float value)
         }
         case (3):
         {
-            delayTimeInSamples = static_cast<int> (round (sampleRate * timeParam->get() / 1000.0));
+            delayTimeInSamples = static_cast<int> (round (sampleRate * getParameterSnapshot().get (timeParam) / 1000.0));
             segmentIndex = 0;
             fillSegmentFlag = true;
             break;// time
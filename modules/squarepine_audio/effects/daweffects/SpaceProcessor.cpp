@@ -51,16 +51,12 @@ SpaceProcessor::SpaceProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     reverbColourParam = reverbColour.get();
-    reverbColourParam->addListener (this);
 
     otherParam = other.get();
-    otherParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -76,17 +72,11 @@ SpaceProcessor::SpaceProcessor (int idNum)
 
 }
 
-SpaceProcessor::~SpaceProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    reverbColourParam->removeListener (this);
-    otherParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
-void SpaceProcessor::prepareToPlay (double sampleRate, int)
+void SpaceProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
+    InternalProcessor::prepareToPlay (sampleRate, bufferSize);
+
     reverb.reset();
     reverb.setSampleRate (sampleRate);
     filter.setFs (sampleRate);
@@ -96,14 +86,14 @@ void SpaceProcessor::prepareToPlay (double sampleRate, int)
 
 void SpaceProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer& midiBuffer)
 {
+    updateParameterSnapshot();
+
     const auto numChannels = buffer.getNumChannels();
     const auto numSamples = buffer.getNumSamples();
 
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -114,8 +104,6 @@ void SpaceProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&
 
     auto chans = buffer.getArrayOfWritePointers();
 
-    const ScopedLock sl (getCallbackLock());
-
     switch (numChannels)
     {
         case 1:
@@ -137,7 +125,7 @@ Identifier SpaceProcessor::getIdentifier() const { return "Space" + String (idNu
 /** @internal */
 bool SpaceProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void SpaceProcessor::parameterValueChanged (int id, float value)
+void SpaceProcessor::parameterSnapshotChanged (int id, float value)
 {
     if (id == 1)
     {
@@ -166,13 +154,14 @@ void SpaceProcessor::releaseResources()
 
 void SpaceProcessor::updateReverbParams()
 {
+    const auto& parameters = getParameterSnapshot();
     Reverb::Parameters localParams;
 
-    localParams.roomSize = otherParam->get();
+    localParams.roomSize = parameters.get (otherParam);
     localParams.damping = 0.2f;//1.f - reverbColourParam->get();
-    localParams.wetLevel = wetDryParam->get();
-    localParams.dryLevel = 1.f - wetDryParam->get();
-    if (abs(reverbColourParam->get()) < 0.01f)
+    localParams.wetLevel = parameters.get (wetDryParam);
+    localParams.dryLevel = 1.f - parameters.get (wetDryParam);
+    if (abs(parameters.get (reverbColourParam)) < 0.01f)
     {
         localParams.wetLevel = 0.f;
         localParams.dryLevel = 1.f;
@@ -182,10 +171,7 @@ void SpaceProcessor::updateReverbParams()
     localParams.width = 1;
     localParams.freezeMode = 0;
 
-    {
-        const ScopedLock sl (getCallbackLock());
-        reverb.setParameters (localParams);
-    }
+    reverb.setParameters (localParams);
 }
 
 }
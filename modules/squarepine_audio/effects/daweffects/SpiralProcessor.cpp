@@ -40,13 +40,10 @@ SpiralProcessor::SpiralProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -73,22 +70,20 @@ SpiralProcessor::SpiralProcessor (int idNum)
 
 }
 
-SpiralProcessor::~SpiralProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void SpiralProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
-    delayUnit.setFs ((float) Fs);
+    const auto numChannels = getNumPreparedChannels();
+    delayUnit.setFs ((float) Fs, numChannels);
+    apf.setMaximumDelaySeconds (1.f); // A quarter of the longest delay time.
+    apf.setFs ((float) Fs, numChannels);
     sampleRate = Fs;
-    hsf.setFs(Fs);
-    lsf.setFs(Fs);
+    hsf.setFs (Fs, numChannels);
+    lsf.setFs (Fs, numChannels);
+    z.resize ((size_t) numChannels, 0.f);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
     
     apf.setFeedbackAmount(0.3f);
 }
@@ -99,15 +94,13 @@ void SpiralProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiB
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        float delayMS = timeParam->get();
-        float samplesOfDelay = delayMS / 1000.f * static_cast<float> (sampleRate);
-        delayUnit.setDelaySamples (samplesOfDelay);
-        apf.setDelaySamples(samplesOfDelay/4.f);
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    float delayMS = parameters.get (timeParam);
+    float samplesOfDelay = delayMS / 1000.f * static_cast<float> (sampleRate);
+    delayUnit.setDelaySamples (samplesOfDelay);
+    apf.setDelaySamples(samplesOfDelay/4.f);
 
     if (bypass || isBypassed())
         return;
@@ -144,13 +137,12 @@ Identifier SpiralProcessor::getIdentifier() const { return "Spiral" + String (id
 /** @internal */
 bool SpiralProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void SpiralProcessor::parameterValueChanged (int id, float value)
+void SpiralProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
 }
 
 }
@@ -15,7 +15,6 @@ class SpiralProcessor final : public BandProcessor
 public:
     //Constructor with ID
     SpiralProcessor (int idNum = 1);
-    ~SpiralProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -27,8 +26,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -44,9 +42,7 @@ private:
 
     FractionalDelay delayUnit;
     double sampleRate = 44100.0;
-    float z[2] = { 0.f };
-
-    float wetSmooth[2] = { 0.0 };
+    std::vector<float> z, wetSmooth;  // Per channel, sized in prepareToPlay().
 };
 
 }
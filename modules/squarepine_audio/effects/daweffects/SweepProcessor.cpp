@@ -62,16 +62,12 @@ SweepProcessor::SweepProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     colourParam = colour.get();
-    colourParam->addListener (this);
 
     otherParam = other.get();
-    otherParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -89,36 +85,39 @@ SweepProcessor::SweepProcessor (int idNum)
     lpf.setFilterType (DigitalFilter::FilterType::LPF);
     lpf.setFreq (INITLPF);
     lpf.setQValue (DEFAULTQ);
-}
 
-SweepProcessor::~SweepProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    colourParam->removeListener (this);
-    otherParam->removeListener (this);
+    lpf.registerWith (filterBank);
+    hpf.registerWith (filterBank);
 }
 
 //============================================================================== Audio processing
-void SweepProcessor::prepareToPlay (double Fs, int)
+void SweepProcessor::prepareToPlay (double Fs, int bufferSize)
 {
-    lpf.setFs (Fs);
-    hpf.setFs (Fs);
+    InternalProcessor::prepareToPlay (Fs, bufferSize);
+
+    const auto numChannels = jmax (2, getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    const ScopedLock sl (getCallbackLock());
+    lpf.setFs (Fs, numChannels);
+    hpf.setFs (Fs, numChannels);
+    filterBank.prepare (numChannels);
+    filterBank.reset();
+    wetBuffer.setSize (numChannels, bufferSize, false, true, true);
 }
 void SweepProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
+    updateParameterSnapshot();
+
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
     float wet;
     bool bypass;
     float colour;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-        colour = colourParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
+    colour = parameters.get (colourParam);
 
     if (bypass || isBypassed())
         return;
@@ -127,21 +126,30 @@ void SweepProcessor::processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&
         wet = 0.f;
     
     if (colour > 0)
+
+    // Both filters get run over every channel in one pass, and the result is mixed in afterwards
+    wetBuffer.setSize (wetBuffer.getNumChannels(), numSamples, false, false, true);
+
+    for (int c = 0; c < jmin (numChannels, wetBuffer.getNumChannels()); ++c)
+        wetBuffer.copyFrom (c, 0, buffer, c, 0, numSamples);
+
+    lpf.updateBank (numSamples);
+    hpf.updateBank (numSamples);
+    filterBank.process (wetBuffer, 0, numSamples);
+
+    for (int c = 0; c < jmin (numChannels, wetBuffer.getNumChannels()); ++c)
     {
-        for (int c = 0; c < numChannels; ++c)
+        const auto* wetSamples = wetBuffer.getReadPointer (c);
+
+        for (int n = 0; n < numSamples; ++n)
         {
-            for (int n = 0; n < numSamples; ++n)
-            {
-                float x = buffer.getWritePointer (c)[n];
+            float x = buffer.getWritePointer (c)[n];
+            float wetSample = wetSamples[n];
 
-                float wetSample = lpf.processSample (x, c);
-                wetSample = hpf.processSample (wetSample, c);
+            float y = (1.f - wetSmooth[c]) * x + wetSmooth[c] * wetSample;
+            wetSmooth[c] = 0.999f * wetSmooth[c] + 0.001f * wet;
 
-                float y = (1.f - wetSmooth[c]) * x + wetSmooth[c] * wetSample;
-                wetSmooth[c] = 0.999f * wetSmooth[c] + 0.001f * wet;
-
-                buffer.getWritePointer (c)[n] = y;
-            }
+            buffer.getWritePointer (c)[n] = y;
         }
     }
     else
@@ -178,9 +186,8 @@ Identifier SweepProcessor::getIdentifier() const { return "Sweep" + String (idNu
 /** @internal */
 bool SweepProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void SweepProcessor::parameterValueChanged (int paramIndex, float value)
+void SweepProcessor::parameterSnapshotChanged (int paramIndex, float value)
 {
-    const ScopedLock sl (getCallbackLock());
     switch (paramIndex)
     {
         case (1):
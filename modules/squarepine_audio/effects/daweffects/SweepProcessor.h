@@ -12,13 +12,11 @@ namespace djdawprocessor
 /// The color control for the filter is the bandwidth of the filter. It causes the cut-off frequency on either side of
 /// the BPF to narrow from 20 or 20k to the center frequency (set by the extra parameter).
 
-class SweepProcessor final : public InternalProcessor,
-                             public AudioProcessorParameter::Listener
+class SweepProcessor final : public InternalProcessor
 {
 public:
     //Constructor with ID
     SweepProcessor (int idNum = 1);
-    ~SweepProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -29,9 +27,10 @@ public:
     Identifier getIdentifier() const override;
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
+    /** @internal */
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override { return isAtMostStereo (layouts); }
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
@@ -43,6 +42,8 @@ private:
 
     DigitalFilter lpf;
     DigitalFilter hpf;
+    BiquadBank<float> filterBank;// Runs the lpf and hpf in a single pass
+    juce::AudioBuffer<float> wetBuffer;
 
     const float DEFAULTQ = 0.7071f;
     const float RESQ = 4.f;
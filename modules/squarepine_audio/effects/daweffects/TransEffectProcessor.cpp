@@ -40,13 +40,10 @@ TransEffectProcessor::TransEffectProcessor (int idNum)
                                                                  });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -61,20 +58,17 @@ TransEffectProcessor::TransEffectProcessor (int idNum)
     phase.setFrequency (1.f / (timeParam->get() / 1000.f));
 }
 
-TransEffectProcessor::~TransEffectProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void TransEffectProcessor::prepareToPlay (double Fs, int bufferSize)
 {
     BandProcessor::prepareToPlay (Fs, bufferSize);
 
     const ScopedLock sl (getCallbackLock());
-    phase.prepare (Fs, bufferSize);
+    const auto numChannels = getNumPreparedChannels();
+    phase.prepare (Fs, bufferSize, numChannels);
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+    ampSmooth.resize ((size_t) numChannels, 1.f);
+    depthSmooth.resize ((size_t) numChannels, 1.f);
 }
 void TransEffectProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&)
 {
@@ -83,13 +77,11 @@ void TransEffectProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer,
 
     float wet;
     bool bypass;
-    float periodOfCycle = timeParam->get() / 1000.f;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        phase.setFrequency (1.f / periodOfCycle);
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    float periodOfCycle = parameters.get (timeParam) / 1000.f;
+    wet = parameters.get (wetDryParam);
+    phase.setFrequency (1.f / periodOfCycle);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -132,13 +124,12 @@ Identifier TransEffectProcessor::getIdentifier() const { return "Trans" + String
 /** @internal */
 bool TransEffectProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void TransEffectProcessor::parameterValueChanged (int id, float value)
+void TransEffectProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
 }
 
 }
@@ -18,7 +18,6 @@ class TransEffectProcessor final : public BandProcessor
 public:
     //Constructor with ID
     TransEffectProcessor (int idNum = 1);
-    ~TransEffectProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -30,8 +29,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -42,9 +40,7 @@ private:
 
     PhaseIncrementer phase;
 
-    float wetSmooth[2] = { 0.0 };
-    float ampSmooth[2] = { 1.0 };
-    float depthSmooth[2] = { 1.0 };
+    std::vector<float> wetSmooth, ampSmooth, depthSmooth;  // Per channel, sized in prepareToPlay().
 };
 
 }
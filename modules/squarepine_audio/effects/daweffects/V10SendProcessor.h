@@ -3,8 +3,7 @@ namespace djdawprocessor
 
 ///This is a wrapper class specifically for the effect sends on the V10
 ///This class should do no processing but the extra dry wet parameter should be shown when created in performance with a V10
-class V10SendProcessor : public InternalProcessor,
-                         public AudioProcessorParameter::Listener
+class V10SendProcessor : public InternalProcessor
 {
 public:
     V10SendProcessor() {}
@@ -58,16 +58,12 @@ VinylBreakProcessor::VinylBreakProcessor (int idNum)
                                                                   });
 
     wetDryParam = wetdry.get();
-    wetDryParam->addListener (this);
 
     fxOnParam = fxon.get();
-    fxOnParam->addListener (this);
 
     timeParam = time.get();
-    timeParam->addListener (this);
 
     speedParam = speed.get();
-    speedParam->addListener (this);
 
     auto layout = createDefaultParameterLayout (false);
     layout.add (std::move (fxon));
@@ -81,14 +77,6 @@ VinylBreakProcessor::VinylBreakProcessor (int idNum)
     setEffectiveInTimeDomain (true);
 }
 
-VinylBreakProcessor::~VinylBreakProcessor()
-{
-    wetDryParam->removeListener (this);
-    fxOnParam->removeListener (this);
-    timeParam->removeListener (this);
-    speedParam->removeListener (this);
-}
-
 //============================================================================== Audio processing
 void VinylBreakProcessor::prepareToPlay (double sampleRate, int bufferSize)
 {
@@ -102,7 +90,10 @@ void VinylBreakProcessor::prepareToPlay (double sampleRate, int bufferSize)
 
     BandProcessor::prepareToPlay (sampleRate, bufferSize);
 
-    effectBuffer = AudioBuffer<float> (2, bufferSize);
+    const auto numChannels = getNumPreparedChannels();
+    wetSmooth.resize ((size_t) numChannels, 0.f);
+
+    effectBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #if SQUAREPINE_USE_ELASTIQUE
 
@@ -110,7 +101,7 @@ void VinylBreakProcessor::prepareToPlay (double sampleRate, int bufferSize)
                           ? CElastiqueProV3If::kV3Pro
                           : CElastiqueProV3If::kV3Eff;
 
-    elastique = zplane::createElastiquePtr (bufferSize, 2, sampleRate, mode);
+    elastique = zplane::createElastiquePtr (bufferSize, numChannels, sampleRate, mode);
 
     if (elastique == nullptr)
     {
@@ -123,7 +114,7 @@ void VinylBreakProcessor::prepareToPlay (double sampleRate, int bufferSize)
     auto localRatio = (float) std::clamp (1.0, 0.01, 10.0);
     zplane::isValid (elastique->SetStretchPitchQFactor (localRatio, pitchFactor, useElastiquePro));
 
-    outputBuffer = AudioBuffer<float> (2, bufferSize);
+    outputBuffer = AudioBuffer<float> (numChannels, bufferSize);
 
 #endif
 }
@@ -134,11 +125,9 @@ void VinylBreakProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, M
 
     float wet;
     bool bypass;
-    {
-        const ScopedLock sl (getCallbackLock());
-        wet = wetDryParam->get();
-        bypass = ! fxOnParam->get();
-    }
+    const auto& parameters = getParameterSnapshot();
+    wet = parameters.get (wetDryParam);
+    bypass = ! parameters.getBool (fxOnParam);
 
     if (bypass || isBypassed())
         return;
@@ -153,7 +142,7 @@ void VinylBreakProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, M
 
     const auto numSamplesToRead = elastique->GetFramesNeeded (static_cast<int> (numSamples));
 
-    effectBuffer.setSize (2, numSamplesToRead, false, true, true);
+    effectBuffer.setSize (getNumPreparedChannels(), numSamplesToRead, false, true, true);
 
     for (int c = 0; c < numChannels; ++c)
     {
@@ -178,8 +167,6 @@ void VinylBreakProcessor::processAudioBlock (juce::AudioBuffer<float>& buffer, M
     auto outChannels = outputBuffer.getArrayOfWritePointers();
     zplane::isValid (elastique->ProcessData ((float**) inChannels, numSamplesToRead, (float**) outChannels));
 
-    const ScopedLock sl (getCallbackLock());
-
     for (int c = 0; c < numChannels; ++c)
         buffer.addFrom (c, 0, outputBuffer.getWritePointer (c), numSamples);
 }
@@ -190,15 +177,12 @@ Identifier VinylBreakProcessor::getIdentifier() const { return "Vinyl Break" + S
 /** @internal */
 bool VinylBreakProcessor::supportsDoublePrecisionProcessing() const { return false; }
 //============================================================================== Parameter callbacks
-void VinylBreakProcessor::parameterValueChanged (int id, float value)
+void VinylBreakProcessor::parameterSnapshotChanged (int id, float value)
 {
     //If the beat division is changed, the delay time should be set.
     //If the X Pad is used, the beat div and subsequently, time, should be updated.
 
     //Subtract the number of new parameters in this processor
-    BandProcessor::parameterValueChanged (id, value);
-
-    const ScopedLock sl (getCallbackLock());
     switch (id)
     {
         case (1):
@@ -212,8 +196,8 @@ void VinylBreakProcessor::parameterValueChanged (int id, float value)
             else
             {
                 pitchFactorTarget = 0.f;
-                float time = timeParam->get() / 1000.f;
-                float speed = jmax (speedParam->get(), 0.3f);
+                float time = getParameterSnapshot().get (timeParam) / 1000.f;
+                float speed = jmax (getParameterSnapshot().get (speedParam), 0.3f);
                 alpha = std::exp (-std::log (9.f) / (Fs * time * speed));
             }
             break;
@@ -225,7 +209,7 @@ void VinylBreakProcessor::parameterValueChanged (int id, float value)
         case (3):
         {
             float time = value / 1000.f;
-            float speed = jmax (speedParam->get(), 0.3f);
+            float speed = jmax (getParameterSnapshot().get (speedParam), 0.3f);
             alpha = std::exp (-std::log (9.f) / (Fs * time * speed));
 
             break;
@@ -241,7 +225,7 @@ void VinylBreakProcessor::parameterValueChanged (int id, float value)
             else
             {
                 pitchFactorTarget = 0.f;
-                float time = timeParam->get() / 1000.f;
+                float time = getParameterSnapshot().get (timeParam) / 1000.f;
                 value = jmax (value, 0.3f);
                 alpha = std::exp (-std::log (9.f) / (Fs * time * value));
             }
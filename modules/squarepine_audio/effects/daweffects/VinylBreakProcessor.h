@@ -14,7 +14,6 @@ class VinylBreakProcessor final : public BandProcessor
 public:
     //Constructor with ID
     VinylBreakProcessor (int idNum = 1);
-    ~VinylBreakProcessor() override;
 
     //============================================================================== Audio processing
     void prepareToPlay (double Fs, int bufferSize) override;
@@ -26,8 +25,7 @@ public:
     /** @internal */
     bool supportsDoublePrecisionProcessing() const override;
     //============================================================================== Parameter callbacks
-    void parameterValueChanged (int paramNum, float value) override;
-    void parameterGestureChanged (int, bool) override {}
+    void parameterSnapshotChanged (int paramNum, float value) override;
 private:
     AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     NotifiableAudioParameterFloat* timeParam = nullptr;
@@ -41,7 +39,7 @@ private:
 
     AudioBuffer<float> effectBuffer;
 
-    float wetSmooth[2] = { 0.f };
+    std::vector<float> wetSmooth;     // Per channel, sized in prepareToPlay().
 
     bool useElastiquePro = false;
     zplane::ElastiquePtr elastique;
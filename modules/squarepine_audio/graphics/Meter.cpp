@@ -53,6 +53,18 @@ Meter::~Meter()
 {
 }
 
+void Meter::setSource (const MeterBus* bus, MeterBus::Level level) noexcept
+{
+    source = bus;
+    sourceLevel = level;
+}
+
+void Meter::getChannelLevels (Array<float>& destData)
+{
+    if (source != nullptr)
+        source->read (destData, sourceLevel);
+}
+
 bool Meter::refreshLevels()
 {
     levels.clearQuick();
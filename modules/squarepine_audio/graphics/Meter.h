@@ -196,12 +196,26 @@ public:
     void resetClippingLevel() { clippingLevel = ClippingLevel::none; }
 
     //==============================================================================
-    /** */
-    virtual void getChannelLevels (Array<float>& destData) = 0;
+    /** Makes the meter read its levels straight from a MeterBus, without locking.
+
+        The bus must outlive the meter, or be detached by passing nullptr.
+
+        @param bus      The bus to read from, or nullptr to stop reading from it.
+        @param level    The reading of each channel to display.
+    */
+    void setSource (const MeterBus* bus, MeterBus::Level level = MeterBus::Level::peak) noexcept;
+
+    /** Fills the array with the latest level of every channel.
+
+        By default, this reads from the MeterBus set with setSource(), if any.
+    */
+    virtual void getChannelLevels (Array<float>& destData);
 
 protected:
     //==============================================================================
     bool needMaxLevel = false;
+    const MeterBus* source = nullptr;
+    MeterBus::Level sourceLevel = MeterBus::Level::peak;
     Image gradientImage;
     Array<ChannelContext> channels;
     Array<float> levels;
@@ -35,14 +35,23 @@ String getInternalProcessorTypeName()
 #include "core/ChildProcessPluginScanner.cpp"
 #include "core/EffectProcessor.cpp"
 #include "core/EffectProcessorChain.cpp"
+#include "core/EffectProcessorChainState.cpp"
 #include "core/EffectProcessorFactory.cpp"
+#include "core/FakePluginFormat.cpp"
 #include "core/InternalAudioPluginFormat.cpp"
 #include "core/InternalProcessor.cpp"
+#include "core/MeterBus.cpp"
+#include "core/ParallelRenderScheduler.cpp"
+#include "core/ParameterSnapshot.cpp"
+#include "core/PluginScanCache.cpp"
+#include "core/PluginScanService.cpp"
 #include "devices/DummyAudioIODevice.cpp"
 #include "devices/DummyAudioIODeviceCallback.cpp"
 #include "devices/DummyAudioIODeviceType.cpp"
 #include "devices/MediaDevicePoller.cpp"
+#include "dsp/BlockLFO.cpp"
 #include "dsp/LFO.cpp"
+#include "dsp/LoudnessMeter.cpp"
 #include "dsp/PitchDelay.cpp"
 #include "dsp/PitchShifter.cpp"
 #include "effects/ADSRProcessor.cpp"
@@ -108,4 +117,19 @@ String getInternalProcessorTypeName()
 #include "effects/daweffects/VariableBPMProcessor.cpp"
 #include "effects/daweffects/EQProcessor.cpp"
 #include "effects/daweffects/LimiterProcessor.cpp"
+
+#include "unittests/BiquadBankUnitTests.cpp"
+#include "unittests/BlockLFOUnitTests.cpp"
+#include "unittests/LoudnessMeterUnitTests.cpp"
+#include "unittests/MeterBusUnitTests.cpp"
+#include "unittests/EffectProcessorChainUnitTests.cpp"
+#include "unittests/InternalAudioPluginFormatUnitTests.cpp"
+#include "unittests/ParallelRenderSchedulerUnitTests.cpp"
+#include "unittests/ParameterSnapshotUnitTests.cpp"
+#include "unittests/PluginScanCacheUnitTests.cpp"
+#include "unittests/PluginScanServiceUnitTests.cpp"
+#include "unittests/PolyphaseOversamplerUnitTests.cpp"
+#include "unittests/TruePeakDetectorUnitTests.cpp"
+#include "unittests/DummyAudioIODeviceUnitTests.cpp"
+#include "unittests/SquarePineAudioUnitTestGatherer.cpp"
 }
@@ -103,30 +103,43 @@ String getInternalProcessorTypeName();
 #include "core/AudioBufferView.h"
 #include "core/AudioBufferFIFO.h"
 #include "core/AudioUtilities.h"
+#include "core/PluginScanService.h"
+#include "core/PluginScanCache.h"
 #include "core/ChildProcessPluginScanner.h"
+#include "core/FakePluginFormat.h"
 #include "core/InternalAudioPluginFormat.h"
+#include "core/ParameterSnapshot.h"
 #include "core/InternalProcessor.h"
+#include "core/LatencyCompensationDelay.h"
+#include "core/SequenceLock.h"
+#include "core/MeterBus.h"
 #include "core/EffectProcessor.h"
 #include "core/EffectProcessorFactory.h"
+#include "core/EffectProcessorChainState.h"
 #include "core/EffectProcessorChain.h"
 #include "core/LastKnownPluginDetails.h"
 #include "core/MetadataUtilities.h"
 #include "core/MIDIChannel.h"
+#include "core/ParallelRenderScheduler.h"
 #include "codecs/REXAudioFormat.h"
 #include "devices/DummyAudioIODevice.h"
 #include "devices/DummyAudioIODeviceCallback.h"
 #include "devices/DummyAudioIODeviceType.h"
 #include "devices/MediaDevicePoller.h"
 #include "dsp/BasicDither.h"
+#include "dsp/BiquadBank.h"
 #include "dsp/DistortionFunctions.h"
 #include "dsp/EnvelopeFollower.h"
+#include "dsp/InterpolatedDelayLine.h"
+#include "dsp/MultibandCrossover.h"
 #include "dsp/LFO.h"
-#include "dsp/AntiAliasFilter.h"
-#include "dsp/DownSampling2Stage.h"
-#include "dsp/UpSampling2Stage.h"
+#include "dsp/BlockLFO.h"
 #include "dsp/PositionedImpulseResponse.h"
 #include "dsp/PitchDelay.h"
+#include "dsp/PolyphaseOversampler.h"
 #include "dsp/PitchShifter.h"
+#include "dsp/TruePeakDetector.h"
+#include "dsp/LoudnessMeter.h"
 #include "effects/PhaseIncrementer.h"
 #include "effects/ADSRProcessor.h"
 #include "effects/BitCrusherProcessor.h"
@@ -161,6 +174,7 @@ String getInternalProcessorTypeName();
 #include "time/TimeSignature.h"
 #include "time/MBTTime.h"
 #include "time/TimeKeeper.h"
+#include "unittests/SquarePineAudioUnitTestGatherer.h"
 #include "wrappers/AudioSourceProcessor.h"
 #include "wrappers/AudioTransportProcessor.h"
 //==============================================================================
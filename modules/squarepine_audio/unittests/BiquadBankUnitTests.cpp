@@ -0,0 +1,173 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class BiquadBankUnitTests final : public UnitTest
+{
+public:
+    BiquadBankUnitTests() :
+        UnitTest ("BiquadBank", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runCascadeTests<float>();
+        runCascadeTests<double>();
+        runSweepTests<float>();
+        runSweepTests<double>();
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        numChannels = 5,    // Not a multiple of any SIMD width, so the last group is partly empty.
+        numSamples = 512
+    };
+
+    template<typename FloatType>
+    using Coefficients = typename BiquadBank<FloatType>::Coefficients;
+
+    /** A plain, one channel at a time, transposed direct form II biquad to compare the bank against. */
+    template<typename FloatType>
+    struct ReferenceBiquad final
+    {
+        Coefficients<FloatType> c;
+        FloatType s1 = {}, s2 = {};
+
+        FloatType process (FloatType x) noexcept
+        {
+            const auto y = c.b0 * x + s1;
+            s1 = c.b1 * x - c.a1 * y + s2;
+            s2 = c.b2 * x - c.a2 * y;
+            return y;
+        }
+    };
+
+    template<typename FloatType>
+    static Coefficients<FloatType> makeCoefficients (const std::array<FloatType, 6>& c)
+    {
+        return Coefficients<FloatType>::fromUnnormalised (c);
+    }
+
+    //==============================================================================
+    template<typename FloatType>
+    void runCascadeTests()
+    {
+        using ArrayCoeffs = dsp::IIR::ArrayCoefficients<FloatType>;
+        const auto typeName = String (std::is_same_v<FloatType, float> ? "float" : "double");
+
+        beginTest ("Cascade - " + typeName);
+
+        const std::vector<Coefficients<FloatType>> coefficients
+        {
+            makeCoefficients<FloatType> (ArrayCoeffs::makeLowShelf (44100.0, (FloatType) 100, (FloatType) 0.7, (FloatType) 2)),
+            makeCoefficients<FloatType> (ArrayCoeffs::makePeakFilter (44100.0, (FloatType) 1000, (FloatType) 2, (FloatType) 0.5)),
+            makeCoefficients<FloatType> (ArrayCoeffs::makeHighShelf (44100.0, (FloatType) 8000, (FloatType) 0.7, (FloatType) 1.5))
+        };
+
+        BiquadBank<FloatType> bank;
+        for (const auto& c : coefficients)
+            bank.addSection (c);
+
+        bank.prepare (numChannels);
+        expect (bank.getNumSections() == (int) coefficients.size());
+
+        juce::AudioBuffer<FloatType> buffer (numChannels, numSamples), expected (numChannels, numSamples);
+        fillWithNoise (buffer);
+        expected.makeCopyOf (buffer);
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            std::vector<ReferenceBiquad<FloatType>> reference (coefficients.size());
+            for (size_t i = 0; i < coefficients.size(); ++i)
+                reference[i].c = coefficients[i];
+
+            for (int n = 0; n < numSamples; ++n)
+            {
+                auto sample = expected.getSample (c, n);
+
+                for (auto& biquad : reference)
+                    sample = biquad.process (sample);
+
+                expected.setSample (c, n, sample);
+            }
+        }
+
+        // Split in two to make sure the state carries over from one block to the next.
+        bank.process (buffer, 0, numSamples / 2);
+        bank.process (buffer, numSamples / 2, numSamples - numSamples / 2);
+
+        expectBuffersMatch (buffer, expected);
+
+        beginTest ("Reset - " + typeName);
+
+        bank.reset();
+        buffer.clear();
+        bank.process (buffer, 0, numSamples);
+        expect (buffer.getMagnitude (0, numSamples) == FloatType(), "The state should have been cleared.");
+    }
+
+    template<typename FloatType>
+    void runSweepTests()
+    {
+        const auto typeName = String (std::is_same_v<FloatType, float> ? "float" : "double");
+
+        beginTest ("Sweep - " + typeName);
+
+        // Sweeping a plain gain from 1 down to 0 makes the interpolation easy to check.
+        BiquadBank<FloatType> bank;
+        const auto section = bank.addSection();
+        bank.prepare (numChannels);
+
+        constexpr int rampLength = numSamples / 2;
+        bank.setCoefficients (section, { FloatType(), FloatType(), FloatType(), FloatType(), FloatType() }, rampLength);
+        expect (bank.isSweeping());
+
+        juce::AudioBuffer<FloatType> buffer (numChannels, numSamples);
+
+        for (int c = 0; c < numChannels; ++c)
+            FloatVectorOperations::fill (buffer.getWritePointer (c), (FloatType) 1, numSamples);
+
+        // Split into uneven blocks, so the sweep straddles a few of them.
+        for (int start = 0; start < numSamples;)
+        {
+            const auto num = jmin (numSamples - start, 100);
+            bank.process (buffer, start, num);
+            start += num;
+        }
+
+        expect (! bank.isSweeping());
+
+        for (int c = 0; c < numChannels; ++c)
+        {
+            for (int n = 0; n < numSamples; ++n)
+            {
+                const auto expected = n < rampLength ? (FloatType) 1 - (FloatType) n / (FloatType) rampLength : FloatType();
+                expectWithinAbsoluteError (buffer.getSample (c, n), expected, (FloatType) 1.0e-5);
+            }
+        }
+    }
+
+    //==============================================================================
+    template<typename FloatType>
+    void fillWithNoise (juce::AudioBuffer<FloatType>& buffer)
+    {
+        auto& random = getRandom();
+
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            for (int n = 0; n < buffer.getNumSamples(); ++n)
+                buffer.setSample (c, n, (FloatType) (random.nextFloat() * 2.0f - 1.0f));
+    }
+
+    template<typename FloatType>
+    void expectBuffersMatch (const juce::AudioBuffer<FloatType>& buffer, const juce::AudioBuffer<FloatType>& expected)
+    {
+        const auto tolerance = std::is_same_v<FloatType, float> ? (FloatType) 1.0e-4 : (FloatType) 1.0e-10;
+
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            for (int n = 0; n < buffer.getNumSamples(); ++n)
+                expectWithinAbsoluteError (buffer.getSample (c, n), expected.getSample (c, n), tolerance);
+    }
+};
+
+#endif
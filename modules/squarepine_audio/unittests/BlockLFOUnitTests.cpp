@@ -0,0 +1,186 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class BlockLFOUnitTests final : public UnitTest
+{
+public:
+    BlockLFOUnitTests() :
+        UnitTest ("BlockLFO", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runSineTests<float>();
+        runSineTests<double>();
+        runContinuityTests();
+        runShapeTests();
+        runWavetableTests();
+        runOperationTests();
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        blockSize = 512
+    };
+
+    static constexpr auto sampleRate = 44100.0;
+
+    //==============================================================================
+    template<typename FloatType>
+    void runSineTests()
+    {
+        beginTest (String ("Sine accuracy - ") + (std::is_same_v<FloatType, float> ? "float" : "double"));
+
+        for (const auto frequency : { 0.5, 3.0, 441.0, 5000.0 })
+        {
+            BlockLFO lfo;
+            lfo.prepare (sampleRate);
+            lfo.setFrequency (frequency);
+            lfo.setPhase (0.3);
+
+            std::vector<FloatType> samples ((size_t) blockSize);
+            lfo.render<LFOWaveforms::Sine> (samples.data(), blockSize);
+
+            auto maxError = 0.0;
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const auto phase = 0.3 + (double) i * frequency / sampleRate;
+                const auto expected = std::sin (MathConstants<double>::twoPi * phase);
+                maxError = jmax (maxError, std::abs ((double) samples[(size_t) i] - expected));
+            }
+
+            expect (maxError < 1.0e-4, "The sine is off by " + String (maxError) + " at " + String (frequency) + " Hz");
+        }
+    }
+
+    void runContinuityTests()
+    {
+        beginTest ("Continuity across blocks");
+
+        BlockLFO whole, split;
+
+        for (auto* lfo : { &whole, &split })
+        {
+            lfo->prepare (sampleRate);
+            lfo->setFrequency (7.0);
+        }
+
+        std::vector<double> expected ((size_t) blockSize), actual ((size_t) blockSize);
+        whole.render<LFOWaveforms::Triangle> (expected.data(), blockSize);
+
+        for (int start = 0; start < blockSize; start += 100)
+            split.render<LFOWaveforms::Triangle> (actual.data() + start, jmin (100, blockSize - start));
+
+        auto maxError = 0.0;
+        for (size_t i = 0; i < expected.size(); ++i)
+            maxError = jmax (maxError, std::abs (expected[i] - actual[i]));
+
+        expect (maxError < 1.0e-9, "Rendering in pieces should be the same as rendering in one go.");
+        expectWithinAbsoluteError (whole.getPhase(), split.getPhase(), 1.0e-12);
+        expectWithinAbsoluteError (whole.getPhase(), std::fmod (7.0 * blockSize / sampleRate, 1.0), 1.0e-9);
+    }
+
+    void runShapeTests()
+    {
+        beginTest ("Shapes");
+
+        BlockLFO lfo;
+        lfo.prepare (sampleRate);
+        lfo.setFrequency (1.0);
+
+        auto valueAt = [&] (auto waveform, double phase)
+        {
+            double value = 0.0;
+            lfo.setPhase (phase);
+            lfo.render<decltype (waveform)> (&value, 1);
+            return value;
+        };
+
+        const auto tolerance = 1.0e-6;
+
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Triangle(), 0.0), 0.0, tolerance);
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Triangle(), 0.25), 1.0, tolerance);
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Triangle(), 0.5), 0.0, tolerance);
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Triangle(), 0.75), -1.0, tolerance);
+
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Sine(), 0.25), 1.0, tolerance);
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Sine(), 0.75), -1.0, tolerance);
+
+        // A slow saw and square have all of their harmonics, so they're close to the naive shapes:
+        expect (valueAt (LFOWaveforms::Saw(), 0.1) < valueAt (LFOWaveforms::Saw(), 0.5));
+        expect (valueAt (LFOWaveforms::Saw(), 0.5) < valueAt (LFOWaveforms::Saw(), 0.9));
+        expectWithinAbsoluteError (valueAt (LFOWaveforms::Saw(), 0.5), 0.0, 0.01);
+        expect (valueAt (LFOWaveforms::Square(), 0.25) > 0.85);
+        expect (valueAt (LFOWaveforms::Square(), 0.75) < -0.85);
+    }
+
+    void runWavetableTests()
+    {
+        beginTest ("Band-limited wavetables");
+
+        expectEquals (LFOWavetable::getLevelFor (1.0, sampleRate), LFOWavetable::numLevels - 1);
+        expectEquals (LFOWavetable::getLevelFor (5000.0, sampleRate), 2);
+        expectEquals (LFOWavetable::getLevelFor (15000.0, sampleRate), 0);
+        expectEquals (LFOWavetable::getLevelFor (30000.0, sampleRate), 0);
+
+        for (const auto* wavetable : { &LFOWavetable::getSaw(), &LFOWavetable::getSquare() })
+        {
+            for (int level = 0; level < LFOWavetable::numLevels; ++level)
+            {
+                const auto* table = wavetable->getTable (level);
+                auto peak = 0.0f;
+
+                for (int i = 0; i <= LFOWavetable::tableSize + 1; ++i)
+                    peak = jmax (peak, std::abs (table[i]));
+
+                expectWithinAbsoluteError (peak, 1.0f, 1.0e-5f);
+                expectWithinAbsoluteError (table[LFOWavetable::tableSize], table[0], 1.0e-9f);
+            }
+        }
+
+        // The lowest level is nothing but the fundamental:
+        const auto* sawTable = LFOWavetable::getSaw().getTable (0);
+        expectWithinAbsoluteError (LFOWavetable::lookup (sawTable, 0.25), -1.0, 1.0e-5);
+        expectWithinAbsoluteError (LFOWavetable::lookup (sawTable, 0.75), 1.0, 1.0e-5);
+    }
+
+    void runOperationTests()
+    {
+        beginTest ("Operations");
+
+        BlockLFO lfo;
+        lfo.prepare (sampleRate);
+
+        // With no depth, the LFO is just its offset, which makes the operations easy to check:
+        std::vector<float> samples (16, 2.0f);
+
+        lfo.render<LFOWaveforms::Sine, LFOOperations::Add> (samples.data(), (int) samples.size(), 0.0, 3.0);
+        expectEquals (samples.back(), 5.0f);
+
+        lfo.render<LFOWaveforms::Sine, LFOOperations::Multiply> (samples.data(), (int) samples.size(), 0.0, 2.0);
+        expectEquals (samples.back(), 10.0f);
+
+        lfo.render<LFOWaveforms::Sine, LFOOperations::Subtract> (samples.data(), (int) samples.size(), 0.0, 4.0);
+        expectEquals (samples.back(), 6.0f);
+
+        lfo.render<LFOWaveforms::Sine, LFOOperations::Equals> (samples.data(), (int) samples.size(), 0.0, 1.0);
+        expectEquals (samples.front(), 1.0f);
+
+        beginTest ("Applying to buffers");
+
+        juce::AudioBuffer<float> buffer (3, 16);
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            FloatVectorOperations::fill (buffer.getWritePointer (c), (float) (c + 1), buffer.getNumSamples());
+
+        lfo.render<LFOWaveforms::Triangle> (samples.data(), (int) samples.size(), 0.0, 0.5);
+        BlockLFO::apply<LFOOperations::Multiply> (buffer, samples.data(), 0, buffer.getNumSamples());
+
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            expectEquals (buffer.getSample (c, 7), (float) (c + 1) * 0.5f);
+    }
+};
+
+#endif
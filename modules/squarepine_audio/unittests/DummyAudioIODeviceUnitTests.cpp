@@ -0,0 +1,129 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class DummyAudioIODeviceUnitTests final : public UnitTest
+{
+public:
+    DummyAudioIODeviceUnitTests() :
+        UnitTest ("DummyAudioIODevice", UnitTestCategories::audio)
+    {
+    }
+
+    void runTest() override
+    {
+        const auto realtimeNumSamples = (int64) (sampleRate * runTimeMs / 1000);
+
+        {
+            beginTest ("Freewheeling");
+
+            const auto callback = runDevice (DummyAudioIODevice::RenderMode::freewheel);
+
+            expect (callback.numSamplesRendered > realtimeNumSamples * 4, "Freewheeling should outrun realtime by far.");
+            expect (callback.numFailures == 0, "The device's buffers weren't cleared, or were reallocated.");
+        }
+
+        {
+            beginTest ("Stress");
+
+            const auto callback = runDevice (DummyAudioIODevice::RenderMode::stress);
+
+            expect (callback.numSamplesRendered > 0);
+            expect (callback.numSamplesRendered < realtimeNumSamples * 2, "Stress mode should stay close to realtime.");
+            expect (callback.numFailures == 0, "The device's buffers weren't cleared, or were reallocated.");
+        }
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        blockSize = 64,
+        sampleRate = 44100,
+        runTimeMs = 100
+    };
+
+    //==============================================================================
+    struct Results final
+    {
+        int64 numSamplesRendered = 0;
+        int numFailures = 0;
+    };
+
+    Results runDevice (DummyAudioIODevice::RenderMode mode)
+    {
+        Callback callback;
+
+        DummyAudioIODevice device (false, 2, (double) sampleRate, blockSize);
+        device.setRenderMode (mode);
+        device.open (2, (double) sampleRate, blockSize);
+        device.start (&callback);
+        Thread::sleep (runTimeMs);
+        device.stop();
+
+        const auto stats = device.getRenderStatistics();
+        const auto numCallbacks = callback.numCallbacks.load();
+
+        expect (numCallbacks > 0, "The device never called back.");
+        expect (device.getNumSamplesRendered() == (int64) numCallbacks * blockSize);
+        expect (stats.numCallbacks == (uint64) numCallbacks);
+        expect (std::accumulate (stats.histogram.begin(), stats.histogram.end(), (uint64) 0) == stats.numCallbacks);
+        expect (stats.minimumSeconds <= stats.getAverageSeconds() && stats.getAverageSeconds() <= stats.maximumSeconds);
+        expect (stats.getLoadPercentile (1.0) >= stats.getLoadPercentile (0.5));
+
+        device.close();
+
+        return { device.getNumSamplesRendered(), callback.numFailures.load() };
+    }
+
+    //==============================================================================
+    class Callback final : public AudioIODeviceCallback
+    {
+    public:
+        Callback() = default;
+
+        void audioDeviceIOCallbackWithContext (const float* const* inputs, int numInputs,
+                                               float* const* outputs, int numOutputs,
+                                               int numSamples, const AudioIODeviceCallbackContext&) override
+        {
+            for (int i = 0; i < numInputs; ++i)
+                if (! isSilent (inputs[i], numSamples))
+                    ++numFailures;
+
+            for (int i = 0; i < numOutputs; ++i)
+            {
+                if (! isSilent (outputs[i], numSamples))
+                    ++numFailures;
+
+                // Dirty the output, which the device must clear before the next callback:
+                FloatVectorOperations::fill (outputs[i], 1.0f, numSamples);
+            }
+
+            if (numOutputs > 0)
+            {
+                if (firstOutput != nullptr && firstOutput != outputs[0])
+                    ++numFailures;
+
+                firstOutput = outputs[0];
+            }
+
+            ++numCallbacks;
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override {}
+        void audioDeviceStopped() override {}
+
+        std::atomic<int> numCallbacks { 0 }, numFailures { 0 };
+
+    private:
+        const float* firstOutput = nullptr;
+
+        static bool isSilent (const float* samples, int numSamples)
+        {
+            const auto range = FloatVectorOperations::findMinAndMax (samples, numSamples);
+            return range.getStart() == 0.0f && range.getEnd() == 0.0f;
+        }
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Callback)
+    };
+};
+
+#endif
@@ -0,0 +1,1067 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class EffectProcessorChainUnitTests final : public UnitTest
+{
+public:
+    EffectProcessorChainUnitTests() :
+        UnitTest ("EffectProcessorChain", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Concurrent mutations while rendering");
+
+        TestContext context;
+        expect (context.chain->getNumEffects() == 0);
+
+        DummyAudioIODevice device (false, 2, 44100.0, 64);
+        device.open (2, 44100.0, 64);
+
+        ChainRenderer renderer (*context.chain);
+        device.start (&renderer);
+
+        {
+            OwnedArray<MutatorThread> mutators;
+
+            for (int i = 0; i < numMutatorThreads; ++i)
+                mutators.add (new MutatorThread (*context.chain, getRandom().nextInt64()));
+
+            for (auto* mutator : mutators)
+                mutator->startThread();
+
+            waitForMutators (mutators);
+
+            for (auto* mutator : mutators)
+            {
+                expect (mutator->stopThread (1000), "A mutator thread never finished!");
+                expect (mutator->numFailedInsertions == 0, "Failed to create an effect!");
+            }
+        }
+
+        device.stop();
+        device.close();
+
+        expect (renderer.numBlocksRendered.load() > 0, "The device never rendered the chain.");
+        expect (context.chain->getNumEffects() <= maxNumEffects * numMutatorThreads);
+
+        beginTest ("Clearing after rendering");
+
+        context.chain->clear();
+        expect (context.chain->getNumEffects() == 0);
+
+        runMixingTests<float> (context, "Wet/dry mixing - float");
+        runMixingTests<double> (context, "Wet/dry mixing - double");
+
+        runLatencyTests<float> (context, "Latency compensation - float");
+        runLatencyTests<double> (context, "Latency compensation - double");
+
+        runMultichannelTests<float> (context, "Multichannel processing - float");
+        runMultichannelTests<double> (context, "Multichannel processing - double");
+        runSurroundLayoutTests();
+
+        runStateTests (context);
+        runPoolingTests (context);
+        runUnpreparedTests (context);
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        numMutatorThreads = 4,
+        numMutationsPerThread = 500,
+        maxNumEffects = 12,
+        testLatency = 100 // Longer than a block, so the compensation delays wrap around mid-block.
+    };
+
+    //==============================================================================
+    /** Delays its input by a fixed number of samples, and reports that as its latency,
+        much like a lookahead limiter does minus the limiting.
+    */
+    class LatentDelayProcessor final : public InternalProcessor
+    {
+    public:
+        LatentDelayProcessor() :
+            InternalProcessor (false)
+        {
+            setLatencySamples (testLatency);
+        }
+
+        const String getName() const override { return "Latent Delay"; }
+        Identifier getIdentifier() const override { return "latentDelay"; }
+        bool supportsDoublePrecisionProcessing() const override { return true; }
+
+        void prepareToPlay (double, int) override
+        {
+            for (auto& channel : history)
+                channel.assign ((size_t) testLatency, 0.0);
+
+            position = 0;
+        }
+
+        void processBlock (juce::AudioBuffer<float>& buffer, MidiBuffer&) override     { process (buffer); }
+        void processBlock (juce::AudioBuffer<double>& buffer, MidiBuffer&) override    { process (buffer); }
+
+        static PluginDescription createDescription()
+        {
+            PluginDescription description;
+            description.name = "Latent Delay";
+            description.fileOrIdentifier = "latentDelay";
+            description.pluginFormatName = "LatencyTest";
+            description.numInputChannels = 2;
+            description.numOutputChannels = 2;
+            return description;
+        }
+
+    private:
+        std::array<std::vector<double>, 2> history;
+        int position = 0;
+
+        template<typename FloatType>
+        void process (juce::AudioBuffer<FloatType>& buffer)
+        {
+            const auto numChannels = jmin (buffer.getNumChannels(), (int) history.size());
+
+            for (int s = 0; s < buffer.getNumSamples(); ++s)
+            {
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    auto& delayed = history[(size_t) i][(size_t) position];
+                    const auto input = (double) buffer.getSample (i, s);
+                    buffer.setSample (i, s, static_cast<FloatType> (delayed));
+                    delayed = input;
+                }
+
+                position = (position + 1) % testLatency;
+            }
+        }
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LatentDelayProcessor)
+    };
+
+    /** Provides the LatentDelayProcessor, as a third-party format would. */
+    class LatencyTestFormat final : public InternalAudioPluginFormat
+    {
+    public:
+        LatencyTestFormat (AudioProcessorGraph& g) :
+            InternalAudioPluginFormat (g)
+        {
+        }
+
+        String getName() const override { return "LatencyTest"; }
+
+        void createPluginInstance (const PluginDescription& description, double initialSampleRate,
+                                   int initialBufferSize, PluginCreationCallback callback) override
+        {
+            if (description.fileOrIdentifier != "latentDelay")
+            {
+                callback (nullptr, "Unknown plugin");
+                return;
+            }
+
+            auto plugin = std::make_unique<LatentDelayProcessor>();
+            plugin->prepareToPlay (initialSampleRate, initialBufferSize);
+            callback (std::move (plugin), {});
+        }
+    };
+
+    //==============================================================================
+    class TestEffectProcessorFactory final : public EffectProcessorFactory
+    {
+    public:
+        TestEffectProcessorFactory (KnownPluginList& kpl, AudioPluginFormatManager& afm) :
+            EffectProcessorFactory (kpl, afm)
+        {
+        }
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TestEffectProcessorFactory)
+    };
+
+    struct TestContext final
+    {
+        TestContext()
+        {
+            auto* format = new InternalAudioPluginFormat (graph);
+            formatManager.addFormat (format);
+            format->addPluginDescriptions (knownPluginList);
+
+            formatManager.addFormat (new LatencyTestFormat (graph));
+            knownPluginList.addType (LatentDelayProcessor::createDescription());
+
+            factory = std::make_shared<TestEffectProcessorFactory> (knownPluginList, formatManager);
+            chain = std::make_shared<EffectProcessorChain> (factory);
+            chain->prepareToPlay (44100.0, 64);
+        }
+
+        AudioProcessorGraph graph;
+        AudioPluginFormatManager formatManager;
+        KnownPluginList knownPluginList;
+        std::shared_ptr<EffectProcessorFactory> factory;
+        std::shared_ptr<EffectProcessorChain> chain;
+    };
+
+    //==============================================================================
+    /** Drives the chain directly from the device thread, without allocating. */
+    class ChainRenderer final : public AudioIODeviceCallback
+    {
+    public:
+        ChainRenderer (EffectProcessorChain& c) : chain (c) {}
+
+        void audioDeviceAboutToStart (AudioIODevice* device) override
+        {
+            buffer.setSize (device->getActiveOutputChannels().countNumberOfSetBits(),
+                            device->getCurrentBufferSizeSamples());
+            midiBuffer.ensureSize (256);
+        }
+
+        void audioDeviceIOCallbackWithContext (const float* const*, int,
+                                               float* const* outputs, int numOutputs,
+                                               int numSamples, const AudioIODeviceCallbackContext&) override
+        {
+            const auto numChannels = jmin (numOutputs, buffer.getNumChannels());
+            buffer.setSize (numChannels, numSamples, false, false, true);
+
+            for (int i = 0; i < numChannels; ++i)
+                for (int s = 0; s < numSamples; ++s)
+                    buffer.setSample (i, s, random.nextFloat() * 2.0f - 1.0f);
+
+            midiBuffer.clear();
+            chain.processBlock (buffer, midiBuffer);
+
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::copy (outputs[i], buffer.getReadPointer (i), numSamples);
+
+            ++numBlocksRendered;
+        }
+
+        void audioDeviceStopped() override {}
+
+        std::atomic<int64> numBlocksRendered { 0 };
+
+    private:
+        EffectProcessorChain& chain;
+        juce::AudioBuffer<float> buffer;
+        MidiBuffer midiBuffer;
+        Random random;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChainRenderer)
+    };
+
+    //==============================================================================
+    /** Randomly inserts, moves, removes, queries and tweaks effects in the chain. */
+    class MutatorThread final : public Thread
+    {
+    public:
+        MutatorThread (EffectProcessorChain& c, int64 seed) :
+            Thread ("EffectProcessorChain Mutator"),
+            chain (c),
+            random (seed)
+        {
+        }
+
+        void run() override
+        {
+            const StringArray identifiers { "mute", "polarityInverter", "stereoWidth", "basicDither" };
+
+            for (int i = 0; i < numMutationsPerThread && ! threadShouldExit(); ++i)
+            {
+                const auto numEffects = chain.getNumEffects();
+                const auto index = random.nextInt (jmax (1, numEffects));
+
+                switch (random.nextInt (6))
+                {
+                    case 0:
+                        if (numEffects < maxNumEffects)
+                        {
+                            const auto& identifier = identifiers[random.nextInt (identifiers.size())];
+                            if (chain.insertNewEffect (identifier, index) == nullptr)
+                                ++numFailedInsertions;
+                        }
+                    break;
+
+                    case 1: chain.moveEffect (index, random.nextInt (jmax (1, numEffects))); break;
+                    case 2: chain.moveEffect (index, EffectProcessorChain::PluginPositionPreset::shiftToFirst); break;
+                    case 3: chain.removeEffect (index); break;
+                    case 4: chain.setMixLevel (index, random.nextFloat()); break;
+                    case 5: chain.setBypass (index, random.nextBool()); break;
+
+                    default: jassertfalse; break;
+                };
+
+                [[maybe_unused]] const auto name = chain.getEffectName (index);
+                [[maybe_unused]] const auto mixLevel = chain.getMixLevel (index);
+            }
+        }
+
+        int numFailedInsertions = 0;
+
+    private:
+        EffectProcessorChain& chain;
+        Random random;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MutatorThread)
+    };
+
+    /** Waits for the mutators to finish, for up to a minute.
+
+        N.B.: The message loop is kept running in the meantime, rather than being blocked,
+              because plugins that can't be created on any thread get created on the message thread.
+    */
+    static void waitForMutators (const OwnedArray<MutatorThread>& mutators)
+    {
+        const auto isAnyRunning = [&]
+        {
+            return std::any_of (mutators.begin(), mutators.end(),
+                                [] (MutatorThread* mutator) { return mutator->isThreadRunning(); });
+        };
+
+        const auto timeout = Time::getMillisecondCounter() + 60000;
+
+        while (isAnyRunning() && Time::getMillisecondCounter() < timeout)
+        {
+           #if JUCE_MODAL_LOOPS_PERMITTED
+            MessageManager::getInstance()->runDispatchLoopUntil (10);
+           #else
+            Thread::sleep (10);
+           #endif
+        }
+    }
+
+    //==============================================================================
+    template<typename FloatType>
+    void runMixingTests (TestContext& context, const String& name)
+    {
+        beginTest (name);
+
+        auto& chain = *context.chain;
+        chain.clear();
+
+        auto effect = chain.appendNewEffect ("polarityInverter");
+        expect (effect != nullptr);
+
+        if (effect == nullptr)
+            return;
+
+        if (auto* inverter = dynamic_cast<PolarityInversionProcessor*> (effect->plugin.get()))
+            inverter->setActive (true);
+        else
+            expect (false, "Failed to create a polarity inverter!");
+
+        juce::AudioBuffer<FloatType> buffer (2, 64);
+        MidiBuffer midiBuffer;
+
+        auto renderBlock = [&]()
+        {
+            for (int i = 0; i < buffer.getNumChannels(); ++i)
+                for (int s = 0; s < buffer.getNumSamples(); ++s)
+                    buffer.setSample (i, s, static_cast<FloatType> (0.5));
+
+            chain.processBlock (buffer, midiBuffer);
+        };
+
+        // Renders enough blocks for the mix level ramps to settle:
+        auto render = [&] (float mixLevel)
+        {
+            expect (chain.setMixLevel (0, mixLevel));
+
+            for (int i = 0; i < 64; ++i)
+                renderBlock();
+        };
+
+        const auto tolerance = static_cast<FloatType> (1.0e-5);
+
+        render (1.0f);
+        expectWithinAbsoluteError (buffer.getSample (1, 63), static_cast<FloatType> (-0.5), tolerance);
+
+        // Mix changes should be ramped per sample, rather than jumping per block:
+        expect (chain.setMixLevel (0, 0.5f));
+        renderBlock();
+        expect (buffer.getSample (0, 0) < buffer.getSample (0, 63));
+        expect (buffer.getSample (0, 63) < static_cast<FloatType> (0));
+
+        // Half of the inverted signal blended with half of the dry signal nulls entirely:
+        render (0.5f);
+        expectWithinAbsoluteError (buffer.getMagnitude (0, buffer.getNumSamples()), static_cast<FloatType> (0), tolerance);
+
+        render (0.25f);
+        expectWithinAbsoluteError (buffer.getSample (0, 32), static_cast<FloatType> (0.25), tolerance);
+
+        expect (chain.setBypass (0, true));
+        render (0.25f);
+        expectWithinAbsoluteError (buffer.getSample (0, 32), static_cast<FloatType> (0.5), tolerance);
+
+        // Out of range mix levels are clamped:
+        expect (chain.setBypass (0, false));
+        render (2.0f);
+        expectEquals (chain.getMixLevel (0).value_or (-1.0f), 1.0f);
+        expectWithinAbsoluteError (buffer.getSample (0, 32), static_cast<FloatType> (-0.5), tolerance);
+
+        render (-1.0f);
+        expectEquals (chain.getMixLevel (0).value_or (-1.0f), 0.0f);
+        expectWithinAbsoluteError (buffer.getSample (0, 32), static_cast<FloatType> (0.5), tolerance);
+
+        chain.clear();
+
+        // The constant and ramped blends share a formula, so a flat ramp should match a constant mix level:
+        {
+            constexpr int numSamples = 16;
+            FloatType constantWet[numSamples], rampedWet[numSamples], dry[numSamples];
+            auto& random = getRandom();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                constantWet[i] = rampedWet[i] = static_cast<FloatType> (random.nextDouble() * 2.0 - 1.0);
+                dry[i] = static_cast<FloatType> (random.nextDouble() * 2.0 - 1.0);
+            }
+
+            const auto mixLevel = static_cast<FloatType> (0.3);
+            mixDryIntoWet (constantWet, dry, mixLevel, numSamples);
+            mixDryIntoWet (rampedWet, dry, mixLevel, mixLevel, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (rampedWet[i], constantWet[i], std::numeric_limits<FloatType>::epsilon() * 4);
+        }
+    }
+
+    //==============================================================================
+    template<typename FloatType>
+    void runLatencyTests (TestContext& context, const String& name)
+    {
+        beginTest (name);
+
+        auto& chain = *context.chain;
+        chain.clear();
+        expectEquals (chain.getLatencySamples(), 0);
+
+        for (int i = 0; i < 2; ++i)
+            expect (chain.appendNewEffect ("latentDelay") != nullptr, "Failed to create a latent delay!");
+
+        // An active effect without any latency shouldn't change anything:
+        expect (chain.appendNewEffect ("polarityInverter") != nullptr);
+
+        const auto totalLatency = 2 * (int) testLatency;
+        expectEquals (chain.getLatencySamples(), totalLatency);
+
+        // The latency used to keep on growing with every change...
+        chain.prepareToPlay (44100.0, 64);
+        chain.setMixLevel (2, 0.5f);
+        expectEquals (chain.getLatencySamples(), totalLatency);
+
+        // Each delay's output is its delayed input, so once the dry signal is lined up with it,
+        // every mix level (and every ramp between them) should null against the delayed input.
+        juce::AudioBuffer<FloatType> buffer (2, 64);
+        MidiBuffer midiBuffer;
+        std::vector<FloatType> input;
+        auto& random = getRandom();
+        auto maxError = FloatType();
+
+        auto render = [&] (int numBlocks)
+        {
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                const auto start = (int) input.size();
+
+                for (int s = 0; s < buffer.getNumSamples(); ++s)
+                {
+                    input.push_back (static_cast<FloatType> (random.nextFloat() * 2.0f - 1.0f));
+
+                    for (int i = 0; i < buffer.getNumChannels(); ++i)
+                        buffer.setSample (i, s, input.back());
+                }
+
+                chain.processBlock (buffer, midiBuffer);
+
+                for (int s = 0; s < buffer.getNumSamples(); ++s)
+                {
+                    const auto index = start + s - chain.getLatencySamples();
+                    const auto expected = index >= 0 ? input[(size_t) index] : FloatType();
+
+                    for (int i = 0; i < buffer.getNumChannels(); ++i)
+                        maxError = jmax (maxError, std::abs (buffer.getSample (i, s) - expected));
+                }
+            }
+        };
+
+        chain.setMixLevel (0, 0.5f);
+        chain.setMixLevel (1, 0.3f);
+        render (16);
+
+        chain.setMixLevel (0, 1.0f);
+        chain.setMixLevel (1, 0.0f);
+        render (16);
+
+        // Bypassing an effect ramps it down to its (delayed) dry signal, without changing the chain's latency:
+        expect (chain.setBypass (0, true));
+        render (16);
+        expectEquals (chain.getLatencySamples(), totalLatency);
+
+        expect (chain.setBypass (0, false));
+        chain.setMixLevel (1, 0.7f);
+        render (16);
+
+        expectWithinAbsoluteError (maxError, FloatType(), static_cast<FloatType> (1.0e-5));
+
+        // Taking the effects out should take their latency with them:
+        expect (chain.removeEffect (0));
+        expectEquals (chain.getLatencySamples(), (int) testLatency);
+
+        chain.clear();
+        expectEquals (chain.getLatencySamples(), 0);
+    }
+
+    //==============================================================================
+    template<typename FloatType>
+    void runMultichannelTests (TestContext& context, const String& name)
+    {
+        beginTest (name);
+
+        constexpr int numChannels = 6;
+
+        auto& chain = *context.chain;
+        chain.clear();
+        expect (chain.setPlayConfigDetails (numChannels, numChannels, 44100.0, 64));
+        chain.prepareToPlay (44100.0, 64);
+
+        // The latent delay only handles stereo, so the chain has to delay the rest of the channels to match,
+        // whereas the inverter can handle any number of channels, so it should get widened to all of them.
+        expect (chain.appendNewEffect ("latentDelay") != nullptr, "Failed to create a latent delay!");
+        const auto inverter = chain.appendNewEffect ("polarityInverter");
+        expect (inverter != nullptr);
+
+        if (auto* plugin = dynamic_cast<PolarityInversionProcessor*> (inverter != nullptr ? inverter->plugin.get() : nullptr))
+        {
+            plugin->setActive (true);
+            expectEquals (plugin->getTotalNumInputChannels(), numChannels);
+        }
+
+        expectEquals (chain.getLatencySamples(), (int) testLatency);
+
+        juce::AudioBuffer<FloatType> buffer (numChannels, 64);
+        MidiBuffer midiBuffer;
+        std::vector<FloatType> input;
+        auto& random = getRandom();
+        auto maxError = FloatType();
+
+        for (int b = 0; b < 16; ++b)
+        {
+            const auto start = (int) input.size();
+
+            for (int s = 0; s < buffer.getNumSamples(); ++s)
+            {
+                input.push_back (static_cast<FloatType> (random.nextFloat() * 2.0f - 1.0f));
+
+                // Scaled per channel, so that any channels getting mixed up would show:
+                for (int i = 0; i < numChannels; ++i)
+                    buffer.setSample (i, s, input.back() * static_cast<FloatType> (i + 1) / numChannels);
+            }
+
+            chain.processBlock (buffer, midiBuffer);
+
+            for (int s = 0; s < buffer.getNumSamples(); ++s)
+            {
+                const auto index = start + s - (int) testLatency;
+                const auto delayed = index >= 0 ? input[(size_t) index] : FloatType();
+
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    const auto expected = -delayed * static_cast<FloatType> (i + 1) / numChannels;
+                    maxError = jmax (maxError, std::abs (buffer.getSample (i, s) - expected));
+                }
+            }
+        }
+
+        expectWithinAbsoluteError (maxError, FloatType(), static_cast<FloatType> (1.0e-5));
+
+        chain.clear();
+        expect (chain.setPlayConfigDetails (2, 2, 44100.0, 64));
+        chain.prepareToPlay (44100.0, 64);
+    }
+
+    //==============================================================================
+    static bool setMainLayout (AudioProcessor& processor, const AudioChannelSet& channelSet)
+    {
+        AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add (channelSet);
+        layout.outputBuses.add (channelSet);
+        return processor.setBusesLayout (layout);
+    }
+
+    void runSurroundLayoutTests()
+    {
+        beginTest ("Surround layouts");
+
+        const auto surround = AudioChannelSet::create5point1();
+        const auto numChannels = surround.size();
+        constexpr int blockSize = 256;
+
+        juce::AudioBuffer<float> buffer (numChannels, blockSize);
+        MidiBuffer midiBuffer;
+
+        auto fillBuffer = [&]
+        {
+            for (int i = 0; i < numChannels; ++i)
+                FloatVectorOperations::fill (buffer.getWritePointer (i), (float) (i + 1) / (float) numChannels, blockSize);
+        };
+
+        {
+            LevelsProcessor levels;
+            expect (setMainLayout (levels, surround), "The levels meter should accept any layout.");
+            expectEquals (levels.getTotalNumInputChannels(), numChannels);
+
+            levels.prepareToPlay (48000.0, blockSize);
+            fillBuffer();
+            levels.processBlock (buffer, midiBuffer);
+
+            Array<float> channelLevels;
+            levels.getChannelLevels (channelLevels);
+            expectEquals (channelLevels.size(), numChannels);
+
+            for (int i = 0; i < channelLevels.size(); ++i)
+                expectWithinAbsoluteError (channelLevels[i], (float) (i + 1) / (float) numChannels, 1.0e-6f);
+        }
+
+        {
+            djdawprocessor::GainProcessor gain;
+            expect (setMainLayout (gain, surround), "The gain should accept any layout.");
+            expectEquals (gain.getTotalNumOutputChannels(), numChannels);
+
+            gain.prepareToPlay (48000.0, blockSize);
+            gain.setGain (Decibels::gainToDecibels (0.5f));
+            fillBuffer();
+            gain.processBlock (buffer, midiBuffer);
+
+            // The gain ramp is much shorter than a block, so the end of it has settled:
+            for (int i = 0; i < numChannels; ++i)
+                expectWithinAbsoluteError (buffer.getSample (i, blockSize - 1), 0.5f * (float) (i + 1) / (float) numChannels, 1.0e-5f);
+        }
+
+        {
+            PanProcessor panner;
+            expect (! setMainLayout (panner, surround), "The panner is stereo only.");
+            expect (setMainLayout (panner, AudioChannelSet::stereo()));
+        }
+    }
+
+    //==============================================================================
+    /** Fills the chain with inverters, where every other one is active,
+        and gives each effect a distinct name, mix level, bypass state and UI position.
+    */
+    void fillChain (EffectProcessorChain& chain, int numEffects)
+    {
+        chain.clear();
+
+        for (int i = 0; i < numEffects; ++i)
+        {
+            auto effect = chain.appendNewEffect ("polarityInverter");
+            expect (effect != nullptr);
+
+            if (effect == nullptr)
+                continue;
+
+            if (auto* inverter = dynamic_cast<PolarityInversionProcessor*> (effect->plugin.get()))
+                inverter->setActive ((i % 2) == 0);
+
+            chain.setEffectName (i, "Effect " + String (i));
+            chain.setMixLevel (i, (float) (i + 1) / (float) (numEffects + 1));
+            chain.setBypass (i, (i % 3) == 0);
+            effect->lastUIPosition = { i * 10, i * 20 };
+        }
+    }
+
+    void expectEffectMatches (EffectProcessorChain& chain, int index, int originalIndex, int numEffects)
+    {
+        expectEquals (chain.getEffectName (index).value_or (String()), "Effect " + String (originalIndex));
+        expectWithinAbsoluteError (chain.getMixLevel (index).value_or (-1.0f), (float) (originalIndex + 1) / (float) (numEffects + 1), 1.0e-6f);
+        expect (chain.isBypassed (index).value_or (false) == ((originalIndex % 3) == 0));
+        expect (chain.getLastUIPosition (index).value_or (juce::Point<int>()) == juce::Point<int> (originalIndex * 10, originalIndex * 20));
+
+        const auto plugin = chain.getPluginInstance (index).value_or (nullptr);
+
+        if (auto* inverter = dynamic_cast<PolarityInversionProcessor*> (plugin.get()))
+            expect (inverter->isActive() == ((originalIndex % 2) == 0), "The plugin's state wasn't restored.");
+        else
+            expect (false, "Failed to restore a polarity inverter!");
+    }
+
+    void runStateTests (TestContext& context)
+    {
+        constexpr int numEffects = 6;
+        auto& chain = *context.chain;
+
+        beginTest ("Binary state round trip");
+        {
+            // The chain's own bypass state is hidden by the per-effect one:
+            auto& processor = static_cast<InternalProcessor&> (chain);
+
+            fillChain (chain, numEffects);
+            processor.setBypass (true);
+
+            MemoryBlock state;
+            chain.getStateInformation (state);
+            expect (EffectProcessorChainState::isBinaryState (state.getData(), state.getSize()));
+
+            chain.clear();
+            processor.setBypass (false);
+            chain.setStateInformation (state.getData(), (int) state.getSize());
+
+            expectEquals (chain.getNumEffects(), numEffects);
+            expect (processor.isBypassed());
+
+            for (int i = 0; i < chain.getNumEffects(); ++i)
+                expectEffectMatches (chain, i, i, numEffects);
+
+            processor.setBypass (false);
+        }
+
+        beginTest ("Lazy decoding");
+        {
+            fillChain (chain, numEffects);
+
+            MemoryBlock state;
+            chain.getStateInformation (state);
+
+            MemoryInputStream stream (state, false);
+            EffectProcessorChainState::Reader reader (stream);
+
+            expect (reader.isValid());
+            expectEquals (reader.getVersion(), EffectProcessorChainState::currentVersion);
+            expectEquals (reader.getNumEffects(), numEffects);
+
+            // Out of order, to make sure each effect is found through the index:
+            for (int i = numEffects; --i >= 0;)
+            {
+                const auto effect = reader.readEffect (i);
+                expect (effect.has_value());
+
+                if (effect.has_value())
+                {
+                    expectEquals (effect->name, "Effect " + String (i));
+                    expect (effect->description.fileOrIdentifier == "polarityInverter");
+                    expect (effect->state.getSize() > 0);
+                }
+            }
+
+            expect (! reader.readEffect (numEffects).has_value());
+
+            beginTest ("Restoring a single effect");
+
+            fillChain (chain, 2);
+            expect (chain.restoreEffect (state.getData(), (int) state.getSize(), 4, 1) != nullptr);
+            expectEquals (chain.getNumEffects(), 2);
+            expectEffectMatches (chain, 0, 0, 2);
+            expectEffectMatches (chain, 1, 4, numEffects);
+
+            expect (chain.restoreEffect (state.getData(), (int) state.getSize(), numEffects, 0) == nullptr);
+        }
+
+        beginTest ("Corrupt states");
+        {
+            fillChain (chain, numEffects);
+
+            MemoryBlock state;
+            chain.getStateInformation (state);
+
+            // Cutting the data short leaves the index pointing past the end:
+            MemoryInputStream truncated (state.getData(), state.getSize() / 2, false);
+            expect (! EffectProcessorChainState::Reader (truncated).isValid());
+
+            MemoryInputStream empty (nullptr, 0, false);
+            expect (! EffectProcessorChainState::Reader (empty).isValid());
+        }
+
+        beginTest ("Legacy XML state");
+        {
+            fillChain (chain, numEffects);
+
+            const auto state = createLegacyXmlState (chain);
+            expect (! EffectProcessorChainState::isBinaryState (state.getData(), state.getSize()));
+
+            chain.clear();
+            chain.setStateInformation (state.getData(), (int) state.getSize());
+
+            expectEquals (chain.getNumEffects(), numEffects);
+
+            for (int i = 0; i < chain.getNumEffects(); ++i)
+                expectEffectMatches (chain, i, i, numEffects);
+        }
+
+        beginTest ("Binary versus XML state timing");
+        {
+            constexpr int numIterations = 50;
+
+            fillChain (chain, numEffects);
+
+            MemoryBlock binaryState, xmlState;
+            auto startTicks = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numIterations; ++i)
+            {
+                chain.getStateInformation (binaryState);
+                chain.setStateInformation (binaryState.getData(), (int) binaryState.getSize());
+            }
+
+            const auto binarySeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+            startTicks = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numIterations; ++i)
+            {
+                xmlState = createLegacyXmlState (chain);
+                chain.setStateInformation (xmlState.getData(), (int) xmlState.getSize());
+            }
+
+            const auto xmlSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+
+            logMessage ("Saving and restoring " + String (numEffects) + " effects, " + String (numIterations) + " times - "
+                        + "binary: " + String (binarySeconds * 1000.0, 2) + " ms, " + String ((int) binaryState.getSize()) + " bytes; "
+                        + "XML: " + String (xmlSeconds * 1000.0, 2) + " ms, " + String ((int) xmlState.getSize()) + " bytes");
+
+            // The timings depend too much on the machine to check, but the sizes don't:
+            expectEquals (chain.getNumEffects(), numEffects);
+            expectLessThan (binaryState.getSize(), xmlState.getSize());
+        }
+
+       #if JUCE_MODAL_LOOPS_PERMITTED
+        runAsyncStateTests (chain);
+       #endif
+
+        chain.clear();
+    }
+
+    //==============================================================================
+    /** Saves a chain the way it used to be saved, before the binary format. */
+    static MemoryBlock createLegacyXmlState (EffectProcessorChain& chain)
+    {
+        XmlElement root ("EffectProcessorChain");
+        root.setAttribute ("rootBypassed", 0);
+
+        for (int i = 0; i < chain.getNumEffects(); ++i)
+        {
+            const auto effect = chain.getEffectProcessor (i);
+
+            auto* element = root.createNewChildElement ("effectRoot");
+            element->setAttribute ("effectName", effect->name);
+            element->setAttribute ("effectBypassed", effect->isBypassed ? 1 : 0);
+            element->setAttribute ("effectMixLevel", effect->targetMixLevel.load());
+            element->setAttribute ("effectUIX", effect->lastUIPosition.x);
+            element->setAttribute ("effectUIY", effect->lastUIPosition.y);
+            element->addChildElement (effect->description.createXml().release());
+
+            MemoryBlock pluginState;
+            effect->plugin->getStateInformation (pluginState);
+            element->createNewChildElement ("effectState")->addTextElement (Base64::toBase64 (pluginState.getData(), pluginState.getSize()));
+        }
+
+        MemoryBlock state;
+        AudioProcessor::copyXmlToBinary (root, state);
+        return state;
+    }
+
+    static bool waitForPool (const EffectProcessorFactory& factory, const PluginDescription& description, int numInstances)
+    {
+        for (int i = 0; i < 400; ++i)
+        {
+            if (factory.getNumPooledPlugins (description) >= numInstances)
+                return true;
+
+            Thread::sleep (25);
+        }
+
+        return false;
+    }
+
+    void runPoolingTests (TestContext& context)
+    {
+        beginTest ("Pooled plugins");
+
+        auto& chain = *context.chain;
+        auto& factory = *context.factory;
+        chain.clear();
+        expect (chain.setPlayConfigDetails (2, 2, 48000.0, 128));
+        chain.prepareToPlay (48000.0, 128);
+
+        const auto description = factory.createPluginDescription ("stereoWidth");
+        factory.setPoolSize (description, 2);
+        expect (waitForPool (factory, description, 2), "The pool was never filled!");
+
+        auto effect = chain.appendNewEffect ("stereoWidth");
+        expect (effect != nullptr && effect->plugin != nullptr);
+
+        if (effect == nullptr || effect->plugin == nullptr)
+            return;
+
+        expectEquals (effect->plugin->getSampleRate(), 48000.0);
+        expectEquals (effect->plugin->getBlockSize(), 128);
+        expect (waitForPool (factory, description, 2), "The pool was never refilled!");
+
+        beginTest ("Recycling plugins");
+
+        if (auto* parameter = effect->plugin->getParameters()[0])
+            parameter->setValue (parameter->getDefaultValue() > 0.5f ? 0.0f : 1.0f);
+        else
+            expect (false, "The stereo width has no parameters!");
+
+        // Whether the removed plugin makes it back into the pool or not, nothing pooled may keep its changes:
+        effect = nullptr;
+        expect (chain.removeEffect (0));
+        chain.clear();
+
+        const EffectProcessorFactory::PlaybackConfiguration configuration { 48000.0, 128, 2 };
+
+        for (int i = 0; i < 2; ++i)
+        {
+            expect (waitForPool (factory, description, 1));
+            auto plugin = factory.takePooledPlugin (description, configuration);
+            expect (plugin != nullptr, "Failed to take a pooled plugin!");
+
+            if (plugin != nullptr)
+                if (auto* parameter = plugin->getParameters()[0])
+                    expectWithinAbsoluteError (parameter->getValue(), parameter->getDefaultValue(), 1.0e-4f);
+        }
+
+        beginTest ("Repreparing pooled plugins");
+
+        chain.prepareToPlay (44100.0, 64);
+        expect (waitForPool (factory, description, 2), "The pool was never prepared again!");
+        expect (factory.takePooledPlugin (description, configuration) == nullptr, "Outdated plugins shouldn't be handed out.");
+
+        if (auto plugin = factory.takePooledPlugin (description, { 44100.0, 64, 2 }))
+        {
+            expectEquals (plugin->getSampleRate(), 44100.0);
+            expectEquals (plugin->getBlockSize(), 64);
+        }
+        else
+        {
+            expect (false, "Failed to take a pooled plugin!");
+        }
+
+        factory.setPoolSize (description, 0);
+        expectEquals (factory.getNumPooledPlugins (description), 0);
+    }
+
+    void runUnpreparedTests (TestContext& context)
+    {
+        beginTest ("Inserting into an unprepared chain");
+
+        // Like a session being loaded before the audio device has started:
+        constexpr int numEffects = 3;
+        EffectProcessorChain chain (context.factory);
+        chain.setRateAndBufferSizeDetails (0.0, 0);
+
+        fillChain (chain, numEffects);
+        expectEquals (chain.getNumEffects(), numEffects);
+
+        MemoryBlock state;
+        chain.getStateInformation (state);
+
+        beginTest ("Restoring into an unprepared chain");
+
+        chain.setStateInformation (state.getData(), (int) state.getSize());
+        expectEquals (chain.getNumEffects(), numEffects);
+
+        for (int i = 0; i < chain.getNumEffects(); ++i)
+            expectEffectMatches (chain, i, i, numEffects);
+
+        expect (chain.restoreEffect (state.getData(), (int) state.getSize(), 1, 0) != nullptr);
+        expectEquals (chain.getNumEffects(), numEffects + 1);
+        expectEffectMatches (chain, 0, 1, numEffects);
+
+        // Preparing the chain afterwards is what sets up the mix ramps:
+        chain.prepareToPlay (44100.0, 64);
+
+        juce::AudioBuffer<float> buffer (2, 64);
+        MidiBuffer midiBuffer;
+
+        for (int i = 0; i < buffer.getNumChannels(); ++i)
+            FloatVectorOperations::fill (buffer.getWritePointer (i), 0.5f, buffer.getNumSamples());
+
+        chain.processBlock (buffer, midiBuffer);
+
+        const auto range = buffer.findMinMax (0, 0, buffer.getNumSamples());
+        expect (std::isfinite (range.getStart()) && std::isfinite (range.getEnd()));
+        expect (range.getStart() >= -0.5f && range.getEnd() <= 0.5f);
+    }
+
+   #if JUCE_MODAL_LOOPS_PERMITTED
+    void runAsyncStateTests (EffectProcessorChain& chain)
+    {
+        constexpr int numEffects = 12;
+
+        fillChain (chain, numEffects);
+
+        MemoryBlock state;
+        chain.getStateInformation (state);
+
+        ThreadPool threadPool (4);
+
+        for (auto* pool : { &threadPool, static_cast<ThreadPool*> (nullptr) })
+        {
+            beginTest (String ("Asynchronous restore") + (pool != nullptr ? " - threaded" : " - message thread"));
+
+            fillChain (chain, 2);
+
+            int numProgressCalls = 0, lastNumRestored = 0;
+            auto completed = false, allRestored = false;
+
+            expect (chain.setStateInformationAsync (state.getData(), (int) state.getSize(), pool,
+                                                    [&] (int numRestored, int total)
+                                                    {
+                                                        ++numProgressCalls;
+                                                        expect (numRestored > lastNumRestored && total == numEffects);
+                                                        lastNumRestored = numRestored;
+                                                    },
+                                                    [&] (bool result)
+                                                    {
+                                                        completed = true;
+                                                        allRestored = result;
+                                                    }));
+
+            // Nothing gets swapped in until the messages have been dispatched:
+            expect (chain.isRestoring());
+            expectEquals (chain.getNumEffects(), 2);
+
+            for (int i = 0; i < 1000 && ! completed; ++i)
+                MessageManager::getInstance()->runDispatchLoopUntil (5);
+
+            expect (completed && allRestored);
+            expect (! chain.isRestoring());
+            expectEquals (numProgressCalls, numEffects);
+            expectEquals (chain.getNumEffects(), numEffects);
+
+            for (int i = 0; i < chain.getNumEffects(); ++i)
+                expectEffectMatches (chain, i, i, numEffects);
+        }
+
+        beginTest ("Cancelling an asynchronous restore");
+        {
+            fillChain (chain, 2);
+
+            auto numCallbacks = 0;
+            expect (chain.setStateInformationAsync (state.getData(), (int) state.getSize(), &threadPool,
+                                                    [&] (int, int) { ++numCallbacks; },
+                                                    [&] (bool) { ++numCallbacks; }));
+
+            chain.cancelAsyncRestore();
+            expect (! chain.isRestoring());
+
+            for (int i = 0; i < 20; ++i)
+                MessageManager::getInstance()->runDispatchLoopUntil (5);
+
+            expectEquals (numCallbacks, 0);
+            expectEquals (chain.getNumEffects(), 2);
+            expectEffectMatches (chain, 1, 1, 2);
+        }
+
+        beginTest ("Invalid asynchronous restore");
+        {
+            const char garbage[] = "Not a chain state";
+            expect (! chain.setStateInformationAsync (garbage, (int) sizeof (garbage), &threadPool));
+            expect (! chain.isRestoring());
+            expectEquals (chain.getNumEffects(), 2);
+        }
+    }
+   #endif
+};
+
+#endif
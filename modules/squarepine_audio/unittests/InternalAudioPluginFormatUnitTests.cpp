@@ -0,0 +1,70 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class InternalAudioPluginFormatUnitTests final : public UnitTest
+{
+public:
+    InternalAudioPluginFormatUnitTests() :
+        UnitTest ("InternalAudioPluginFormat", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Static descriptions match the processors");
+
+        AudioProcessorGraph graph;
+        InternalAudioPluginFormat format (graph);
+
+        const auto identifiers = format.searchPathsForPlugins ({}, true, false);
+        expect (! identifiers.isEmpty());
+
+        // The DAW effects are only worth registering if they're all there, so they're checked by name:
+        for (const auto* dawEffect : { "Butter Sem1", "Crush1", "Delay1", "Digital Sem1", "Digital Sem Two1",
+                                       "Dub Echo1", "Echo1", "effectiveTempoProcessor", "equaliser", "Flanger1",
+                                       "gain1", "Helix1", "LFO Filter1", "Long Delay1", "Noise1", "Phaser1",
+                                       "Ping Pong1", "Pitch1", "Reverb1", "Rev Roll1", "Roll1", "SEM Filter1",
+                                       "Shimmer1", "Short Delay1", "Slip Roll1", "Space1", "Spiral1", "Sweep1",
+                                       "Trans1", "variableBPMProcessor", "Vinyl Break1" })
+        {
+            expect (identifiers.contains (dawEffect), String ("Missing DAW effect: ") + dawEffect);
+        }
+
+        for (const auto& identifier : identifiers)
+        {
+            OwnedArray<PluginDescription> found;
+            format.findAllTypesForFile (found, identifier);
+            expect (found.size() == 1, "Missing description for " + identifier);
+
+            if (found.isEmpty())
+                continue;
+
+            const auto& registered = *found.getFirst();
+
+            std::unique_ptr<AudioPluginInstance> instance;
+            format.createPluginInstance (registered, 44100.0, 256,
+                                         [&] (std::unique_ptr<AudioPluginInstance> result, const String&)
+                                         {
+                                             instance = std::move (result);
+                                         });
+
+            expect (instance != nullptr, "Failed to create " + identifier);
+
+            // The graph's own processors aren't described statically:
+            if (dynamic_cast<InternalProcessor*> (instance.get()) == nullptr)
+                continue;
+
+            const auto actual = instance->getPluginDescription();
+
+            expect (registered.name == actual.name, identifier + ": the name doesn't match.");
+            expect (registered.fileOrIdentifier == actual.fileOrIdentifier, identifier + ": the identifier doesn't match.");
+            expect (registered.isInstrument == actual.isInstrument, identifier + ": the type doesn't match.");
+            expect (registered.category == actual.category, identifier + ": the category doesn't match.");
+            expect (registered.version == actual.version, identifier + ": the version doesn't match.");
+            expect (registered.uniqueId == actual.uniqueId, identifier + ": the unique ID doesn't match.");
+            expect (registered.numInputChannels == actual.numInputChannels, identifier + ": the inputs don't match.");
+            expect (registered.numOutputChannels == actual.numOutputChannels, identifier + ": the outputs don't match.");
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,144 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class LoudnessMeterUnitTests final : public UnitTest
+{
+public:
+    LoudnessMeterUnitTests() :
+        UnitTest ("LoudnessMeter", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runEBUTech3341Tests();
+        runEBUTech3342Tests();
+        runOfflineTests();
+    }
+
+private:
+    //==============================================================================
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    /** A stereo 1 kHz sine, in sections of a given level in dBFS and length in seconds. */
+    static juce::AudioBuffer<float> createProgramme (std::initializer_list<std::pair<float, double>> sections)
+    {
+        auto numSamples = 0;
+        for (const auto& section : sections)
+            numSamples += roundToInt (section.second * sampleRate);
+
+        juce::AudioBuffer<float> buffer (2, numSamples);
+        auto position = 0;
+
+        for (const auto& section : sections)
+        {
+            const auto gain = Decibels::decibelsToGain (section.first);
+            const auto length = roundToInt (section.second * sampleRate);
+
+            for (int n = 0; n < length; ++n)
+            {
+                const auto sample = gain * (float) std::sin (MathConstants<double>::twoPi * 1000.0 * (double) (position + n) / sampleRate);
+                buffer.setSample (0, position + n, sample);
+                buffer.setSample (1, position + n, sample);
+            }
+
+            position += length;
+        }
+
+        return buffer;
+    }
+
+    static LoudnessMeter::Results measure (const juce::AudioBuffer<float>& programme)
+    {
+        LoudnessMeter meter;
+        meter.prepare (sampleRate, programme.getNumChannels(), blockSize, AudioChannelSet::stereo());
+
+        for (int start = 0; start < programme.getNumSamples(); start += blockSize)
+            meter.process (programme, start, jmin (blockSize, programme.getNumSamples() - start));
+
+        return meter.getResults();
+    }
+
+    //==============================================================================
+    /** The minimum requirements test signals of EBU Tech 3341, which must read within 0.1 LU. */
+    void runEBUTech3341Tests()
+    {
+        beginTest ("EBU Tech 3341 - constant levels");
+
+        for (const auto level : { -23.0f, -33.0f })
+        {
+            const auto results = measure (createProgramme ({ { level, 20.0 } }));
+
+            expectWithinAbsoluteError (results.momentary, level, 0.1f);
+            expectWithinAbsoluteError (results.shortTerm, level, 0.1f);
+            expectWithinAbsoluteError (results.integrated, level, 0.1f);
+            expectWithinAbsoluteError (results.truePeak, level, 0.2f);
+        }
+
+        beginTest ("EBU Tech 3341 - relative gate");
+
+        {
+            const auto results = measure (createProgramme ({ { -36.0f, 10.0 }, { -23.0f, 60.0 }, { -36.0f, 10.0 } }));
+            expectWithinAbsoluteError (results.integrated, -23.0f, 0.1f);
+        }
+
+        beginTest ("EBU Tech 3341 - absolute gate");
+
+        {
+            const auto results = measure (createProgramme ({ { -72.0f, 10.0 }, { -36.0f, 10.0 }, { -23.0f, 60.0 },
+                                                             { -36.0f, 10.0 }, { -72.0f, 10.0 } }));
+            expectWithinAbsoluteError (results.integrated, -23.0f, 0.1f);
+        }
+
+        beginTest ("Silence");
+
+        {
+            juce::AudioBuffer<float> silence (2, roundToInt (sampleRate));
+            silence.clear();
+
+            const auto results = measure (silence);
+            expect (results.integrated == LoudnessMeter::silence);
+            expect (results.momentary == LoudnessMeter::silence);
+            expect (results.range == 0.0f);
+        }
+    }
+
+    /** The loudness range test signals of EBU Tech 3342, which must read within 1 LU. */
+    void runEBUTech3342Tests()
+    {
+        beginTest ("EBU Tech 3342 - loudness range");
+
+        const auto expectRange = [this] (float low, float high, float expectedRange)
+        {
+            const auto results = measure (createProgramme ({ { low, 20.0 }, { high, 20.0 } }));
+            expectWithinAbsoluteError (results.range, expectedRange, 1.0f);
+        };
+
+        expectRange (-20.0f, -30.0f, 10.0f);
+        expectRange (-20.0f, -15.0f, 5.0f);
+        expectRange (-40.0f, -20.0f, 20.0f);
+    }
+
+    /** Splitting the programme up across threads should measure the same as going through it in one go. */
+    void runOfflineTests()
+    {
+        beginTest ("Offline analysis");
+
+        const auto programme = createProgramme ({ { -36.0f, 7.3 }, { -20.0f, 11.1 }, { -26.0f, 5.7 } });
+        const auto realtime = measure (programme);
+        const auto serial = LoudnessMeter::analyse (programme, sampleRate);
+
+        ThreadPool threadPool (4);
+        const auto parallel = LoudnessMeter::analyse (programme, sampleRate, &threadPool);
+
+        for (const auto& results : { serial, parallel })
+        {
+            expectWithinAbsoluteError (results.integrated, realtime.integrated, 0.01f);
+            expectWithinAbsoluteError (results.range, realtime.range, 0.1f);
+            expectWithinAbsoluteError (results.shortTerm, realtime.shortTerm, 0.01f);
+            expectWithinAbsoluteError (results.truePeak, realtime.truePeak, 0.01f);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,163 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class MeterBusUnitTests final : public UnitTest
+{
+public:
+    MeterBusUnitTests() :
+        UnitTest ("MeterBus", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runPublishingTests();
+        runClippingTests();
+        runConcurrencyTests();
+    }
+
+private:
+    //==============================================================================
+    void runPublishingTests()
+    {
+        beginTest ("Publishing and reading");
+
+        MeterBus bus (4);
+        expect (bus.getNumFramesPublished() == 0);
+
+        MeterBus::ChannelLevels frame[4];
+        expect (bus.read (frame, 4) == 0, "Nothing should be readable before the first frame.");
+
+        juce::AudioBuffer<float> buffer (6, 128);
+        for (int c = 0; c < buffer.getNumChannels(); ++c)
+            FloatVectorOperations::fill (buffer.getWritePointer (c), 0.1f * (float) (c + 1), buffer.getNumSamples());
+
+        bus.publish (buffer, 0, buffer.getNumSamples());
+        expect (bus.getNumFramesPublished() == 1);
+
+        expect (bus.read (frame, 4) == 4, "Channels past the maximum should have been dropped.");
+
+        for (int c = 0; c < 4; ++c)
+        {
+            expectWithinAbsoluteError (frame[c].peak, 0.1f * (float) (c + 1), 1.0e-6f);
+            expectWithinAbsoluteError (frame[c].rms, 0.1f * (float) (c + 1), 1.0e-6f);
+            expect (frame[c].gainReduction == 1.0f);
+            expect (! frame[c].clipped);
+        }
+
+        Array<float> levels;
+        bus.read (levels, MeterBus::Level::peak);
+        expect (levels.size() == 4);
+        expectWithinAbsoluteError (levels[3], 0.4f, 1.0e-6f);
+
+        expect (bus.read (frame, 2) == 2, "Readers should be able to ask for fewer channels.");
+
+        beginTest ("Reading wide buses");
+
+        MeterBus wideBus (AudioChannelSet::maxChannelsOfNamedLayout);
+        juce::AudioBuffer<float> wideBuffer (wideBus.getMaximumNumChannels(), 16);
+
+        for (int c = 0; c < wideBuffer.getNumChannels(); ++c)
+            FloatVectorOperations::fill (wideBuffer.getWritePointer (c), 0.001f * (float) (c + 1), wideBuffer.getNumSamples());
+
+        wideBus.publish (wideBuffer, 0, wideBuffer.getNumSamples());
+        wideBus.read (levels, MeterBus::Level::peak);
+
+        expect (levels.size() == wideBuffer.getNumChannels(), "Every channel of a wide bus should be read.");
+        expectWithinAbsoluteError (levels.getLast(), 0.001f * (float) wideBuffer.getNumChannels(), 1.0e-6f);
+
+        juce::AudioBuffer<float> stereo (2, 16);
+        stereo.clear();
+        wideBus.publish (stereo, 0, stereo.getNumSamples());
+        wideBus.read (levels, MeterBus::Level::peak);
+        expect (levels.size() == 2, "The array should follow the channel count that was last published.");
+    }
+
+    void runClippingTests()
+    {
+        beginTest ("Clip latching");
+
+        MeterBus bus (2);
+        MeterBus::ChannelLevels frame[2];
+
+        frame[0].peak = 1.5f;
+        frame[0].clipped = true;
+        bus.publish (frame, 2);
+
+        frame[0] = {};
+        bus.publish (frame, 2);
+
+        expect (bus.hasClipped (0), "A clip should stay latched until it's acknowledged.");
+        expect (! bus.hasClipped (1));
+
+        bus.resetClip (0);
+        expect (! bus.hasClipped (0));
+        expect (! bus.hasClipped (5));
+    }
+
+    /** Every frame has the same value in every field of every channel,
+        so any read that mixes up two frames shows up as a mismatch.
+    */
+    void runConcurrencyTests()
+    {
+        beginTest ("Readers never see partial frames");
+
+        constexpr int numChannels = 16;
+        MeterBus bus (numChannels);
+
+        std::atomic<bool> keepGoing { true };
+        std::atomic<int> numTornReads { 0 };
+        std::atomic<int> numReads { 0 };
+
+        std::vector<std::thread> readers;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            readers.emplace_back ([&]()
+            {
+                MeterBus::ChannelLevels frame[numChannels];
+
+                while (keepGoing.load())
+                {
+                    const auto num = bus.read (frame, numChannels);
+
+                    for (int c = 0; c < num; ++c)
+                    {
+                        const auto value = frame[0].peak;
+
+                        if (frame[c].peak != value || frame[c].rms != value
+                            || frame[c].truePeak != value || frame[c].gainReduction != value)
+                        {
+                            ++numTornReads;
+                        }
+                    }
+
+                    ++numReads;
+                }
+            });
+        }
+
+        MeterBus::ChannelLevels frame[numChannels];
+
+        for (int i = 1; i <= 100000; ++i)
+        {
+            for (auto& channel : frame)
+            {
+                const auto value = (float) i;
+                channel.peak = channel.rms = channel.truePeak = channel.gainReduction = value;
+            }
+
+            bus.publish (frame, numChannels);
+        }
+
+        keepGoing = false;
+
+        for (auto& reader : readers)
+            reader.join();
+
+        expect (numReads.load() > 0);
+        expect (numTornReads.load() == 0);
+        expect (bus.getNumFramesPublished() == 100000);
+    }
+};
+
+#endif
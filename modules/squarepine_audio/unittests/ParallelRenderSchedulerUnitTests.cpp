@@ -0,0 +1,140 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class ParallelRenderSchedulerUnitTests final : public UnitTest
+{
+public:
+    ParallelRenderSchedulerUnitTests() :
+        UnitTest ("ParallelRenderScheduler", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        for (int i = 0; i < numProcessors; ++i)
+            processors.add (new PolarityInversionProcessor (true));
+
+        const Array<AudioProcessor*> processorList (processors.begin(), processors.size());
+
+        for (const auto numWorkers : { 0, 1, 3 })
+        {
+            beginTest ("Rendering - " + String (numWorkers) + " worker(s)");
+
+            ParallelRenderScheduler scheduler (numWorkers);
+            expect (scheduler.getNumWorkerThreads() == numWorkers);
+
+            scheduler.setProcessors (processorList);
+            scheduler.prepareToPlay (44100.0, blockSize, 2);
+            expect (scheduler.getNumProcessors() == numProcessors);
+
+            for (int block = 0; block < 100; ++block)
+                renderAndCheck (scheduler, blockSize - (block % 3));
+        }
+
+        beginTest ("Headless rendering with a DummyAudioIODevice");
+
+        ParallelRenderScheduler scheduler (2);
+        scheduler.setProcessors (processorList);
+        scheduler.prepareToPlay (44100.0, blockSize, 2);
+
+        DeviceCallback callback (scheduler);
+
+        DummyAudioIODevice device (false, 2, 44100.0, blockSize);
+        device.open (2, 44100.0, blockSize);
+        device.start (&callback);
+        Thread::sleep (250);
+        device.stop();
+        device.close();
+
+        expect (callback.numBlocksRendered.load() > 0, "The device never rendered anything.");
+        expect (callback.numFailures.load() == 0, "The parallel render didn't match the expected output.");
+
+        for (int i = 0; i < numProcessors; ++i)
+            expect (scheduler.getLastRenderTimeSeconds (i) > 0.0);
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        numProcessors = 16,
+        blockSize = 64
+    };
+
+    OwnedArray<AudioProcessor> processors;
+
+    //==============================================================================
+    static float getInputValue (int processorIndex) noexcept
+    {
+        return 0.01f * (float) (processorIndex + 1);
+    }
+
+    /** @returns true if every processor inverted its input, and the mix is the sum of it all. */
+    static bool render (ParallelRenderScheduler& scheduler, juce::AudioBuffer<float>& mixBus, int numSamples)
+    {
+        for (int i = 0; i < scheduler.getNumProcessors(); ++i)
+        {
+            auto& buffer = scheduler.getBuffer (i);
+
+            for (int c = 0; c < buffer.getNumChannels(); ++c)
+                FloatVectorOperations::fill (buffer.getWritePointer (c), getInputValue (i), numSamples);
+        }
+
+        scheduler.process (numSamples);
+
+        mixBus.clear();
+        scheduler.mixInto (mixBus, numSamples);
+
+        auto expectedMix = 0.0f;
+
+        for (int i = 0; i < scheduler.getNumProcessors(); ++i)
+        {
+            const auto& buffer = scheduler.getBuffer (i);
+            expectedMix -= getInputValue (i);
+
+            if (! approximatelyEqual (buffer.getSample (0, numSamples - 1), -getInputValue (i)))
+                return false;
+        }
+
+        return std::abs (mixBus.getSample (1, numSamples - 1) - expectedMix) < 1.0e-5f;
+    }
+
+    void renderAndCheck (ParallelRenderScheduler& scheduler, int numSamples)
+    {
+        juce::AudioBuffer<float> mixBus (2, numSamples);
+        expect (render (scheduler, mixBus, numSamples));
+    }
+
+    //==============================================================================
+    class DeviceCallback final : public AudioIODeviceCallback
+    {
+    public:
+        DeviceCallback (ParallelRenderScheduler& s) :
+            scheduler (s)
+        {
+        }
+
+        void audioDeviceIOCallbackWithContext (const float* const*, int,
+                                               float* const* outputs, int numOutputs,
+                                               int numSamples, const AudioIODeviceCallbackContext&) override
+        {
+            juce::AudioBuffer<float> mixBus (outputs, numOutputs, numSamples);
+
+            if (! render (scheduler, mixBus, numSamples))
+                ++numFailures;
+
+            ++numBlocksRendered;
+        }
+
+        void audioDeviceAboutToStart (AudioIODevice*) override {}
+        void audioDeviceStopped() override {}
+
+        std::atomic<int> numBlocksRendered { 0 }, numFailures { 0 };
+
+    private:
+        ParallelRenderScheduler& scheduler;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DeviceCallback)
+    };
+};
+
+#endif
@@ -0,0 +1,132 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class ParameterSnapshotUnitTests final : public UnitTest
+{
+public:
+    ParameterSnapshotUnitTests() :
+        UnitTest ("ParameterSnapshot", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runAttachingTests();
+        runUpdatingTests();
+    }
+
+private:
+    //==============================================================================
+    class SnapshotProcessor final : public InternalProcessor
+    {
+    public:
+        SnapshotProcessor() :
+            InternalProcessor (false)
+        {
+            auto on = std::make_unique<AudioParameterBool> ("on", "On", false);
+            auto gain = std::make_unique<AudioParameterFloat> ("gain", "Gain", NormalisableRange<float> (0.0f, 10.0f), 1.0f);
+
+            onParam = on.get();
+            gainParam = gain.get();
+
+            AudioProcessorValueTreeState::ParameterLayout layout;
+            layout.add (std::move (on));
+            layout.add (std::move (gain));
+            apvts.reset (new AudioProcessorValueTreeState (*this, nullptr, "parameters", std::move (layout)));
+        }
+
+        const String getName() const override { return "Snapshot"; }
+        Identifier getIdentifier() const override { return "snapshot"; }
+
+        void processBlock (juce::AudioBuffer<float>&, MidiBuffer&) override
+        {
+            changes.clear();
+            updateParameterSnapshot();
+        }
+
+        void parameterSnapshotChanged (int parameterIndex, float newValue) override
+        {
+            changes.push_back ({ parameterIndex, newValue });
+        }
+
+        void setGain (float newGain)
+        {
+            gainParam->setValueNotifyingHost (gainParam->convertTo0to1 (newGain));
+        }
+
+        void process()
+        {
+            juce::AudioBuffer<float> buffer (2, 32);
+            MidiBuffer midi;
+            processBlock (buffer, midi);
+        }
+
+        using InternalProcessor::getParameterSnapshot;
+
+        AudioParameterBool* onParam = nullptr;
+        AudioParameterFloat* gainParam = nullptr;
+        std::vector<std::pair<int, float>> changes;
+    };
+
+    //==============================================================================
+    void runAttachingTests()
+    {
+        beginTest ("Attaching");
+
+        SnapshotProcessor processor;
+        processor.setGain (5.0f); // Nothing's listening yet, like when restoring a preset.
+
+        processor.prepareToPlay (44100.0, 32);
+
+        const auto& snapshot = processor.getParameterSnapshot();
+        expect (snapshot.size() == 2);
+        expectWithinAbsoluteError (snapshot.get (processor.gainParam), 5.0f, 1.0e-4f);
+        expect (! snapshot.getBool (processor.onParam));
+
+        processor.process();
+        expect (processor.changes.size() == 1, "Only the parameter moved away from its default should be reported.");
+
+        if (processor.changes.size() == 1)
+        {
+            expect (processor.changes.front().first == processor.gainParam->getParameterIndex());
+            expectWithinAbsoluteError (processor.changes.front().second, 5.0f, 1.0e-4f);
+        }
+
+        processor.prepareToPlay (44100.0, 32);
+        processor.process();
+        expect (processor.changes.empty(), "Preparing again shouldn't report anything.");
+    }
+
+    void runUpdatingTests()
+    {
+        beginTest ("Updating");
+
+        SnapshotProcessor processor;
+        processor.prepareToPlay (44100.0, 32);
+
+        processor.process();
+        expect (processor.changes.empty(), "Nothing changed, so nothing should be reported.");
+
+        processor.setGain (2.0f);
+        processor.setGain (7.5f);
+        expectWithinAbsoluteError (processor.getParameterSnapshot().get (processor.gainParam), 1.0f, 1.0e-4f,
+                                   "The snapshot shouldn't change until it's updated.");
+
+        processor.process();
+        expect (processor.changes.size() == 1, "Changing a parameter twice between blocks should only be reported once.");
+
+        if (processor.changes.size() == 1)
+            expectWithinAbsoluteError (processor.changes.front().second, 7.5f, 1.0e-4f);
+
+        expectWithinAbsoluteError (processor.getParameterSnapshot().get (processor.gainParam), 7.5f, 1.0e-4f);
+
+        *processor.onParam = true;
+        processor.process();
+        expect (processor.changes.size() == 1);
+        expect (processor.getParameterSnapshot().getBool (processor.onParam));
+
+        processor.process();
+        expect (processor.changes.empty());
+    }
+};
+
+#endif
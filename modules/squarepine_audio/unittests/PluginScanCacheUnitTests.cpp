@@ -0,0 +1,153 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class PluginScanCacheUnitTests final : public UnitTest
+{
+public:
+    PluginScanCacheUnitTests() :
+        UnitTest ("PluginScanCache", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runFingerprintTests();
+        runCachingTests();
+    }
+
+private:
+    //==============================================================================
+    static void writeContent (const File& file, size_t numBytes, uint8 value)
+    {
+        MemoryBlock content (numBytes);
+        content.fillWith (value);
+        file.replaceWithData (content.getData(), content.getSize());
+    }
+
+    static OwnedArray<PluginDescription> createDescriptions (const String& fileOrIdentifier, int numDescriptions)
+    {
+        OwnedArray<PluginDescription> descriptions;
+
+        for (int i = 0; i < numDescriptions; ++i)
+        {
+            auto* description = descriptions.add (new PluginDescription());
+            description->name = "Plugin " + String (i + 1);
+            description->pluginFormatName = "VST3";
+            description->fileOrIdentifier = fileOrIdentifier;
+            description->uniqueId = i + 1;
+        }
+
+        return descriptions;
+    }
+
+    //==============================================================================
+    void runFingerprintTests()
+    {
+        beginTest ("Fingerprints");
+
+        TemporaryFile plugin (".vst3");
+        const auto path = plugin.getFile().getFullPathName();
+
+        writeContent (plugin.getFile(), 300 * 1024, 1);
+        const auto original = PluginScanCache::Fingerprint::create (path);
+        expect (original.size == 300 * 1024);
+        expect (original == PluginScanCache::Fingerprint::create (path), "Nothing changed, so neither should the fingerprint.");
+
+        // The same size and modification time, but different content:
+        const auto modificationTime = plugin.getFile().getLastModificationTime();
+        writeContent (plugin.getFile(), 300 * 1024, 2);
+        plugin.getFile().setLastModificationTime (modificationTime);
+        expect (original != PluginScanCache::Fingerprint::create (path), "The content hash should have caught the change.");
+
+        plugin.getFile().deleteFile();
+        expect (PluginScanCache::Fingerprint::create (path).size < 0);
+
+        const auto identifier = PluginScanCache::Fingerprint::create ("AudioUnit:Effects/aufx,abcd,EFGH");
+        expect (identifier == PluginScanCache::Fingerprint::create ("AudioUnit:Effects/aufx,abcd,EFGH"));
+        expect (identifier != PluginScanCache::Fingerprint::create ("AudioUnit:Effects/aufx,abcd,IJKL"));
+    }
+
+    void runCachingTests()
+    {
+        beginTest ("Caching");
+
+        TemporaryFile index (".index");
+        const auto fingerprint = PluginScanCache::Fingerprint::create ("First");
+        const auto otherFingerprint = PluginScanCache::Fingerprint::create ("Other");
+
+        {
+            PluginScanCache cache (index.getFile());
+            expect (cache.getNumEntries() == 0);
+
+            OwnedArray<PluginDescription> found;
+            expect (! cache.find ("VST3", "First", fingerprint, found));
+
+            cache.store ("VST3", "First", fingerprint, createDescriptions ("First", 2));
+            cache.store ("VST3", "Empty", otherFingerprint, {});
+            expect (cache.getNumEntries() == 2);
+
+            expect (cache.find ("VST3", "First", fingerprint, found));
+            expect (found.size() == 2);
+            expect (! cache.find ("VST3", "First", otherFingerprint, found), "A changed file shouldn't be found.");
+            expect (! cache.find ("AU", "First", fingerprint, found), "Formats should be kept apart.");
+
+            expect (cache.save());
+            expect (index.getFile().getSize() > 0);
+        }
+
+        beginTest ("Reopening");
+
+        {
+            PluginScanCache cache (index.getFile());
+            expect (cache.getNumEntries() == 2);
+
+            OwnedArray<PluginDescription> found;
+            expect (cache.find ("VST3", "First", fingerprint, found));
+            expect (found.size() == 2);
+
+            if (found.size() == 2)
+            {
+                expect (found[1]->name == "Plugin 2");
+                expect (found[1]->uniqueId == 2);
+            }
+
+            found.clear();
+            expect (cache.find ("VST3", "Empty", otherFingerprint, found), "Files without plugins should be cached too.");
+            expect (found.isEmpty());
+
+            // Anything new gets merged with what's in the index, replacing older entries:
+            cache.store ("VST3", "First", otherFingerprint, createDescriptions ("First", 1));
+            cache.store ("VST3", "Second", fingerprint, createDescriptions ("Second", 3));
+            expect (cache.getNumEntries() == 3);
+            expect (cache.save());
+        }
+
+        {
+            PluginScanCache cache (index.getFile());
+            expect (cache.getNumEntries() == 3);
+
+            OwnedArray<PluginDescription> found;
+            expect (! cache.find ("VST3", "First", fingerprint, found));
+            expect (cache.find ("VST3", "First", otherFingerprint, found));
+            expect (cache.find ("VST3", "Second", fingerprint, found));
+            expect (found.size() == 4);
+
+            cache.clear();
+            expect (cache.getNumEntries() == 0);
+            expect (cache.save());
+        }
+
+        expect (PluginScanCache (index.getFile()).getNumEntries() == 0);
+
+        beginTest ("Corrupted index");
+
+        index.getFile().replaceWithText ("This isn't an index!");
+
+        PluginScanCache cache (index.getFile());
+        expect (cache.getNumEntries() == 0, "An invalid index should leave the cache empty.");
+
+        cache.store ("VST3", "First", fingerprint, createDescriptions ("First", 1));
+        expect (cache.save(), "An invalid index should simply be replaced.");
+    }
+};
+
+#endif
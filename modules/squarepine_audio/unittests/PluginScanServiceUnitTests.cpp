@@ -0,0 +1,285 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class PluginScanServiceUnitTests final : public UnitTest
+{
+public:
+    PluginScanServiceUnitTests() :
+        UnitTest ("PluginScanService", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runFakeFormatTests();
+        runProtocolTests();
+        runServiceTests();
+        runMisbehavingWorkerTests (1);
+        runMisbehavingWorkerTests (3);
+    }
+
+private:
+    //==============================================================================
+    /** Stands in for a worker process: it scans the fake plugins in-process,
+        and plays dead for those that would crash or hang a real worker.
+    */
+    class FakeWorkerConnection final : public PluginScanService::WorkerConnection
+    {
+    public:
+        explicit FakeWorkerConnection (std::atomic<int>& launchCounter) :
+            numLaunches (launchCounter)
+        {
+        }
+
+        bool launch() override
+        {
+            ++numLaunches;
+            isAlive = true;
+            return true;
+        }
+
+        void kill() override
+        {
+            isAlive = false;
+        }
+
+        bool send (const MemoryBlock& message) override
+        {
+            int requestID = 0;
+            String formatName, fileOrIdentifier;
+
+            if (! isAlive || ! PluginScanProtocol::readScanRequest (message, requestID, formatName, fileOrIdentifier))
+                return false;
+
+            switch (FakePluginFormat::getBehaviourFromIdentifier (fileOrIdentifier))
+            {
+                case FakePluginFormat::Behaviour::crash:
+                    // This is all the service gets to see of a worker that died:
+                    isAlive = false;
+                    onConnectionLost();
+                break;
+
+                case FakePluginFormat::Behaviour::hang:
+                    // Never replying is what a hung worker looks like.
+                break;
+
+                default:
+                {
+                    OwnedArray<PluginDescription> found;
+                    format.findAllTypesForFile (found, fileOrIdentifier);
+                    onMessage (PluginScanProtocol::createScanResult (requestID, found));
+                }
+                break;
+            }
+
+            return true;
+        }
+
+    private:
+        std::atomic<int>& numLaunches;
+        FakePluginFormat format;
+        bool isAlive = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FakeWorkerConnection)
+    };
+
+    //==============================================================================
+    void runFakeFormatTests()
+    {
+        beginTest ("Fake plugin format");
+
+        const auto succeeding = FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::succeed, "Fake: Reverb");
+        const auto slow = FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::slow, "Slow", 100);
+        const auto failing = FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::fail, "Failing");
+
+        FakePluginFormat format ({ succeeding, slow, failing });
+        expect (format.searchPathsForPlugins ({}, true, false).size() == 3);
+
+        expect (FakePluginFormat::isFakeIdentifier (succeeding));
+        expect (! FakePluginFormat::isFakeIdentifier ("/Library/Audio/Plug-Ins/VST3/Real.vst3"));
+        expect (FakePluginFormat::getNameFromIdentifier (succeeding) == "Fake: Reverb", "Names should be able to contain the separator.");
+
+        OwnedArray<PluginDescription> found;
+        format.findAllTypesForFile (found, succeeding);
+        expect (found.size() == 1);
+
+        if (found.size() == 1)
+        {
+            expect (found.getFirst()->name == "Fake: Reverb");
+            expect (found.getFirst()->pluginFormatName == format.getName());
+            expect (found.getFirst()->fileOrIdentifier == succeeding);
+        }
+
+        const auto startTimeMs = Time::getMillisecondCounter();
+        format.findAllTypesForFile (found, slow);
+        expect (Time::getMillisecondCounter() - startTimeMs >= 90, "The slow plugin should have taken its time.");
+        expect (found.size() == 2);
+
+        format.findAllTypesForFile (found, failing);
+        expect (found.size() == 2, "Nothing should have been found for the failing plugin.");
+    }
+
+    void runProtocolTests()
+    {
+        beginTest ("Protocol");
+
+        {
+            int requestID = 0;
+            String formatName, fileOrIdentifier;
+
+            const auto request = PluginScanProtocol::createScanRequest (42, "VST3", "/Plug-Ins/Some Plugin.vst3");
+            expect (PluginScanProtocol::readScanRequest (request, requestID, formatName, fileOrIdentifier));
+            expect (requestID == 42);
+            expect (formatName == "VST3");
+            expect (fileOrIdentifier == "/Plug-Ins/Some Plugin.vst3");
+
+            OwnedArray<PluginDescription> found;
+            expect (! PluginScanProtocol::readScanResult (request, requestID, found), "A request isn't a result.");
+        }
+
+        FakePluginFormat format;
+        OwnedArray<PluginDescription> sent;
+        format.findAllTypesForFile (sent, FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::succeed, "First"));
+        format.findAllTypesForFile (sent, FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::succeed, "Second"));
+        sent.getLast()->isInstrument = true;
+        sent.getLast()->numInputChannels = 0;
+
+        const auto result = PluginScanProtocol::createScanResult (7, sent);
+
+        int requestID = 0;
+        OwnedArray<PluginDescription> received;
+        expect (PluginScanProtocol::readScanResult (result, requestID, received));
+        expect (requestID == 7);
+        expect (received.size() == sent.size());
+
+        for (int i = 0; i < jmin (sent.size(), received.size()); ++i)
+        {
+            const auto& a = *sent.getUnchecked (i);
+            const auto& b = *received.getUnchecked (i);
+
+            expect (a.isDuplicateOf (b));
+            expect (a.name == b.name && a.manufacturerName == b.manufacturerName && a.category == b.category);
+            expect (a.lastInfoUpdateTime == b.lastInfoUpdateTime);
+            expect (a.isInstrument == b.isInstrument);
+            expect (a.numInputChannels == b.numInputChannels && a.numOutputChannels == b.numOutputChannels);
+        }
+
+        MemoryBlock truncated (result);
+        truncated.setSize (truncated.getSize() - 3);
+
+        OwnedArray<PluginDescription> fromTruncated;
+        expect (! PluginScanProtocol::readScanResult (truncated, requestID, fromTruncated), "A truncated result should be rejected.");
+        expect (fromTruncated.isEmpty(), "Nothing should be added from a rejected result.");
+    }
+
+    void runServiceTests()
+    {
+        beginTest ("Blacklisting");
+
+        PluginScanService::Options options;
+        options.executable = File::getSpecialLocation (File::tempDirectory).getChildFile ("NoSuchScanWorker");
+        options.numWorkers = 2;
+
+        PluginScanService service (options);
+
+        const auto crashing = FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::crash, "Crashing");
+        service.setBlacklist ({ crashing });
+        expect (service.isBlacklisted (crashing));
+
+        OwnedArray<PluginDescription> found;
+        expect (service.scan ("Fake", crashing, found) == PluginScanService::Outcome::blacklisted);
+
+        beginTest ("Missing worker executable");
+
+        const auto succeeding = FakePluginFormat::createIdentifier (FakePluginFormat::Behaviour::succeed, "Succeeding");
+        expect (service.scan ("Fake", succeeding, found) == PluginScanService::Outcome::workerUnavailable);
+        expect (! service.isBlacklisted (succeeding), "A worker that can't start isn't the plugin's fault.");
+
+        CriticalSection outcomeLock;
+        StringArray outcomes;
+        service.scanAll ("Fake", { crashing, succeeding, succeeding }, found,
+                         [&] (const String&, PluginScanService::Outcome outcome)
+                         {
+                             const ScopedLock sl (outcomeLock);
+                             outcomes.add (String ((int) outcome));
+                         });
+
+        expect (outcomes.size() == 3, "Every plugin should have been reported.");
+        expect (found.isEmpty());
+
+        service.clearBlacklist();
+        expect (service.getBlacklist().isEmpty());
+    }
+
+    void runMisbehavingWorkerTests (int numWorkers)
+    {
+        beginTest ("Crashing and hanging workers - " + String (numWorkers) + " worker(s)");
+
+        using Behaviour = FakePluginFormat::Behaviour;
+        using Outcome = PluginScanService::Outcome;
+
+        std::atomic<int> numLaunches { 0 };
+
+        PluginScanService::Options options;
+        options.numWorkers = numWorkers;
+        options.scanTimeoutMs = 250;
+        options.createConnection = [&numLaunches] { return std::make_unique<FakeWorkerConnection> (numLaunches); };
+
+        PluginScanService service (options);
+
+        const auto first = FakePluginFormat::createIdentifier (Behaviour::succeed, "First");
+        const auto crashing = FakePluginFormat::createIdentifier (Behaviour::crash, "Crashing");
+        const auto second = FakePluginFormat::createIdentifier (Behaviour::succeed, "Second");
+        const auto hanging = FakePluginFormat::createIdentifier (Behaviour::hang, "Hanging");
+        const auto third = FakePluginFormat::createIdentifier (Behaviour::slow, "Third", 20);
+        const auto failing = FakePluginFormat::createIdentifier (Behaviour::fail, "Failing");
+
+        CriticalSection outcomeLock;
+        std::map<String, Outcome> outcomes;
+        OwnedArray<PluginDescription> found;
+
+        service.scanAll ("Fake", { first, crashing, second, hanging, third, failing }, found,
+                         [&] (const String& fileOrIdentifier, Outcome outcome)
+                         {
+                             const ScopedLock sl (outcomeLock);
+                             outcomes[fileOrIdentifier] = outcome;
+                         });
+
+        expect (outcomes.size() == 6, "Every plugin should have been reported.");
+        expect (outcomes[crashing] == Outcome::crashed);
+        expect (outcomes[hanging] == Outcome::timedOut);
+
+        for (const auto& fileOrIdentifier : { first, second, third, failing })
+            expect (outcomes[fileOrIdentifier] == Outcome::scanned, FakePluginFormat::getNameFromIdentifier (fileOrIdentifier) + " should have been scanned.");
+
+        // The plugins after the crash and the hang should still have been found, in their original order:
+        expect (found.size() == 3);
+
+        if (found.size() == 3)
+        {
+            expect (found[0]->name == "First");
+            expect (found[1]->name == "Second");
+            expect (found[2]->name == "Third");
+        }
+
+        expect (service.isBlacklisted (crashing), "The plugin that crashed its worker should be blacklisted.");
+        expect (service.isBlacklisted (hanging), "The plugin that hung its worker should be blacklisted.");
+        expect (service.getBlacklist().size() == 2, "Nothing else should be blacklisted.");
+
+        // Each worker is started when it's first needed, and restarted after crashing or hanging
+        // if it's needed again; which, with a single worker, is always the case:
+        const auto numLaunchesAfterScan = numLaunches.load();
+        expect (numLaunchesAfterScan <= numWorkers + 2, "Too many worker launches: " + String (numLaunchesAfterScan));
+
+        if (numWorkers == 1)
+            expect (numLaunchesAfterScan == 3, "The worker should have been restarted after the crash and after the hang.");
+
+        found.clear();
+        expect (service.scan ("Fake", crashing, found) == Outcome::blacklisted);
+        expect (service.scan ("Fake", hanging, found) == Outcome::blacklisted);
+        expect (service.scan ("Fake", first, found) == Outcome::scanned, "The restarted worker should carry on scanning.");
+        expect (found.size() == 1);
+        expect (numLaunches.load() == numLaunchesAfterScan, "Skipping blacklisted plugins shouldn't restart anything.");
+    }
+};
+
+#endif
@@ -0,0 +1,146 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class PolyphaseOversamplerUnitTests final : public UnitTest
+{
+public:
+    PolyphaseOversamplerUnitTests() :
+        UnitTest ("PolyphaseOversampler", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runRoundTripTests<float>();
+        runRoundTripTests<double>();
+
+        {
+            BitCrusherProcessor bitCrusher;
+            runBitCrusherTests (bitCrusher, "Bit crusher");
+        }
+
+        {
+            djdawprocessor::BitCrusherProcessor bitCrusher;
+            runBitCrusherTests (bitCrusher, "DAW bit crusher");
+        }
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        numChannels = 5,    // Not a multiple of any SIMD width, so the last group is partly empty.
+        blockSize = 256,
+        numBlocks = 8,
+        numSettlingSamples = 512
+    };
+
+    //==============================================================================
+    /** Going up and straight back down should give back the input, delayed by exactly the reported latency. */
+    template<typename FloatType>
+    void runRoundTripTests()
+    {
+        using Oversampler = PolyphaseOversampler<FloatType>;
+
+        for (const auto phase : { Oversampler::Phase::linear, Oversampler::Phase::minimum })
+        {
+            for (const auto factor : { 1, 2, 4, 8 })
+            {
+                beginTest (String ("Round trip - ")
+                           + (std::is_same_v<FloatType, float> ? "float" : "double")
+                           + (phase == Oversampler::Phase::linear ? ", linear phase, " : ", minimum phase, ")
+                           + String (factor) + "x");
+
+                Oversampler oversampler (factor, phase);
+                oversampler.prepare (numChannels, blockSize);
+                expect (oversampler.getFactor() == factor);
+
+                const auto latency = oversampler.getLatencyInSamples();
+                if (factor == 1)
+                    expect (latency == 0.0);
+                else
+                    expect (latency > 0.0);
+
+                // Well within the passband of every stage, at 44.1 kHz.
+                const auto frequency = MathConstants<double>::twoPi * 441.0 / 44100.0;
+
+                juce::AudioBuffer<FloatType> buffer (numChannels, blockSize);
+                auto maxError = 0.0;
+                auto numCalls = 0;
+
+                for (int block = 0; block < numBlocks; ++block)
+                {
+                    const auto offset = block * blockSize;
+
+                    for (int c = 0; c < numChannels; ++c)
+                        for (int n = 0; n < blockSize; ++n)
+                            buffer.setSample (c, n, (FloatType) std::sin (frequency * (double) (offset + n)));
+
+                    oversampler.process (buffer, numChannels, blockSize, [&] (juce::AudioBuffer<FloatType>& oversampled)
+                    {
+                        expect (oversampled.getNumSamples() == blockSize * factor);
+                        ++numCalls;
+                    });
+
+                    for (int c = 0; c < numChannels; ++c)
+                    {
+                        for (int n = 0; n < blockSize; ++n)
+                        {
+                            const auto position = offset + n;
+
+                            if (position >= numSettlingSamples)
+                            {
+                                const auto expected = std::sin (frequency * ((double) position - latency));
+                                maxError = jmax (maxError, std::abs ((double) buffer.getSample (c, n) - expected));
+                            }
+                        }
+                    }
+                }
+
+                expect (numCalls == numBlocks);
+                expectLessThan (maxError, 1.0e-3);
+            }
+        }
+    }
+
+    /** At full depth, the crushers shouldn't touch the audio, nor add any latency. */
+    template<typename BitCrusherType>
+    void runBitCrusherTests (BitCrusherType& bitCrusher, const String& name)
+    {
+        beginTest (name + " - full depth");
+
+        bitCrusher.prepareToPlay (44100.0, blockSize);
+        expectEquals (bitCrusher.getLatencySamples(), 0);
+
+        juce::AudioBuffer<float> buffer (2, blockSize), original (2, blockSize);
+        MidiBuffer midiBuffer;
+        auto& random = getRandom();
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int c = 0; c < buffer.getNumChannels(); ++c)
+                for (int n = 0; n < blockSize; ++n)
+                    buffer.setSample (c, n, random.nextFloat() * 2.0f - 1.0f);
+
+            original.makeCopyOf (buffer, true);
+            bitCrusher.processBlock (buffer, midiBuffer);
+
+            for (int c = 0; c < buffer.getNumChannels(); ++c)
+                expect (std::memcmp (buffer.getReadPointer (c), original.getReadPointer (c), sizeof (float) * (size_t) blockSize) == 0,
+                        "The audio should pass through bit-exact.");
+        }
+
+        expectEquals (bitCrusher.getLatencySamples(), 0);
+
+        beginTest (name + " - crushing");
+
+        bitCrusher.setBitDepth (4.0f);
+        bitCrusher.processBlock (buffer, midiBuffer);
+        expect (bitCrusher.getLatencySamples() > 0, "The oversampler's latency should be reported while crushing.");
+
+        bitCrusher.setBitDepth (32.0f);
+        bitCrusher.processBlock (buffer, midiBuffer);
+        expectEquals (bitCrusher.getLatencySamples(), 0);
+    }
+};
+
+#endif
@@ -0,0 +1,23 @@
+//==============================================================================
+OwnedArray<UnitTest> SquarePineAudioUnitTestGatherer::createTests()
+{
+    OwnedArray<UnitTest> tests;
+
+   #if SQUAREPINE_COMPILE_UNIT_TESTS
+    tests.add (new BiquadBankUnitTests());
+    tests.add (new BlockLFOUnitTests());
+    tests.add (new EffectProcessorChainUnitTests());
+    tests.add (new InternalAudioPluginFormatUnitTests());
+    tests.add (new ParallelRenderSchedulerUnitTests());
+    tests.add (new PolyphaseOversamplerUnitTests());
+    tests.add (new TruePeakDetectorUnitTests());
+    tests.add (new LoudnessMeterUnitTests());
+    tests.add (new MeterBusUnitTests());
+    tests.add (new ParameterSnapshotUnitTests());
+    tests.add (new PluginScanCacheUnitTests());
+    tests.add (new PluginScanServiceUnitTests());
+    tests.add (new DummyAudioIODeviceUnitTests());
+   #endif
+
+    return tests;
+}
@@ -0,0 +1,16 @@
+//==============================================================================
+/** Assembles all unit tests for the SquarePine Audio module. */
+class SquarePineAudioUnitTestGatherer final : public UnitTestGatherer
+{
+public:
+    /** Constructor. */
+    SquarePineAudioUnitTestGatherer() = default;
+
+    //==============================================================================
+    /** @internal */
+    OwnedArray<UnitTest> createTests() override;
+
+private:
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SquarePineAudioUnitTestGatherer)
+};
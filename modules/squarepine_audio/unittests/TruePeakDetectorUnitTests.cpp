@@ -0,0 +1,269 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+class TruePeakDetectorUnitTests final : public UnitTest
+{
+public:
+    TruePeakDetectorUnitTests() :
+        UnitTest ("TruePeakDetector", UnitTestCategories::audioProcessors)
+    {
+    }
+
+    void runTest() override
+    {
+        runConformanceTests();
+        runReferenceTests();
+        runLatencyTests();
+        runMeterFeedTests();
+        runThroughputTests();
+    }
+
+private:
+    //==============================================================================
+    enum
+    {
+        numChannels = 5,
+        maximumBlockSize = 64,
+        numSamples = 4800
+    };
+
+    /** The sample by sample, one phase at a time, detector that this replaced. */
+    struct ReferenceDetector final
+    {
+        std::array<float, TruePeakDetector::numTapsPerPhase> history {};
+        int index = 0;
+
+        float process (float x)
+        {
+            // ITU-R BS.1770-4, Annex 2, Table 1
+            static constexpr float phases[TruePeakDetector::oversamplingFactor][TruePeakDetector::numTapsPerPhase] =
+            {
+                { -0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f,
+                   0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f },
+                { -0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f,
+                   0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f },
+                { -0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f,
+                   0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f },
+                { 0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f,
+                  0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f }
+            };
+
+            const auto size = (int) history.size();
+            history[(size_t) index] = x;
+
+            auto peak = 0.0f;
+
+            for (const auto& phase : phases)
+            {
+                auto y = 0.0f;
+
+                for (int i = 0; i < size; ++i)
+                    y += history[(size_t) ((index - i + size) % size)] * phase[i];
+
+                peak = jmax (peak, std::abs (y));
+            }
+
+            index = (index + 1) % size;
+            return peak;
+        }
+    };
+
+    //==============================================================================
+    /** The true-peak cases of EBU Tech 3341 (v3), table 2: 12 kHz sines at 48 kHz, with a peak
+        of -6 dBFS, and a phase that makes the samples miss the peak by more and more.
+        The meter must read -6.0 dBTP, within +0.2 and -0.4 dB.
+    */
+    void runConformanceTests()
+    {
+        struct ConformanceCase final
+        {
+            int number = 0;
+            double phaseDegrees = 0.0;
+        };
+
+        constexpr double sampleRate = 48000.0;
+        constexpr double frequency = 12000.0;
+        constexpr float expectedDecibels = -6.0f;
+        constexpr float maximumOverDecibels = 0.2f, maximumUnderDecibels = 0.4f;
+
+        const auto amplitude = Decibels::decibelsToGain (expectedDecibels);
+
+        for (const auto& testCase : { ConformanceCase { 15, 0.0 },
+                                      ConformanceCase { 16, 45.0 },
+                                      ConformanceCase { 17, 60.0 },
+                                      ConformanceCase { 18, 67.5 } })
+        {
+            beginTest ("EBU Tech 3341, case " + String (testCase.number));
+
+            TruePeakDetector detector;
+            detector.prepare (numChannels, maximumBlockSize);
+
+            juce::AudioBuffer<float> buffer (numChannels, numSamples);
+            const auto phase = degreesToRadians (testCase.phaseDegrees);
+
+            for (int c = 0; c < numChannels; ++c)
+                for (int n = 0; n < numSamples; ++n)
+                    buffer.setSample (c, n, amplitude * (float) std::sin (MathConstants<double>::twoPi * frequency * (double) n / sampleRate + phase));
+
+            // Skip the onset, where the filter is still ringing.
+            constexpr int numSettlingSamples = 480;
+            detector.analyse (buffer, 0, numSettlingSamples);
+            detector.analyse (buffer, numSettlingSamples, numSamples - numSettlingSamples);
+
+            for (int c = 0; c < numChannels; ++c)
+            {
+                const auto decibels = Decibels::gainToDecibels (detector.getBlockPeak (c));
+                expectGreaterOrEqual (decibels, expectedDecibels - maximumUnderDecibels);
+                expectLessOrEqual (decibels, expectedDecibels + maximumOverDecibels);
+            }
+        }
+    }
+
+    /** Feeds noise through both detectors, in blocks larger and smaller than the prepared size. */
+    void runReferenceTests()
+    {
+        beginTest ("Matches the sample by sample reference");
+
+        TruePeakDetector detector;
+        detector.prepare (numChannels, maximumBlockSize);
+
+        juce::AudioBuffer<float> buffer (numChannels, numSamples);
+        auto& random = getRandom();
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int n = 0; n < numSamples; ++n)
+                buffer.setSample (c, n, random.nextFloat() * 2.0f - 1.0f);
+
+        std::vector<ReferenceDetector> references ((size_t) numChannels);
+        std::vector<float> expectedFramePeaks ((size_t) numSamples, 0.0f), framePeaks ((size_t) numSamples, 0.0f);
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int n = 0; n < numSamples; ++n)
+                expectedFramePeaks[(size_t) n] = jmax (expectedFramePeaks[(size_t) n], references[(size_t) c].process (buffer.getSample (c, n)));
+
+        for (int start = 0, i = 0; start < numSamples; ++i)
+        {
+            const auto num = jmin (numSamples - start, i % 2 == 0 ? 100 : 7);
+            detector.analyse (buffer, start, num, framePeaks.data() + start);
+            start += num;
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+            expectWithinAbsoluteError (framePeaks[(size_t) n], expectedFramePeaks[(size_t) n], 1.0e-5f);
+    }
+
+    void runLatencyTests()
+    {
+        beginTest ("Latency compensation");
+
+        TruePeakDetector detector;
+        detector.prepare (numChannels, maximumBlockSize);
+
+        juce::AudioBuffer<float> buffer (numChannels, maximumBlockSize);
+        buffer.clear();
+
+        for (int c = 0; c < numChannels; ++c)
+            buffer.setSample (c, c, 1.0f);
+
+        std::vector<float> framePeaks ((size_t) maximumBlockSize, 0.0f);
+        detector.analyseAndDelay (buffer, 0, maximumBlockSize, framePeaks.data());
+
+        for (int c = 0; c < numChannels; ++c)
+            for (int n = 0; n < maximumBlockSize; ++n)
+                expect (buffer.getSample (c, n) == (n == c + TruePeakDetector::latencyInSamples ? 1.0f : 0.0f));
+
+        // The frame peaks should line up with the delayed impulses.
+        for (int c = 0; c < numChannels; ++c)
+            expectGreaterThan (framePeaks[(size_t) (c + TruePeakDetector::latencyInSamples)], 0.9f);
+    }
+
+    void runMeterFeedTests()
+    {
+        beginTest ("Meter feed");
+
+        TruePeakDetector detector;
+        detector.prepare (numChannels, maximumBlockSize);
+
+        juce::AudioBuffer<float> buffer (numChannels, maximumBlockSize);
+
+        for (const auto level : { 0.25f, 0.5f, 0.125f })
+        {
+            buffer.clear();
+
+            for (int c = 0; c < numChannels; ++c)
+                buffer.setSample (c, maximumBlockSize / 2, level);
+
+            detector.analyse (buffer, 0, maximumBlockSize);
+            expectGreaterThan (detector.getBlockPeak(), level * 0.9f);
+        }
+
+        // The feed holds on to the largest peak until it's read.
+        for (int c = 0; c < numChannels; ++c)
+        {
+            expectWithinAbsoluteError (detector.getPeak (c), 0.5f, 0.05f);
+            expectWithinAbsoluteError (detector.getAndResetPeak (c), 0.5f, 0.05f);
+            expect (detector.getPeak (c) == 0.0f);
+        }
+
+        expect (detector.getAndResetPeak (numChannels) == 0.0f, "Out of range channels should read as silent.");
+    }
+
+    /** Times both detectors over the same noise, so a regression in the block detector shows up in the log.
+        There's nothing to compare against across machines, so only the speedup is checked, and loosely.
+    */
+    void runThroughputTests()
+    {
+        beginTest ("Throughput");
+
+        constexpr double sampleRate = 48000.0;
+        constexpr int numThroughputChannels = 2, blockSize = 512, numBlocks = 1000;
+
+        TruePeakDetector detector;
+        detector.prepare (numThroughputChannels, blockSize);
+
+        juce::AudioBuffer<float> buffer (numThroughputChannels, blockSize);
+        auto& random = getRandom();
+
+        for (int c = 0; c < numThroughputChannels; ++c)
+            for (int n = 0; n < blockSize; ++n)
+                buffer.setSample (c, n, random.nextFloat() * 2.0f - 1.0f);
+
+        auto blockPeaks = 0.0f;
+        auto startTicks = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            detector.analyse (buffer, 0, blockSize);
+            blockPeaks += detector.getBlockPeak();
+        }
+
+        const auto blockSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+
+        std::vector<ReferenceDetector> references ((size_t) numThroughputChannels);
+        auto referencePeaks = 0.0f;
+        startTicks = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            auto peak = 0.0f;
+
+            for (int c = 0; c < numThroughputChannels; ++c)
+                for (int n = 0; n < blockSize; ++n)
+                    peak = jmax (peak, references[(size_t) c].process (buffer.getSample (c, n)));
+
+            referencePeaks += peak;
+        }
+
+        const auto referenceSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - startTicks);
+        const auto audioSeconds = (double) (numBlocks * blockSize) / sampleRate;
+
+        logMessage ("TruePeakDetector: " + String (audioSeconds / jmax (1.0e-9, blockSeconds), 1) + "x realtime, "
+                    + "reference: " + String (audioSeconds / jmax (1.0e-9, referenceSeconds), 1) + "x realtime, "
+                    + "for " + String (numThroughputChannels) + " channels");
+
+        // Both should have found the same peaks, which also keeps the loops from being optimised away.
+        expectWithinAbsoluteError (blockPeaks, referencePeaks, (float) numBlocks * 1.0e-4f);
+        expectLessOrEqual (blockSeconds, referenceSeconds * 2.0, "The block detector shouldn't be much slower than the reference.");
+    }
+};
+
+#endif
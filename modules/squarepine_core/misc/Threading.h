@@ -102,56 +102,209 @@ inline void callInBackground (std::function<void (void)> function)
 }
 
 //==============================================================================
-/** Runs a for-loop that is split between each available core,
-    as provided by the thread pool.
+/** The size of a cache line on pretty much any CPU these days, in bytes. */
+static constexpr int cacheLineSizeBytes = 64;
+
+/** Splits a range into contiguous chunks, and runs the chunks on the provided thread pool,
+    with the calling thread pitching in as well.
+
+    The chunks are handed out dynamically: each thread keeps grabbing the next
+    unclaimed chunk until there are none left, so threads that finish early
+    take on more of the work when the iterations don't all cost the same.
+
+    The body is passed along as-is (ie: not wrapped in a std::function),
+    so the compiler gets to inline it.
+
+    @param start        The first index of the range.
+    @param end          One past the last index of the range.
+    @param threadPool   The pool to run on. If this is null, the whole range
+                        is run as a single chunk on the calling thread.
+    @param body         A callable with the signature (Type chunkStart, Type chunkEnd).
+    @param grainSize    The number of indices per chunk. If this is 0 or less, the range
+                        is split into a few chunks per thread.
+    @param alignment    Chunk boundaries get rounded to multiples of this, relative to the start.
+                        For example; you can pass cacheLineSizeBytes / sizeof (element)
+                        to keep threads from writing to the same cache lines.
+
+    @see parallelFor, parallelForTiles
+*/
+template<typename Type, typename Function>
+inline void parallelForChunks (Type start, Type end, ThreadPool* threadPool, Function&& body,
+                               Type grainSize = 0, Type alignment = 1)
+{
+    static_assert (std::is_integral_v<Type>, "The range must be made of integers!");
+
+    if (end <= start)
+        return;
+
+    const auto numThreads = threadPool != nullptr ? threadPool->getNumThreads() : 0;
+    const auto length = end - start;
+
+    if (numThreads <= 0)
+    {
+        body (start, end);
+        return;
+    }
+
+    // A few chunks per thread is enough to even out the load without the chunks becoming tiny:
+    constexpr Type chunksPerThread = 4;
+
+    if (grainSize <= 0)
+        grainSize = jmax ((Type) 1, (Type) (length / (Type) ((numThreads + 1) * chunksPerThread)));
+
+    alignment = jmax ((Type) 1, alignment);
+    grainSize = ((grainSize + alignment - 1) / alignment) * alignment;
+
+    const auto numChunks = (int64) ((length + grainSize - 1) / grainSize);
+
+    if (numChunks <= 1)
+    {
+        body (start, end);
+        return;
+    }
+
+    std::atomic<int64> nextChunk { 0 };
+
+    const auto runChunks = [&]()
+    {
+        for (;;)
+        {
+            const auto chunk = nextChunk.fetch_add (1);
+            if (chunk >= numChunks)
+                break;
+
+            const auto chunkStart = (Type) (start + (Type) chunk * grainSize);
+            const auto chunkEnd = (Type) jmin (end, (Type) (chunkStart + grainSize));
+            body (chunkStart, chunkEnd);
+        }
+    };
+
+    const auto numHelpers = (int) jmin ((int64) numThreads, numChunks - 1);
+
+    WaitableEvent finished;
+    std::atomic<int> helpersRunning { numHelpers };
+
+    for (int i = 0; i < numHelpers; ++i)
+    {
+        threadPool->addJob ([&]()
+        {
+            runChunks();
+
+            if (--helpersRunning == 0)
+                finished.signal();
+        });
+    }
+
+    runChunks();
+
+    // N.B.: Helpers that haven't even started yet still reference this stack frame.
+    finished.wait();
+}
 
-    If no thread pool is provided, this will retain the
-    for-loop by performing it as per the usual.
+/** Runs a for-loop whose iterations are split into contiguous chunks,
+    between each thread of the provided thread pool and the calling thread.
+
+    If no thread pool is provided, this will retain the for-loop
+    by performing it as per the usual.
 
     So, this means:
     @code
-        for (int i = 0; i < 10; ++i)
+        for (int y = 0; y < height; ++y)
     @endcode
 
     becomes
 
     @code
-        multithreadedFor<int> (0, 10, 1, threadPool, [&] (int i) {});
+        parallelFor (0, height, threadPool, [&] (int y) {});
     @endcode
 
     @note Make sure each iteration of the loop is independant!
+
+    @see parallelForChunks, parallelForTiles
 */
-template<typename Type>
-inline void multithreadedFor (Type start, Type end, Type interval, ThreadPool* threadPool, std::function<void (Type)> callback)
+template<typename Type, typename Function>
+inline void parallelFor (Type start, Type end, ThreadPool* threadPool, Function&& body, Type grainSize = 0)
 {
-    if (threadPool == nullptr)
+    parallelForChunks (start, end, threadPool, [&] (Type chunkStart, Type chunkEnd)
     {
-        for (int i = start; i < end; i += interval)
-            callback (i);
+        for (auto i = chunkStart; i < chunkEnd; ++i)
+            body (i);
+    },
+    grainSize);
+}
 
+/** Splits an area into tiles, and runs the tiles on the provided thread pool
+    with the calling thread pitching in as well, handing them out dynamically.
+
+    This is meant for 2D work where neighbouring pixels in both directions
+    are read (eg: blurs), or where the cost of a pixel varies wildly across
+    the image, so that each thread stays within a cache-friendly region.
+
+    @param area         The area to split up.
+    @param tileWidth    The width of each tile, which is rounded up so that the rows of
+                        a tile start on a cache line boundary (assuming 4 bytes per pixel).
+    @param tileHeight   The height of each tile.
+    @param threadPool   The pool to run on. If this is null, the whole area
+                        is run as a single tile on the calling thread.
+    @param body         A callable with the signature (juce::Rectangle<int> tile).
+
+    @see parallelForChunks
+*/
+template<typename Function>
+inline void parallelForTiles (juce::Rectangle<int> area, int tileWidth, int tileHeight,
+                              ThreadPool* threadPool, Function&& body)
+{
+    if (area.isEmpty())
         return;
-    }
 
-    const auto num = threadPool->getNumThreads();
+    constexpr auto pixelsPerCacheLine = cacheLineSizeBytes / 4;
+    tileWidth = jmax (1, (tileWidth + pixelsPerCacheLine - 1) / pixelsPerCacheLine) * pixelsPerCacheLine;
+    tileHeight = jmax (1, tileHeight);
 
-    WaitableEvent wait;
-    std::atomic<int> threadsRunning (num);
+    const auto numColumns = (area.getWidth() + tileWidth - 1) / tileWidth;
+    const auto numRows = (area.getHeight() + tileHeight - 1) / tileHeight;
 
-    for (int i = 0; i < num; ++i)
+    parallelForChunks (0, numColumns * numRows, threadPool, [&] (int first, int last)
     {
-        threadPool->addJob
-        ([&]()
+        for (int i = first; i < last; ++i)
         {
-            for (int j = start + interval * i; j < end; j += interval * num)
-                callback (j);
+            const auto x = area.getX() + (i % numColumns) * tileWidth;
+            const auto y = area.getY() + (i / numColumns) * tileHeight;
 
-            const auto stillRunning = --threadsRunning;
-            if (stillRunning == 0)
-                wait.signal();
-        });
-    }
+            body (juce::Rectangle<int> (x, y, tileWidth, tileHeight).getIntersection (area));
+        }
+    },
+    1);
+}
 
-    wait.wait();
+/** Runs a for-loop that is split between each available core,
+    as provided by the thread pool.
+
+    This is a shorthand for parallelFor() for loops with an interval,
+    so it has the same contiguous chunking.
+
+    @code
+        multithreadedFor<int> (0, 10, 1, threadPool, [&] (int i) {});
+    @endcode
+
+    @note Make sure each iteration of the loop is independant!
+
+    @see parallelFor
+*/
+template<typename Type, typename Function>
+inline void multithreadedFor (Type start, Type end, Type interval, ThreadPool* threadPool, Function&& callback)
+{
+    jassert (interval > 0);
+
+    if (end <= start || interval <= 0)
+        return;
+
+    const auto numIterations = (end - start + interval - 1) / interval;
+
+    parallelFor ((Type) 0, numIterations, threadPool, [&] (Type i)
+    {
+        callback (start + i * interval);
+    });
 }
 
 //==============================================================================
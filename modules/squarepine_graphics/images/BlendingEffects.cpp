@@ -19,7 +19,7 @@ void applyBlend (Image& dest, const Image& source, float alpha, Point<int> posit
     Image::BitmapData srcData (source, Image::BitmapData::readOnly),
                       dstData (dest, Image::BitmapData::readWrite);
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    parallelFor (0, h, threadPool, [&] (int y)
     {
         auto* lineSource = srcData.getLinePointer (cropY + y);
         auto* lineDest = dstData.getLinePointer (rcOverlap.getY() + y);
@@ -118,108 +118,137 @@ void applyBlend (Image& dest, const Image& source, BlendMode mode, float alpha,
     }
 }
 
-template<class PixelType, uint8 (*blendFunc) (uint8, uint8)>
-void applyBlend (Image& dest, Colour c, ThreadPool* threadPool)
+//==============================================================================
+using ChannelBlendFunction = uint8 (*) (uint8, uint8);
+
+inline ChannelBlendFunction getChannelBlendFunction (BlendMode mode)
 {
-    const auto w = dest.getWidth();
-    const auto h = dest.getHeight();
+    switch (mode)
+    {
+        case BlendMode::normal:         return channelBlendNormal<uint8>;
+        case BlendMode::lighten:        return channelBlendLighten<uint8>;
+        case BlendMode::darken:         return channelBlendDarken<uint8>;
+        case BlendMode::multiply:       return channelBlendMultiply<uint8>;
+        case BlendMode::average:        return channelBlendAverage<uint8>;
+        case BlendMode::add:            return channelBlendAdd<uint8>;
+        case BlendMode::subtract:       return channelBlendSubtract<uint8>;
+        case BlendMode::difference:     return channelBlendDifference<uint8>;
+        case BlendMode::negation:       return channelBlendNegation<uint8>;
+        case BlendMode::screen:         return channelBlendScreen<uint8>;
+        case BlendMode::exclusion:      return channelBlendExclusion<uint8>;
+        case BlendMode::overlay:        return channelBlendOverlay<uint8>;
+        case BlendMode::softLight:      return channelBlendSoftLight<uint8>;
+        case BlendMode::hardLight:      return channelBlendHardLight<uint8>;
+        case BlendMode::colorDodge:     return channelBlendColorDodge<uint8>;
+        case BlendMode::colorBurn:      return channelBlendColorBurn<uint8>;
+        case BlendMode::linearDodge:    return channelBlendLinearDodge<uint8>;
+        case BlendMode::linearBurn:     return channelBlendLinearBurn<uint8>;
+        case BlendMode::linearLight:    return channelBlendLinearLight<uint8>;
+        case BlendMode::vividLight:     return channelBlendVividLight<uint8>;
+        case BlendMode::pinLight:       return channelBlendPinLight<uint8>;
+        case BlendMode::hardMix:        return channelBlendHardMix<uint8>;
+        case BlendMode::reflect:        return channelBlendReflect<uint8>;
+        case BlendMode::glow:           return channelBlendGlow<uint8>;
+        case BlendMode::phoenix:        return channelBlendPhoenix<uint8>;
 
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+        default:
+            jassertfalse;
+        break;
+    }
 
-    Image::BitmapData dstData (dest, Image::BitmapData::readWrite);
+    return channelBlendNormal<uint8>;
+}
 
-    const auto ar = c.getRed();
-    const auto ag = c.getGreen();
-    const auto ab = c.getBlue();
-    const auto aa = c.getAlpha();
+/** Blends a solid colour onto each pixel.
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    Seeing as one side of the blend is constant, the blend function
+    is looked up per channel instead of being called for every pixel.
+
+    @see forEachPixel, ImageEffectsPipeline
+*/
+struct ColourBlendKernel final
+{
+    ColourBlendKernel (BlendMode mode, Colour c) :
+        srcAlpha (c.getAlpha() / 255.0f)
     {
-        auto* lineDest = dstData.getLinePointer (y);
+        const auto blendFunc = getChannelBlendFunction (mode);
 
-        for (int x = 0; x < w; x++)
+        for (int i = 0; i < 256; ++i)
         {
-            auto* bc = (PixelType*) lineDest;
+            red[(size_t) i] = blendFunc (c.getRed(), (uint8) i);
+            green[(size_t) i] = blendFunc (c.getGreen(), (uint8) i);
+            blue[(size_t) i] = blendFunc (c.getBlue(), (uint8) i);
+        }
+    }
 
-            auto br = bc->getRed();
-            auto bg = bc->getGreen();
-            auto bb = bc->getBlue();
-            auto ba = bc->getAlpha();
+    template<class PixelType>
+    void process (uint8* p, int, int) const noexcept
+    {
+        auto* bc = (PixelType*) p;
 
-            if (ba == 255)
-            {
-                const auto pixelAlpha = aa / 255.0f;
+        auto br = bc->getRed();
+        auto bg = bc->getGreen();
+        auto bb = bc->getBlue();
+        auto ba = bc->getAlpha();
 
-                br = channelBlendAlpha (blendFunc (ar, br), br, pixelAlpha);
-                bg = channelBlendAlpha (blendFunc (ag, bg), bg, pixelAlpha);
-                bb = channelBlendAlpha (blendFunc (ab, bb), bb, pixelAlpha);
+        if (ba == 255)
+        {
+            br = channelBlendAlpha (red[br], br, srcAlpha);
+            bg = channelBlendAlpha (green[bg], bg, srcAlpha);
+            bb = channelBlendAlpha (blue[bb], bb, srcAlpha);
+        }
+        else
+        {
+            const auto dstAlpha = ba / 255.0f;
+            const auto outAlpha = srcAlpha + dstAlpha * (1.0f - srcAlpha);
+
+            if (outAlpha == 0.0)
+            {
+                br = 0;
+                bg = 0;
+                bb = 0;
             }
             else
             {
-                const auto srcAlpha = aa / 255.0f;
-                const auto dstAlpha = ba / 255.0f;
-                const auto outAlpha = srcAlpha + dstAlpha * (1.0f - srcAlpha);
+                auto r = red[br];
+                auto g = green[bg];
+                auto b = blue[bb];
 
-                if (outAlpha == 0.0)
-                {
-                    br = 0;
-                    bg = 0;
-                    bb = 0;
-                }
-                else
-                {
-                    auto r = blendFunc (ar, br);
-                    auto g = blendFunc (ag, bg);
-                    auto b = blendFunc (ab, bb);
-
-                    br = uint8 ((r * srcAlpha + br * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
-                    bg = uint8 ((g * srcAlpha + bg * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
-                    bb = uint8 ((b * srcAlpha + bb * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
-                }
+                br = uint8 ((r * srcAlpha + br * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
+                bg = uint8 ((g * srcAlpha + bg * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
+                bb = uint8 ((b * srcAlpha + bb * dstAlpha * (1.0f - srcAlpha)) / outAlpha);
             }
+        }
 
-            bc->setARGB (ba, br, bg, bb);
+        bc->setARGB (ba, br, bg, bb);
+    }
 
-            lineDest += dstData.pixelStride;
-        }
-    });
-}
+    std::array<uint8, 256> red, green, blue;
+    float srcAlpha = 1.0f;
+};
 
-template<class Type>
+template<class PixelType>
 void applyBlend (Image& dest, BlendMode mode, Colour c, ThreadPool* threadPool)
 {
-    switch (mode)
+    const auto w = dest.getWidth();
+    const auto h = dest.getHeight();
+
+    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+
+    Image::BitmapData dstData (dest, Image::BitmapData::readWrite);
+
+    const ColourBlendKernel kernel (mode, c);
+
+    parallelFor (0, h, threadPool, [&] (int y)
     {
-        case BlendMode::normal:         applyBlend<Type, channelBlendNormal<uint8>> (dest, c, threadPool); break;
-        case BlendMode::lighten:        applyBlend<Type, channelBlendLighten> (dest, c, threadPool); break;
-        case BlendMode::darken:         applyBlend<Type, channelBlendDarken> (dest, c, threadPool); break;
-        case BlendMode::multiply:       applyBlend<Type, channelBlendMultiply> (dest, c, threadPool); break;
-        case BlendMode::average:        applyBlend<Type, channelBlendAverage> (dest, c, threadPool); break;
-        case BlendMode::add:            applyBlend<Type, channelBlendAdd> (dest, c, threadPool); break;
-        case BlendMode::subtract:       applyBlend<Type, channelBlendSubtract> (dest, c, threadPool); break;
-        case BlendMode::difference:     applyBlend<Type, channelBlendDifference> (dest, c, threadPool); break;
-        case BlendMode::negation:       applyBlend<Type, channelBlendNegation> (dest, c, threadPool); break;
-        case BlendMode::screen:         applyBlend<Type, channelBlendScreen> (dest, c, threadPool); break;
-        case BlendMode::exclusion:      applyBlend<Type, channelBlendExclusion> (dest, c, threadPool); break;
-        case BlendMode::overlay:        applyBlend<Type, channelBlendOverlay> (dest, c, threadPool); break;
-        case BlendMode::softLight:      applyBlend<Type, channelBlendSoftLight> (dest, c, threadPool); break;
-        case BlendMode::hardLight:      applyBlend<Type, channelBlendHardLight> (dest, c, threadPool); break;
-        case BlendMode::colorDodge:     applyBlend<Type, channelBlendColorDodge> (dest, c, threadPool); break;
-        case BlendMode::colorBurn:      applyBlend<Type, channelBlendColorBurn> (dest, c, threadPool); break;
-        case BlendMode::linearDodge:    applyBlend<Type, channelBlendLinearDodge> (dest, c, threadPool); break;
-        case BlendMode::linearBurn:     applyBlend<Type, channelBlendLinearBurn> (dest, c, threadPool); break;
-        case BlendMode::linearLight:    applyBlend<Type, channelBlendLinearLight> (dest, c, threadPool); break;
-        case BlendMode::vividLight:     applyBlend<Type, channelBlendVividLight> (dest, c, threadPool); break;
-        case BlendMode::pinLight:       applyBlend<Type, channelBlendPinLight> (dest, c, threadPool); break;
-        case BlendMode::hardMix:        applyBlend<Type, channelBlendHardMix> (dest, c, threadPool); break;
-        case BlendMode::reflect:        applyBlend<Type, channelBlendReflect> (dest, c, threadPool); break;
-        case BlendMode::glow:           applyBlend<Type, channelBlendGlow> (dest, c, threadPool); break;
-        case BlendMode::phoenix:        applyBlend<Type, channelBlendPhoenix> (dest, c, threadPool); break;
+        auto* lineDest = dstData.getLinePointer (y);
 
-        default:
-            jassertfalse;
-        break;
-    }
+        for (int x = 0; x < w; x++)
+        {
+            kernel.process<PixelType> (lineDest, x, y);
+            lineDest += dstData.pixelStride;
+        }
+    });
 }
 
 void applyBlend (Image& dest, const Image& source, BlendMode mode, float alpha, Point<int> position, ThreadPool* threadPool)
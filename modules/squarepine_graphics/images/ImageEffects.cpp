@@ -17,6 +17,9 @@ inline uint8_t computeAlpha (uint8_t la, uint8_t ra)
     return (uint8_t) (((la * (256 - (ra + (ra >> 7)))) >> 8) + ra);
 }
 
+/** The size of the tiles, in pixels, that the effects reading neighbouring pixels get split into. */
+constexpr int tileSize = 64;
+
 //==============================================================================
 template<class PixelType>
 PixelType blend (const PixelType& c1, const PixelType& c2)
@@ -42,582 +45,601 @@ inline ResultType convert (const ValueType& in)
 }
 
 //==============================================================================
-template<class Type>
-void applyVignette (Image& img, float amountIn, float radiusIn, float fallOff, ThreadPool* threadPool)
-{
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+/** A lookup table that maps every possible 8-bit channel value to a new one. */
+using ChannelCurve = std::array<uint8, 256>;
 
-    double outA = w * 0.5 * radiusIn;
-    double outB = h * 0.5 * radiusIn;
-    auto inA = outA * fallOff;
-    auto inB = outB * fallOff;
-    auto cx = w * 0.5;
-    auto cy = h * 0.5;
-    auto amount = 1.0 - amountIn;
-
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
-
-    Ellipse<double> outE { outA, outB }, inE { inA, inB };
-
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
-    {
-        auto* p = data.getLinePointer (y);
-
-        auto dy = y - cy;
-
-        for (int x = 0; x < w; x++)
-        {
-            const auto dx = x - cx;
+template<typename ValueType, typename Function>
+std::array<ValueType, 256> createLookupTable (Function&& function)
+{
+    std::array<ValueType, 256> table;
 
-            const bool outside = outE.isPointOutside ({ dx, dy });
-            const bool inside = inE.isPointInside ({ dx, dy });
+    for (size_t i = 0; i < table.size(); ++i)
+        table[i] = static_cast<ValueType> (function ((uint8) i));
 
-            auto* s = (Type*) p;
+    return table;
+}
 
-            if (outside)
-            {
-                const auto r = toByte (0.5 + (s->getRed() * amount));
-                const auto g = toByte (0.5 + (s->getGreen() * amount));
-                const auto b = toByte (0.5 + (s->getBlue() * amount));
-                const auto a = s->getAlpha();
+/** Runs a pixel kernel over every pixel of an image.
 
-                s->setARGB (a, r, g, b);
-            }
-            else if (! inside)
-            {
-                const auto angle = std::atan2 (dy, dx);
-                const auto p1 = outE.getPointAtAngle (angle);
-                const auto p2 = inE.getPointAtAngle (angle);
-                const auto l1 = Line<double> ({ dx, dy }, p2);
-                const auto l2 = Line<double> (p1, p2);
-                const auto factor = 1.0 - (amountIn * jlimit (0.0, 1.0, l1.getLength() / l2.getLength()));
-
-                const auto r = toByte (0.5 + (s->getRed() * factor));
-                const auto g = toByte (0.5 + (s->getGreen() * factor));
-                const auto b = toByte (0.5 + (s->getBlue() * factor));
-                const auto a = s->getAlpha();
-
-                s->setARGB (a, r, g, b);
-            }
+    A pixel kernel is any object with a member function of the form:
+    @code
+        template<class T>
+        void process (uint8* pixel, int x, int y) const noexcept;
+    @endcode
 
-            p += data.pixelStride;
-        }
-    });
-}
-
-//==============================================================================
-template<class T>
-void applySepia (Image& img, ThreadPool* threadPool)
+    The kernels work on the raw bytes (ie: through T::indexR and friends),
+    which skips the accessors and lets the compiler keep things in registers.
+    The same kernels are chained together by ImageEffectsPipeline.
+*/
+template<class T, typename Kernel>
+void forEachPixel (Image& img, ThreadPool* threadPool, const Kernel& kernel)
 {
     const auto w = img.getWidth();
     const auto h = img.getHeight();
-
     threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
     Image::BitmapData data (img, Image::BitmapData::readWrite);
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    parallelFor (0, h, threadPool, [&] (int y)
     {
         auto* p = data.getLinePointer (y);
 
-        for (int x = 0; x < w; x++)
+        for (int x = 0; x < w; ++x)
         {
-            auto* s = (PixelARGB*) p;
-
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
-            auto ro = toByte ((r * .393) + (g * .769) + (b * .189));
-            auto go = toByte ((r * .349) + (g * .686) + (b * .168));
-            auto bo = toByte ((r * .272) + (g * .534) + (b * .131));
-
-            s->setARGB (a, ro, go, bo);
-
+            kernel.template process<T> (p, x, y);
             p += data.pixelStride;
         }
     });
 }
 
-template<class T>
-void applyGreyScale (Image& img, ThreadPool* threadPool)
+/** XORs a run of bytes with a repeating 4-byte pattern, 16 bytes at a time where the CPU allows it. */
+inline void xorBytes (uint8* data, int numBytes, uint32 pattern) noexcept
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+    int i = 0;
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+   #if SQUAREPINE_GRAPHICS_USE_SSE2
+    const auto mask = _mm_set1_epi32 ((int) pattern);
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    for (; i + 16 <= numBytes; i += 16)
     {
-        auto* p = data.getLinePointer (y);
-
-        for (int x = 0; x < w; x++)
-        {
-            auto* s = (T*) p;
-
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
-            auto ro = toByte (r * 0.30 + 0.5);
-            auto go = toByte (g * 0.59 + 0.5);
-            auto bo = toByte (b * 0.11 + 0.5);
+        auto* block = reinterpret_cast<__m128i*> (data + i);
+        _mm_storeu_si128 (block, _mm_xor_si128 (_mm_loadu_si128 (block), mask));
+    }
+   #elif SQUAREPINE_GRAPHICS_USE_NEON
+    const auto mask = vreinterpretq_u8_u32 (vdupq_n_u32 (pattern));
 
-            s->setARGB (a,
-                        toByte (ro + go + bo),
-                        toByte (ro + go + bo),
-                        toByte (ro + go + bo));
+    for (; i + 16 <= numBytes; i += 16)
+        vst1q_u8 (data + i, veorq_u8 (vld1q_u8 (data + i), mask));
+   #endif
 
-            p += data.pixelStride;
-        }
-    });
+    for (; i < numBytes; ++i)
+        data[i] ^= (uint8) (pattern >> (8 * (i % 4)));
 }
 
-template<class T>
-void applySoften (Image& img, ThreadPool* threadPool)
+//==============================================================================
+/** Remaps the red, green and blue channels of every pixel through the curves, leaving the alpha alone. */
+struct ChannelCurvesKernel final
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
-
-    Image dst (img.getFormat(), w, h, true);
-
-    Image::BitmapData srcData (img, Image::BitmapData::readOnly);
-    Image::BitmapData dstData (dst, Image::BitmapData::writeOnly);
+    ChannelCurve red, green, blue;
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
     {
-        for (int x = 0; x < w; x++)
-        {
-            int ro = 0, go = 0, bo = 0;
-            uint8_t a = 0;
-
-            for (int m = -1; m <= 1; m++)
-            {
-                for (int n = -1; n <= 1; n++)
-                {
-                    int cx = jlimit (0, w - 1, x + m);
-                    int cy = jlimit (0, h - 1, y + n);
-
-                    T* s = (T*) srcData.getPixelPointer (cx, cy);
+        p[T::indexR] = red[p[T::indexR]];
+        p[T::indexG] = green[p[T::indexG]];
+        p[T::indexB] = blue[p[T::indexB]];
+    }
+};
 
-                    ro += s->getRed();
-                    go += s->getGreen();
-                    bo += s->getBlue();
-                }
-            }
+inline ChannelCurvesKernel createGammaKernel (float gamma)
+{
+    const auto curve = createLookupTable<uint8> ([gamma] (uint8 v)
+    {
+        return toByte (std::pow (v / 255.0, gamma) * 255.0 + 0.5);
+    });
 
-            auto* s = (T*) srcData.getPixelPointer (x, y);
-            a = s->getAlpha();
+    return { curve, curve, curve };
+}
 
-            auto* d = (T*) dstData.getPixelPointer (x, y);
+inline ChannelCurvesKernel createContrastKernel (float contrast)
+{
+    contrast = (100.0f + contrast) / 100.0f;
+    contrast = square (contrast);
 
-            d->setARGB (a, toByte (ro / 9), toByte (go / 9), toByte (bo / 9));
-        }
+    const auto curve = createLookupTable<uint8> ([contrast] (uint8 v)
+    {
+        auto o = (double) v / 255.0;
+        o = o - 0.5;
+        o = o * contrast;
+        o = o + 0.5;
+        o = o * 255.0;
+        return toByte (o);
     });
-    img = dst;
+
+    return { curve, curve, curve };
 }
 
-template<class T>
-void applySharpen (Image& img, ThreadPool* threadPool)
+//==============================================================================
+struct VignetteKernel final
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
-
-    Image dst (img.getFormat(), w, h, true);
-
-    Image::BitmapData srcData (img, Image::BitmapData::readOnly);
-    Image::BitmapData dstData (dst, Image::BitmapData::writeOnly);
+    VignetteKernel() = default;
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    VignetteKernel (float amountToDarken, float radiusIn, float fallOff, int w, int h) :
+        amountIn (amountToDarken),
+        amount (1.0 - amountToDarken),
+        cx (w * 0.5),
+        cy (h * 0.5)
     {
-        for (int x = 0; x < w; x++)
-        {
-            auto getPixelPointer = [&] (int cx, int cy) -> T* {
-                cx = jlimit (0, w - 1, cx);
-                cy = jlimit (0, h - 1, cy);
+        const double outA = w * 0.5 * radiusIn;
+        const double outB = h * 0.5 * radiusIn;
 
-                return (T*) srcData.getPixelPointer (cx, cy);
-            };
+        outE = { outA, outB };
+        inE = { outA * fallOff, outB * fallOff };
+    }
 
-            int ro = 0, go = 0, bo = 0;
-            uint8 ao = 0;
+    template<class T>
+    void process (uint8* p, int x, int y) const noexcept
+    {
+        const auto dx = x - cx;
+        const auto dy = y - cy;
 
-            auto* s = getPixelPointer (x, y);
+        if (outE.isPointOutside ({ dx, dy }))
+        {
+            p[T::indexR] = toByte (0.5 + (p[T::indexR] * amount));
+            p[T::indexG] = toByte (0.5 + (p[T::indexG] * amount));
+            p[T::indexB] = toByte (0.5 + (p[T::indexB] * amount));
+        }
+        else if (! inE.isPointInside ({ dx, dy }))
+        {
+            const auto angle = std::atan2 (dy, dx);
+            const auto p1 = outE.getPointAtAngle (angle);
+            const auto p2 = inE.getPointAtAngle (angle);
+            const auto l1 = Line<double> ({ dx, dy }, p2);
+            const auto l2 = Line<double> (p1, p2);
+            const auto factor = 1.0 - (amountIn * jlimit (0.0, 1.0, l1.getLength() / l2.getLength()));
+
+            p[T::indexR] = toByte (0.5 + (p[T::indexR] * factor));
+            p[T::indexG] = toByte (0.5 + (p[T::indexG] * factor));
+            p[T::indexB] = toByte (0.5 + (p[T::indexB] * factor));
+        }
+    }
 
-            ro = s->getRed() * 5;
-            go = s->getGreen() * 5;
-            bo = s->getBlue() * 5;
-            ao = s->getAlpha();
+    float amountIn = 0.0f;
+    double amount = 1.0, cx = 0.0, cy = 0.0;
+    Ellipse<double> outE, inE;
+};
 
-            s = getPixelPointer (x, y - 1);
-            ro -= s->getRed();
-            go -= s->getGreen();
-            bo -= s->getBlue();
+//==============================================================================
+struct SepiaKernel final
+{
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
+    {
+        const auto r = p[T::indexR];
+        const auto g = p[T::indexG];
+        const auto b = p[T::indexB];
 
-            s = getPixelPointer (x - 1, y);
-            ro -= s->getRed();
-            go -= s->getGreen();
-            bo -= s->getBlue();
+        p[T::indexR] = toByte (redToRed[r] + greenToRed[g] + blueToRed[b]);
+        p[T::indexG] = toByte (redToGreen[r] + greenToGreen[g] + blueToGreen[b]);
+        p[T::indexB] = toByte (redToBlue[r] + greenToBlue[g] + blueToBlue[b]);
+    }
 
-            s = getPixelPointer (x + 1, y);
-            ro -= s->getRed();
-            go -= s->getGreen();
-            bo -= s->getBlue();
+    // The products are looked up rather than computed,
+    // but they're summed up exactly like they used to be.
+    std::array<double, 256> redToRed        = createLookupTable<double> ([] (uint8 v) { return v * .393; }),
+                            greenToRed      = createLookupTable<double> ([] (uint8 v) { return v * .769; }),
+                            blueToRed       = createLookupTable<double> ([] (uint8 v) { return v * .189; }),
+                            redToGreen      = createLookupTable<double> ([] (uint8 v) { return v * .349; }),
+                            greenToGreen    = createLookupTable<double> ([] (uint8 v) { return v * .686; }),
+                            blueToGreen     = createLookupTable<double> ([] (uint8 v) { return v * .168; }),
+                            redToBlue       = createLookupTable<double> ([] (uint8 v) { return v * .272; }),
+                            greenToBlue     = createLookupTable<double> ([] (uint8 v) { return v * .534; }),
+                            blueToBlue      = createLookupTable<double> ([] (uint8 v) { return v * .131; });
+};
+
+/** Looks up the weighted sum of the channels, as used by the grey scale and gradient map effects. */
+struct GreyLevelTables final
+{
+    int getGreyLevel (uint8 r, uint8 g, uint8 b) const noexcept
+    {
+        return redToGrey[r] + greenToGrey[g] + blueToGrey[b];
+    }
 
-            s = getPixelPointer (x, y + 1);
-            ro -= s->getRed();
-            go -= s->getGreen();
-            bo -= s->getBlue();
+    ChannelCurve redToGrey      = createLookupTable<uint8> ([] (uint8 v) { return toByte (v * 0.30 + 0.5); }),
+                 greenToGrey    = createLookupTable<uint8> ([] (uint8 v) { return toByte (v * 0.59 + 0.5); }),
+                 blueToGrey     = createLookupTable<uint8> ([] (uint8 v) { return toByte (v * 0.11 + 0.5); });
+};
 
-            auto* d = (T*) dstData.getPixelPointer (x, y);
+struct GreyScaleKernel final
+{
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
+    {
+        const auto grey = toByte (tables.getGreyLevel (p[T::indexR], p[T::indexG], p[T::indexB]));
 
-            d->setARGB (ao, toByte (ro), toByte (go), toByte (bo));
-        }
-    });
+        p[T::indexR] = grey;
+        p[T::indexG] = grey;
+        p[T::indexB] = grey;
+    }
 
-    img = dst;
-}
+    GreyLevelTables tables;
+};
 
-template<class T>
-void applyGamma (Image& img, float gamma, ThreadPool* threadPool)
+struct InvertKernel final
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
-
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
+    {
+        p[T::indexR] ^= 0xff;
+        p[T::indexG] ^= 0xff;
+        p[T::indexB] ^= 0xff;
+    }
+};
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+//==============================================================================
+struct BrightnessContrastKernel final
+{
+    BrightnessContrastKernel (float brightness, float contrast)
     {
-        auto* p = data.getLinePointer (y);
+        auto multiply = 1.0f;
+        auto divide = 1.0f;
 
-        for (int x = 0; x < w; x++)
+        if (contrast < 0.0f)
+        {
+            multiply = contrast + 100;
+            divide = 100.0f;
+        }
+        else if (contrast > 0.0f)
+        {
+            multiply = 100.0f;
+            divide = 100.0f - contrast;
+        }
+        else
         {
-            auto* s = (T*) p;
+            multiply = 1.0f;
+            divide = 1.0f;
+        }
 
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
-            auto ro = toByte (std::pow (r / 255.0, gamma) * 255.0 + 0.5);
-            auto go = toByte (std::pow (g / 255.0, gamma) * 255.0 + 0.5);
-            auto bo = toByte (std::pow (b / 255.0, gamma) * 255.0 + 0.5);
+        rgbTable.resize (65536);
 
-            s->setARGB (a, ro, go, bo);
+        if (divide == 0.0f)
+        {
+            isThreshold = true;
 
-            p += data.pixelStride;
+            for (int intensity = 0; intensity < 256; intensity++)
+            {
+                if ((float) intensity + brightness < 128.0f)
+                    rgbTable[intensity] = 0;
+                else
+                    rgbTable[intensity] = 255;
+            }
         }
-    });
-}
+        else if (divide == 100.0f)
+        {
+            for (int intensity = 0; intensity < 256; intensity++)
+            {
+                auto shift = int ((intensity - 127.0f) * multiply / divide + 127.0f - (float) intensity + brightness);
 
-template<class T>
-void applyInvert (Image& img, ThreadPool* threadPool)
-{
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+                for (int col = 0; col < 256; col++)
+                {
+                    auto index = (intensity * 256) + col;
+                    rgbTable[index] = toByte (col + shift);
+                }
+            }
+        }
+        else
+        {
+            for (int intensity = 0; intensity < 256; intensity++)
+            {
+                auto shift = int ((intensity - 127.0f + brightness) * multiply / divide + 127.0f - intensity);
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+                for (int col = 0; col < 256; col++)
+                {
+                    auto index = (intensity * 256) + col;
+                    rgbTable[index] = toByte (col + shift);
+                }
+            }
+        }
+    }
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
     {
-        auto* p = data.getLinePointer (y);
+        const auto intensity = getIntensity (p[T::indexR], p[T::indexG], p[T::indexB]);
 
-        for (int x = 0; x < w; x++)
+        if (isThreshold)
         {
-            auto* s = (T*) p;
+            const auto c = rgbTable[intensity];
 
-            const auto r = s->getRed();
-            const auto g = s->getGreen();
-            const auto b = s->getBlue();
-            const auto ro = 255 - r;
-            const auto go = 255 - g;
-            const auto bo = 255 - b;
-
-            s->setARGB ((uint8) s->getAlpha(), (uint8) ro, (uint8) go, (uint8) bo);
+            p[T::indexR] = c;
+            p[T::indexG] = c;
+            p[T::indexB] = c;
+        }
+        else
+        {
+            const auto* shifted = rgbTable.data() + intensity * 256;
 
-            p += data.pixelStride;
+            p[T::indexR] = shifted[p[T::indexR]];
+            p[T::indexG] = shifted[p[T::indexG]];
+            p[T::indexB] = shifted[p[T::indexB]];
         }
-    });
-}
+    }
+
+    std::vector<uint8_t> rgbTable;
+    bool isThreshold = false;
+};
 
 //==============================================================================
-template<class T>
-void applyContrast (Image& img, float contrast, ThreadPool* threadPool)
+struct HueSaturationLightnessKernel final
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
-
-    contrast = (100.0f + contrast) / 100.0f;
-    contrast = square (contrast);
+    HueSaturationLightnessKernel (float hue, float saturationIn, float lightnessIn) :
+        hueIn (hue / 360.0f),
+        lightness (lightnessIn)
+    {
+        if (saturationIn > 100)
+            saturationIn = ((saturationIn - 100) * 3) + 100;
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+        saturation = (saturationIn * 1024) / 100;
+    }
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
     {
-        auto* p = data.getLinePointer (y);
+        auto* s = (T*) p;
 
-        for (int x = 0; x < w; x++)
-        {
-            auto* s = (T*) p;
+        auto r = s->getRed();
+        auto g = s->getGreen();
+        auto b = s->getBlue();
+        auto a = s->getAlpha();
 
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
+        auto intensity = getIntensity (toByte (r), toByte (g), toByte (b));
+        auto ro = toByte (int (intensity * 1024 + (r - intensity) * saturation) >> 10);
+        auto go = toByte (int (intensity * 1024 + (g - intensity) * saturation) >> 10);
+        auto bo = toByte (int (intensity * 1024 + (b - intensity) * saturation) >> 10);
 
-            auto ro = (double) r / 255.0;
-            ro = ro - 0.5;
-            ro = ro * contrast;
-            ro = ro + 0.5;
-            ro = ro * 255.0;
+        Colour c (toByte (ro), toByte (go), toByte (bo));
+        auto hue = c.getHue();
+        hue += hueIn;
 
-            auto go = (double) g / 255.0;
-            go = go - 0.5;
-            go = go * contrast;
-            go = go + 0.5;
-            go = go * 255.0;
+        while (hue < 0.0f)
+            hue += 1.0f;
+        while (hue >= 1.0f)
+            hue -= 1.0f;
 
-            auto bo = (double) b / 255.0;
-            bo = bo - 0.5;
-            bo = bo * contrast;
-            bo = bo + 0.5;
-            bo = bo * 255.0;
+        c = Colour::fromHSV (hue, c.getSaturation(), c.getBrightness(), float (a));
+        ro = c.getRed();
+        go = c.getGreen();
+        bo = c.getBlue();
 
-            ro = toByte (ro);
-            go = toByte (go);
-            bo = toByte (bo);
+        ro = toByte (ro);
+        go = toByte (go);
+        bo = toByte (bo);
 
-            s->setARGB (a, toByte (ro), toByte (go), toByte (bo));
+        s->setARGB (a, toByte (ro), toByte (go), toByte (bo));
 
-            p += data.pixelStride;
+        if (lightness > 0)
+        {
+            auto blended = blend (PixelARGB (toByte ((lightness * 255) / 100 * (a / 255.0)), 255, 255, 255), convert<T, PixelARGB> (*s));
+            *s = convert<PixelARGB, T> (blended);
         }
-    });
-}
+        else if (lightness < 0)
+        {
+            auto blended = blend (PixelARGB (toByte ((-lightness * 255) / 100 * (a / 255.0)), 0, 0, 0), convert<T, PixelARGB> (*s));
+            *s = convert<PixelARGB, T> (blended);
+        }
+    }
+
+    float hueIn = 0.0f, saturation = 0.0f, lightness = 0.0f;
+};
 
 //==============================================================================
-template<class T>
-void applyBrightnessContrast (Image& img, float brightness, float contrast, ThreadPool* threadPool)
+struct GradientMapKernel final
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
+    GradientMapKernel (const ColourGradient& gradient) :
+        // The weighted sum can't go past 255, so the gradient only ever gets sampled at 256 spots:
+        colours (createLookupTable<Colour> ([&] (uint8 grey) { return gradient.getColourAtPosition (float (grey) / 256.0f); }))
+    {
+    }
 
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
+    {
+        const auto& c = colours[(size_t) tables.getGreyLevel (p[T::indexR], p[T::indexG], p[T::indexB])];
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+        p[T::indexR] = c.getRed();
+        p[T::indexG] = c.getGreen();
+        p[T::indexB] = c.getBlue();
+    }
 
-    auto multiply = 1.0f;
-    auto divide = 1.0f;
+    GreyLevelTables tables;
+    std::array<Colour, 256> colours;
+};
 
-    if (contrast < 0.0f)
-    {
-        multiply = contrast + 100;
-        divide = 100.0f;
-    }
-    else if (contrast > 0.0f)
+struct ColourKernel final
+{
+    ColourKernel (Colour c) :
+        r (c.getRed()), g (c.getGreen()), b (c.getBlue()), a (c.getAlpha())
     {
-        multiply = 100.0f;
-        divide = 100.0f - contrast;
     }
-    else
+
+    template<class T>
+    void process (uint8* p, int, int) const noexcept
     {
-        multiply = 1.0f;
-        divide = 1.0f;
+        ((T*) p)->setARGB (a, r, g, b);
     }
 
-    auto* rgbTable = new uint8_t[65536];
+    uint8 r = 0, g = 0, b = 0, a = 0;
+};
 
-    if (divide == 0.0f)
-    {
-        for (int intensity = 0; intensity < 256; intensity++)
-        {
-            if ((float) intensity + brightness < 128.0f)
-                rgbTable[intensity] = 0;
-            else
-                rgbTable[intensity] = 255;
-        }
-    }
-    else if (divide == 100.0f)
-    {
-        for (int intensity = 0; intensity < 256; intensity++)
-        {
-            auto shift = int ((intensity - 127.0f) * multiply / divide + 127.0f - (float) intensity + brightness);
+//==============================================================================
+template<class T>
+void applyVignette (Image& img, float amountIn, float radiusIn, float fallOff, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, VignetteKernel (amountIn, radiusIn, fallOff, img.getWidth(), img.getHeight()));
+}
 
-            for (int col = 0; col < 256; col++)
-            {
-                auto index = (intensity * 256) + col;
-                rgbTable[index] = toByte (col + shift);
-            }
-        }
-    }
-    else
-    {
-        for (int intensity = 0; intensity < 256; intensity++)
-        {
-            auto shift = int ((intensity - 127.0f + brightness) * multiply / divide + 127.0f - intensity);
+//==============================================================================
+template<class T>
+void applySepia (Image& img, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, SepiaKernel());
+}
 
-            for (int col = 0; col < 256; col++)
-            {
-                auto index = (intensity * 256) + col;
-                rgbTable[index] = toByte (col + shift);
-            }
-        }
-    }
+template<class T>
+void applyGreyScale (Image& img, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, GreyScaleKernel());
+}
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
-    {
-        auto* p = data.getLinePointer (y);
+template<class T>
+void applySoften (Image& img, ThreadPool* threadPool)
+{
+    const auto w = img.getWidth();
+    const auto h = img.getHeight();
+    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
-        for (int x = 0; x < w; x++)
-        {
-            auto* s = (T*) p;
+    Image dst (img.getFormat(), w, h, true);
 
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
+    Image::BitmapData srcData (img, Image::BitmapData::readOnly);
+    Image::BitmapData dstData (dst, Image::BitmapData::writeOnly);
 
-            if (divide == 0)
+    parallelForTiles ({ w, h }, tileSize, tileSize, threadPool, [&] (juce::Rectangle<int> tile)
+    {
+        for (int y = tile.getY(); y < tile.getBottom(); ++y)
+        {
+            for (int x = tile.getX(); x < tile.getRight(); x++)
             {
-                auto i = getIntensity (toByte (r), toByte (g), toByte (b));
-                auto c = rgbTable[i];
+                int ro = 0, go = 0, bo = 0;
+                uint8_t a = 0;
 
-                s->setARGB (a, c, c, c);
-            }
-            else
-            {
-                auto i = getIntensity (toByte (r), toByte (g), toByte (b));
-                auto shiftIndex = i * 256;
+                for (int m = -1; m <= 1; m++)
+                {
+                    for (int n = -1; n <= 1; n++)
+                    {
+                        int cx = jlimit (0, w - 1, x + m);
+                        int cy = jlimit (0, h - 1, y + n);
+
+                        T* s = (T*) srcData.getPixelPointer (cx, cy);
 
-                auto ro = rgbTable[shiftIndex + r];
-                auto go = rgbTable[shiftIndex + g];
-                auto bo = rgbTable[shiftIndex + b];
+                        ro += s->getRed();
+                        go += s->getGreen();
+                        bo += s->getBlue();
+                    }
+                }
 
-                ro = toByte (ro);
-                go = toByte (go);
-                bo = toByte (bo);
+                auto* s = (T*) srcData.getPixelPointer (x, y);
+                a = s->getAlpha();
 
-                s->setARGB (a, ro, go, bo);
-            }
+                auto* d = (T*) dstData.getPixelPointer (x, y);
 
-            p += data.pixelStride;
+                d->setARGB (a, toByte (ro / 9), toByte (go / 9), toByte (bo / 9));
+            }
         }
     });
-
-    delete[] rgbTable;
+    img = dst;
 }
 
-//==============================================================================
 template<class T>
-void applyHueSaturationLightness (Image& img, float hueIn, float saturation, float lightness, ThreadPool* threadPool)
+void applySharpen (Image& img, ThreadPool* threadPool)
 {
     const auto w = img.getWidth();
     const auto h = img.getHeight();
     threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
-    if (saturation > 100)
-        saturation = ((saturation - 100) * 3) + 100;
-
-    saturation = (saturation * 1024) / 100;
-
-    hueIn /= 360.0f;
+    Image dst (img.getFormat(), w, h, true);
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+    Image::BitmapData srcData (img, Image::BitmapData::readOnly);
+    Image::BitmapData dstData (dst, Image::BitmapData::writeOnly);
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    parallelForTiles ({ w, h }, tileSize, tileSize, threadPool, [&] (juce::Rectangle<int> tile)
     {
-        auto* p = data.getLinePointer (y);
-
-        for (int x = 0; x < w; x++)
+        for (int y = tile.getY(); y < tile.getBottom(); ++y)
         {
-            auto* s = (T*) p;
+            for (int x = tile.getX(); x < tile.getRight(); x++)
+            {
+                auto getPixelPointer = [&] (int cx, int cy) -> T* {
+                    cx = jlimit (0, w - 1, cx);
+                    cy = jlimit (0, h - 1, cy);
 
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
+                    return (T*) srcData.getPixelPointer (cx, cy);
+                };
 
-            auto intensity = getIntensity (toByte (r), toByte (g), toByte (b));
-            auto ro = toByte (int (intensity * 1024 + (r - intensity) * saturation) >> 10);
-            auto go = toByte (int (intensity * 1024 + (g - intensity) * saturation) >> 10);
-            auto bo = toByte (int (intensity * 1024 + (b - intensity) * saturation) >> 10);
+                int ro = 0, go = 0, bo = 0;
+                uint8 ao = 0;
 
-            Colour c (toByte (ro), toByte (go), toByte (bo));
-            auto hue = c.getHue();
-            hue += hueIn;
+                auto* s = getPixelPointer (x, y);
 
-            while (hue < 0.0f)
-                hue += 1.0f;
-            while (hue >= 1.0f)
-                hue -= 1.0f;
+                ro = s->getRed() * 5;
+                go = s->getGreen() * 5;
+                bo = s->getBlue() * 5;
+                ao = s->getAlpha();
 
-            c = Colour::fromHSV (hue, c.getSaturation(), c.getBrightness(), float (a));
-            ro = c.getRed();
-            go = c.getGreen();
-            bo = c.getBlue();
+                s = getPixelPointer (x, y - 1);
+                ro -= s->getRed();
+                go -= s->getGreen();
+                bo -= s->getBlue();
 
-            ro = toByte (ro);
-            go = toByte (go);
-            bo = toByte (bo);
+                s = getPixelPointer (x - 1, y);
+                ro -= s->getRed();
+                go -= s->getGreen();
+                bo -= s->getBlue();
 
-            s->setARGB (a, toByte (ro), toByte (go), toByte (bo));
+                s = getPixelPointer (x + 1, y);
+                ro -= s->getRed();
+                go -= s->getGreen();
+                bo -= s->getBlue();
 
-            if (lightness > 0)
-            {
-                auto blended = blend (PixelARGB (toByte ((lightness * 255) / 100 * (a / 255.0)), 255, 255, 255), convert<T, PixelARGB> (*s));
-                *s = convert<PixelARGB, T> (blended);
-            }
-            else if (lightness < 0)
-            {
-                auto blended = blend (PixelARGB (toByte ((-lightness * 255) / 100 * (a / 255.0)), 0, 0, 0), convert<T, PixelARGB> (*s));
-                *s = convert<PixelARGB, T> (blended);
-            }
+                s = getPixelPointer (x, y + 1);
+                ro -= s->getRed();
+                go -= s->getGreen();
+                bo -= s->getBlue();
 
-            p += data.pixelStride;
+                auto* d = (T*) dstData.getPixelPointer (x, y);
+
+                d->setARGB (ao, toByte (ro), toByte (go), toByte (bo));
+            }
         }
     });
+
+    img = dst;
 }
 
-//==============================================================================
+
 template<class T>
-void applyGradientMap (Image& img, const ColourGradient& gradient, ThreadPool* threadPool)
+void applyGamma (Image& img, float gamma, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, createGammaKernel (gamma));
+}
+
+template<class T>
+void applyInvert (Image& img, ThreadPool* threadPool)
 {
     const auto w = img.getWidth();
     const auto h = img.getHeight();
     threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
 
+    // Inverting a channel (ie: 255 - value) is the same as flipping all of its bits,
+    // so whole rows can be XOR'd at once. Packed RGB has no alpha to skip, so every byte gets flipped.
+    uint32 pattern = 0xffffffff;
+
+    if constexpr (sizeof (T) == 4)
+        pattern = (0xffu << (8 * T::indexR)) | (0xffu << (8 * T::indexG)) | (0xffu << (8 * T::indexB));
+
     Image::BitmapData data (img, Image::BitmapData::readWrite);
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
+    parallelFor (0, h, threadPool, [&] (int y)
     {
         auto* p = data.getLinePointer (y);
 
-        for (int x = 0; x < w; x++)
+        if (data.pixelStride == (int) sizeof (T))
         {
-            auto* s = (T*) p;
-
-            auto r = s->getRed();
-            auto g = s->getGreen();
-            auto b = s->getBlue();
-            auto a = s->getAlpha();
-            auto ro = toByte (r * 0.30 + 0.5);
-            auto go = toByte (g * 0.59 + 0.5);
-            auto bo = toByte (b * 0.11 + 0.5);
-
-            auto proportion = float (ro + go + bo) / 256.0f;
-            auto c = gradient.getColourAtPosition (proportion);
-
-            s->setARGB (a,
-                        c.getRed(),
-                        c.getGreen(),
-                        c.getBlue());
+            xorBytes (p, w * data.pixelStride, pattern);
+            return;
+        }
 
+        for (int x = 0; x < w; ++x)
+        {
+            InvertKernel().process<T> (p, x, y);
             p += data.pixelStride;
         }
     });
@@ -625,30 +647,37 @@ void applyGradientMap (Image& img, const ColourGradient& gradient, ThreadPool* t
 
 //==============================================================================
 template<class T>
-void applyColour (Image& img, Colour c, ThreadPool* threadPool)
+void applyContrast (Image& img, float contrast, ThreadPool* threadPool)
 {
-    const auto w = img.getWidth();
-    const auto h = img.getHeight();
-    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+    forEachPixel<T> (img, threadPool, createContrastKernel (contrast));
+}
 
-    auto r = c.getRed();
-    auto g = c.getGreen();
-    auto b = c.getBlue();
-    auto a = c.getAlpha();
+//==============================================================================
+template<class T>
+void applyBrightnessContrast (Image& img, float brightness, float contrast, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, BrightnessContrastKernel (brightness, contrast));
+}
 
-    Image::BitmapData data (img, Image::BitmapData::readWrite);
+//==============================================================================
+template<class T>
+void applyHueSaturationLightness (Image& img, float hueIn, float saturation, float lightness, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, HueSaturationLightnessKernel (hueIn, saturation, lightness));
+}
 
-    multithreadedFor<int> (0, h, 1, threadPool, [&] (int y)
-    {
-        auto* p = data.getLinePointer (y);
+//==============================================================================
+template<class T>
+void applyGradientMap (Image& img, const ColourGradient& gradient, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, GradientMapKernel (gradient));
+}
 
-        for (int x = 0; x < w; x++)
-        {
-            auto* s = (T*) p;
-            s->setARGB (a, r, g, b);
-            p += data.pixelStride;
-        }
-    });
+//==============================================================================
+template<class T>
+void applyColour (Image& img, Colour c, ThreadPool* threadPool)
+{
+    forEachPixel<T> (img, threadPool, ColourKernel (c));
 }
 
 //==============================================================================
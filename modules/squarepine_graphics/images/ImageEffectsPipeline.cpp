@@ -0,0 +1,311 @@
+class ImageEffectsPipeline::Effect
+{
+public:
+    Effect() = default;
+    virtual ~Effect() = default;
+
+    /** Called before each run, with the size of the image about to be processed. */
+    virtual void prepare (int /*width*/, int /*height*/) {}
+
+    /** Neighbourhood effects get the whole image to themselves. */
+    virtual bool isPointWise() const noexcept { return true; }
+    virtual void apply (Image&, ThreadPool*) {}
+
+    /** Point-wise effects get handed runs of pixels, which start at (x, y). */
+    virtual void processARGB (uint8* /*pixels*/, int /*pixelStride*/, int /*x*/, int /*y*/, int /*numPixels*/) const {}
+    virtual void processRGB (uint8* /*pixels*/, int /*pixelStride*/, int /*x*/, int /*y*/, int /*numPixels*/) const {}
+
+    template<class PixelType>
+    void process (uint8* pixels, int pixelStride, int x, int y, int numPixels) const
+    {
+        if constexpr (std::is_same_v<PixelType, PixelARGB>)
+            processARGB (pixels, pixelStride, x, y, numPixels);
+        else
+            processRGB (pixels, pixelStride, x, y, numPixels);
+    }
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Effect)
+};
+
+//==============================================================================
+template<typename Kernel>
+class ImageEffectsPipeline::PointEffect : public Effect
+{
+public:
+    PointEffect (Kernel k) :
+        kernel (std::move (k))
+    {
+    }
+
+    void processARGB (uint8* pixels, int pixelStride, int x, int y, int numPixels) const override
+    {
+        processRun<PixelARGB> (pixels, pixelStride, x, y, numPixels);
+    }
+
+    void processRGB (uint8* pixels, int pixelStride, int x, int y, int numPixels) const override
+    {
+        processRun<PixelRGB> (pixels, pixelStride, x, y, numPixels);
+    }
+
+protected:
+    Kernel kernel;
+
+private:
+    template<class PixelType>
+    void processRun (uint8* pixels, int pixelStride, int x, int y, int numPixels) const noexcept
+    {
+        for (int i = 0; i < numPixels; ++i)
+        {
+            kernel.template process<PixelType> (pixels, x + i, y);
+            pixels += pixelStride;
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PointEffect)
+};
+
+//==============================================================================
+/** The vignette's shape depends on the size of the image, so it only gets worked out when the pipeline is applied. */
+class ImageEffectsPipeline::VignetteEffect final : public PointEffect<VignetteKernel>
+{
+public:
+    VignetteEffect (float amountToUse, float radiusToUse, float falloffToUse) :
+        PointEffect ({}),
+        amount (amountToUse),
+        radius (radiusToUse),
+        falloff (falloffToUse)
+    {
+    }
+
+    void prepare (int width, int height) override
+    {
+        kernel = VignetteKernel (amount, radius, falloff, width, height);
+    }
+
+private:
+    const float amount, radius, falloff;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VignetteEffect)
+};
+
+//==============================================================================
+class ImageEffectsPipeline::NeighbourhoodEffect final : public Effect
+{
+public:
+    NeighbourhoodEffect (std::function<void (Image&, ThreadPool*)> f) :
+        function (std::move (f))
+    {
+    }
+
+    bool isPointWise() const noexcept override { return false; }
+
+    void apply (Image& img, ThreadPool* threadPool) override
+    {
+        function (img, threadPool);
+    }
+
+private:
+    std::function<void (Image&, ThreadPool*)> function;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (NeighbourhoodEffect)
+};
+
+//==============================================================================
+ImageEffectsPipeline::ImageEffectsPipeline() = default;
+ImageEffectsPipeline::~ImageEffectsPipeline() = default;
+
+ImageEffectsPipeline& ImageEffectsPipeline::add (std::unique_ptr<Effect> effect)
+{
+    effects.emplace_back (std::move (effect));
+    return *this;
+}
+
+//==============================================================================
+ImageEffectsPipeline& ImageEffectsPipeline::addVignette (float amount, float radius, float falloff)
+{
+    return add (std::make_unique<VignetteEffect> (amount, radius, falloff));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addSepia()
+{
+    return add (std::make_unique<PointEffect<SepiaKernel>> (SepiaKernel()));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addGreyScale()
+{
+    return add (std::make_unique<PointEffect<GreyScaleKernel>> (GreyScaleKernel()));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addGamma (float gamma)
+{
+    return add (std::make_unique<PointEffect<ChannelCurvesKernel>> (createGammaKernel (gamma)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addInvert()
+{
+    return add (std::make_unique<PointEffect<InvertKernel>> (InvertKernel()));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addContrast (float contrast)
+{
+    return add (std::make_unique<PointEffect<ChannelCurvesKernel>> (createContrastKernel (contrast)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addBrightnessContrast (float brightness, float contrast)
+{
+    return add (std::make_unique<PointEffect<BrightnessContrastKernel>> (BrightnessContrastKernel (brightness, contrast)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addHueSaturationLightness (float hue, float saturation, float lightness)
+{
+    return add (std::make_unique<PointEffect<HueSaturationLightnessKernel>> (HueSaturationLightnessKernel (hue, saturation, lightness)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addGradientMap (const ColourGradient& gradient)
+{
+    return add (std::make_unique<PointEffect<GradientMapKernel>> (GradientMapKernel (gradient)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addGradientMap (Colour c1, Colour c2)
+{
+    ColourGradient g;
+    g.addColour (0.0, c1);
+    g.addColour (1.0, c2);
+
+    return addGradientMap (g);
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addColour (Colour c)
+{
+    return add (std::make_unique<PointEffect<ColourKernel>> (ColourKernel (c)));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addBlend (BlendMode mode, Colour c)
+{
+    return add (std::make_unique<PointEffect<ColourBlendKernel>> (ColourBlendKernel (mode, c)));
+}
+
+//==============================================================================
+ImageEffectsPipeline& ImageEffectsPipeline::addSoften()
+{
+    return add (std::make_unique<NeighbourhoodEffect> ([] (Image& img, ThreadPool* threadPool) { applySoften (img, threadPool); }));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addSharpen()
+{
+    return add (std::make_unique<NeighbourhoodEffect> ([] (Image& img, ThreadPool* threadPool) { applySharpen (img, threadPool); }));
+}
+
+ImageEffectsPipeline& ImageEffectsPipeline::addStackBlur (int radius)
+{
+    return add (std::make_unique<NeighbourhoodEffect> ([radius] (Image& img, ThreadPool*) { applyStackBlur (img, radius); }));
+}
+
+//==============================================================================
+void ImageEffectsPipeline::clear()
+{
+    effects.clear();
+}
+
+int ImageEffectsPipeline::getNumEffects() const noexcept
+{
+    return (int) effects.size();
+}
+
+int ImageEffectsPipeline::getNumPasses() const noexcept
+{
+    int numPasses = 0;
+    bool inPointWiseRun = false;
+
+    for (const auto& effect : effects)
+    {
+        if (effect->isPointWise())
+        {
+            if (! inPointWiseRun)
+                ++numPasses;
+
+            inPointWiseRun = true;
+        }
+        else
+        {
+            ++numPasses;
+            inPointWiseRun = false;
+        }
+    }
+
+    return numPasses;
+}
+
+//==============================================================================
+void ImageEffectsPipeline::apply (Image& img, ThreadPool* threadPool)
+{
+    const auto format = img.getFormat();
+
+    if (format != Image::ARGB && format != Image::RGB)
+    {
+        jassertfalse;
+        return;
+    }
+
+    std::vector<const Effect*> pointEffects;
+    pointEffects.reserve (effects.size());
+
+    auto flushPointEffects = [&]()
+    {
+        if (pointEffects.empty())
+            return;
+
+        if (format == Image::ARGB)
+            applyPointEffects<PixelARGB> (img, pointEffects, threadPool);
+        else
+            applyPointEffects<PixelRGB> (img, pointEffects, threadPool);
+
+        pointEffects.clear();
+    };
+
+    for (auto& effect : effects)
+    {
+        // Sizes can't change mid-way, but it's cheap enough to not rely on that:
+        effect->prepare (img.getWidth(), img.getHeight());
+
+        if (effect->isPointWise())
+        {
+            pointEffects.push_back (effect.get());
+        }
+        else
+        {
+            flushPointEffects();
+            effect->apply (img, threadPool);
+        }
+    }
+
+    flushPointEffects();
+}
+
+template<class PixelType>
+void ImageEffectsPipeline::applyPointEffects (Image& img, const std::vector<const Effect*>& pointEffects, ThreadPool* threadPool) const
+{
+    const auto w = img.getWidth();
+    const auto h = img.getHeight();
+    threadPool = (w >= 256 || h >= 256) ? threadPool : nullptr;
+
+    Image::BitmapData data (img, Image::BitmapData::readWrite);
+
+    // Runs of up to tileSize pixels are small enough to stay in the L1 cache while every effect gets run over them.
+    // (Without a thread pool, the whole image comes through as a single tile, hence splitting the rows up here.)
+    parallelForTiles ({ w, h }, tileSize, tileSize, threadPool, [&] (juce::Rectangle<int> tile)
+    {
+        for (int y = tile.getY(); y < tile.getBottom(); ++y)
+        {
+            for (int x = tile.getX(); x < tile.getRight(); x += tileSize)
+            {
+                auto* p = data.getPixelPointer (x, y);
+                const auto numPixels = jmin (tileSize, tile.getRight() - x);
+
+                for (const auto* effect : pointEffects)
+                    effect->process<PixelType> (p, data.pixelStride, x, y, numPixels);
+            }
+        }
+    });
+}
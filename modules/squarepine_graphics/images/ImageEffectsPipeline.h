@@ -0,0 +1,108 @@
+/** Chains a number of image effects together, and applies them in as few passes over the image as possible.
+
+    Applying several effects one after the other (eg: applyBrightnessContrast(), then applyGradientMap(),
+    then applyVignette()) makes each of them sweep the whole image again. Instead, the point-wise effects
+    collected here (ie: the ones where each output pixel only depends on the same input pixel) get fused
+    together so that each tile of the image gets loaded once, run through all of them, and written back once.
+
+    Effects that read neighbouring pixels (ie: soften, sharpen and stack blur) need the previous effects to be
+    done with the whole image, so they split the pipeline into stages. For example, a pipeline made of
+    brightness/contrast, gradient map, soften, vignette and invert makes 3 passes over the image:
+    one for the first 2 effects, one for the softening, and one for the last 2 effects.
+
+    The output is identical to calling the matching functions from ImageEffects.h and BlendingEffects.h in order.
+
+    @code
+        ImageEffectsPipeline pipeline;
+        pipeline.addBrightnessContrast (10.0f, 20.0f)
+                .addGradientMap (Colours::darkblue, Colours::orange)
+                .addVignette (0.5f, 0.9f, 0.6f);
+
+        pipeline.apply (image, &threadPool);
+    @endcode
+*/
+class ImageEffectsPipeline final
+{
+public:
+    /** Creates an empty pipeline. */
+    ImageEffectsPipeline();
+
+    /** Destructor. */
+    ~ImageEffectsPipeline();
+
+    //==============================================================================
+    /** @see applyVignette */
+    ImageEffectsPipeline& addVignette (float amount, float radius, float falloff);
+    /** @see applySepia */
+    ImageEffectsPipeline& addSepia();
+    /** @see applyGreyScale */
+    ImageEffectsPipeline& addGreyScale();
+    /** @see applyGamma */
+    ImageEffectsPipeline& addGamma (float gamma);
+    /** @see applyInvert */
+    ImageEffectsPipeline& addInvert();
+    /** @see applyContrast */
+    ImageEffectsPipeline& addContrast (float contrast);
+    /** @see applyBrightnessContrast */
+    ImageEffectsPipeline& addBrightnessContrast (float brightness, float contrast);
+    /** @see applyHueSaturationLightness */
+    ImageEffectsPipeline& addHueSaturationLightness (float hue, float saturation, float lightness);
+    /** @see applyGradientMap */
+    ImageEffectsPipeline& addGradientMap (const ColourGradient&);
+    /** @see applyGradientMap */
+    ImageEffectsPipeline& addGradientMap (Colour c1, Colour c2);
+    /** @see applyColour */
+    ImageEffectsPipeline& addColour (Colour);
+    /** @see applyBlend */
+    ImageEffectsPipeline& addBlend (BlendMode, Colour);
+
+    //==============================================================================
+    /** Adds a soften effect, which ends the current stage.
+        @see applySoften
+    */
+    ImageEffectsPipeline& addSoften();
+
+    /** Adds a sharpen effect, which ends the current stage.
+        @see applySharpen
+    */
+    ImageEffectsPipeline& addSharpen();
+
+    /** Adds a stack blur, which ends the current stage.
+        @see applyStackBlur
+    */
+    ImageEffectsPipeline& addStackBlur (int radius);
+
+    //==============================================================================
+    /** Removes all of the effects. */
+    void clear();
+
+    /** @returns the number of effects added to the pipeline. */
+    [[nodiscard]] int getNumEffects() const noexcept;
+
+    /** @returns the number of passes over the image that apply() will make. */
+    [[nodiscard]] int getNumPasses() const noexcept;
+
+    //==============================================================================
+    /** Applies all of the effects, in the order they were added.
+
+        The image must be in the ARGB or RGB format.
+    */
+    void apply (Image&, ThreadPool* threadPool = nullptr);
+
+private:
+    //==============================================================================
+    class Effect;
+    template<typename Kernel>
+    class PointEffect;
+    class VignetteEffect;
+    class NeighbourhoodEffect;
+
+    std::vector<std::unique_ptr<Effect>> effects;
+
+    ImageEffectsPipeline& add (std::unique_ptr<Effect>);
+    template<class PixelType>
+    void applyPointEffects (Image&, const std::vector<const Effect*>&, ThreadPool*) const;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ImageEffectsPipeline)
+};
@@ -4,6 +4,14 @@
     #include <squarepine_images/squarepine_images.h>
 #endif
 
+#if JUCE_INTEL
+    #include <emmintrin.h>
+    #define SQUAREPINE_GRAPHICS_USE_SSE2 1
+#elif JUCE_ARM && (defined (__ARM_NEON__) || defined (__ARM_NEON))
+    #include <arm_neon.h>
+    #define SQUAREPINE_GRAPHICS_USE_NEON 1
+#endif
+
 namespace sp
 {
     using namespace juce;
@@ -63,6 +71,7 @@ namespace sp
     #include "images/BlendingEffects.cpp"
     #include "images/BMPImageFormat.cpp"
     #include "images/ImageEffects.cpp"
+    #include "images/ImageEffectsPipeline.cpp"
     #include "images/ImageFormatManager.cpp"
     #include "images/Resizer.cpp"
     #include "images/StackBlurEffects.cpp"
@@ -71,4 +80,7 @@ namespace sp
     #include "linkers/CueSDKLinker.cpp"
     #include "lookandfeels/Windows10LookAndFeel.cpp"
    // #include "tokenisers/JavascriptCodeTokeniser.cpp"
+    #include "unittests/ImageEffectsUnitTests.cpp"
+    #include "unittests/ImageEffectsPipelineUnitTests.cpp"
+    #include "unittests/SquarePineGraphicsUnitTestGatherer.cpp"
 }
@@ -197,6 +197,7 @@ namespace sp
     #include "images/BlendingEffects.h"
     #include "images/BMPImageFormat.h"
     #include "images/ImageEffects.h"
+    #include "images/ImageEffectsPipeline.h"
     #include "images/ImageFormatManager.h"
     #include "images/Resizer.h"
     #include "images/SVGParser.h"
@@ -208,6 +209,7 @@ namespace sp
     #include "utilities/Fonts.h"
     #include "utilities/Particles.h"
     #include "utilities/Resolution.h"
+    #include "unittests/SquarePineGraphicsUnitTestGatherer.h"
 }
 
 #endif //SQUAREPINE_GRAPHICS_H
@@ -0,0 +1,138 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+/** Checks that fusing effects together gives the same output as applying them one after the other. */
+class ImageEffectsPipelineUnitTests final : public UnitTest
+{
+public:
+    ImageEffectsPipelineUnitTests() :
+        UnitTest ("ImageEffectsPipeline", UnitTestCategories::graphics)
+    {
+    }
+
+    void runTest() override
+    {
+        ThreadPool threadPool (3);
+
+        for (auto* pool : { static_cast<ThreadPool*> (nullptr), &threadPool })
+        {
+            for (auto format : { Image::ARGB, Image::RGB })
+            {
+                const auto suffix = String (format == Image::ARGB ? " - ARGB" : " - RGB")
+                                  + String (pool != nullptr ? ", threaded" : "");
+
+                // Odd sizes make sure the partial tiles are covered:
+                const auto source = createRandomImage (format, 301, 283);
+
+                beginTest ("Passes" + suffix);
+                {
+                    ImageEffectsPipeline pipeline;
+                    expectEquals (pipeline.getNumPasses(), 0);
+
+                    pipeline.addBrightnessContrast (10.0f, 20.0f).addGradientMap (Colours::darkblue, Colours::orange);
+                    expectEquals (pipeline.getNumPasses(), 1);
+
+                    pipeline.addSoften().addVignette (0.5f, 0.9f, 0.6f).addInvert();
+                    expectEquals (pipeline.getNumEffects(), 5);
+                    expectEquals (pipeline.getNumPasses(), 3);
+
+                    pipeline.clear();
+                    expectEquals (pipeline.getNumEffects(), 0);
+                }
+
+                beginTest ("Point-wise effects" + suffix);
+                {
+                    ColourGradient gradient;
+                    gradient.addColour (0.0, Colours::darkblue);
+                    gradient.addColour (0.4, Colours::orange.withAlpha (0.5f));
+                    gradient.addColour (1.0, Colours::white);
+
+                    ImageEffectsPipeline pipeline;
+                    pipeline.addBrightnessContrast (15.0f, -30.0f)
+                            .addGamma (0.8f)
+                            .addContrast (20.0f)
+                            .addSepia()
+                            .addHueSaturationLightness (30.0f, 120.0f, -10.0f)
+                            .addBlend (BlendMode::overlay, Colours::red.withAlpha (0.4f))
+                            .addGradientMap (gradient)
+                            .addInvert()
+                            .addVignette (0.7f, 0.8f, 0.5f);
+
+                    auto expected = source.createCopy();
+                    applyBrightnessContrast (expected, 15.0f, -30.0f, pool);
+                    applyGamma (expected, 0.8f, pool);
+                    applyContrast (expected, 20.0f, pool);
+                    applySepia (expected, pool);
+                    applyHueSaturationLightness (expected, 30.0f, 120.0f, -10.0f, pool);
+                    applyBlend (expected, BlendMode::overlay, Colours::red.withAlpha (0.4f), pool);
+                    applyGradientMap (expected, gradient, pool);
+                    applyInvert (expected, pool);
+                    applyVignette (expected, 0.7f, 0.8f, 0.5f, pool);
+
+                    expectMatch (pipeline, source, expected, pool);
+                }
+
+                beginTest ("Stage boundaries" + suffix);
+                {
+                    ImageEffectsPipeline pipeline;
+                    pipeline.addGreyScale()
+                            .addSharpen()
+                            .addGamma (1.8f)
+                            .addSoften()
+                            .addStackBlur (4)
+                            .addColour (Colours::green.withAlpha (0.75f));
+
+                    auto expected = source.createCopy();
+                    applyGreyScale (expected, pool);
+                    applySharpen (expected, pool);
+                    applyGamma (expected, 1.8f, pool);
+                    applySoften (expected, pool);
+                    applyStackBlur (expected, 4);
+                    applyColour (expected, Colours::green.withAlpha (0.75f), pool);
+
+                    expectMatch (pipeline, source, expected, pool);
+                }
+            }
+        }
+    }
+
+private:
+    //==============================================================================
+    Image createRandomImage (Image::PixelFormat format, int width, int height)
+    {
+        Image image (format, width, height, false);
+        Image::BitmapData data (image, Image::BitmapData::writeOnly);
+        auto& random = getRandom();
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto* p = data.getLinePointer (y);
+
+            for (int i = 0; i < width * data.pixelStride; ++i)
+                p[i] = (uint8) random.nextInt (256);
+        }
+
+        return image;
+    }
+
+    void expectMatch (ImageEffectsPipeline& pipeline, const Image& source, const Image& expected, ThreadPool* threadPool)
+    {
+        auto result = source.createCopy();
+        pipeline.apply (result, threadPool);
+
+        expect (result.getFormat() == expected.getFormat());
+        expect (result.getBounds() == expected.getBounds());
+
+        const Image::BitmapData resultData (result, Image::BitmapData::readOnly);
+        const Image::BitmapData expectedData (expected, Image::BitmapData::readOnly);
+
+        auto numMismatchingRows = 0;
+
+        for (int y = 0; y < result.getHeight(); ++y)
+            if (std::memcmp (resultData.getLinePointer (y), expectedData.getLinePointer (y), (size_t) (result.getWidth() * resultData.pixelStride)) != 0)
+                ++numMismatchingRows;
+
+        expectEquals (numMismatchingRows, 0);
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#if SQUAREPINE_COMPILE_UNIT_TESTS
+
+/** Checks that the lookup table and SIMD based effects match the per-pixel versions they replaced, bit for bit. */
+class ImageEffectsUnitTests final : public UnitTest
+{
+public:
+    ImageEffectsUnitTests() :
+        UnitTest ("ImageEffects", UnitTestCategories::graphics)
+    {
+    }
+
+    void runTest() override
+    {
+        ThreadPool threadPool (3);
+
+        for (auto* pool : { static_cast<ThreadPool*> (nullptr), &threadPool })
+        {
+            runFormatTests<PixelARGB> (Image::ARGB, pool);
+            runFormatTests<PixelRGB> (Image::RGB, pool);
+        }
+    }
+
+private:
+    //==============================================================================
+    template<class T>
+    void runFormatTests (Image::PixelFormat format, ThreadPool* threadPool)
+    {
+        const auto suffix = String (format == Image::ARGB ? " - ARGB" : " - RGB")
+                          + String (threadPool != nullptr ? ", threaded" : "");
+
+        // An odd width makes sure the leftovers of the SIMD paths are covered:
+        const auto source = createRandomImage (format, 263, 257);
+
+        beginTest ("Sepia" + suffix);
+        expectMatch<T> (source, [&] (Image& i) { applySepia (i, threadPool); }, [] (T& s)
+        {
+            const auto r = s.getRed(), g = s.getGreen(), b = s.getBlue();
+            s.setARGB (s.getAlpha(),
+                       toByte ((r * .393) + (g * .769) + (b * .189)),
+                       toByte ((r * .349) + (g * .686) + (b * .168)),
+                       toByte ((r * .272) + (g * .534) + (b * .131)));
+        });
+
+        beginTest ("Grey scale" + suffix);
+        expectMatch<T> (source, [&] (Image& i) { applyGreyScale (i, threadPool); }, [] (T& s)
+        {
+            const auto ro = toByte (s.getRed() * 0.30 + 0.5);
+            const auto go = toByte (s.getGreen() * 0.59 + 0.5);
+            const auto bo = toByte (s.getBlue() * 0.11 + 0.5);
+            const auto grey = toByte (ro + go + bo);
+            s.setARGB (s.getAlpha(), grey, grey, grey);
+        });
+
+        beginTest ("Invert" + suffix);
+        expectMatch<T> (source, [&] (Image& i) { applyInvert (i, threadPool); }, [] (T& s)
+        {
+            s.setARGB (s.getAlpha(), (uint8) (255 - s.getRed()), (uint8) (255 - s.getGreen()), (uint8) (255 - s.getBlue()));
+        });
+
+        for (const auto gamma : { 0.45f, 1.0f, 2.2f })
+        {
+            beginTest ("Gamma " + String (gamma) + suffix);
+            expectMatch<T> (source, [&] (Image& i) { applyGamma (i, gamma, threadPool); }, [gamma] (T& s)
+            {
+                s.setARGB (s.getAlpha(),
+                           toByte (std::pow (s.getRed() / 255.0, gamma) * 255.0 + 0.5),
+                           toByte (std::pow (s.getGreen() / 255.0, gamma) * 255.0 + 0.5),
+                           toByte (std::pow (s.getBlue() / 255.0, gamma) * 255.0 + 0.5));
+            });
+        }
+
+        for (const auto contrast : { -50.0f, 0.0f, 35.0f })
+        {
+            beginTest ("Contrast " + String (contrast) + suffix);
+
+            const auto factor = square ((100.0f + contrast) / 100.0f);
+
+            expectMatch<T> (source, [&] (Image& i) { applyContrast (i, contrast, threadPool); }, [factor] (T& s)
+            {
+                auto apply = [factor] (uint8 v)
+                {
+                    auto o = (double) v / 255.0;
+                    o = o - 0.5;
+                    o = o * factor;
+                    o = o + 0.5;
+                    o = o * 255.0;
+                    return toByte (o);
+                };
+
+                s.setARGB (s.getAlpha(), apply (s.getRed()), apply (s.getGreen()), apply (s.getBlue()));
+            });
+        }
+
+        for (const auto& [brightness, contrast] : std::initializer_list<std::pair<float, float>> { { 20.0f, -40.0f }, { -10.0f, 60.0f }, { 0.0f, 100.0f } })
+        {
+            beginTest ("Brightness/contrast " + String (brightness) + ", " + String (contrast) + suffix);
+
+            auto reference = source.createCopy();
+            applyReferenceBrightnessContrast<T> (reference, brightness, contrast);
+
+            auto result = source.createCopy();
+            applyBrightnessContrast (result, brightness, contrast, threadPool);
+            expect (imagesMatch (reference, result));
+        }
+
+        beginTest ("Gradient map" + suffix);
+        {
+            ColourGradient gradient;
+            gradient.addColour (0.0, Colours::darkblue);
+            gradient.addColour (0.4, Colours::orange.withAlpha (0.5f));
+            gradient.addColour (1.0, Colours::white);
+
+            expectMatch<T> (source, [&] (Image& i) { applyGradientMap (i, gradient, threadPool); }, [&] (T& s)
+            {
+                const auto ro = toByte (s.getRed() * 0.30 + 0.5);
+                const auto go = toByte (s.getGreen() * 0.59 + 0.5);
+                const auto bo = toByte (s.getBlue() * 0.11 + 0.5);
+                const auto c = gradient.getColourAtPosition (float (ro + go + bo) / 256.0f);
+                s.setARGB (s.getAlpha(), c.getRed(), c.getGreen(), c.getBlue());
+            });
+        }
+    }
+
+    //==============================================================================
+    Image createRandomImage (Image::PixelFormat format, int width, int height)
+    {
+        Image image (format, width, height, false);
+        Image::BitmapData data (image, Image::BitmapData::writeOnly);
+        auto& random = getRandom();
+
+        for (int y = 0; y < height; ++y)
+        {
+            auto* p = data.getLinePointer (y);
+
+            for (int i = 0; i < width * data.pixelStride; ++i)
+                p[i] = (uint8) random.nextInt (256);
+        }
+
+        return image;
+    }
+
+    static bool imagesMatch (const Image& a, const Image& b)
+    {
+        const Image::BitmapData dataA (a, Image::BitmapData::readOnly);
+        const Image::BitmapData dataB (b, Image::BitmapData::readOnly);
+
+        for (int y = 0; y < a.getHeight(); ++y)
+            if (std::memcmp (dataA.getLinePointer (y), dataB.getLinePointer (y), (size_t) (a.getWidth() * dataA.pixelStride)) != 0)
+                return false;
+
+        return true;
+    }
+
+    /** Runs the reference, per-pixel, version of an effect and the real one, and compares their output. */
+    template<class T, typename EffectFunction, typename ReferenceFunction>
+    void expectMatch (const Image& source, EffectFunction&& effect, ReferenceFunction&& reference)
+    {
+        auto expected = source.createCopy();
+
+        {
+            Image::BitmapData data (expected, Image::BitmapData::readWrite);
+
+            for (int y = 0; y < expected.getHeight(); ++y)
+                for (int x = 0; x < expected.getWidth(); ++x)
+                    reference (*reinterpret_cast<T*> (data.getPixelPointer (x, y)));
+        }
+
+        auto result = source.createCopy();
+        effect (result);
+
+        expect (imagesMatch (expected, result));
+    }
+
+    template<class T>
+    static void applyReferenceBrightnessContrast (Image& img, float brightness, float contrast)
+    {
+        auto multiply = 1.0f;
+        auto divide = 1.0f;
+
+        if (contrast < 0.0f)
+        {
+            multiply = contrast + 100;
+            divide = 100.0f;
+        }
+        else if (contrast > 0.0f)
+        {
+            multiply = 100.0f;
+            divide = 100.0f - contrast;
+        }
+
+        std::vector<uint8_t> rgbTable (65536);
+
+        for (int intensity = 0; intensity < 256; intensity++)
+        {
+            if (divide == 0.0f)
+            {
+                rgbTable[(size_t) intensity] = (float) intensity + brightness < 128.0f ? 0 : 255;
+                continue;
+            }
+
+            const auto shift = divide == 100.0f
+                             ? int ((intensity - 127.0f) * multiply / divide + 127.0f - (float) intensity + brightness)
+                             : int ((intensity - 127.0f + brightness) * multiply / divide + 127.0f - intensity);
+
+            for (int col = 0; col < 256; col++)
+                rgbTable[(size_t) (intensity * 256 + col)] = toByte (col + shift);
+        }
+
+        Image::BitmapData data (img, Image::BitmapData::readWrite);
+
+        for (int y = 0; y < img.getHeight(); ++y)
+        {
+            for (int x = 0; x < img.getWidth(); ++x)
+            {
+                auto* s = reinterpret_cast<T*> (data.getPixelPointer (x, y));
+                const auto r = s->getRed(), g = s->getGreen(), b = s->getBlue();
+                const auto i = getIntensity (r, g, b);
+
+                if (divide == 0.0f)
+                    s->setARGB (s->getAlpha(), rgbTable[i], rgbTable[i], rgbTable[i]);
+                else
+                    s->setARGB (s->getAlpha(), rgbTable[(size_t) (i * 256 + r)], rgbTable[(size_t) (i * 256 + g)], rgbTable[(size_t) (i * 256 + b)]);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,12 @@
+//==============================================================================
+OwnedArray<UnitTest> SquarePineGraphicsUnitTestGatherer::createTests()
+{
+    OwnedArray<UnitTest> tests;
+
+   #if SQUAREPINE_COMPILE_UNIT_TESTS
+    tests.add (new ImageEffectsUnitTests());
+    tests.add (new ImageEffectsPipelineUnitTests());
+   #endif
+
+    return tests;
+}